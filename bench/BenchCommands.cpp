@@ -0,0 +1,284 @@
+//
+// Benchmarks all registered MeshProc commands on generated meshes of increasing size
+//
+// Additional command line argument:
+//   --meshproc_max_triangles=<n>   Largest mesh size to register (default 10000000)
+// All other arguments are passed to Google Benchmark, e.g.:
+//   --benchmark_filter=edit\.  --benchmark_out=result.json --benchmark_out_format=json
+//
+#include "BenchFixture.h"
+
+#include "commands/AbstractCommand.h"
+#include "commands/CommandFactory.h"
+#include "commands/CommandProfiler.h"
+#include "commands/CommandRegistration.h"
+#include "commands/ParameterBinding.h"
+#include "data/Selection.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace meshproc;
+using namespace meshproc::bench;
+using namespace meshproc::commands;
+
+namespace
+{
+
+	constexpr std::array<uint64_t, 4> MeshSizes{ 10'000, 100'000, 1'000'000, 10'000'000 };
+
+	sgrottel::NullLog s_log;
+	CommandFactory* s_factory = nullptr;
+
+	BenchFixture& GetFixture(uint64_t triangleCount)
+	{
+		static std::map<uint64_t, std::unique_ptr<BenchFixture>> fixtures;
+		auto it = fixtures.find(triangleCount);
+		if (it == fixtures.end())
+		{
+			it = fixtures.insert(std::make_pair(triangleCount, std::make_unique<BenchFixture>(triangleCount))).first;
+		}
+		return *it->second;
+	}
+
+	std::wstring FileExtension(const std::string& commandName)
+	{
+		if (commandName.find("CompressedMesh") != std::string::npos) return L".mpcm";
+		if (commandName.find("Obj") != std::string::npos) return L".obj";
+		if (commandName.find("Ply") != std::string::npos) return L".ply";
+		if (commandName.find("Stl") != std::string::npos) return L".stl";
+		if (commandName.find("3mf") != std::string::npos) return L".3mf";
+		return L"";
+	}
+
+	template<ParamType PT, typename T>
+	void Set(const ParameterBinding::ParamBindingBase* param, const T& value)
+	{
+		auto* target = ParameterBinding::GetValueTarget<PT>(param);
+		if (target != nullptr)
+		{
+			*target = value;
+		}
+	}
+
+	// copies for InOut parameters, as the command modifies them
+	template<typename T>
+	std::shared_ptr<T> Value(const ParameterBinding::ParamBindingBase* param, const std::shared_ptr<T>& value)
+	{
+		return (param->m_mode == ParamMode::InOut) ? std::make_shared<T>(*value) : value;
+	}
+
+	// copies for all mesh parameters, without the bounding volume hierarchy cached by earlier iterations,
+	// so every iteration measures the same work, including building the hierarchy
+	std::shared_ptr<data::Mesh> FreshMesh(const std::shared_ptr<data::Mesh>& mesh)
+	{
+		auto copy = std::make_shared<data::Mesh>(*mesh);
+		copy->ResetBvh();
+		return copy;
+	}
+
+	// Sets all input parameters of `cmd` from the fixture
+	// @return false if a required input cannot be provided
+	bool BindInputs(AbstractCommand& cmd, BenchFixture& fixture, uint64_t triangleCount, std::string& error)
+	{
+		const std::string& name = cmd.TypeName();
+		for (const auto& p : cmd.GetParams())
+		{
+			const ParameterBinding::ParamBindingBase* param = p.second.get();
+			if (param->m_mode == ParamMode::Out) continue;
+			const std::string& pn = p.first;
+
+			switch (param->m_type)
+			{
+			case ParamType::Mesh:
+				if (pn == "MeshB")
+				{
+					// a shifted copy, so both meshes intersect along curves instead of being coplanar
+					auto shifted = FreshMesh(fixture.mesh);
+					for (glm::vec3& v : shifted->vertices) v += glm::vec3{ 0.31f, 0.17f, 0.05f };
+					Set<ParamType::Mesh>(param, shifted);
+				}
+				else Set<ParamType::Mesh>(param, FreshMesh(fixture.mesh));
+				break;
+			case ParamType::Scene: Set<ParamType::Scene>(param, fixture.scene); break;
+			case ParamType::HalfSpace: Set<ParamType::HalfSpace>(param, fixture.plane); break;
+			case ParamType::FloatList: Set<ParamType::FloatList>(param, Value(param, fixture.scalars)); break;
+			case ParamType::Vec3List: Set<ParamType::Vec3List>(param, Value(param, fixture.normals)); break;
+			case ParamType::IndexList:
+				Set<ParamType::IndexList>(param, Value(param, (pn == "Loop") ? fixture.loop : fixture.selection));
+				break;
+			case ParamType::Selection:
+				Set<ParamType::Selection>(param, std::make_shared<data::Selection>(data::Selection::FromIndices(*fixture.selection, fixture.mesh->vertices.size())));
+				break;
+			case ParamType::Vec3:
+				if (pn == "PlaneNormal") Set<ParamType::Vec3>(param, glm::vec3{ 0.0f, 0.0f, 1.0f });
+				else if (pn == "PlaneXAxis") Set<ParamType::Vec3>(param, glm::vec3{ 1.0f, 0.0f, 0.0f });
+				else Set<ParamType::Vec3>(param, glm::vec3{ 1.35f, 0.0f, 0.0f });
+				break;
+			case ParamType::UInt32:
+				// generators: match the requested size
+				if (pn == "Iterations")
+				{
+					// 20 * 4^n triangles
+					const double it = std::log(static_cast<double>(triangleCount) / 20.0) / std::log(4.0);
+					Set<ParamType::UInt32>(param, static_cast<uint32_t>(std::max(0.0, std::round(it))));
+				}
+				else if (pn.starts_with("NumSegments"))
+				{
+					// triangles per n^2 segments, with all other parameters at their defaults
+					double trisPerSeg = 2.0;
+					if (name == "generator.Cuboid") trisPerSeg = 6.0 * 2.0;
+					else if (name == "generator.NonManifold") trisPerSeg = 3.0 * 2.0;
+					else if (name == "generator.ComponentSoup") trisPerSeg = 100.0 * 2.0;
+					Set<ParamType::UInt32>(param, std::max<uint32_t>(1, static_cast<uint32_t>(std::sqrt(static_cast<double>(triangleCount) / trisPerSeg))));
+				}
+				else if (pn == "TargetTriangleCount")
+				{
+					// decimation to a quarter of the input
+					Set<ParamType::UInt32>(param, static_cast<uint32_t>(fixture.mesh->triangles.size() / 4));
+				}
+				else if (pn == "Seed")
+				{
+					// reproducible random data
+					Set<ParamType::UInt32>(param, 42u);
+				}
+				break;
+			case ParamType::String:
+				if (pn == "Path")
+				{
+					const std::wstring ext = FileExtension(name);
+					std::filesystem::path path;
+					if (name.find("Reader") != std::string::npos)
+					{
+						path = fixture.GetFile(ext, *s_factory);
+						if (path.empty())
+						{
+							error = "no input file available";
+							return false;
+						}
+					}
+					else
+					{
+						path = BenchFixture::WorkingDirectory() / (L"out" + ext);
+					}
+					Set<ParamType::String>(param, path.wstring());
+				}
+				break;
+			case ParamType::StringList:
+				if (pn == "Paths")
+				{
+					const std::filesystem::path path = fixture.GetFile(L".obj", *s_factory);
+					if (path.empty())
+					{
+						error = "no input file available";
+						return false;
+					}
+					Set<ParamType::StringList>(param, std::make_shared<std::vector<std::wstring>>(1, path.wstring()));
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		return true;
+	}
+
+	void BenchCommand(benchmark::State& state, const std::string& name)
+	{
+		const uint64_t triangleCount = static_cast<uint64_t>(state.range(0));
+		BenchFixture& fixture = GetFixture(triangleCount);
+		std::shared_ptr<AbstractCommand> cmd = s_factory->Instantiate(name, s_log);
+		if (!cmd)
+		{
+			state.SkipWithError("Failed to instantiate command");
+			return;
+		}
+
+		uint64_t items = 0;
+		for (auto _ : state)
+		{
+			// binds fresh copies of the inputs each iteration, as the command changes InOut parameters and caches data on meshes
+			state.PauseTiming();
+			std::string error;
+			const bool bound = BindInputs(*cmd, fixture, triangleCount, error);
+			state.ResumeTiming();
+			if (!bound)
+			{
+				state.SkipWithError(error.c_str());
+				break;
+			}
+
+			if (!cmd->Invoke())
+			{
+				state.SkipWithError("Command invocation failed");
+				break;
+			}
+
+			if (items == 0)
+			{
+				state.PauseTiming();
+				const auto in = CommandProfiler::CountElements(*cmd, false);
+				const auto out = CommandProfiler::CountElements(*cmd, true);
+				items = std::max<uint64_t>({ in.triangles, out.triangles, 1 });
+				state.ResumeTiming();
+			}
+		}
+
+		state.SetItemsProcessed(static_cast<int64_t>(items * state.iterations()));
+		state.counters["triangles"] = static_cast<double>(items);
+	}
+
+}
+
+int main(int argc, char** argv)
+{
+	uint64_t maxTriangles = MeshSizes.back();
+	std::vector<char*> args;
+	for (int i = 0; i < argc; ++i)
+	{
+		constexpr const char* maxArg = "--meshproc_max_triangles=";
+		if (std::strncmp(argv[i], maxArg, std::strlen(maxArg)) == 0)
+		{
+			maxTriangles = std::strtoull(argv[i] + std::strlen(maxArg), nullptr, 10);
+			continue;
+		}
+		args.push_back(argv[i]);
+	}
+	int benchArgc = static_cast<int>(args.size());
+
+	CommandFactory factory{ s_log };
+	CommandRegistration(factory, s_log);
+	s_factory = &factory;
+
+	for (const std::string& name : factory.GetAllNames())
+	{
+		auto* b = benchmark::RegisterBenchmark(name, &BenchCommand, name);
+		for (uint64_t size : MeshSizes)
+		{
+			if (size > maxTriangles) break;
+			b->Arg(static_cast<int64_t>(size));
+		}
+		b->Unit(benchmark::kMillisecond)->UseRealTime();
+	}
+
+	benchmark::Initialize(&benchArgc, args.data());
+	if (benchmark::ReportUnrecognizedArguments(benchArgc, args.data()))
+	{
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
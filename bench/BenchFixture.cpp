@@ -0,0 +1,117 @@
+#include "BenchFixture.h"
+
+#include "commands/AbstractCommand.h"
+#include "commands/CommandFactory.h"
+#include "commands/ParameterBinding.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <string>
+
+using namespace meshproc;
+using namespace meshproc::bench;
+
+BenchFixture::BenchFixture(uint64_t triangleCount)
+{
+	constexpr float majorRadius = 1.0f;
+	constexpr float minorRadius = 0.35f;
+
+	// 2 * (4 * n) * n triangles
+	const uint32_t n = std::max<uint32_t>(3, static_cast<uint32_t>(std::sqrt(static_cast<double>(triangleCount) / 8.0)));
+	const uint32_t nMajor = 4 * n;
+	const uint32_t nMinor = n;
+
+	mesh = std::make_shared<data::Mesh>();
+	normals = std::make_shared<std::vector<glm::vec3>>();
+	scalars = std::make_shared<std::vector<float>>();
+	mesh->vertices.reserve(static_cast<size_t>(nMajor) * nMinor);
+	normals->reserve(static_cast<size_t>(nMajor) * nMinor);
+	scalars->reserve(static_cast<size_t>(nMajor) * nMinor);
+	for (uint32_t i = 0; i < nMajor; ++i)
+	{
+		const float u = 2.0f * std::numbers::pi_v<float> * static_cast<float>(i) / static_cast<float>(nMajor);
+		const glm::vec3 dir{ std::cos(u), std::sin(u), 0.0f };
+		for (uint32_t j = 0; j < nMinor; ++j)
+		{
+			const float v = 2.0f * std::numbers::pi_v<float> * static_cast<float>(j) / static_cast<float>(nMinor);
+			const glm::vec3 n{ dir * std::cos(v) + glm::vec3{ 0.0f, 0.0f, std::sin(v) } };
+			const glm::vec3 p{ dir * majorRadius + n * minorRadius };
+			mesh->vertices.push_back(p);
+			normals->push_back(n);
+			scalars->push_back(p.z);
+		}
+	}
+
+	mesh->triangles.reserve(2 * static_cast<size_t>(nMajor) * nMinor);
+	for (uint32_t i = 0; i < nMajor; ++i)
+	{
+		const uint32_t i2 = (i + 1) % nMajor;
+		for (uint32_t j = 0; j < nMinor; ++j)
+		{
+			const uint32_t j2 = (j + 1) % nMinor;
+			mesh->AddQuad(i * nMinor + j, i2 * nMinor + j, i * nMinor + j2, i2 * nMinor + j2);
+		}
+	}
+
+	scene = std::make_shared<data::Scene>();
+	scene->m_meshes.push_back(std::make_pair(mesh, glm::mat4{ 1.0f }));
+
+	plane = std::make_shared<data::HalfSpace>();
+	plane->Set(glm::vec3{ 0.1f, 0.2f, 1.0f }, 0.0f);
+
+	selection = std::make_shared<std::vector<uint32_t>>();
+	for (uint32_t i = 0; i < mesh->vertices.size(); i += 100)
+	{
+		selection->push_back(i);
+	}
+
+	loop = std::make_shared<std::vector<uint32_t>>();
+	for (uint32_t j = 0; j < nMinor; ++j)
+	{
+		loop->push_back(j);
+	}
+}
+
+std::filesystem::path BenchFixture::GetFile(const std::wstring& extension, const commands::CommandFactory& factory)
+{
+	auto it = m_files.find(extension);
+	if (it != m_files.end())
+	{
+		return it->second;
+	}
+
+	std::string writerName;
+	if (extension == L".obj") writerName = "io.ObjWriter";
+	else if (extension == L".ply") writerName = "io.PlyWriter";
+	else if (extension == L".stl") writerName = "io.StlWriter";
+	else if (extension == L".mpcm") writerName = "io.CompressedMeshWriter";
+	else return {};
+
+	sgrottel::NullLog log;
+	std::shared_ptr<commands::AbstractCommand> writer = factory.Instantiate(writerName, log);
+	if (!writer) return {};
+
+	const std::filesystem::path path = WorkingDirectory()
+		/ (L"fixture-" + std::to_wstring(mesh->triangles.size()) + extension);
+	using commands::ParameterBinding;
+	using commands::ParamType;
+	*ParameterBinding::GetValueTarget<ParamType::String>(writer->GetParam("Path").get()) = path.wstring();
+	*ParameterBinding::GetValueTarget<ParamType::Scene>(writer->GetParam("Scene").get()) = scene;
+	if (!writer->Invoke())
+	{
+		return {};
+	}
+
+	m_files[extension] = path;
+	return path;
+}
+
+std::filesystem::path BenchFixture::WorkingDirectory()
+{
+	const std::filesystem::path dir = std::filesystem::temp_directory_path() / L"meshproc-bench";
+	std::filesystem::create_directories(dir);
+	return dir;
+}
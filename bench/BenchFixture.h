@@ -0,0 +1,58 @@
+#pragma once
+
+#include "data/HalfSpace.h"
+#include "data/Mesh.h"
+#include "data/Scene.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		class CommandFactory;
+	}
+
+	namespace bench
+	{
+
+		// Generated input data for benchmarking commands at one mesh size
+		class BenchFixture
+		{
+		public:
+
+			// Closed torus with approximately `triangleCount` triangles, and matching attribute data
+			BenchFixture(uint64_t triangleCount);
+
+			std::shared_ptr<data::Mesh> mesh;
+			std::shared_ptr<data::Scene> scene;
+			std::shared_ptr<data::HalfSpace> plane;
+
+			// every 100th vertex
+			std::shared_ptr<std::vector<uint32_t>> selection;
+			// closed loop of vertices around the tube
+			std::shared_ptr<std::vector<uint32_t>> loop;
+			// per vertex height
+			std::shared_ptr<std::vector<float>> scalars;
+			// per vertex normals
+			std::shared_ptr<std::vector<glm::vec3>> normals;
+
+			// Path of the mesh written in the format of `extension`, written by the respective writer command on first request
+			// @return empty path if no writer is available for the format
+			std::filesystem::path GetFile(const std::wstring& extension, const commands::CommandFactory& factory);
+
+			static std::filesystem::path WorkingDirectory();
+
+		private:
+			std::map<std::wstring, std::filesystem::path> m_files;
+		};
+
+	}
+}
@@ -0,0 +1,95 @@
+//
+// Benchmarks utilities::LoopsFromEdges on shuffled edges of closed loops, formerly extra/perf_looper
+//
+#include "data/HashableEdge.h"
+#include "utilities/LoopsFromEdges.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace meshproc;
+
+namespace
+{
+
+	constexpr std::array<uint32_t, 3> LoopSizes{ 800, 1000, 1600 };
+
+	sgrottel::NullLog s_log;
+
+	// `repeat` times three loops of `LoopSizes`, with randomly ordered vertices, and all edges shuffled
+	class LoopsDataSet
+	{
+	public:
+		LoopsDataSet(uint32_t repeat)
+			: m_repeat{ repeat }
+		{
+			std::mt19937 generator(1337);
+			std::vector<uint32_t> sequence;
+			uint32_t first = 0;
+			for (uint32_t r = 0; r < repeat; ++r)
+			{
+				for (uint32_t size : LoopSizes)
+				{
+					sequence.resize(size);
+					std::iota(sequence.begin(), sequence.end(), first);
+					std::shuffle(sequence.begin(), sequence.end(), generator);
+					for (size_t i = 1; i < sequence.size(); ++i)
+					{
+						edges.push_back(data::HashableEdge{ sequence[i - 1], sequence[i] });
+					}
+					edges.push_back(data::HashableEdge{ sequence.back(), sequence.front() });
+					first += size;
+				}
+			}
+			std::shuffle(edges.begin(), edges.end(), generator);
+		}
+
+		bool IsValid(const commands::ParamTypeInfo_t<commands::ParamType::IndexListList>& loops) const
+		{
+			if (!loops || loops->size() != LoopSizes.size() * m_repeat) return false;
+			std::map<size_t, uint32_t> sizes;
+			for (const auto& loop : *loops)
+			{
+				sizes[loop->size()]++;
+			}
+			return std::all_of(LoopSizes.begin(), LoopSizes.end(), [&](uint32_t s) { return sizes[s] == m_repeat; });
+		}
+
+		std::vector<data::HashableEdge> edges;
+
+	private:
+		uint32_t m_repeat;
+	};
+
+	void BenchLoopsFromEdges(benchmark::State& state)
+	{
+		const LoopsDataSet data{ static_cast<uint32_t>(state.range(0)) };
+		commands::ParamTypeInfo_t<commands::ParamType::IndexListList> loops;
+		for (auto _ : state)
+		{
+			utilities::LoopsFromEdges(data.edges, loops, s_log);
+			benchmark::DoNotOptimize(loops);
+		}
+		if (!data.IsValid(loops))
+		{
+			state.SkipWithError("Results not valid");
+			return;
+		}
+		state.SetItemsProcessed(static_cast<int64_t>(data.edges.size() * state.iterations()));
+		state.counters["edges"] = static_cast<double>(data.edges.size());
+	}
+
+}
+
+// 3.4k edges as the original data set, up to 1.7M edges
+BENCHMARK(BenchLoopsFromEdges)->Name("utilities.LoopsFromEdges")->Arg(1)->Arg(30)->Arg(500)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,157 @@
+#
+# Performance regression gate
+#
+# Runs MeshProcBench with repetitions (or loads an existing result file via -Current),
+# and compares the median real time per command and mesh size against the checked-in baseline.
+#
+# A benchmark counts as regressed, if its median got slower by more than -Threshold (relative),
+# and the difference is larger than -NoiseSigma times the combined standard deviation of both runs.
+# Benchmarks reporting an error, and baseline benchmarks matching -Filter but missing from the current run, fail the gate as well.
+#
+# Exit codes:
+#   0   no regression
+#   1   regression, failed or missing benchmark detected, or error
+#   77  skipped, because there is no baseline (cf. ctest SKIP_RETURN_CODE); with -RequireBaseline this is an error instead
+#
+# Use -Update to store the current results as new baseline.
+#
+[CmdletBinding()]
+param(
+	[string]$Exe,
+	[string]$Current,
+	[string]$Baseline = (Join-Path $PSScriptRoot "baseline.json"),
+	[double]$Threshold = 0.15,
+	[double]$NoiseSigma = 2.0,
+	[int]$Repetitions = 5,
+	[long]$MaxTriangles = 1000000,
+	[string]$Filter = ".",
+	[switch]$RequireBaseline,
+	[switch]$Update
+)
+
+function Load-BenchmarkAggregates
+{
+	param(
+		[Parameter(Mandatory = $true)][string]$File
+	)
+
+	# run_name -> @{ median; stddev; unit; error }
+	$result = @{}
+	$json = Get-Content -Raw -Path $File | ConvertFrom-Json
+	foreach ($b in $json.benchmarks) {
+		$name = if ($b.run_name) { $b.run_name } else { $b.name }
+		if ($b.error_occurred) {
+			# failed runs report no aggregates
+			if (-not $result.ContainsKey($name)) {
+				$result[$name] = @{ median = $null; stddev = 0.0; unit = $b.time_unit; error = $null }
+			}
+			$result[$name].error = "$($b.error_message)"
+			continue
+		}
+		if ($b.run_type -ne "aggregate") { continue }
+		if (-not $result.ContainsKey($name)) {
+			$result[$name] = @{ median = $null; stddev = 0.0; unit = $b.time_unit; error = $null }
+		}
+		switch ($b.aggregate_name) {
+			"median" { $result[$name].median = [double]$b.real_time }
+			"stddev" { $result[$name].stddev = [double]$b.real_time }
+		}
+	}
+	return $result
+}
+
+if (-not $Update -and -not (Test-Path $Baseline -PathType Leaf)) {
+	if ($RequireBaseline) {
+		Write-Error "No baseline found at $Baseline. Run with -Update to create one."
+		exit 1
+	}
+	Write-Host "No baseline found at $Baseline; skipping. Run with -Update to create one." -ForegroundColor Yellow
+	exit 77
+}
+
+if (-not $Current) {
+	if (-not $Exe) {
+		Write-Error "Either -Exe or -Current must be specified"
+		exit 1
+	}
+	$Current = Join-Path ([System.IO.Path]::GetTempPath()) "meshproc-bench-current.json"
+	& $Exe "--meshproc_max_triangles=$MaxTriangles" "--benchmark_filter=$Filter" `
+		"--benchmark_repetitions=$Repetitions" "--benchmark_report_aggregates_only=true" `
+		"--benchmark_out=$Current" "--benchmark_out_format=json"
+	if ($LASTEXITCODE -ne 0) {
+		Write-Error "Benchmark run failed"
+		exit 1
+	}
+}
+
+if ($Update) {
+	Copy-Item -Path $Current -Destination $Baseline -Force
+	Write-Host "Baseline updated: $Baseline"
+	exit 0
+}
+
+$base = Load-BenchmarkAggregates $Baseline
+$curr = Load-BenchmarkAggregates $Current
+
+$rows = @()
+$regressions = 0
+$failures = 0
+foreach ($name in ($curr.Keys | Sort-Object)) {
+	$c = $curr[$name]
+	if ($c.error) {
+		$rows += [PSCustomObject]@{ Benchmark = $name; Baseline = "-"; Current = "-"; Change = "-"; Result = "ERROR: $($c.error)" }
+		$failures++
+		continue
+	}
+	if (-not $base.ContainsKey($name)) {
+		$rows += [PSCustomObject]@{ Benchmark = $name; Baseline = "-"; Current = "{0:N3}" -f $c.median; Change = "-"; Result = "new" }
+		continue
+	}
+	$b = $base[$name]
+	if ($b.unit -ne $c.unit -or -not $b.median -or -not $c.median) {
+		$rows += [PSCustomObject]@{ Benchmark = $name; Baseline = "?"; Current = "?"; Change = "-"; Result = "incomparable" }
+		continue
+	}
+
+	$ratio = $c.median / $b.median
+	$noise = $NoiseSigma * [math]::Sqrt($b.stddev * $b.stddev + $c.stddev * $c.stddev)
+	$result = "ok"
+	if ($ratio -gt (1.0 + $Threshold)) {
+		if (($c.median - $b.median) -gt $noise) {
+			$result = "REGRESSION"
+			$regressions++
+		} else {
+			$result = "noise"
+		}
+	} elseif ($ratio -lt (1.0 - $Threshold) -and ($b.median - $c.median) -gt $noise) {
+		$result = "faster"
+	}
+
+	$rows += [PSCustomObject]@{
+		Benchmark = $name
+		Baseline = "{0:N3} {1}" -f $b.median, $b.unit
+		Current = "{0:N3} {1}" -f $c.median, $c.unit
+		Change = "{0:+0.0;-0.0}%" -f (($ratio - 1.0) * 100.0)
+		Result = $result
+	}
+}
+# baseline benchmarks excluded by -Filter are not expected in the current run
+foreach ($name in ($base.Keys | Where-Object { -not $curr.ContainsKey($_) -and $_ -match $Filter } | Sort-Object)) {
+	$rows += [PSCustomObject]@{ Benchmark = $name; Baseline = "{0:N3}" -f $base[$name].median; Current = "-"; Change = "-"; Result = "MISSING" }
+	$failures++
+}
+
+$rows | Format-Table -AutoSize | Out-String -Width 200 | Write-Host
+
+if ($failures -gt 0) {
+	Write-Host "$failures benchmark(s) failed or missing" -ForegroundColor Red
+}
+if ($regressions -gt 0) {
+	Write-Host "$regressions benchmark(s) regressed by more than $($Threshold * 100)%" -ForegroundColor Red
+}
+if ($failures -gt 0 -or $regressions -gt 0) {
+	exit 1
+}
+
+Write-Host "No performance regressions (threshold $($Threshold * 100)%)" -ForegroundColor Green
+exit 0
@@ -57,27 +57,15 @@ do
 	normals:invoke()
 	normals = normals.Normals
 
-	local minv = meshval[1]
-	local maxv = meshval[1]
-	for i = 2, #meshval do
-		local v = meshval[i]
-		if v < minv then
-			minv = v
-		elseif v > maxv then
-			maxv = v
-		end
-	end
+	local minv = meshval:min()
+	local maxv = meshval:max()
 	log.detail("Dist values in "..tostring(minv).." .. "..tostring(maxv))
 
-	for vI, v in ipairs(mesh.vertex) do
-		local vv = meshval[vI]
-		if vv > 0 then
-			vv = vv / maxv
-		else
-			vv = -(vv / minv)
-		end
-		mesh.vertex[vI] = v + normals[vI] * vv * 0.6
-	end
+	-- normalize positive and negative distances separately, then offset along the normals;
+	-- the gradient keys must ascend strictly, also when all distances have the same sign
+	local eps = 1e-6
+	local offsets = meshval:map_gradient({ math.min(minv, -eps), 0, math.max(maxv, eps) }, { -0.6, 0, 0.6 })
+	mesh.vertices:add(normals:mul(offsets))
 end
 
 -- -- do return end
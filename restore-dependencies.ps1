@@ -1,6 +1,11 @@
 #
 # Restores dependencies pre build
 #
+# -Benchmarks additionally restores the dependencies of the benchmark suite (cmake -DMESHPROC_BUILD_BENCHMARKS=ON)
+#
+param(
+	[switch]$Benchmarks
+)
 Write-Host "Restoring dependencies"
 
 # Nuget
@@ -16,7 +21,9 @@ if (-not (Test-Path (Join-Path $PSScriptRoot "vcpkg\vcpkg.exe") -PathType Leaf))
     .\vcpkg\bootstrap-vcpkg.bat
 }
 
-.\vcpkg\vcpkg.exe install --triplet x64-windows "--vcpkg-root=$(Join-Path $PSScriptRoot 'vcpkg')"
+$vcpkgArgs = @("install", "--triplet", "x64-windows", "--vcpkg-root=$(Join-Path $PSScriptRoot 'vcpkg')")
+if ($Benchmarks) { $vcpkgArgs += "--x-feature=benchmarks" }
+.\vcpkg\vcpkg.exe @vcpkgArgs
 
 # done.
 Write-Host "done."
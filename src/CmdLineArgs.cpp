@@ -5,6 +5,8 @@
 #include <SimpleLog/SimpleLog.hpp>
 #include <yaclap.hpp>
 
+#include <cstdlib>
+
 namespace
 {
 
@@ -55,6 +57,22 @@ bool meshproc::CmdLineArgs::Parse(sgrottel::ISimpleLog& log, int argc, wchar_t c
 	Switch swVerbose{ L"-v", L"Verbose output" };
 	parser.Add(swVerbose);
 
+	Option optThreads{ L"--threads", L"count", L"Number of threads used for parallel processing (0 = number of hardware threads; 1 = deterministic single-threaded)" };
+	optThreads.AddAlias(L"-threads");
+	parser.Add(optThreads);
+
+	Switch swProfile{ L"--profile", L"Profiles all command invocations and prints a report at exit" };
+	swProfile.AddAlias(L"-profile");
+	parser.Add(swProfile);
+
+	Option optProfileOut{ L"--profile-out", L"file", L"Output JSON file for the profile data (defaults to the script name with extension '.profile.json'); implies --profile" };
+	optProfileOut.AddAlias(L"-profile-out");
+	parser.Add(optProfileOut);
+
+	Option optTrace{ L"--trace", L"file", L"Writes a timeline of the script run to the JSON file in the Chrome trace-event format" };
+	optTrace.AddAlias(L"-trace");
+	parser.Add(optTrace);
+
 	Parser::Result res = parser.Parse(argc, argv);
 
 	if (res.HasCommand(cmdRun))
@@ -94,6 +112,38 @@ bool meshproc::CmdLineArgs::Parse(sgrottel::ISimpleLog& log, int argc, wchar_t c
 
 	m_verbose = res.HasSwitch(swVerbose) > 0;
 
+	for (auto const& t : res.GetOptionValues(optThreads))
+	{
+		std::wstring value{ Trim(t) };
+		wchar_t* end = nullptr;
+		const unsigned long threads = std::wcstoul(value.c_str(), &end, 10);
+		if (value.empty() || end == nullptr || *end != L'\0')
+		{
+			res.SetError(L"Invalid number of threads");
+		}
+		else
+		{
+			m_threads = static_cast<uint32_t>(threads);
+		}
+	}
+
+	m_profile = res.HasSwitch(swProfile) > 0;
+	for (auto const& p : res.GetOptionValues(optProfileOut))
+	{
+		m_profileOutput = static_cast<std::wstring_view>(p);
+		m_profile = true;
+	}
+	if (m_profile && m_profileOutput.empty() && !m_script.empty())
+	{
+		m_profileOutput = m_script;
+		m_profileOutput.replace_extension(L".profile.json");
+	}
+
+	for (auto const& p : res.GetOptionValues(optTrace))
+	{
+		m_traceOutput = static_cast<std::wstring_view>(p);
+	}
+
 	LogGreeting(log);
 	parser.PrintErrorAndHelpIfNeeded(res);
 	return res.IsSuccess() && !res.ShouldShowHelp();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string_view>
 #include <filesystem>
 #include <unordered_map>
@@ -26,6 +27,10 @@ namespace meshproc
 	public:
 		CliCommand m_command{ CliCommand::Error };
 		bool m_verbose{ false };
+		uint32_t m_threads{ 0 };
+		bool m_profile{ false };
+		std::filesystem::path m_profileOutput{};
+		std::filesystem::path m_traceOutput{};
 		std::filesystem::path m_script{};
 		std::unordered_map<std::wstring_view, std::wstring_view> m_scriptArgs{};
 
@@ -1,8 +1,11 @@
 ﻿#include "CmdLineArgs.h"
 
 #include "commands/CommandFactory.h"
+#include "commands/CommandProfiler.h"
 #include "commands/CommandRegistration.h"
 #include "lua/Runner.h"
+#include "utilities/TaskScheduler.h"
+#include "utilities/Trace.h"
 
 #include <SimpleLog/SimpleLog.hpp>
 
@@ -29,14 +32,30 @@ int wmain(int argc, wchar_t **argv)
 
 	log.SetEchoDetails(cmdLine.m_verbose);
 
+	if (!cmdLine.m_traceOutput.empty())
+	{
+		meshproc::utilities::Trace::Instance().Enable();
+		meshproc::utilities::Trace::Instance().SetThreadName("main");
+	}
+
+	meshproc::utilities::TaskScheduler::Instance().SetThreadCount(cmdLine.m_threads);
+	log.Detail("Using %u threads", meshproc::utilities::TaskScheduler::Instance().GetThreadCount());
+
 	meshproc::commands::CommandFactory cmdFactory{ log };
 	meshproc::commands::CommandRegistration(cmdFactory, log);
 
+	std::shared_ptr<meshproc::commands::CommandProfiler> profiler;
+
 	switch (cmdLine.m_command)
 	{
 	case CliCommand::RunScript:
 	{
 		meshproc::lua::Runner lua{ log, cmdFactory };
+		if (cmdLine.m_profile)
+		{
+			profiler = std::make_shared<meshproc::commands::CommandProfiler>();
+			lua.SetProfiler(profiler);
+		}
 		if (!lua.Init()) break;
 		if (!lua.RegisterCommands()) break;
 
@@ -60,5 +79,19 @@ int wmain(int argc, wchar_t **argv)
 		break;
 	}
 
+	if (!cmdLine.m_traceOutput.empty())
+	{
+		meshproc::utilities::Trace::Instance().WriteJson(cmdLine.m_traceOutput, log);
+	}
+
+	if (profiler)
+	{
+		profiler->LogReport(log);
+		if (!cmdLine.m_profileOutput.empty())
+		{
+			profiler->WriteJson(cmdLine.m_profileOutput, log);
+		}
+	}
+
 	return 0;
 }
@@ -1,5 +1,7 @@
 #include "AbstractCommand.h"
 
+#include "utilities/TaskScheduler.h"
+
 #include <SimpleLog/SimpleLog.hpp>
 
 #include <stdexcept>
@@ -18,6 +20,11 @@ void AbstractCommand::LogInfo(const sgrottel::ISimpleLog& log, bool verbose) con
 	m_paramsRefs.LogInfo(log, verbose);
 }
 
+utilities::TaskScheduler& AbstractCommand::Tasks() const noexcept
+{
+	return utilities::TaskScheduler::Instance();
+}
+
 void AbstractCommand::InitTypeName(std::string const& name)
 {
 	if (m_typeName.empty())
@@ -37,11 +44,7 @@ void AbstractCommand::ParamBindingRefs::LogInfo(const sgrottel::ISimpleLog& log,
 	{
 		return;
 	}
-	std::vector<std::pair<std::string, std::shared_ptr<ParamBindingBase>>> params;
-	params.resize(m_params.size());
-	std::copy(m_params.begin(), m_params.end(), params.begin());
-	std::sort(params.begin(), params.end(), [](auto& a, auto& b) { return std::get<1>(a)->m_idx < std::get<1>(b)->m_idx; });
-	for (auto const& p : params)
+	for (auto const& p : GetParams())
 	{
 		log.Detail("  %s  [%s]  %s", p.first.c_str(), GetParamModeName(p.second->m_mode), GetParamTypeName(p.second->m_type));
 	}
@@ -57,3 +60,13 @@ AbstractCommand::ParamBindingRefs::GetParam(const std::string& name) const
 	}
 	return p->second;
 }
+
+std::vector<std::pair<std::string, std::shared_ptr<AbstractCommand::ParamBindingRefs::ParamBindingBase>>>
+AbstractCommand::ParamBindingRefs::GetParams() const
+{
+	std::vector<std::pair<std::string, std::shared_ptr<ParamBindingBase>>> params;
+	params.resize(m_params.size());
+	std::copy(m_params.begin(), m_params.end(), params.begin());
+	std::sort(params.begin(), params.end(), [](auto& a, auto& b) { return std::get<1>(a)->m_idx < std::get<1>(b)->m_idx; });
+	return params;
+}
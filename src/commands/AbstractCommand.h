@@ -3,10 +3,13 @@
 #include "Parameter.h"
 #include "ParameterBinding.h"
 
+#include "utilities/Trace.h"
+
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace sgrottel
@@ -16,6 +19,11 @@ namespace sgrottel
 
 namespace meshproc
 {
+	namespace utilities
+	{
+		class TaskScheduler;
+	}
+
 	namespace commands
 	{
 
@@ -35,6 +43,12 @@ namespace meshproc
 				return m_paramsRefs.GetParam(name);
 			}
 
+			// All parameters in the order of their registration
+			inline std::vector<std::pair<std::string, std::shared_ptr<ParameterBinding::ParamBindingBase>>> GetParams() const
+			{
+				return m_paramsRefs.GetParams();
+			}
+
 			inline const std::string& TypeName() const
 			{
 				return m_typeName;
@@ -59,6 +73,16 @@ namespace meshproc
 				return m_log;
 			}
 
+			// The process-wide task scheduler for parallel execution
+			utilities::TaskScheduler& Tasks() const noexcept;
+
+			// Scoped span for the timeline trace, e.g. `auto span = TraceScope("flood fill");`
+			// `name` must stay valid for the life time of the span
+			inline utilities::Trace::Span TraceScope(const char* name) const
+			{
+				return utilities::Trace::Span{ name, "phase" };
+			}
+
 		private:
 
 			class ParamBindingRefs : public ParameterBinding
@@ -72,6 +96,8 @@ namespace meshproc
 
 				std::shared_ptr<ParamBindingBase> GetParam(const std::string& name) const;
 
+				std::vector<std::pair<std::string, std::shared_ptr<ParamBindingBase>>> GetParams() const;
+
 			private:
 
 				std::unordered_map<std::string, std::shared_ptr<ParamBindingBase>> m_params;
@@ -0,0 +1,259 @@
+#include "CommandProfiler.h"
+
+#include "AbstractCommand.h"
+#include "data/Mesh.h"
+#include "data/Scene.h"
+#include "data/Selection.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <windows.h>
+#include <psapi.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+
+namespace
+{
+
+	void AddMesh(CommandProfiler::ElementCounts& counts, const std::shared_ptr<data::Mesh>& mesh)
+	{
+		if (!mesh) return;
+		counts.vertices += mesh->vertices.size();
+		counts.triangles += mesh->triangles.size();
+	}
+
+	template<ParamType PT>
+	void AddList(CommandProfiler::ElementCounts& counts, const ParameterBinding::ParamBindingBase* param)
+	{
+		const auto* list = ParameterBinding::GetValueSource<PT>(param);
+		if (list == nullptr || !*list) return;
+		counts.listElements += (*list)->size();
+	}
+
+	template<ParamType PT>
+	void AddListList(CommandProfiler::ElementCounts& counts, const ParameterBinding::ParamBindingBase* param)
+	{
+		const auto* lists = ParameterBinding::GetValueSource<PT>(param);
+		if (lists == nullptr || !*lists) return;
+		for (const auto& l : **lists)
+		{
+			if (l) counts.listElements += l->size();
+		}
+	}
+
+	void AddCounts(CommandProfiler::ElementCounts& sum, const CommandProfiler::ElementCounts& add)
+	{
+		sum.vertices += add.vertices;
+		sum.triangles += add.triangles;
+		sum.listElements += add.listElements;
+	}
+
+	void WriteJsonCounts(FILE* file, const char* name, const CommandProfiler::ElementCounts& counts)
+	{
+		fprintf(file, "\"%s\": { \"vertices\": %llu, \"triangles\": %llu, \"list_elements\": %llu }", name,
+			static_cast<unsigned long long>(counts.vertices),
+			static_cast<unsigned long long>(counts.triangles),
+			static_cast<unsigned long long>(counts.listElements));
+	}
+
+}
+
+CommandProfiler::Measurement CommandProfiler::Begin(const AbstractCommand& cmd) const
+{
+	Measurement m;
+	m.input = CountElements(cmd, false);
+	m.peakRssStart = ProcessPeakRss();
+	m.cpuStartMs = ProcessCpuTimeMs();
+	m.wallStart = std::chrono::steady_clock::now();
+	return m;
+}
+
+void CommandProfiler::End(const AbstractCommand& cmd, const Measurement& measurement, bool success)
+{
+	Record r;
+	r.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - measurement.wallStart).count();
+	r.cpuMs = ProcessCpuTimeMs() - measurement.cpuStartMs;
+	const uint64_t peakRss = ProcessPeakRss();
+	r.peakRssGrowth = (peakRss > measurement.peakRssStart) ? (peakRss - measurement.peakRssStart) : 0;
+	r.command = cmd.TypeName();
+	r.success = success;
+	r.input = measurement.input;
+	r.output = CountElements(cmd, true);
+	m_records.push_back(std::move(r));
+}
+
+CommandProfiler::ElementCounts CommandProfiler::CountElements(const AbstractCommand& cmd, bool output)
+{
+	ElementCounts counts;
+	for (const auto& p : cmd.GetParams())
+	{
+		const ParameterBinding::ParamBindingBase* param = p.second.get();
+		if (param->m_mode != ParamMode::InOut && (param->m_mode == ParamMode::Out) != output)
+		{
+			continue;
+		}
+
+		switch (param->m_type)
+		{
+		case ParamType::Mesh:
+		{
+			const auto* mesh = ParameterBinding::GetValueSource<ParamType::Mesh>(param);
+			if (mesh != nullptr) AddMesh(counts, *mesh);
+		}
+		break;
+		case ParamType::MeshList:
+		{
+			const auto* meshes = ParameterBinding::GetValueSource<ParamType::MeshList>(param);
+			if (meshes == nullptr || !*meshes) break;
+			for (const auto& mesh : **meshes)
+			{
+				AddMesh(counts, mesh);
+			}
+		}
+		break;
+		case ParamType::Scene:
+		{
+			const auto* scene = ParameterBinding::GetValueSource<ParamType::Scene>(param);
+			if (scene == nullptr || !*scene) break;
+			for (const auto& mesh : (*scene)->m_meshes)
+			{
+				AddMesh(counts, mesh.first);
+			}
+		}
+		break;
+		case ParamType::FloatList: AddList<ParamType::FloatList>(counts, param); break;
+		case ParamType::StringList: AddList<ParamType::StringList>(counts, param); break;
+		case ParamType::Vec3List: AddList<ParamType::Vec3List>(counts, param); break;
+		case ParamType::IndexList: AddList<ParamType::IndexList>(counts, param); break;
+		case ParamType::Vec3ListList: AddListList<ParamType::Vec3ListList>(counts, param); break;
+		case ParamType::IndexListList: AddListList<ParamType::IndexListList>(counts, param); break;
+		case ParamType::Selection:
+		{
+			const auto* sel = ParameterBinding::GetValueSource<ParamType::Selection>(param);
+			if (sel != nullptr && *sel) counts.listElements += (*sel)->Count();
+		}
+		break;
+		default: break;
+		}
+	}
+	return counts;
+}
+
+std::vector<CommandProfiler::Aggregate> CommandProfiler::Aggregated() const
+{
+	std::vector<Aggregate> aggregates;
+	std::unordered_map<std::string, size_t> index;
+	for (const Record& r : m_records)
+	{
+		auto it = index.find(r.command);
+		if (it == index.end())
+		{
+			it = index.insert(std::make_pair(r.command, aggregates.size())).first;
+			aggregates.push_back(Aggregate{});
+			aggregates.back().command = r.command;
+		}
+		Aggregate& a = aggregates[it->second];
+		a.calls++;
+		a.wallMs += r.wallMs;
+		a.wallMaxMs = std::max(a.wallMaxMs, r.wallMs);
+		a.cpuMs += r.cpuMs;
+		a.peakRssGrowthMax = std::max(a.peakRssGrowthMax, r.peakRssGrowth);
+		AddCounts(a.input, r.input);
+		AddCounts(a.output, r.output);
+	}
+	std::sort(aggregates.begin(), aggregates.end(), [](const Aggregate& a, const Aggregate& b) { return a.wallMs > b.wallMs; });
+	return aggregates;
+}
+
+void CommandProfiler::LogReport(const sgrottel::ISimpleLog& log) const
+{
+	const std::vector<Aggregate> aggregates = Aggregated();
+	double wallTotal = 0.0;
+	for (const Aggregate& a : aggregates)
+	{
+		wallTotal += a.wallMs;
+	}
+
+	log.Message("");
+	log.Message("Profile (%d invocations, %.2f ms):", static_cast<int>(m_records.size()), wallTotal);
+	log.Message("  %-40s %6s %12s %6s %12s %12s %12s %12s %12s",
+		"Command", "Calls", "Wall ms", "%", "Max ms", "CPU ms", "Peak+ MB", "In tris", "Out tris");
+	for (const Aggregate& a : aggregates)
+	{
+		log.Message("  %-40s %6u %12.2f %6.1f %12.2f %12.2f %12.2f %12llu %12llu",
+			a.command.c_str(), a.calls, a.wallMs,
+			(wallTotal > 0.0) ? (100.0 * a.wallMs / wallTotal) : 0.0,
+			a.wallMaxMs, a.cpuMs,
+			static_cast<double>(a.peakRssGrowthMax) / (1024.0 * 1024.0),
+			static_cast<unsigned long long>(a.input.triangles),
+			static_cast<unsigned long long>(a.output.triangles));
+	}
+}
+
+bool CommandProfiler::WriteJson(const std::filesystem::path& path, const sgrottel::ISimpleLog& log) const
+{
+	FILE* file = nullptr;
+	errno_t r = _wfopen_s(&file, path.wstring().c_str(), L"wb");
+	if (r != 0 || file == nullptr)
+	{
+		log.Error(L"Failed to open \"%s\": %d", path.wstring().c_str(), static_cast<int>(r));
+		return false;
+	}
+
+	fprintf(file, "{\n\"invocations\": [\n");
+	for (size_t i = 0; i < m_records.size(); ++i)
+	{
+		const Record& rec = m_records[i];
+		fprintf(file, "  { \"command\": \"%s\", \"success\": %s, \"wall_ms\": %.4f, \"cpu_ms\": %.4f, \"peak_rss_growth_bytes\": %llu, ",
+			rec.command.c_str(), rec.success ? "true" : "false", rec.wallMs, rec.cpuMs,
+			static_cast<unsigned long long>(rec.peakRssGrowth));
+		WriteJsonCounts(file, "input", rec.input);
+		fprintf(file, ", ");
+		WriteJsonCounts(file, "output", rec.output);
+		fprintf(file, " }%s\n", (i + 1 < m_records.size()) ? "," : "");
+	}
+	fprintf(file, "],\n\"commands\": [\n");
+	const std::vector<Aggregate> aggregates = Aggregated();
+	for (size_t i = 0; i < aggregates.size(); ++i)
+	{
+		const Aggregate& a = aggregates[i];
+		fprintf(file, "  { \"command\": \"%s\", \"calls\": %u, \"wall_ms\": %.4f, \"wall_max_ms\": %.4f, \"cpu_ms\": %.4f, \"peak_rss_growth_max_bytes\": %llu, ",
+			a.command.c_str(), a.calls, a.wallMs, a.wallMaxMs, a.cpuMs,
+			static_cast<unsigned long long>(a.peakRssGrowthMax));
+		WriteJsonCounts(file, "input", a.input);
+		fprintf(file, ", ");
+		WriteJsonCounts(file, "output", a.output);
+		fprintf(file, " }%s\n", (i + 1 < aggregates.size()) ? "," : "");
+	}
+	fprintf(file, "]\n}\n");
+
+	fclose(file);
+	log.Detail(L"Profile written to \"%s\"", path.wstring().c_str());
+	return true;
+}
+
+double CommandProfiler::ProcessCpuTimeMs()
+{
+	FILETIME creation, exit, kernel, user;
+	if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+	{
+		return 0.0;
+	}
+	const uint64_t k = (static_cast<uint64_t>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime;
+	const uint64_t u = (static_cast<uint64_t>(user.dwHighDateTime) << 32) | user.dwLowDateTime;
+	return static_cast<double>(k + u) / 10000.0; // 100 ns units
+}
+
+uint64_t CommandProfiler::ProcessPeakRss()
+{
+	PROCESS_MEMORY_COUNTERS counters{};
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return 0;
+	}
+	return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+}
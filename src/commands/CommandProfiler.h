@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace sgrottel
+{
+	class ISimpleLog;
+}
+
+namespace meshproc
+{
+	namespace commands
+	{
+		class AbstractCommand;
+
+		// Records time, memory and data sizes of command invocations
+		class CommandProfiler
+		{
+		public:
+
+			// Sizes of the data bound to the parameters of a command
+			struct ElementCounts
+			{
+				uint64_t vertices{ 0 };
+				uint64_t triangles{ 0 };
+				uint64_t listElements{ 0 };
+			};
+
+			// State captured right before a command is invoked
+			struct Measurement
+			{
+				std::chrono::steady_clock::time_point wallStart;
+				double cpuStartMs{ 0.0 };
+				uint64_t peakRssStart{ 0 };
+				ElementCounts input;
+			};
+
+			Measurement Begin(const AbstractCommand& cmd) const;
+			void End(const AbstractCommand& cmd, const Measurement& measurement, bool success);
+
+			// Logs one line per command type, aggregating all invocations
+			void LogReport(const sgrottel::ISimpleLog& log) const;
+
+			bool WriteJson(const std::filesystem::path& path, const sgrottel::ISimpleLog& log) const;
+
+			// Sums the sizes of all In/InOut (`output == false`) or InOut/Out (`output == true`) parameters
+			static ElementCounts CountElements(const AbstractCommand& cmd, bool output);
+
+		private:
+
+			struct Record
+			{
+				std::string command;
+				bool success{ false };
+				double wallMs{ 0.0 };
+				double cpuMs{ 0.0 };
+				// increase of the process-lifetime peak working set, i.e. memory above any previous high-water mark;
+				// zero for commands staying below an earlier peak, however much they allocate
+				uint64_t peakRssGrowth{ 0 };
+				ElementCounts input;
+				ElementCounts output;
+			};
+
+			struct Aggregate
+			{
+				std::string command;
+				uint32_t calls{ 0 };
+				double wallMs{ 0.0 };
+				double wallMaxMs{ 0.0 };
+				double cpuMs{ 0.0 };
+				uint64_t peakRssGrowthMax{ 0 };
+				ElementCounts input;
+				ElementCounts output;
+			};
+
+			static double ProcessCpuTimeMs();
+			static uint64_t ProcessPeakRss();
+
+			std::vector<Aggregate> Aggregated() const;
+
+			std::vector<Record> m_records;
+		};
+
+	}
+}
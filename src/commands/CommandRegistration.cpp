@@ -13,10 +13,18 @@ namespace
 //   #include "namespace/class_name.h"
 //   And the template specialization of `RegisterCommandHelper` for class runtime registration logic
 
+#define COMMAND_PATH compute, ClosestPoint
+#include "CommandRegistration.inc"
 #define COMMAND_PATH compute, LinearColorMap
 #include "CommandRegistration.inc"
+#define COMMAND_PATH compute, MeshDistance
+#include "CommandRegistration.inc"
 #define COMMAND_PATH compute, OpenBorder
 #include "CommandRegistration.inc"
+#define COMMAND_PATH compute, RayCast
+#include "CommandRegistration.inc"
+#define COMMAND_PATH compute, SelfIntersections
+#include "CommandRegistration.inc"
 #define COMMAND_PATH compute, SplitByEdges
 #include "CommandRegistration.inc"
 #define COMMAND_PATH compute, VertexEdgeDistance
@@ -25,6 +33,8 @@ namespace
 #include "CommandRegistration.inc"
 #define COMMAND_PATH compute, VertexNormals
 #include "CommandRegistration.inc"
+#define COMMAND_PATH edit, Boolean
+#include "CommandRegistration.inc"
 #define COMMAND_PATH edit, CloseLoopWithPin
 #include "CommandRegistration.inc"
 #define COMMAND_PATH edit, InvertVertexSelection
@@ -35,20 +45,48 @@ namespace
 #include "CommandRegistration.inc"
 #define COMMAND_PATH edit, CutPlaneLoop
 #include "CommandRegistration.inc"
+#define COMMAND_PATH edit, Decimate
+#include "CommandRegistration.inc"
 #define COMMAND_PATH edit, DisplacementNoise
 #include "CommandRegistration.inc"
+#define COMMAND_PATH edit, FillHoles
+#include "CommandRegistration.inc"
+#define COMMAND_PATH edit, OptimizeLayout
+#include "CommandRegistration.inc"
+#define COMMAND_PATH edit, Remesh
+#include "CommandRegistration.inc"
+#define COMMAND_PATH edit, Smooth
+#include "CommandRegistration.inc"
+#define COMMAND_PATH edit, SpatialSort
+#include "CommandRegistration.inc"
 #define COMMAND_PATH edit, Subdivision
 #include "CommandRegistration.inc"
+#define COMMAND_PATH generator, ComponentSoup
+#include "CommandRegistration.inc"
 #define COMMAND_PATH generator, Cuboid
 #include "CommandRegistration.inc"
+#define COMMAND_PATH generator, Grid
+#include "CommandRegistration.inc"
 #define COMMAND_PATH generator, Icosahedron
 #include "CommandRegistration.inc"
+#define COMMAND_PATH generator, NoisyPatch
+#include "CommandRegistration.inc"
+#define COMMAND_PATH generator, NonManifold
+#include "CommandRegistration.inc"
 #define COMMAND_PATH generator, Octahedron
 #include "CommandRegistration.inc"
 #define COMMAND_PATH generator, SphereIco
 #include "CommandRegistration.inc"
+#define COMMAND_PATH generator, Torus
+#include "CommandRegistration.inc"
+#define COMMAND_PATH io, CompressedMeshReader
+#include "CommandRegistration.inc"
+#define COMMAND_PATH io, CompressedMeshWriter
+#include "CommandRegistration.inc"
 #define COMMAND_PATH io, Model3mfReader
 #include "CommandRegistration.inc"
+#define COMMAND_PATH io, MultiReader
+#include "CommandRegistration.inc"
 #define COMMAND_PATH io, ObjReader
 #include "CommandRegistration.inc"
 #define COMMAND_PATH io, ObjWriter
@@ -14,6 +14,7 @@ namespace meshproc
 		class HalfSpace;
 		class Mesh;
 		class Scene;
+		class Selection;
 		class Shape2D;
 	}
 
@@ -26,6 +27,7 @@ namespace meshproc
 			Float,
 			FloatList,
 			String,
+			StringList,
 			Vec3,
 			Vec3List,
 			Vec3ListList,
@@ -36,6 +38,7 @@ namespace meshproc
 //			Shape2D,
 			IndexList, // e.g. vertices, also edges/loops, or triangles
 			IndexListList,
+			Selection, // bitset of e.g. vertices or triangles
 			HalfSpace,
 			Bool,
 
@@ -89,6 +92,15 @@ namespace meshproc
 			static type NilVal() { return L""; }
 		};
 
+		template<>
+		struct ParamTypeInfo<ParamType::StringList>
+		{
+			static constexpr const char* name = "StringList";
+			typedef std::shared_ptr<std::vector<std::wstring>> type;
+			static constexpr bool canSetNil = true;
+			static type NilVal() { return nullptr; }
+		};
+
 		template<>
 		struct ParamTypeInfo<ParamType::Vec3>
 		{
@@ -159,6 +171,15 @@ namespace meshproc
 			static type NilVal() { return nullptr; }
 		};
 
+		template<>
+		struct ParamTypeInfo<ParamType::Selection>
+		{
+			static constexpr const char* name = "Selection";
+			typedef std::shared_ptr<data::Selection> type;
+			static constexpr bool canSetNil = true;
+			static type NilVal() { return nullptr; }
+		};
+
 		template<>
 		struct ParamTypeInfo<ParamType::Vec3List>
 		{
@@ -0,0 +1,65 @@
+#include "ClosestPoint.h"
+
+#include "data/Bvh.h"
+#include "utilities/TaskScheduler.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+
+compute::ClosestPoint::ClosestPoint(const sgrottel::ISimpleLog& log)
+	: AbstractCommand(log)
+{
+	AddParamBinding<ParamMode::In, ParamType::Mesh>("Mesh", m_mesh);
+	AddParamBinding<ParamMode::In, ParamType::Vec3List>("Points", m_points);
+	AddParamBinding<ParamMode::In, ParamType::Float>("MaxDistance", m_maxDistance);
+	AddParamBinding<ParamMode::Out, ParamType::FloatList>("Distances", m_distances);
+	AddParamBinding<ParamMode::Out, ParamType::IndexList>("Triangles", m_triangles);
+	AddParamBinding<ParamMode::Out, ParamType::Vec3List>("Barycentrics", m_barycentrics);
+	AddParamBinding<ParamMode::Out, ParamType::Vec3List>("ClosestPoints", m_closestPoints);
+}
+
+bool compute::ClosestPoint::Invoke()
+{
+	if (!m_mesh)
+	{
+		Log().Error("Mesh is empty");
+		return false;
+	}
+	if (!m_points)
+	{
+		Log().Error("Points is empty");
+		return false;
+	}
+	if (!m_mesh->IsValid())
+	{
+		Log().Error("Mesh is invalid");
+		return false;
+	}
+
+	const std::shared_ptr<const data::Bvh> bvh = m_mesh->GetBvh();
+
+	const size_t cnt = m_points->size();
+	m_distances = std::make_shared<std::vector<float>>(cnt, -1.0f);
+	m_triangles = std::make_shared<std::vector<uint32_t>>(cnt, data::Bvh::InvalidIndex);
+	m_barycentrics = std::make_shared<std::vector<glm::vec3>>(cnt, glm::vec3{ 0.0f });
+	m_closestPoints = std::make_shared<std::vector<glm::vec3>>(*m_points);
+
+	Tasks().ParallelFor(0, cnt, 0x1000, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				data::Bvh::PointHit hit;
+				if (bvh->ClosestPoint(m_points->at(i), m_maxDistance, hit))
+				{
+					m_distances->at(i) = hit.distance;
+					m_triangles->at(i) = hit.triangle;
+					m_barycentrics->at(i) = hit.barycentric;
+					m_closestPoints->at(i) = hit.point;
+				}
+			}
+		});
+
+	return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <glm/glm.hpp>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace compute
+		{
+
+			// Nearest points on the surface of the mesh, using the mesh's bounding volume hierarchy
+			class ClosestPoint : public AbstractCommand
+			{
+			public:
+				ClosestPoint(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				const std::shared_ptr<data::Mesh> m_mesh;
+				const std::shared_ptr<std::vector<glm::vec3>> m_points;
+				const float m_maxDistance{ std::numeric_limits<float>::max() };
+
+				// -1 for points farther than MaxDistance from the surface
+				std::shared_ptr<std::vector<float>> m_distances;
+				// invalid index (0 in lua) for points farther than MaxDistance from the surface
+				std::shared_ptr<std::vector<uint32_t>> m_triangles;
+				std::shared_ptr<std::vector<glm::vec3>> m_barycentrics;
+				std::shared_ptr<std::vector<glm::vec3>> m_closestPoints;
+			};
+
+		}
+	}
+}
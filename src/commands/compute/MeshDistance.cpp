@@ -0,0 +1,221 @@
+#include "MeshDistance.h"
+
+#include "data/Bvh.h"
+#include "utilities/TaskScheduler.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+
+namespace
+{
+
+	// Angle-weighted pseudo normals [Baerentzen & Aanaes 2005] of the faces, edges and vertices of a mesh.
+	// The sign of `dot(p - closest, pseudoNormal)` at the closest surface feature tells inside from outside.
+	class PseudoNormals
+	{
+	public:
+		PseudoNormals(const data::Mesh& mesh)
+			: m_mesh{ mesh }
+		{
+			const size_t vertCnt = mesh.vertices.size();
+			const size_t triCnt = mesh.triangles.size();
+
+			m_faceNormals.resize(triCnt);
+			utilities::TaskScheduler::Instance().ParallelFor(0, triCnt, 0x4000, [&](size_t begin, size_t end)
+				{
+					for (size_t ti = begin; ti < end; ++ti)
+					{
+						const glm::vec3 n = glm::cross(
+							mesh.vertices[mesh.triangles[ti][1]] - mesh.vertices[mesh.triangles[ti][0]],
+							mesh.vertices[mesh.triangles[ti][2]] - mesh.vertices[mesh.triangles[ti][0]]);
+						const float len = glm::length(n);
+						m_faceNormals[ti] = (len > 0.0f) ? n / len : glm::vec3{ 0.0f };
+					}
+				});
+
+			// vertex -> triangles adjacency, for the edge normals
+			m_adjStart.assign(vertCnt + 1, 0);
+			for (const data::Triangle& t : mesh.triangles)
+			{
+				for (int i = 0; i < 3; ++i)
+				{
+					m_adjStart[t[i] + 1]++;
+				}
+			}
+			for (size_t v = 0; v < vertCnt; ++v)
+			{
+				m_adjStart[v + 1] += m_adjStart[v];
+			}
+			m_adj.resize(m_adjStart.back());
+			std::vector<uint32_t> fill(m_adjStart.begin(), m_adjStart.end() - 1);
+			m_vertexNormals.assign(vertCnt, glm::vec3{ 0.0f });
+			for (size_t ti = 0; ti < triCnt; ++ti)
+			{
+				const data::Triangle& t = mesh.triangles[ti];
+				for (int i = 0; i < 3; ++i)
+				{
+					m_adj[fill[t[i]]++] = static_cast<uint32_t>(ti);
+
+					const glm::vec3 e1 = mesh.vertices[t[(i + 1) % 3]] - mesh.vertices[t[i]];
+					const glm::vec3 e2 = mesh.vertices[t[(i + 2) % 3]] - mesh.vertices[t[i]];
+					const float l = glm::length(e1) * glm::length(e2);
+					if (l <= 0.0f) continue;
+					const float angle = std::acos(std::clamp(glm::dot(e1, e2) / l, -1.0f, 1.0f));
+					m_vertexNormals[t[i]] += angle * m_faceNormals[ti];
+				}
+			}
+		}
+
+		// @param barycentric of the closest point within `triangle`
+		glm::vec3 At(uint32_t triangle, const glm::vec3& barycentric) const
+		{
+			constexpr float eps = 1e-5f;
+			const data::Triangle& t = m_mesh.triangles[triangle];
+			const bool zero[3] = { barycentric.x <= eps, barycentric.y <= eps, barycentric.z <= eps };
+			const int zeroCnt = zero[0] + zero[1] + zero[2];
+			if (zeroCnt >= 2)
+			{
+				// vertex
+				for (int i = 0; i < 3; ++i)
+				{
+					if (!zero[i]) return m_vertexNormals[t[i]];
+				}
+			}
+			else if (zeroCnt == 1)
+			{
+				// edge opposite the zero weight; sum of the normals of all triangles sharing it
+				const int z = zero[0] ? 0 : (zero[1] ? 1 : 2);
+				const uint32_t v0 = t[(z + 1) % 3];
+				const uint32_t v1 = t[(z + 2) % 3];
+				glm::vec3 n{ 0.0f };
+				for (uint32_t a = m_adjStart[v0]; a < m_adjStart[v0 + 1]; ++a)
+				{
+					if (m_mesh.triangles[m_adj[a]].HasIndex(v1))
+					{
+						n += m_faceNormals[m_adj[a]];
+					}
+				}
+				return n;
+			}
+			return m_faceNormals[triangle];
+		}
+
+	private:
+		const data::Mesh& m_mesh;
+		std::vector<glm::vec3> m_faceNormals;
+		std::vector<glm::vec3> m_vertexNormals;
+		std::vector<uint32_t> m_adjStart;
+		std::vector<uint32_t> m_adj;
+	};
+
+	struct Stats
+	{
+		double sum{ 0.0 };
+		double sumSq{ 0.0 };
+		float max{ 0.0f };
+	};
+
+	Stats Combine(const Stats& a, const Stats& b)
+	{
+		return Stats{ a.sum + b.sum, a.sumSq + b.sumSq, std::max(a.max, b.max) };
+	}
+
+}
+
+compute::MeshDistance::MeshDistance(const sgrottel::ISimpleLog& log)
+	: AbstractCommand(log)
+{
+	AddParamBinding<ParamMode::In, ParamType::Mesh>("Mesh", m_mesh);
+	AddParamBinding<ParamMode::In, ParamType::Mesh>("Reference", m_reference);
+	AddParamBinding<ParamMode::In, ParamType::Bool>("Signed", m_signed);
+	AddParamBinding<ParamMode::Out, ParamType::FloatList>("Distances", m_distances);
+	AddParamBinding<ParamMode::Out, ParamType::Float>("Hausdorff", m_hausdorff);
+	AddParamBinding<ParamMode::Out, ParamType::Float>("Mean", m_mean);
+	AddParamBinding<ParamMode::Out, ParamType::Float>("RMS", m_rms);
+}
+
+bool compute::MeshDistance::Invoke()
+{
+	if (!m_mesh)
+	{
+		Log().Error("Mesh is empty");
+		return false;
+	}
+	if (!m_reference)
+	{
+		Log().Error("Reference is empty");
+		return false;
+	}
+	if (!m_mesh->IsValid() || !m_reference->IsValid())
+	{
+		Log().Error("Mesh or Reference is invalid");
+		return false;
+	}
+	if (m_mesh->triangles.empty() || m_reference->triangles.empty())
+	{
+		Log().Error("Mesh and Reference must contain triangles");
+		return false;
+	}
+
+	const std::shared_ptr<const data::Bvh> refBvh = m_reference->GetBvh();
+	std::unique_ptr<PseudoNormals> pseudoNormals;
+	if (m_signed)
+	{
+		pseudoNormals = std::make_unique<PseudoNormals>(*m_reference);
+	}
+
+	const size_t vertCnt = m_mesh->vertices.size();
+	m_distances = std::make_shared<std::vector<float>>(vertCnt, 0.0f);
+
+	// partial sums in fixed chunks, so that the statistics do not depend on the thread count
+	const Stats forward = Tasks().ParallelReduce<Stats>(0, vertCnt, 0x1000, Stats{},
+		[&](size_t begin, size_t end)
+		{
+			Stats s;
+			for (size_t i = begin; i < end; ++i)
+			{
+				const glm::vec3& p = m_mesh->vertices[i];
+				data::Bvh::PointHit hit;
+				refBvh->ClosestPoint(p, std::numeric_limits<float>::max(), hit);
+				s.sum += hit.distance;
+				s.sumSq += static_cast<double>(hit.distance) * hit.distance;
+				s.max = std::max(s.max, hit.distance);
+
+				float d = hit.distance;
+				if (pseudoNormals && glm::dot(p - hit.point, pseudoNormals->At(hit.triangle, hit.barycentric)) < 0.0f)
+				{
+					d = -d;
+				}
+				m_distances->at(i) = d;
+			}
+			return s;
+		}, Combine);
+
+	const std::shared_ptr<const data::Bvh> meshBvh = m_mesh->GetBvh();
+	const float backwardMax = Tasks().ParallelReduce<float>(0, m_reference->vertices.size(), 0x1000, 0.0f,
+		[&](size_t begin, size_t end)
+		{
+			float m = 0.0f;
+			for (size_t i = begin; i < end; ++i)
+			{
+				data::Bvh::PointHit hit;
+				if (meshBvh->ClosestPoint(m_reference->vertices[i], std::numeric_limits<float>::max(), hit))
+				{
+					m = std::max(m, hit.distance);
+				}
+			}
+			return m;
+		}, [](float a, float b) { return std::max(a, b); });
+
+	m_hausdorff = std::max(forward.max, backwardMax);
+	m_mean = (vertCnt > 0) ? static_cast<float>(forward.sum / static_cast<double>(vertCnt)) : 0.0f;
+	m_rms = (vertCnt > 0) ? static_cast<float>(std::sqrt(forward.sumSq / static_cast<double>(vertCnt))) : 0.0f;
+
+	return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <memory>
+#include <vector>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace compute
+		{
+
+			// Distances of the vertices of a mesh to the surface of a reference mesh, and deviation statistics of both meshes
+			class MeshDistance : public AbstractCommand
+			{
+			public:
+				MeshDistance(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				const std::shared_ptr<data::Mesh> m_mesh;
+				const std::shared_ptr<data::Mesh> m_reference;
+				// negative distances for vertices inside the reference mesh, which should be closed and consistently oriented
+				const bool m_signed{ false };
+
+				// per vertex of `Mesh`
+				std::shared_ptr<std::vector<float>> m_distances;
+				// symmetric, i.e. the larger of the maximum vertex distances in both directions
+				float m_hausdorff{ 0.0f };
+				// of the unsigned distances of the vertices of `Mesh`
+				float m_mean{ 0.0f };
+				float m_rms{ 0.0f };
+			};
+
+		}
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <glm/glm.hpp>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace compute
+		{
+
+			// Nearest hits of rays with the triangles of the mesh, both sides, using the mesh's bounding volume hierarchy
+			class RayCast : public AbstractCommand
+			{
+			public:
+				RayCast(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				const std::shared_ptr<data::Mesh> m_mesh;
+				const std::shared_ptr<std::vector<glm::vec3>> m_origins;
+				// one direction per origin, or one direction for all origins
+				const std::shared_ptr<std::vector<glm::vec3>> m_directions;
+				const float m_maxDistance{ std::numeric_limits<float>::max() };
+
+				// -1 for rays missing the mesh
+				std::shared_ptr<std::vector<float>> m_distances;
+				// invalid index (0 in lua) for rays missing the mesh
+				std::shared_ptr<std::vector<uint32_t>> m_triangles;
+				std::shared_ptr<std::vector<glm::vec3>> m_barycentrics;
+			};
+
+		}
+	}
+}
@@ -0,0 +1,179 @@
+#include "SelfIntersections.h"
+
+#include "data/Bvh.h"
+#include "utilities/TaskScheduler.h"
+#include "utilities/TriangleIntersection.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+using utilities::TriangleIntersection;
+
+namespace
+{
+
+	// Tests two triangles of the same mesh, ignoring the contact of neighbors at their shared corners
+	bool Intersecting(const data::Mesh& mesh, uint32_t ta, uint32_t tb)
+	{
+		glm::vec3 a[3];
+		glm::vec3 b[3];
+		for (int k = 0; k < 3; ++k)
+		{
+			a[k] = mesh.vertices[mesh.triangles[ta][k]];
+			b[k] = mesh.vertices[mesh.triangles[tb][k]];
+		}
+
+		TriangleIntersection::Point segment[2];
+		switch (TriangleIntersection::Intersect(a, b, segment))
+		{
+		case TriangleIntersection::Result::Disjoint:
+			return false;
+		case TriangleIntersection::Result::Coplanar:
+			return TriangleIntersection::CoplanarOverlap(a, b);
+		default:
+			break;
+		}
+
+		// corners are shared by position, so that unwelded neighbors are not reported either
+		int shared = 0;
+		for (int i = 0; i < 3; ++i)
+		{
+			if (a[i] == b[0] || a[i] == b[1] || a[i] == b[2]) shared++;
+		}
+		if (shared >= 2)
+		{
+			// triangles not in the same plane only meet along their shared edge
+			return false;
+		}
+		if (shared == 1)
+		{
+			// the intersection contains the shared corner, and is more than that for crossing triangles
+			return segment[0].position != segment[1].position;
+		}
+		return true;
+	}
+
+}
+
+compute::SelfIntersections::SelfIntersections(const sgrottel::ISimpleLog& log)
+	: AbstractCommand{ log }
+{
+	AddParamBinding<ParamMode::In, ParamType::Mesh>("Mesh", m_mesh);
+	AddParamBinding<ParamMode::In, ParamType::Bool>("FirstOnly", m_firstOnly);
+	AddParamBinding<ParamMode::Out, ParamType::IndexListList>("Pairs", m_pairs);
+	AddParamBinding<ParamMode::Out, ParamType::Selection>("Vertices", m_vertices);
+	AddParamBinding<ParamMode::Out, ParamType::Bool>("Intersecting", m_intersecting);
+}
+
+bool compute::SelfIntersections::Invoke()
+{
+	if (!m_mesh)
+	{
+		Log().Error("Mesh is empty");
+		return false;
+	}
+	if (!m_mesh->IsValid())
+	{
+		Log().Error("Mesh is invalid");
+		return false;
+	}
+	if (m_mesh->triangles.empty())
+	{
+		Log().Error("Mesh has no triangles");
+		return false;
+	}
+
+	// candidate pairs, each reported once, from the hierarchy traversed against itself
+	const std::shared_ptr<const data::Bvh> bvh = m_mesh->GetBvh();
+	std::vector<std::pair<uint32_t, uint32_t>> found;
+	size_t candidateCnt = 0;
+	if (m_firstOnly)
+	{
+		// pairs are tested in batches as the traversal emits them, and the traversal stops after the first batch with a hit;
+		// within a batch, chunks behind the first known hit stop early, so the reported pair does not depend on the thread count
+		constexpr size_t batchSize = 0x4000;
+		std::vector<std::pair<uint32_t, uint32_t>> batch;
+		batch.reserve(batchSize);
+		auto testBatch = [&]()
+			{
+				std::atomic<size_t> first{ batch.size() };
+				Tasks().ParallelFor(0, batch.size(), 0x400, [&](size_t begin, size_t end)
+					{
+						for (size_t i = begin; i < end && i < first.load(std::memory_order_relaxed); ++i)
+						{
+							if (Intersecting(*m_mesh, batch[i].first, batch[i].second))
+							{
+								size_t cur = first.load(std::memory_order_relaxed);
+								while (i < cur && !first.compare_exchange_weak(cur, i, std::memory_order_relaxed))
+								{
+								}
+								break;
+							}
+						}
+					});
+				candidateCnt += batch.size();
+				if (first.load() < batch.size())
+				{
+					found.push_back(batch[first.load()]);
+				}
+				batch.clear();
+				return !found.empty();
+			};
+		const bool stopped = data::Bvh::OverlapPairsUntil(*bvh, *bvh, [&](uint32_t a, uint32_t b)
+			{
+				if (a >= b) return false;
+				batch.push_back(std::make_pair(a, b));
+				return batch.size() == batchSize && testBatch();
+			});
+		if (!stopped && !batch.empty())
+		{
+			testBatch();
+		}
+	}
+	else
+	{
+		std::vector<std::pair<uint32_t, uint32_t>> pairs;
+		data::Bvh::OverlapPairs(*bvh, *bvh, [&pairs](uint32_t a, uint32_t b)
+			{
+				if (a < b) pairs.push_back(std::make_pair(a, b));
+			});
+
+		std::vector<uint8_t> hit(pairs.size(), 0);
+		Tasks().ParallelFor(0, pairs.size(), 0x400, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					hit[i] = Intersecting(*m_mesh, pairs[i].first, pairs[i].second) ? 1 : 0;
+				}
+			});
+		for (size_t i = 0; i < pairs.size(); ++i)
+		{
+			if (hit[i] != 0) found.push_back(pairs[i]);
+		}
+		candidateCnt = pairs.size();
+	}
+	std::sort(found.begin(), found.end());
+
+	m_pairs = std::make_shared<std::vector<std::shared_ptr<std::vector<uint32_t>>>>();
+	m_pairs->reserve(found.size());
+	m_vertices = std::make_shared<data::Selection>(m_mesh->vertices.size());
+	for (const auto& [a, b] : found)
+	{
+		m_pairs->push_back(std::make_shared<std::vector<uint32_t>>(std::initializer_list<uint32_t>{ a, b }));
+		for (int k = 0; k < 3; ++k)
+		{
+			m_vertices->Set(m_mesh->triangles[a][k]);
+			m_vertices->Set(m_mesh->triangles[b][k]);
+		}
+	}
+	m_intersecting = !found.empty();
+
+	Log().Detail("Found %d intersecting pairs of triangles, out of %d candidates", static_cast<int>(found.size()), static_cast<int>(candidateCnt));
+
+	return true;
+}
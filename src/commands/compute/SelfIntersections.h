@@ -0,0 +1,39 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+#include "data/Selection.h"
+
+#include <memory>
+#include <vector>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace compute
+		{
+
+			// Pairs of triangles of a mesh which intersect each other, other than along shared vertices or edges
+			class SelfIntersections : public AbstractCommand
+			{
+			public:
+				SelfIntersections(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				const std::shared_ptr<data::Mesh> m_mesh;
+				// stops at the first intersecting pair, which is the only one reported
+				const bool m_firstOnly{ false };
+
+				// two triangle indices per pair, ascending
+				std::shared_ptr<std::vector<std::shared_ptr<std::vector<uint32_t>>>> m_pairs;
+				// vertices of all intersecting triangles
+				std::shared_ptr<data::Selection> m_vertices;
+				bool m_intersecting{ false };
+			};
+
+		}
+	}
+}
@@ -44,6 +44,7 @@ bool SplitByEdges::Invoke()
 	std::unordered_map<data::HashableEdge, std::array<uint32_t, 2>> ett;
 	std::unordered_map<data::HashableEdge, float> edgeAngle;
 	{
+		auto span = TraceScope("build edge map");
 		constexpr std::array<glm::vec3, 2> emptyNormals{ glm::vec3{ 0.0f }, glm::vec3{ 0.0f } };
 		constexpr std::array<uint32_t, 2> emptyIndices{
 			std::numeric_limits<uint32_t>::max(),
@@ -119,6 +120,7 @@ bool SplitByEdges::Invoke()
 		}
 	};
 
+	auto floodFillSpan = TraceScope("flood fill");
 	while (!freeTI.empty())
 	{
 		segmentTI.clear();
@@ -157,8 +159,11 @@ bool SplitByEdges::Invoke()
 		m_segments->push_back(m);
 	}
 
+	floodFillSpan.End();
+
 	if (m_smallSegmentConsolidation > 0)
 	{
+		auto span = TraceScope("consolidate small segments");
 		std::vector<std::shared_ptr<data::Mesh>> smlSegs;
 		for (auto m : *m_segments)
 		{
@@ -249,10 +254,12 @@ bool SplitByEdges::Invoke()
 		}
 	}
 
+	auto finalizeSpan = TraceScope("finalize vertices");
 	for(auto m : *m_segments)
 	{
 		finalizeVertices(*m, *m_mesh);
 	}
+	finalizeSpan.End();
 
 	Log().Detail("Mesh split into %d segments", m_segments->size());
 
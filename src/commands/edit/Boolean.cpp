@@ -0,0 +1,501 @@
+#include "Boolean.h"
+
+#include "data/Bvh.h"
+#include "data/HashableEdge.h"
+#include "utilities/Constrained2DTriangulation.h"
+#include "utilities/TaskScheduler.h"
+#include "utilities/TriangleIntersection.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cwctype>
+#include <exception>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+using namespace meshproc::commands::edit;
+
+namespace
+{
+	using utilities::TriangleIntersection;
+
+	constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+	inline bool Less(const glm::vec3& a, const glm::vec3& b)
+	{
+		if (a.x != b.x) return a.x < b.x;
+		if (a.y != b.y) return a.y < b.y;
+		return a.z < b.z;
+	}
+
+	inline uint64_t EdgeKey(uint32_t a, uint32_t b)
+	{
+		return (a < b) ? ((static_cast<uint64_t>(a) << 32) | b) : ((static_cast<uint64_t>(b) << 32) | a);
+	}
+
+	uint32_t FindRoot(std::vector<uint32_t>& parent, uint32_t i)
+	{
+		while (parent[i] != i)
+		{
+			parent[i] = parent[parent[i]];
+			i = parent[i];
+		}
+		return i;
+	}
+
+	// Winding number of `mesh` around `p`, from the signed crossings of rays through its hierarchy:
+	// leaving through the front side of a triangle counts +1, entering through it -1.
+	// About 1 inside and 0 outside of a closed mesh; the majority of three skew rays tolerates rays grazing edges or passing through small holes.
+	int WindingNumber(const data::Mesh& mesh, const data::Bvh& bvh, const glm::vec3& p)
+	{
+		static const glm::vec3 directions[3] = {
+			glm::normalize(glm::vec3{ 0.5773f, 0.6124f, 0.5400f }),
+			glm::normalize(glm::vec3{ -0.7071f, 0.3827f, 0.5946f }),
+			glm::normalize(glm::vec3{ 0.1951f, -0.8315f, 0.5197f })
+		};
+		thread_local std::vector<data::Bvh::RayHit> hits;
+		int insideVotes = 0;
+		int winding[3];
+		for (int d = 0; d < 3; ++d)
+		{
+			hits.clear();
+			bvh.RayCastAll(p, directions[d], std::numeric_limits<float>::max(), hits);
+			winding[d] = 0;
+			for (const data::Bvh::RayHit& hit : hits)
+			{
+				const data::Triangle& t = mesh.triangles[hit.triangle];
+				const glm::vec3 n = glm::cross(mesh.vertices[t[1]] - mesh.vertices[t[0]], mesh.vertices[t[2]] - mesh.vertices[t[0]]);
+				const float s = glm::dot(n, directions[d]);
+				if (s > 0.0f) winding[d]++;
+				if (s < 0.0f) winding[d]--;
+			}
+			if (winding[d] != 0) insideVotes++;
+		}
+		if (insideVotes >= 2)
+		{
+			return (winding[0] != 0) ? winding[0] : winding[1];
+		}
+		return 0;
+	}
+
+}
+
+Boolean::Boolean(const sgrottel::ISimpleLog& log)
+	: AbstractCommand{ log }
+{
+	AddParamBinding<ParamMode::In, ParamType::Mesh>("MeshA", m_meshA);
+	AddParamBinding<ParamMode::In, ParamType::Mesh>("MeshB", m_meshB);
+	AddParamBinding<ParamMode::In, ParamType::String>("Operation", m_operation);
+	AddParamBinding<ParamMode::Out, ParamType::Mesh>("Mesh", m_mesh);
+}
+
+bool Boolean::Invoke()
+{
+	enum class Operation
+	{
+		Union,
+		Intersection,
+		Difference
+	};
+
+	if (!m_meshA)
+	{
+		Log().Error("MeshA is empty");
+		return false;
+	}
+	if (!m_meshB)
+	{
+		Log().Error("MeshB is empty");
+		return false;
+	}
+
+	std::wstring operationName{ m_operation };
+	std::transform(operationName.begin(), operationName.end(), operationName.begin(), [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+	Operation operation;
+	if (operationName == L"union")
+	{
+		operation = Operation::Union;
+	}
+	else if (operationName == L"intersection")
+	{
+		operation = Operation::Intersection;
+	}
+	else if (operationName == L"difference")
+	{
+		operation = Operation::Difference;
+	}
+	else
+	{
+		Log().Error(L"Operation '%s' unknown; must be 'Union', 'Intersection' or 'Difference'", m_operation.c_str());
+		return false;
+	}
+
+	if (!m_meshA->IsValid() || !m_meshB->IsValid())
+	{
+		Log().Error("Mesh is invalid");
+		return false;
+	}
+
+	const data::Mesh* meshes[2] = { m_meshA.get(), m_meshB.get() };
+	const uint32_t vertCnt[2] = { static_cast<uint32_t>(meshes[0]->vertices.size()), static_cast<uint32_t>(meshes[1]->vertices.size()) };
+	const uint32_t vertOffset[2] = { 0, vertCnt[0] };
+	const uint32_t curveBase = vertCnt[0] + vertCnt[1];
+
+	// candidate pairs of triangles, from both hierarchies traversed together
+	const std::shared_ptr<const data::Bvh> bvhA = meshes[0]->GetBvh();
+	const std::shared_ptr<const data::Bvh> bvhB = meshes[1]->GetBvh();
+	std::vector<std::pair<uint32_t, uint32_t>> pairs;
+	data::Bvh::OverlapPairs(*bvhA, *bvhB, [&pairs](uint32_t a, uint32_t b) { pairs.push_back(std::make_pair(a, b)); });
+
+	// intersection segments
+	std::vector<std::array<TriangleIntersection::Point, 2>> segments(pairs.size());
+	std::vector<uint8_t> state(pairs.size(), 0);
+	Tasks().ParallelFor(0, pairs.size(), 0x400, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				glm::vec3 tri[2][3];
+				const uint32_t ti[2] = { pairs[i].first, pairs[i].second };
+				for (int s = 0; s < 2; ++s)
+				{
+					for (int k = 0; k < 3; ++k)
+					{
+						tri[s][k] = meshes[s]->vertices[meshes[s]->triangles[ti[s]][k]];
+					}
+				}
+				const TriangleIntersection::Result r = TriangleIntersection::Intersect(tri[0], tri[1], segments[i].data());
+				if (r == TriangleIntersection::Result::Coplanar)
+				{
+					// coplanar triangles only touching along their borders are classified like all other triangles
+					if (TriangleIntersection::CoplanarOverlap(tri[0], tri[1]))
+					{
+						state[i] = 2;
+					}
+				}
+				else if (r == TriangleIntersection::Result::Segment && segments[i][0].position != segments[i][1].position)
+				{
+					state[i] = 1;
+				}
+			}
+		});
+	std::vector<uint32_t> cuts;
+	size_t coplanarCnt = 0;
+	for (uint32_t i = 0; i < state.size(); ++i)
+	{
+		if (state[i] == 1) cuts.push_back(i);
+		if (state[i] == 2) coplanarCnt++;
+	}
+	if (coplanarCnt > 0)
+	{
+		// neither side of a shared face is inside of the other mesh, so the result would not be closed
+		Log().Error("%d pairs of coplanar triangles overlap; flush faces are not supported, offset one mesh slightly", static_cast<int>(coplanarCnt));
+		return false;
+	}
+
+	// points of the intersection curves, welded by their bit-identical positions
+	std::vector<glm::vec3> positions;
+	positions.reserve(curveBase + cuts.size());
+	positions.insert(positions.end(), meshes[0]->vertices.begin(), meshes[0]->vertices.end());
+	positions.insert(positions.end(), meshes[1]->vertices.begin(), meshes[1]->vertices.end());
+	{
+		std::vector<glm::vec3> curvePoints;
+		curvePoints.reserve(cuts.size() * 2);
+		for (uint32_t c : cuts)
+		{
+			curvePoints.push_back(segments[c][0].position);
+			curvePoints.push_back(segments[c][1].position);
+		}
+		std::sort(curvePoints.begin(), curvePoints.end(), Less);
+		curvePoints.erase(std::unique(curvePoints.begin(), curvePoints.end()), curvePoints.end());
+		positions.insert(positions.end(), curvePoints.begin(), curvePoints.end());
+	}
+	auto curveIndex = [&](const glm::vec3& p)
+		{
+			return static_cast<uint32_t>(std::lower_bound(positions.begin() + curveBase, positions.end(), p, Less) - positions.begin());
+		};
+	std::vector<std::array<uint32_t, 2>> segmentIndices(cuts.size());
+	Tasks().ParallelFor(0, cuts.size(), 0x1000, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				segmentIndices[i] = { curveIndex(segments[cuts[i]][0].position), curveIndex(segments[cuts[i]][1].position) };
+			}
+		});
+
+	// input vertices on the curves are replaced by the curve points
+	std::vector<uint32_t> remap(positions.size());
+	std::iota(remap.begin(), remap.end(), 0);
+	for (size_t i = 0; i < cuts.size(); ++i)
+	{
+		const uint32_t ti[2] = { pairs[cuts[i]].first, pairs[cuts[i]].second };
+		for (int e = 0; e < 2; ++e)
+		{
+			for (int s = 0; s < 2; ++s)
+			{
+				const uint8_t f = segments[cuts[i]][e].feature[s];
+				if (f >= TriangleIntersection::Edge) continue;
+				remap[vertOffset[s] + meshes[s]->triangles[ti[s]][f - TriangleIntersection::Vertex]] = segmentIndices[i][e];
+			}
+		}
+	}
+
+	// retriangulation of the crossed triangles of both meshes, constrained by their curve segments and edge points
+	std::vector<uint32_t> cutStart[2];
+	std::vector<uint32_t> cutList[2];
+	for (int s = 0; s < 2; ++s)
+	{
+		cutStart[s].assign(meshes[s]->triangles.size() + 1, 0);
+		for (uint32_t c : cuts)
+		{
+			cutStart[s][((s == 0) ? pairs[c].first : pairs[c].second) + 1]++;
+		}
+		for (size_t t = 0; t + 1 < cutStart[s].size(); ++t)
+		{
+			cutStart[s][t + 1] += cutStart[s][t];
+		}
+		cutList[s].resize(cuts.size());
+		std::vector<uint32_t> fill(cutStart[s].begin(), cutStart[s].end() - 1);
+		for (uint32_t i = 0; i < cuts.size(); ++i)
+		{
+			cutList[s][fill[(s == 0) ? pairs[cuts[i]].first : pairs[cuts[i]].second]++] = i;
+		}
+	}
+	std::vector<std::pair<int, uint32_t>> crossed;
+	for (int s = 0; s < 2; ++s)
+	{
+		for (uint32_t t = 0; t < meshes[s]->triangles.size(); ++t)
+		{
+			if (cutStart[s][t + 1] > cutStart[s][t]) crossed.push_back(std::make_pair(s, t));
+		}
+	}
+	std::vector<std::vector<data::Triangle>> pieces(crossed.size());
+	std::vector<uint8_t> failed(crossed.size(), 0);
+	Tasks().ParallelFor(0, crossed.size(), 0x10, [&](size_t begin, size_t end)
+		{
+			for (size_t ci = begin; ci < end; ++ci)
+			{
+				const int s = crossed[ci].first;
+				const uint32_t ti = crossed[ci].second;
+				const data::Triangle& t = meshes[s]->triangles[ti];
+				uint32_t corner[3];
+				for (int k = 0; k < 3; ++k)
+				{
+					corner[k] = remap[vertOffset[s] + t[k]];
+				}
+				const glm::vec3 normal = glm::cross(positions[corner[1]] - positions[corner[0]], positions[corner[2]] - positions[corner[0]]);
+
+				// projection dropping the dominant axis of the normal
+				const glm::vec3 an = glm::abs(normal);
+				const int axis = (an.x >= an.y && an.x >= an.z) ? 0 : ((an.y >= an.z) ? 1 : 2);
+				auto project = [axis](const glm::vec3& p)
+					{
+						return (axis == 0) ? glm::vec2{ p.y, p.z } : ((axis == 1) ? glm::vec2{ p.z, p.x } : glm::vec2{ p.x, p.y });
+					};
+
+				std::unordered_map<uint32_t, glm::vec2> points;
+				std::unordered_set<data::HashableEdge> edges;
+				std::vector<std::pair<float, uint32_t>> onEdge[3];
+				for (int k = 0; k < 3; ++k)
+				{
+					points[corner[k]] = project(positions[corner[k]]);
+				}
+				for (uint32_t a = cutStart[s][ti]; a < cutStart[s][ti + 1]; ++a)
+				{
+					const uint32_t i = cutList[s][a];
+					for (int e = 0; e < 2; ++e)
+					{
+						const uint32_t id = segmentIndices[i][e];
+						points[id] = project(positions[id]);
+						const uint8_t f = segments[cuts[i]][e].feature[s];
+						if (f >= TriangleIntersection::Edge && f < TriangleIntersection::Interior)
+						{
+							const int k = f - TriangleIntersection::Edge;
+							onEdge[k].push_back(std::make_pair(glm::distance(positions[id], positions[corner[k]]), id));
+						}
+					}
+					if (segmentIndices[i][0] != segmentIndices[i][1])
+					{
+						edges.insert(data::HashableEdge{ segmentIndices[i][0], segmentIndices[i][1] });
+					}
+				}
+				for (int k = 0; k < 3; ++k)
+				{
+					std::sort(onEdge[k].begin(), onEdge[k].end());
+					uint32_t prev = corner[k];
+					for (const auto& p : onEdge[k])
+					{
+						if (p.second == prev || p.second == corner[(k + 1) % 3]) continue;
+						edges.insert(data::HashableEdge{ prev, p.second });
+						prev = p.second;
+					}
+					edges.insert(data::HashableEdge{ prev, corner[(k + 1) % 3] });
+				}
+
+				std::vector<glm::uvec3> tris;
+				try
+				{
+					utilities::Constrained2DTriangulation cdt(points, edges, Log());
+					// only the inside of the triangle, as the convex hull can add slivers outside of slightly bent edges
+					tris = cdt.Compute(utilities::Constrained2DTriangulation::Region::Enclosed);
+					if (cdt.HasError())
+					{
+						failed[ci] = 1;
+						continue;
+					}
+				}
+				catch (const std::exception&)
+				{
+					// e.g. crossing constraints of a self-intersecting input
+					failed[ci] = 1;
+					continue;
+				}
+
+				for (const glm::uvec3& f : tris)
+				{
+					// counter-clockwise in the projection; the normal of the 3d points is unreliable for slivers
+					pieces[ci].push_back((normal[axis] > 0.0f) ? data::Triangle{ f.x, f.y, f.z } : data::Triangle{ f.x, f.z, f.y });
+				}
+			}
+		});
+	const size_t failedCnt = std::count(failed.begin(), failed.end(), 1);
+	if (failedCnt > 0)
+	{
+		Log().Warning("Failed to split %d triangles along the intersection curves", static_cast<int>(failedCnt));
+	}
+
+	// triangles of both meshes, with the crossed ones replaced by their pieces
+	std::vector<data::Triangle> triangles[2];
+	{
+		size_t ci = 0;
+		for (int s = 0; s < 2; ++s)
+		{
+			triangles[s].reserve(meshes[s]->triangles.size());
+			for (uint32_t ti = 0; ti < meshes[s]->triangles.size(); ++ti)
+			{
+				if (ci < crossed.size() && crossed[ci].first == s && crossed[ci].second == ti)
+				{
+					if (failed[ci] == 0)
+					{
+						triangles[s].insert(triangles[s].end(), pieces[ci].begin(), pieces[ci].end());
+						ci++;
+						continue;
+					}
+					ci++;
+				}
+				const data::Triangle& t = meshes[s]->triangles[ti];
+				triangles[s].push_back(data::Triangle{ remap[vertOffset[s] + t[0]], remap[vertOffset[s] + t[1]], remap[vertOffset[s] + t[2]] });
+			}
+		}
+	}
+
+	// patches of triangles connected over edges not on the curves, each entirely inside or outside of the other mesh
+	std::vector<uint64_t> curveEdges;
+	curveEdges.reserve(cuts.size());
+	for (const auto& si : segmentIndices)
+	{
+		if (si[0] != si[1]) curveEdges.push_back(EdgeKey(si[0], si[1]));
+	}
+	std::sort(curveEdges.begin(), curveEdges.end());
+	curveEdges.erase(std::unique(curveEdges.begin(), curveEdges.end()), curveEdges.end());
+
+	std::vector<uint8_t> keep[2];
+	size_t patchCnt = 0;
+	for (int s = 0; s < 2; ++s)
+	{
+		const std::vector<data::Triangle>& tris = triangles[s];
+		std::vector<std::pair<uint64_t, uint32_t>> edgeTris(tris.size() * 3);
+		for (uint32_t ti = 0; ti < tris.size(); ++ti)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				edgeTris[ti * 3 + k] = std::make_pair(EdgeKey(tris[ti][k], tris[ti][(k + 1) % 3]), ti);
+			}
+		}
+		std::sort(edgeTris.begin(), edgeTris.end());
+		std::vector<uint32_t> parent(tris.size());
+		std::iota(parent.begin(), parent.end(), 0);
+		for (size_t i = 1; i < edgeTris.size(); ++i)
+		{
+			if (edgeTris[i].first != edgeTris[i - 1].first) continue;
+			if (std::binary_search(curveEdges.begin(), curveEdges.end(), edgeTris[i].first)) continue;
+			const uint32_t a = FindRoot(parent, edgeTris[i - 1].second);
+			const uint32_t b = FindRoot(parent, edgeTris[i].second);
+			if (a != b) parent[std::max(a, b)] = std::min(a, b);
+		}
+
+		// the largest triangle of each patch is classified by the winding number of the other mesh around its center
+		std::vector<uint32_t> representative(tris.size(), InvalidIndex);
+		std::vector<float> area(tris.size(), 0.0f);
+		for (uint32_t ti = 0; ti < tris.size(); ++ti)
+		{
+			const uint32_t r = FindRoot(parent, ti);
+			area[ti] = tris[ti].CalcSurface(positions);
+			if (representative[r] == InvalidIndex || area[ti] > area[representative[r]]) representative[r] = ti;
+		}
+		const data::Bvh& otherBvh = (s == 0) ? *bvhB : *bvhA;
+		std::vector<uint32_t> roots;
+		for (uint32_t r = 0; r < tris.size(); ++r)
+		{
+			if (representative[r] != InvalidIndex) roots.push_back(r);
+		}
+		std::vector<uint8_t> inside(tris.size(), 0);
+		Tasks().ParallelFor(0, roots.size(), 0x10, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					const data::Triangle& t = tris[representative[roots[i]]];
+					const glm::vec3 center = (positions[t[0]] + positions[t[1]] + positions[t[2]]) / 3.0f;
+					inside[roots[i]] = (WindingNumber(*meshes[1 - s], otherBvh, center) != 0) ? 1 : 0;
+				}
+			});
+		patchCnt += roots.size();
+
+		keep[s].resize(tris.size());
+		const bool keepInside = (operation == Operation::Intersection) || (operation == Operation::Difference && s == 1);
+		for (uint32_t ti = 0; ti < tris.size(); ++ti)
+		{
+			keep[s][ti] = ((inside[FindRoot(parent, ti)] != 0) == keepInside) ? 1 : 0;
+		}
+	}
+
+	// result, with only the referenced vertices
+	m_mesh = std::make_shared<data::Mesh>();
+	std::vector<uint32_t> index(positions.size(), InvalidIndex);
+	auto vertex = [&](uint32_t v)
+		{
+			if (index[v] == InvalidIndex)
+			{
+				index[v] = static_cast<uint32_t>(m_mesh->vertices.size());
+				m_mesh->vertices.push_back(positions[v]);
+			}
+			return index[v];
+		};
+	for (int s = 0; s < 2; ++s)
+	{
+		const bool flip = (operation == Operation::Difference && s == 1);
+		for (uint32_t ti = 0; ti < triangles[s].size(); ++ti)
+		{
+			if (keep[s][ti] == 0) continue;
+			const data::Triangle& t = triangles[s][ti];
+			const uint32_t v0 = vertex(t[0]);
+			const uint32_t v1 = vertex(t[1]);
+			const uint32_t v2 = vertex(t[2]);
+			m_mesh->triangles.push_back(flip ? data::Triangle{ v0, v2, v1 } : data::Triangle{ v0, v1, v2 });
+		}
+	}
+
+	Log().Detail("Boolean of %d and %d triangles: %d candidate pairs, %d intersecting, %d patches, %d triangles",
+		static_cast<int>(meshes[0]->triangles.size()), static_cast<int>(meshes[1]->triangles.size()),
+		static_cast<int>(pairs.size()), static_cast<int>(cuts.size()), static_cast<int>(patchCnt), static_cast<int>(m_mesh->triangles.size()));
+
+	return true;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <memory>
+#include <string>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace edit
+		{
+			// union, intersection or difference of the volumes of two closed meshes
+			class Boolean : public AbstractCommand
+			{
+			public:
+				Boolean(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				const std::shared_ptr<data::Mesh> m_meshA;
+				const std::shared_ptr<data::Mesh> m_meshB;
+				// 'Union', 'Intersection' or 'Difference', i.e. A minus B
+				const std::wstring m_operation{ L"Union" };
+				std::shared_ptr<data::Mesh> m_mesh;
+			};
+
+		}
+	}
+}
@@ -0,0 +1,62 @@
+#include "Decimate.h"
+
+#include "utilities/QuadricDecimator.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+using namespace meshproc::commands::edit;
+
+Decimate::Decimate(const sgrottel::ISimpleLog& log)
+	: AbstractCommand{ log }
+{
+	AddParamBinding<ParamMode::InOut, ParamType::Mesh>("Mesh", m_mesh);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("TargetTriangleCount", m_targetTriangleCount);
+	AddParamBinding<ParamMode::In, ParamType::Float>("MaxError", m_maxError);
+	AddParamBinding<ParamMode::In, ParamType::Float>("CreaseAngle", m_creaseAngle);
+	AddParamBinding<ParamMode::In, ParamType::Bool>("LockBoundary", m_lockBoundary);
+	AddParamBinding<ParamMode::InOut, ParamType::Vec3List>("Attributes", m_attributes);
+	AddParamBinding<ParamMode::Out, ParamType::Float>("Error", m_error);
+}
+
+bool Decimate::Invoke()
+{
+	if (!m_mesh)
+	{
+		Log().Error("Mesh is empty");
+		return false;
+	}
+	if (!m_mesh->IsValid())
+	{
+		Log().Error("Mesh is invalid");
+		return false;
+	}
+	if (m_targetTriangleCount == 0 && m_maxError == std::numeric_limits<float>::max())
+	{
+		Log().Error("TargetTriangleCount or MaxError must be set");
+		return false;
+	}
+	if (m_maxError < 0.0f)
+	{
+		Log().Error("MaxError must not be negative");
+		return false;
+	}
+	if (m_attributes && m_attributes->size() != m_mesh->vertices.size())
+	{
+		Log().Error("Attributes size %d does not match vertex count %d", static_cast<int>(m_attributes->size()), static_cast<int>(m_mesh->vertices.size()));
+		return false;
+	}
+
+	utilities::QuadricDecimator::Settings settings;
+	settings.targetTriangleCount = m_targetTriangleCount;
+	settings.maxError = m_maxError;
+	settings.creaseAngle = m_creaseAngle;
+	settings.lockBoundary = m_lockBoundary;
+
+	const size_t triCnt = m_mesh->triangles.size();
+	m_error = utilities::QuadricDecimator::Decimate(*m_mesh, m_attributes.get(), settings);
+	Log().Detail("Decimated %d triangles to %d; max error %f", static_cast<int>(triCnt), static_cast<int>(m_mesh->triangles.size()), m_error);
+
+	return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <glm/glm.hpp>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace edit
+		{
+			// inplace edit of mesh: reduces the number of triangles by edge collapses ordered by the quadric error metric
+			class Decimate : public AbstractCommand
+			{
+			public:
+				Decimate(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				std::shared_ptr<data::Mesh> m_mesh;
+				const uint32_t m_targetTriangleCount{ 0 };
+				// root mean square distance of the collapsed vertices to the planes of their original triangles
+				const float m_maxError{ std::numeric_limits<float>::max() };
+				// in degrees
+				const float m_creaseAngle{ 180.0f };
+				const bool m_lockBoundary{ false };
+				// optional per-vertex values, e.g. colors, interpolated along collapsed edges
+				std::shared_ptr<std::vector<glm::vec3>> m_attributes;
+				float m_error{ 0.0f };
+			};
+
+		}
+	}
+}
@@ -0,0 +1,598 @@
+#include "FillHoles.h"
+
+#include "utilities/Constrained2DTriangulation.h"
+#include "utilities/LoopsFromEdges.h"
+#include "utilities/TaskScheduler.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <initializer_list>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+
+namespace
+{
+
+	// loops with at most this number of edges, which are not planar, are filled by the triangulation of minimal area
+	constexpr size_t MaxMinimalAreaSize = 64;
+	// relative to the loop extent
+	constexpr float PlanarTolerance = 1e-4f;
+
+	enum class Strategy : uint8_t
+	{
+		None,
+		Planar,
+		MinimalArea,
+		AdvancingFront
+	};
+
+	struct Patch
+	{
+		Strategy strategy{ Strategy::None };
+		// indices into the loop, or `loop.size() + i` for `newVertices[i]`
+		std::vector<glm::uvec3> triangles;
+		std::vector<glm::vec3> newVertices;
+	};
+
+	// Plane of a loop with the normal facing the side of counter-clockwise winding, and an orthonormal basis
+	struct Frame
+	{
+		glm::vec3 center{ 0.0f };
+		glm::vec3 normal{ 0.0f };
+		glm::vec3 u{ 0.0f };
+		glm::vec3 w{ 0.0f };
+
+		inline glm::vec2 Project(const glm::vec3& p) const
+		{
+			return glm::vec2{ glm::dot(p - center, u), glm::dot(p - center, w) };
+		}
+	};
+
+	// @return false if the loop has no area
+	bool LoopFrame(const std::vector<glm::vec3>& pts, Frame& outFrame)
+	{
+		// Newell's method
+		glm::dvec3 n{ 0.0 };
+		glm::dvec3 c{ 0.0 };
+		for (size_t i = 0; i < pts.size(); ++i)
+		{
+			const glm::dvec3 a{ pts[i] };
+			const glm::dvec3 b{ pts[(i + 1) % pts.size()] };
+			n += glm::dvec3{ (a.y - b.y) * (a.z + b.z), (a.z - b.z) * (a.x + b.x), (a.x - b.x) * (a.y + b.y) };
+			c += a;
+		}
+		const double len = glm::length(n);
+		if (!(len > 0.0))
+		{
+			return false;
+		}
+		outFrame.center = glm::vec3{ c / static_cast<double>(pts.size()) };
+		outFrame.normal = glm::vec3{ n / len };
+		const glm::vec3 an = glm::abs(outFrame.normal);
+		const glm::vec3 axis = (an.x <= an.y && an.x <= an.z) ? glm::vec3{ 1.0f, 0.0f, 0.0f } : ((an.y <= an.z) ? glm::vec3{ 0.0f, 1.0f, 0.0f } : glm::vec3{ 0.0f, 0.0f, 1.0f });
+		outFrame.u = glm::normalize(glm::cross(outFrame.normal, axis));
+		outFrame.w = glm::cross(outFrame.normal, outFrame.u);
+		return true;
+	}
+
+	bool IsPlanar(const std::vector<glm::vec3>& pts, const Frame& frame)
+	{
+		glm::vec3 bmin = pts[0];
+		glm::vec3 bmax = pts[0];
+		float dev = 0.0f;
+		for (const glm::vec3& p : pts)
+		{
+			bmin = glm::min(bmin, p);
+			bmax = glm::max(bmax, p);
+			dev = std::max(dev, std::abs(glm::dot(p - frame.center, frame.normal)));
+		}
+		return dev <= PlanarTolerance * glm::length(bmax - bmin);
+	}
+
+	// Constrained triangulation of the projected loop, keeping the triangles inside of it
+	bool FillPlanar(const std::vector<glm::vec3>& pts, const Frame& frame, const sgrottel::ISimpleLog& log, Patch& outPatch)
+	{
+		const uint32_t n = static_cast<uint32_t>(pts.size());
+		std::unordered_map<uint32_t, glm::vec2> pt2d;
+		std::unordered_set<data::HashableEdge> edges;
+		pt2d.reserve(n);
+		edges.reserve(n);
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			pt2d.insert({ i, frame.Project(pts[i]) });
+			edges.insert({ i, (i + 1) % n });
+		}
+
+		utilities::Constrained2DTriangulation cdt{ pt2d, edges, log };
+		try
+		{
+			outPatch.triangles = cdt.Compute(utilities::Constrained2DTriangulation::Region::Inside);
+		}
+		catch (...)
+		{
+			// the projected loop crosses itself; one of the other strategies fills it
+			outPatch.triangles.clear();
+			return false;
+		}
+		if (cdt.HasError())
+		{
+			outPatch.triangles.clear();
+			return false;
+		}
+
+		// a simple polygon is triangulated without additional vertices
+		if (outPatch.triangles.size() != n - 2)
+		{
+			outPatch.triangles.clear();
+			return false;
+		}
+		outPatch.strategy = Strategy::Planar;
+		return true;
+	}
+
+	// Triangulation of the loop of minimal total area by dynamic programming, in O(n^3)
+	void FillMinimalArea(const std::vector<glm::vec3>& pts, Patch& outPatch)
+	{
+		const size_t n = pts.size();
+		std::vector<double> weight(n * n, 0.0);
+		std::vector<uint32_t> split(n * n, 0);
+		for (size_t len = 2; len < n; ++len)
+		{
+			for (size_t i = 0; i + len < n; ++i)
+			{
+				const size_t j = i + len;
+				double best = std::numeric_limits<double>::max();
+				for (size_t m = i + 1; m < j; ++m)
+				{
+					const double area = glm::length(glm::cross(glm::dvec3{ pts[m] } - glm::dvec3{ pts[i] }, glm::dvec3{ pts[j] } - glm::dvec3{ pts[i] }));
+					const double w = weight[i * n + m] + weight[m * n + j] + area;
+					if (w < best)
+					{
+						best = w;
+						split[i * n + j] = static_cast<uint32_t>(m);
+					}
+				}
+				weight[i * n + j] = best;
+			}
+		}
+
+		std::vector<std::pair<uint32_t, uint32_t>> stack;
+		stack.push_back(std::make_pair(0u, static_cast<uint32_t>(n - 1)));
+		while (!stack.empty())
+		{
+			const auto [i, j] = stack.back();
+			stack.pop_back();
+			if (j - i < 2) continue;
+			const uint32_t m = split[i * n + j];
+			outPatch.triangles.push_back(glm::uvec3{ i, m, j });
+			stack.push_back(std::make_pair(i, m));
+			stack.push_back(std::make_pair(m, j));
+		}
+		outPatch.strategy = Strategy::MinimalArea;
+	}
+
+	// Advancing front, following "A robust hole-filling algorithm for triangular mesh", Zhao, Gao & Lin 2007.
+	// The front is repeatedly advanced at its vertex of smallest interior angle, measured in the plane of the loop,
+	// inserting no, one or two new vertices for angles below 75, below 135, and above.
+	// A new vertex close to another part of the front is merged into it, which splits the front into two.
+	// @param insertVertices false to only cut off ears, which always terminates
+	// @return false if the front did not close within the step limit
+	bool FillAdvancingFront(const std::vector<glm::vec3>& pts, const Frame& frame, bool insertVertices, Patch& outPatch)
+	{
+		constexpr float smallAngle = static_cast<float>(75.0 * std::numbers::pi / 180.0);
+		constexpr float largeAngle = static_cast<float>(135.0 * std::numbers::pi / 180.0);
+		constexpr float fullAngle = static_cast<float>(2.0 * std::numbers::pi);
+		// relative to the length of the new edges
+		constexpr float mergeDistance = 0.5f;
+
+		// the front consists of cycles of nodes, each with the hole on its left side
+		struct Node
+		{
+			uint32_t vertex;
+			uint32_t prev;
+			uint32_t next;
+			float angle;
+			bool alive;
+		};
+
+		const size_t n = pts.size();
+		std::vector<glm::vec3> positions = pts;
+		std::vector<Node> front(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			front[i] = Node{ static_cast<uint32_t>(i), static_cast<uint32_t>((i + n - 1) % n), static_cast<uint32_t>((i + 1) % n), 0.0f, true };
+		}
+
+		auto direction = [&frame](const glm::vec3& d) { return std::atan2(glm::dot(d, frame.w), glm::dot(d, frame.u)); };
+		auto height = [&frame](const glm::vec3& p) { return glm::dot(p - frame.center, frame.normal); };
+		auto interiorAngle = [&](const Node& node)
+			{
+				const glm::vec3& v = positions[node.vertex];
+				float a = direction(positions[front[node.prev].vertex] - v) - direction(positions[front[node.next].vertex] - v);
+				while (a <= 0.0f) a += fullAngle;
+				while (a > fullAngle) a -= fullAngle;
+				return a;
+			};
+
+		std::set<std::pair<float, uint32_t>> queue;
+		auto update = [&](uint32_t i)
+			{
+				queue.erase(std::make_pair(front[i].angle, i));
+				front[i].angle = interiorAngle(front[i]);
+				queue.insert(std::make_pair(front[i].angle, i));
+			};
+		auto remove = [&](uint32_t i)
+			{
+				queue.erase(std::make_pair(front[i].angle, i));
+				front[i].alive = false;
+			};
+
+		// front nodes by grid cell of their vertex, with cells of the mean loop edge length; removed nodes are skipped
+		float cellSize = 0.0f;
+		for (size_t i = 0; i < n; ++i)
+		{
+			cellSize += glm::distance(pts[i], pts[(i + 1) % n]);
+		}
+		cellSize = std::max(cellSize / static_cast<float>(n), std::numeric_limits<float>::min());
+		std::unordered_map<uint64_t, std::vector<uint32_t>> grid;
+		auto cellOf = [cellSize](const glm::vec3& p)
+			{
+				return glm::ivec3{ static_cast<int>(std::floor(p.x / cellSize)), static_cast<int>(std::floor(p.y / cellSize)), static_cast<int>(std::floor(p.z / cellSize)) };
+			};
+		auto cellKey = [](const glm::ivec3& c)
+			{
+				return (static_cast<uint64_t>(static_cast<uint32_t>(c.x) & 0x1fffff) << 42) | (static_cast<uint64_t>(static_cast<uint32_t>(c.y) & 0x1fffff) << 21) | (static_cast<uint64_t>(static_cast<uint32_t>(c.z) & 0x1fffff));
+			};
+		auto addNode = [&](uint32_t vertex, uint32_t prev, uint32_t next)
+			{
+				front.push_back(Node{ vertex, prev, next, 0.0f, true });
+				const uint32_t i = static_cast<uint32_t>(front.size() - 1);
+				grid[cellKey(cellOf(positions[vertex]))].push_back(i);
+				return i;
+			};
+		// nearest node within `maxDist` of `p`, other than the `excluded` ones, or `InvalidNode`
+		constexpr uint32_t InvalidNode = std::numeric_limits<uint32_t>::max();
+		auto nearestNode = [&](const glm::vec3& p, float maxDist, std::initializer_list<uint32_t> excluded)
+			{
+				uint32_t best = InvalidNode;
+				float bestDist = maxDist;
+				const glm::ivec3 c = cellOf(p);
+				const int r = static_cast<int>(std::ceil(maxDist / cellSize));
+				for (int z = c.z - r; z <= c.z + r; ++z)
+				{
+					for (int y = c.y - r; y <= c.y + r; ++y)
+					{
+						for (int x = c.x - r; x <= c.x + r; ++x)
+						{
+							const auto it = grid.find(cellKey(glm::ivec3{ x, y, z }));
+							if (it == grid.end()) continue;
+							for (uint32_t k : it->second)
+							{
+								if (!front[k].alive || std::find(excluded.begin(), excluded.end(), front[k].vertex) != excluded.end()) continue;
+								const float d = glm::distance(p, positions[front[k].vertex]);
+								if (d < bestDist)
+								{
+									bestDist = d;
+									best = k;
+								}
+							}
+						}
+					}
+				}
+				return best;
+			};
+
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			front[i].angle = interiorAngle(front[i]);
+			queue.insert(std::make_pair(front[i].angle, i));
+			grid[cellKey(cellOf(positions[front[i].vertex]))].push_back(i);
+		}
+
+		const size_t maxSteps = n * n + 16 * n;
+		for (size_t step = 0; !queue.empty(); ++step)
+		{
+			if (step > maxSteps)
+			{
+				return false;
+			}
+
+			const auto [angle, i] = *queue.begin();
+			const uint32_t pi = front[i].prev;
+			const uint32_t ni = front[i].next;
+			const uint32_t p = front[pi].vertex;
+			const uint32_t v = front[i].vertex;
+			const uint32_t nx = front[ni].vertex;
+
+			if (front[ni].next == pi)
+			{
+				// last triangle of this part of the front
+				outPatch.triangles.push_back(glm::uvec3{ p, v, nx });
+				remove(pi);
+				remove(i);
+				remove(ni);
+				continue;
+			}
+
+			if (!insertVertices || angle < smallAngle || front[front[ni].next].next == pi)
+			{
+				outPatch.triangles.push_back(glm::uvec3{ p, v, nx });
+				remove(i);
+				front[pi].next = ni;
+				front[ni].prev = pi;
+				update(pi);
+				update(ni);
+				continue;
+			}
+
+			const glm::vec3 vp = positions[v];
+			const float len = cellSize;
+			const float base = direction(positions[nx] - vp);
+			const float h = 0.5f * (height(positions[p]) + height(positions[nx])) - height(vp);
+			auto newPosition = [&](float a)
+				{
+					return vp + len * (std::cos(a) * frame.u + std::sin(a) * frame.w) + h * frame.normal;
+				};
+
+			const int newCnt = (angle < largeAngle) ? 1 : 2;
+			glm::vec3 w[2];
+			uint32_t merge = InvalidNode;
+			for (int k = 0; k < newCnt && merge == InvalidNode; ++k)
+			{
+				w[k] = newPosition(base + angle * static_cast<float>(k + 1) / static_cast<float>(newCnt + 1));
+				merge = nearestNode(w[k], mergeDistance * len, { p, v, nx });
+			}
+
+			remove(i);
+			if (merge != InvalidNode)
+			{
+				// connect `v` to the existing vertex, splitting the front at it
+				const uint32_t xi = merge;
+				const uint32_t x = front[xi].vertex;
+				outPatch.triangles.push_back(glm::uvec3{ p, v, x });
+				outPatch.triangles.push_back(glm::uvec3{ v, nx, x });
+				const uint32_t xp = front[xi].prev;
+				const uint32_t x2 = addNode(x, xp, ni);
+				front[xp].next = x2;
+				front[ni].prev = x2;
+				front[xi].prev = pi;
+				front[pi].next = xi;
+				for (uint32_t k : { pi, xi, x2, ni })
+				{
+					if (!front[k].alive) continue;
+					// both directions of the same edge cancel out
+					if (front[front[k].next].next == k)
+					{
+						remove(front[k].next);
+						remove(k);
+						continue;
+					}
+					if (k == x2)
+					{
+						front[k].angle = interiorAngle(front[k]);
+						queue.insert(std::make_pair(front[k].angle, k));
+					}
+					else
+					{
+						update(k);
+					}
+				}
+				continue;
+			}
+
+			if (newCnt == 1)
+			{
+				const uint32_t w0 = static_cast<uint32_t>(positions.size());
+				positions.push_back(w[0]);
+				outPatch.triangles.push_back(glm::uvec3{ p, v, w0 });
+				outPatch.triangles.push_back(glm::uvec3{ v, nx, w0 });
+				const uint32_t wi = addNode(w0, pi, ni);
+				front[pi].next = wi;
+				front[ni].prev = wi;
+				front[wi].angle = interiorAngle(front[wi]);
+				queue.insert(std::make_pair(front[wi].angle, wi));
+			}
+			else
+			{
+				const uint32_t w1 = static_cast<uint32_t>(positions.size());
+				positions.push_back(w[0]);
+				const uint32_t w2 = static_cast<uint32_t>(positions.size());
+				positions.push_back(w[1]);
+				outPatch.triangles.push_back(glm::uvec3{ v, nx, w1 });
+				outPatch.triangles.push_back(glm::uvec3{ v, w1, w2 });
+				outPatch.triangles.push_back(glm::uvec3{ p, v, w2 });
+				const uint32_t w2i = addNode(w2, pi, ni);
+				const uint32_t w1i = addNode(w1, w2i, ni);
+				front[w2i].next = w1i;
+				front[pi].next = w2i;
+				front[ni].prev = w1i;
+				for (uint32_t k : { w1i, w2i })
+				{
+					front[k].angle = interiorAngle(front[k]);
+					queue.insert(std::make_pair(front[k].angle, k));
+				}
+			}
+			update(pi);
+			update(ni);
+		}
+
+		outPatch.newVertices.assign(positions.begin() + n, positions.end());
+		outPatch.strategy = Strategy::AdvancingFront;
+		return true;
+	}
+
+}
+
+edit::FillHoles::FillHoles(const sgrottel::ISimpleLog& log)
+	: AbstractCommand{ log }
+{
+	AddParamBinding<ParamMode::InOut, ParamType::Mesh>("Mesh", m_mesh);
+	AddParamBinding<ParamMode::In, ParamType::IndexListList>("Loops", m_loops);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("MaxEdges", m_maxEdges);
+	AddParamBinding<ParamMode::Out, ParamType::UInt32>("FilledCount", m_filledCount);
+}
+
+bool edit::FillHoles::Invoke()
+{
+	if (!m_mesh)
+	{
+		Log().Error("Mesh is empty");
+		return false;
+	}
+	if (!m_mesh->IsValid())
+	{
+		Log().Error("Mesh is invalid");
+		return false;
+	}
+
+	std::shared_ptr<std::vector<std::shared_ptr<std::vector<uint32_t>>>> loops = m_loops;
+	if (!loops)
+	{
+		utilities::LoopsFromEdges(m_mesh->CollectOpenEdges(), loops, Log());
+	}
+
+	// directed edges of all triangles, to orient each loop against its adjacent triangles
+	std::vector<uint64_t> halfEdges;
+	halfEdges.reserve(m_mesh->triangles.size() * 3);
+	for (const data::Triangle& t : m_mesh->triangles)
+	{
+		for (int k = 0; k < 3; ++k)
+		{
+			halfEdges.push_back((static_cast<uint64_t>(t[k]) << 32) | t[(k + 1) % 3]);
+		}
+	}
+	std::sort(halfEdges.begin(), halfEdges.end());
+	auto hasHalfEdge = [&halfEdges](uint32_t from, uint32_t to)
+		{
+			return std::binary_search(halfEdges.begin(), halfEdges.end(), (static_cast<uint64_t>(from) << 32) | to);
+		};
+
+	const size_t vertCnt = m_mesh->vertices.size();
+	std::vector<std::vector<uint32_t>> holes;
+	holes.reserve(loops->size());
+	std::unordered_map<uint32_t, size_t> pathPos;
+	for (const auto& input : *loops)
+	{
+		if (!input || input->size() < 3) continue;
+		const std::vector<uint32_t>& loop = *input;
+		if (std::any_of(loop.begin(), loop.end(), [vertCnt](uint32_t i) { return i >= vertCnt; }))
+		{
+			Log().Warning("Loop with invalid vertex index skipped");
+			continue;
+		}
+
+		// holes touching at a vertex are split there into separate loops, as the undirected border edges may connect them in any order
+		std::vector<uint32_t> path;
+		pathPos.clear();
+		for (uint32_t v : loop)
+		{
+			const auto it = pathPos.find(v);
+			if (it == pathPos.end())
+			{
+				pathPos.insert({ v, path.size() });
+				path.push_back(v);
+				continue;
+			}
+			const size_t k = it->second;
+			if (path.size() - k >= 3)
+			{
+				holes.emplace_back(path.begin() + k, path.end());
+			}
+			for (size_t i = k + 1; i < path.size(); ++i)
+			{
+				pathPos.erase(path[i]);
+			}
+			path.resize(k + 1);
+		}
+		if (path.size() >= 3)
+		{
+			holes.push_back(std::move(path));
+		}
+	}
+	if (m_maxEdges > 0)
+	{
+		std::erase_if(holes, [this](const std::vector<uint32_t>& hole) { return hole.size() > m_maxEdges; });
+	}
+
+	// the new triangles use each loop edge opposite to the adjacent triangle
+	for (std::vector<uint32_t>& hole : holes)
+	{
+		int votes = 0;
+		for (size_t i = 0; i < hole.size(); ++i)
+		{
+			const uint32_t a = hole[i];
+			const uint32_t b = hole[(i + 1) % hole.size()];
+			if (hasHalfEdge(b, a)) votes++;
+			if (hasHalfEdge(a, b)) votes--;
+		}
+		if (votes < 0)
+		{
+			std::reverse(hole.begin(), hole.end());
+		}
+	}
+
+	std::vector<Patch> patches(holes.size());
+	Tasks().ParallelFor(0, holes.size(), 1, [&](size_t begin, size_t end)
+		{
+			for (size_t hi = begin; hi < end; ++hi)
+			{
+				const std::vector<uint32_t>& hole = holes[hi];
+				std::vector<glm::vec3> pts(hole.size());
+				for (size_t i = 0; i < hole.size(); ++i)
+				{
+					pts[i] = m_mesh->vertices[hole[i]];
+				}
+				Frame frame;
+				if (!LoopFrame(pts, frame)) continue;
+
+				Patch& patch = patches[hi];
+				if (IsPlanar(pts, frame) && FillPlanar(pts, frame, Log(), patch)) continue;
+				if (pts.size() <= MaxMinimalAreaSize)
+				{
+					FillMinimalArea(pts, patch);
+					continue;
+				}
+				if (!FillAdvancingFront(pts, frame, true, patch))
+				{
+					patch = Patch{};
+					FillAdvancingFront(pts, frame, false, patch);
+				}
+			}
+		});
+
+	size_t counts[4] = { 0, 0, 0, 0 };
+	for (size_t hi = 0; hi < patches.size(); ++hi)
+	{
+		const Patch& patch = patches[hi];
+		counts[static_cast<size_t>(patch.strategy)]++;
+		if (patch.strategy == Strategy::None) continue;
+
+		const std::vector<uint32_t>& loop = holes[hi];
+		const uint32_t base = static_cast<uint32_t>(m_mesh->vertices.size());
+		m_mesh->vertices.insert(m_mesh->vertices.end(), patch.newVertices.begin(), patch.newVertices.end());
+		auto index = [&](uint32_t i) { return (i < loop.size()) ? loop[i] : base + i - static_cast<uint32_t>(loop.size()); };
+		for (const glm::uvec3& t : patch.triangles)
+		{
+			m_mesh->triangles.push_back(data::Triangle{ index(t.x), index(t.y), index(t.z) });
+		}
+	}
+
+	m_filledCount = static_cast<uint32_t>(patches.size() - counts[static_cast<size_t>(Strategy::None)]);
+	Log().Detail("Filled %d of %d holes: %d planar, %d minimal area, %d advancing front",
+		static_cast<int>(m_filledCount),
+		static_cast<int>(patches.size()),
+		static_cast<int>(counts[static_cast<size_t>(Strategy::Planar)]),
+		static_cast<int>(counts[static_cast<size_t>(Strategy::MinimalArea)]),
+		static_cast<int>(counts[static_cast<size_t>(Strategy::AdvancingFront)]));
+
+	return true;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <memory>
+#include <vector>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace edit
+		{
+
+			// Closes open border loops with new triangles, oriented like the adjacent triangles.
+			// Each loop is filled independently, by a constrained triangulation if it is planar,
+			// by the triangulation of minimal area if it is small, and by an advancing front inserting new vertices otherwise.
+			class FillHoles : public AbstractCommand
+			{
+			public:
+				FillHoles(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				std::shared_ptr<data::Mesh> m_mesh;
+				// optional, e.g. from `compute::OpenBorder`; all open border loops of the mesh if not set
+				const std::shared_ptr<std::vector<std::shared_ptr<std::vector<uint32_t>>>> m_loops;
+				// loops with more edges are left open, e.g. the outer border of a scan; 0 for no limit
+				const uint32_t m_maxEdges{ 0 };
+
+				uint32_t m_filledCount{ 0 };
+			};
+
+		}
+	}
+}
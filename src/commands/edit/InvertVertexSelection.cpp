@@ -9,7 +9,7 @@ edit::InvertVertexSelection::InvertVertexSelection(const sgrottel::ISimpleLog& l
 	: AbstractCommand{ log }
 {
 	AddParamBinding<ParamMode::In, ParamType::Mesh>("Mesh", m_mesh);
-	AddParamBinding<ParamMode::InOut, ParamType::IndexList>("Selection", m_selection);
+	AddParamBinding<ParamMode::InOut, ParamType::Selection>("Selection", m_selection);
 }
 
 bool edit::InvertVertexSelection::Invoke()
@@ -25,29 +25,9 @@ bool edit::InvertVertexSelection::Invoke()
 		return false;
 	}
 
-	std::sort(m_selection->begin(), m_selection->end());
-
-	std::vector<uint32_t> comp;
-	comp.reserve(m_mesh->vertices.size() - m_selection->size());
-
-	size_t selIdx = 0;
-	for (uint32_t i = 0; i < m_mesh->vertices.size(); ++i)
-	{
-		while (selIdx < m_selection->size() && m_selection->at(selIdx) < i)
-		{
-			++selIdx;
-		}
-		if (selIdx < m_selection->size() && m_selection->at(selIdx) == i)
-		{
-			++selIdx;
-		}
-		else
-		{
-			comp.push_back(i);
-		}
-	}
-
-	std::swap(comp, *m_selection);
+	// indices beyond the vertex count are dropped; updated in place
+	m_selection->Resize(m_mesh->vertices.size());
+	m_selection->Invert();
 
 	return true;
 }
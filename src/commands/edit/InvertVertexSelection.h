@@ -2,6 +2,7 @@
 
 #include "commands/AbstractCommand.h"
 #include "data/Mesh.h"
+#include "data/Selection.h"
 
 #include <memory>
 #include <vector>
@@ -21,7 +22,7 @@ namespace meshproc
 
 			private:
 				const std::shared_ptr<data::Mesh> m_mesh;
-				std::shared_ptr<std::vector<uint32_t>> m_selection;
+				std::shared_ptr<data::Selection> m_selection;
 			};
 
 		}
@@ -0,0 +1,73 @@
+#include "OptimizeLayout.h"
+
+#include "utilities/VertexCacheOptimizer.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+using namespace meshproc::commands::edit;
+
+OptimizeLayout::OptimizeLayout(const sgrottel::ISimpleLog& log)
+	: AbstractCommand{ log }
+{
+	AddParamBinding<ParamMode::InOut, ParamType::Mesh>("Mesh", m_mesh);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("CacheSize", m_cacheSize);
+	AddParamBinding<ParamMode::Out, ParamType::Float>("AcmrBefore", m_acmrBefore);
+	AddParamBinding<ParamMode::Out, ParamType::Float>("AcmrAfter", m_acmrAfter);
+	AddParamBinding<ParamMode::Out, ParamType::IndexList>("Remap", m_remap);
+}
+
+bool OptimizeLayout::Invoke()
+{
+	using utilities::VertexCacheOptimizer;
+
+	if (!m_mesh)
+	{
+		Log().Error("Mesh is empty");
+		return false;
+	}
+	if (m_cacheSize < 3)
+	{
+		Log().Error("CacheSize must be at least 3");
+		return false;
+	}
+
+	const size_t vertCnt = m_mesh->vertices.size();
+	for (const auto& t : m_mesh->triangles)
+	{
+		if (t[0] >= vertCnt || t[1] >= vertCnt || t[2] >= vertCnt)
+		{
+			Log().Error("Mesh triangle references invalid vertex index");
+			return false;
+		}
+	}
+
+	m_acmrBefore = VertexCacheOptimizer::CalcAcmr(m_mesh->triangles, vertCnt, m_cacheSize);
+
+	const std::vector<uint32_t> order = VertexCacheOptimizer::TipsifyOrder(m_mesh->triangles, vertCnt, m_cacheSize);
+	std::vector<data::Triangle> triangles;
+	triangles.reserve(order.size());
+	for (uint32_t ti : order)
+	{
+		triangles.push_back(m_mesh->triangles[ti]);
+	}
+
+	m_acmrAfter = VertexCacheOptimizer::CalcAcmr(triangles, vertCnt, m_cacheSize);
+	if (m_acmrAfter <= m_acmrBefore)
+	{
+		m_mesh->triangles.swap(triangles);
+	}
+	else
+	{
+		// input order was already better; only improve fetch locality
+		m_acmrAfter = m_acmrBefore;
+	}
+
+	m_remap = std::make_shared<std::vector<uint32_t>>(VertexCacheOptimizer::FirstUseVertexOrder(m_mesh->triangles, vertCnt));
+	VertexCacheOptimizer::RemapVertices(*m_mesh, *m_remap);
+
+	Log().Detail("ACMR (cache size %u): %f -> %f", m_cacheSize, m_acmrBefore, m_acmrAfter);
+
+	return true;
+}
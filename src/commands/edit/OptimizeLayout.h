@@ -0,0 +1,34 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <memory>
+#include <vector>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace edit
+		{
+			// inplace edit of mesh: reorders triangles for post-transform vertex cache reuse,
+			// and renumbers vertices in order of first use for fetch locality
+			class OptimizeLayout : public AbstractCommand
+			{
+			public:
+				OptimizeLayout(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				std::shared_ptr<data::Mesh> m_mesh;
+				const uint32_t m_cacheSize{ 16 };
+				float m_acmrBefore{ 0.0f };
+				float m_acmrAfter{ 0.0f };
+				std::shared_ptr<std::vector<uint32_t>> m_remap;
+			};
+
+		}
+	}
+}
@@ -0,0 +1,333 @@
+#include "Remesh.h"
+
+#include "data/Bvh.h"
+#include "data/HalfEdgeMesh.h"
+#include "utilities/TaskScheduler.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <glm/gtx/vector_angle.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+using namespace meshproc::commands::edit;
+
+Remesh::Remesh(const sgrottel::ISimpleLog& log)
+	: AbstractCommand{ log }
+{
+	AddParamBinding<ParamMode::InOut, ParamType::Mesh>("Mesh", m_mesh);
+	AddParamBinding<ParamMode::In, ParamType::Float>("TargetEdgeLength", m_targetEdgeLength);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("Iterations", m_iterations);
+	AddParamBinding<ParamMode::In, ParamType::Float>("FeatureAngle", m_featureAngle);
+}
+
+bool Remesh::Invoke()
+{
+	using data::HalfEdgeMesh;
+
+	if (!m_mesh)
+	{
+		Log().Error("Mesh is empty");
+		return false;
+	}
+	if (!m_mesh->IsValid())
+	{
+		Log().Error("Mesh is invalid");
+		return false;
+	}
+	if (m_targetEdgeLength < 0.0f)
+	{
+		Log().Error("TargetEdgeLength must not be negative");
+		return false;
+	}
+
+	HalfEdgeMesh hem;
+	if (!hem.Build(*m_mesh))
+	{
+		Log().Error("Mesh is not manifold");
+		return false;
+	}
+	// the input surface, to project the relaxed vertices back onto
+	const std::shared_ptr<const data::Bvh> bvh = m_mesh->GetBvh();
+
+	auto faceNormal = [&hem](uint32_t h)
+		{
+			const glm::vec3& a = hem.positions[hem.From(h)];
+			return glm::cross(hem.positions[hem.To(h)] - a, hem.positions[hem.From(HalfEdgeMesh::Prev(h))] - a);
+		};
+	auto edgeLength = [&hem](uint32_t h)
+		{
+			return glm::distance(hem.positions[hem.From(h)], hem.positions[hem.To(h)]);
+		};
+	// one half-edge per edge
+	auto isEdge = [&hem](uint32_t h)
+		{
+			return hem.IsAlive(h) && (hem.Twin(h) == HalfEdgeMesh::InvalidIndex || h < hem.Twin(h));
+		};
+
+	float targetLength = m_targetEdgeLength;
+	if (targetLength <= 0.0f)
+	{
+		double sum = 0.0;
+		size_t cnt = 0;
+		for (uint32_t h = 0; h < hem.HalfEdgeSlots(); ++h)
+		{
+			if (!isEdge(h)) continue;
+			sum += edgeLength(h);
+			cnt++;
+		}
+		if (cnt == 0)
+		{
+			Log().Warning("Mesh has no edges");
+			return true;
+		}
+		targetLength = static_cast<float>(sum / static_cast<double>(cnt));
+	}
+	const float highLength = targetLength * 4.0f / 3.0f;
+	const float lowLength = targetLength * 4.0f / 5.0f;
+
+	// feature edges, by the angle between the triangle normals like `SplitByEdges`
+	{
+		const float angleRad = glm::radians(std::max<float>(1.0f, m_featureAngle));
+		std::vector<uint8_t> feature(hem.HalfEdgeSlots(), 0);
+		Tasks().ParallelFor(0, hem.HalfEdgeSlots(), 0x1000, [&](size_t begin, size_t end)
+			{
+				for (size_t h = begin; h < end; ++h)
+				{
+					const uint32_t t = hem.Twin(static_cast<uint32_t>(h));
+					if (t == HalfEdgeMesh::InvalidIndex || t < h) continue;
+					const glm::vec3 n1 = faceNormal(static_cast<uint32_t>(h));
+					const glm::vec3 n2 = faceNormal(t);
+					const float l = glm::length(n1) * glm::length(n2);
+					if (l <= 0.0f) continue;
+					const float angle = glm::angle(n1 / glm::length(n1), n2 / glm::length(n2));
+					feature[h] = (angle >= angleRad) ? 1 : 0;
+				}
+			});
+		for (uint32_t h = 0; h < feature.size(); ++h)
+		{
+			if (feature[h] != 0) hem.SetFeature(h, true);
+		}
+	}
+
+	// vertices with other than two feature edges, e.g. corners, are neither moved nor removed
+	std::vector<uint8_t> fixed(hem.VertexSlots(), 0);
+	Tasks().ParallelFor(0, fixed.size(), 0x1000, [&](size_t begin, size_t end)
+		{
+			for (size_t v = begin; v < end; ++v)
+			{
+				const uint32_t f = hem.FeatureValence(static_cast<uint32_t>(v));
+				fixed[v] = (f != 0 && f != 2) ? 1 : 0;
+			}
+		});
+
+	// edge candidates are evaluated in parallel, and then applied in order, re-checked against the edits before
+	std::vector<uint8_t> candidate;
+	auto markCandidates = [&](auto&& predicate)
+		{
+			candidate.assign(hem.HalfEdgeSlots(), 0);
+			Tasks().ParallelFor(0, candidate.size(), 0x1000, [&](size_t begin, size_t end)
+				{
+					for (size_t h = begin; h < end; ++h)
+					{
+						if (isEdge(static_cast<uint32_t>(h)) && predicate(static_cast<uint32_t>(h))) candidate[h] = 1;
+					}
+				});
+		};
+
+	// true if `v` may be merged into the other vertex of the edge
+	auto isRemovable = [&](uint32_t v, uint32_t h)
+		{
+			if (fixed[v] != 0) return false;
+			if (hem.FeatureValence(v) == 0) return true;
+			// feature vertices only slide along their feature lines
+			return hem.IsFeature(h) || hem.Twin(h) == HalfEdgeMesh::InvalidIndex;
+		};
+	// true if moving `v` to `p` keeps all its triangles facing the same side and its edges shorter than `highLength`
+	auto isMoveValid = [&](uint32_t v, const glm::vec3& p, uint32_t skipFace1, uint32_t skipFace2)
+		{
+			bool valid = true;
+			hem.ForEachOutgoing(v, [&](uint32_t o)
+				{
+					if (!valid) return;
+					const glm::vec3& pb = hem.positions[hem.To(o)];
+					const glm::vec3& pc = hem.positions[hem.From(HalfEdgeMesh::Prev(o))];
+					if (glm::distance(p, pb) > highLength || glm::distance(p, pc) > highLength)
+					{
+						valid = false;
+						return;
+					}
+					const uint32_t f = HalfEdgeMesh::Face(o);
+					if (f == skipFace1 || f == skipFace2) return;
+					const glm::vec3 nOld = faceNormal(o);
+					const glm::vec3 nNew = glm::cross(pb - p, pc - p);
+					if (glm::dot(nOld, nNew) <= 0.0f) valid = false;
+				});
+			return valid;
+		};
+
+	for (uint32_t iteration = 0; iteration < m_iterations; ++iteration)
+	{
+		// split long edges, longest first so the splits converge, until all are short enough
+		size_t splitCnt = 0;
+		std::vector<std::pair<float, uint32_t>> longEdges;
+		for (bool again = true; again;)
+		{
+			markCandidates([&](uint32_t h) { return edgeLength(h) > highLength; });
+			longEdges.clear();
+			for (uint32_t h = 0; h < candidate.size(); ++h)
+			{
+				if (candidate[h] != 0) longEdges.push_back(std::make_pair(-edgeLength(h), h));
+			}
+			std::sort(longEdges.begin(), longEdges.end());
+			again = !longEdges.empty();
+			for (const auto& e : longEdges)
+			{
+				const uint32_t h = e.second;
+				if (edgeLength(h) <= highLength) continue;
+				const glm::vec3 p = (hem.positions[hem.From(h)] + hem.positions[hem.To(h)]) * 0.5f;
+				hem.SplitEdge(h, p);
+				fixed.push_back(0);
+				splitCnt++;
+			}
+		}
+
+		// collapse short edges, if the result has no long edges
+		size_t collapseCnt = 0;
+		markCandidates([&](uint32_t h) { return edgeLength(h) < lowLength; });
+		for (uint32_t h = 0; h < candidate.size(); ++h)
+		{
+			if (candidate[h] == 0 || !hem.IsAlive(h)) continue;
+			if (edgeLength(h) >= lowLength) continue;
+			const uint32_t a = hem.From(h);
+			const uint32_t b = hem.To(h);
+
+			// `a` is removed topologically, but `b` can take over its position
+			glm::vec3 p;
+			uint8_t pFixed;
+			if (isRemovable(a, h))
+			{
+				p = hem.positions[b];
+				pFixed = fixed[b];
+			}
+			else if (isRemovable(b, h))
+			{
+				p = hem.positions[a];
+				pFixed = fixed[a];
+			}
+			else
+			{
+				continue;
+			}
+
+			if (!hem.CanCollapse(h)) continue;
+			const uint32_t f1 = HalfEdgeMesh::Face(h);
+			const uint32_t f2 = (hem.Twin(h) != HalfEdgeMesh::InvalidIndex) ? HalfEdgeMesh::Face(hem.Twin(h)) : HalfEdgeMesh::InvalidIndex;
+			if (!isMoveValid(a, p, f1, f2) || !isMoveValid(b, p, f1, f2)) continue;
+
+			hem.CollapseEdge(h, p);
+			fixed[b] = pFixed;
+			collapseCnt++;
+		}
+
+		// flip edges towards valence 6 of inner and 4 of border vertices
+		std::vector<int32_t> valenceError(hem.VertexSlots(), 0);
+		Tasks().ParallelFor(0, valenceError.size(), 0x1000, [&](size_t begin, size_t end)
+			{
+				for (size_t v = begin; v < end; ++v)
+				{
+					if (!hem.IsVertexAlive(static_cast<uint32_t>(v))) continue;
+					valenceError[v] = static_cast<int32_t>(hem.Valence(static_cast<uint32_t>(v)))
+						- (hem.IsBorderVertex(static_cast<uint32_t>(v)) ? 4 : 6);
+				}
+			});
+		// change of the squared valence error by flipping
+		auto flipGain = [&](uint32_t h)
+			{
+				const uint32_t a = hem.From(h);
+				const uint32_t b = hem.To(h);
+				const uint32_t c = hem.To(HalfEdgeMesh::Next(h));
+				const uint32_t d = hem.To(HalfEdgeMesh::Next(hem.Twin(h)));
+				const auto sq = [](int32_t e) { return e * e; };
+				const int32_t before = sq(valenceError[a]) + sq(valenceError[b]) + sq(valenceError[c]) + sq(valenceError[d]);
+				const int32_t after = sq(valenceError[a] - 1) + sq(valenceError[b] - 1) + sq(valenceError[c] + 1) + sq(valenceError[d] + 1);
+				return before - after;
+			};
+		size_t flipCnt = 0;
+		markCandidates([&](uint32_t h)
+			{
+				return hem.Twin(h) != HalfEdgeMesh::InvalidIndex && !hem.IsFeature(h) && flipGain(h) > 0;
+			});
+		for (uint32_t h = 0; h < candidate.size(); ++h)
+		{
+			if (candidate[h] == 0 || flipGain(h) <= 0 || !hem.CanFlip(h)) continue;
+			const uint32_t t = hem.Twin(h);
+			const uint32_t a = hem.From(h);
+			const uint32_t b = hem.To(h);
+			const uint32_t c = hem.To(HalfEdgeMesh::Next(h));
+			const uint32_t d = hem.To(HalfEdgeMesh::Next(t));
+			const glm::vec3 n = faceNormal(h) + faceNormal(t);
+			const glm::vec3& pa = hem.positions[a];
+			const glm::vec3& pb = hem.positions[b];
+			const glm::vec3& pc = hem.positions[c];
+			const glm::vec3& pd = hem.positions[d];
+			if (glm::dot(n, glm::cross(pc - pd, pa - pd)) <= 0.0f || glm::dot(n, glm::cross(pd - pc, pb - pc)) <= 0.0f) continue;
+
+			hem.FlipEdge(h);
+			valenceError[a]--;
+			valenceError[b]--;
+			valenceError[c]++;
+			valenceError[d]++;
+			flipCnt++;
+		}
+
+		// tangential relaxation of the non-feature vertices towards their neighbors' center, projected onto the input surface
+		std::vector<glm::vec3> next(hem.positions);
+		Tasks().ParallelFor(0, next.size(), 0x400, [&](size_t begin, size_t end)
+			{
+				for (size_t vi = begin; vi < end; ++vi)
+				{
+					const uint32_t v = static_cast<uint32_t>(vi);
+					if (!hem.IsVertexAlive(v) || fixed[v] != 0 || hem.FeatureValence(v) != 0) continue;
+
+					const glm::vec3& q = hem.positions[v];
+					glm::vec3 center{ 0.0f };
+					glm::vec3 normal{ 0.0f };
+					uint32_t cnt = 0;
+					hem.ForEachOutgoing(v, [&](uint32_t o)
+						{
+							center += hem.positions[hem.To(o)];
+							normal += faceNormal(o);
+							cnt++;
+						});
+					if (cnt == 0) continue;
+					center /= static_cast<float>(cnt);
+					const float nl = glm::length(normal);
+					if (nl > 0.0f) normal /= nl;
+
+					glm::vec3 p = center - normal * glm::dot(center - q, normal);
+					data::Bvh::PointHit hit;
+					if (bvh->ClosestPoint(p, std::numeric_limits<float>::max(), hit))
+					{
+						p = hit.point;
+					}
+					next[v] = p;
+				}
+			});
+		hem.positions.swap(next);
+
+		Log().Detail("Remesh iteration %d: %d splits, %d collapses, %d flips",
+			static_cast<int>(iteration), static_cast<int>(splitCnt), static_cast<int>(collapseCnt), static_cast<int>(flipCnt));
+	}
+
+	const size_t triCnt = m_mesh->triangles.size();
+	hem.ToMesh(*m_mesh);
+	Log().Detail("Remeshed %d triangles to %d at target edge length %f", static_cast<int>(triCnt), static_cast<int>(m_mesh->triangles.size()), targetLength);
+
+	return true;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <memory>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace edit
+		{
+			// inplace edit of mesh: isotropic remeshing towards a uniform edge length by edge splits, collapses and flips, and tangential relaxation
+			class Remesh : public AbstractCommand
+			{
+			public:
+				Remesh(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				std::shared_ptr<data::Mesh> m_mesh;
+				// mean edge length of the input mesh if not set
+				const float m_targetEdgeLength{ 0.0f };
+				const uint32_t m_iterations{ 5 };
+				// edges between triangles with normals differing by at least this angle, in degrees, are preserved, like open borders
+				const float m_featureAngle{ 30.0f };
+			};
+
+		}
+	}
+}
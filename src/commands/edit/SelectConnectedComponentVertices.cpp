@@ -2,6 +2,8 @@
 
 #include <SimpleLog/SimpleLog.hpp>
 
+#include <vector>
+
 using namespace meshproc;
 using namespace meshproc::commands;
 
@@ -9,7 +11,7 @@ edit::SelectConnectedComponentVertices::SelectConnectedComponentVertices(const s
 	: AbstractCommand{ log }
 {
 	AddParamBinding<ParamMode::In, ParamType::Mesh>("Mesh", m_mesh);
-	AddParamBinding<ParamMode::InOut, ParamType::IndexList>("Selection", m_selection);
+	AddParamBinding<ParamMode::InOut, ParamType::Selection>("Selection", m_selection);
 }
 
 bool edit::SelectConnectedComponentVertices::Invoke()
@@ -25,66 +27,60 @@ bool edit::SelectConnectedComponentVertices::Invoke()
 		return false;
 	}
 
-	std::unordered_set<uint32_t> sel;
-	sel.reserve(m_selection->size());
-	for (uint32_t i : *m_selection)
+	const size_t vertCnt = m_mesh->vertices.size();
+	const size_t triCnt = m_mesh->triangles.size();
+	// updated in place
+	data::Selection& sel = *m_selection;
+	sel.Resize(vertCnt);
+
+	// vertex -> triangles adjacency
+	std::vector<uint32_t> adjStart(vertCnt + 1, 0);
+	for (const data::Triangle& t : m_mesh->triangles)
 	{
-		sel.insert(i);
+		for (int i = 0; i < 3; ++i)
+		{
+			if (t[i] >= vertCnt)
+			{
+				Log().Error("Mesh is invalid; triangle references vertex %u beyond %u vertices", t[i], static_cast<uint32_t>(vertCnt));
+				return false;
+			}
+			adjStart[t[i] + 1]++;
+		}
 	}
-
-	std::unordered_set<uint32_t> tris;
-	tris.reserve(m_mesh->triangles.size());
-	for (size_t i = 0; i < m_mesh->triangles.size(); ++i)
+	for (size_t v = 0; v < vertCnt; ++v)
 	{
-		tris.insert(static_cast<uint32_t>(i));
+		adjStart[v + 1] += adjStart[v];
 	}
-
-	std::unordered_set<uint32_t> gt;
-	gt.reserve(tris.size() / 100);
-	bool grow = true;
-	while (grow)
+	std::vector<uint32_t> adj(adjStart.back());
 	{
-		grow = false;
-
-		for (uint32_t ti : tris)
+		std::vector<uint32_t> fill(adjStart.begin(), adjStart.end() - 1);
+		for (size_t ti = 0; ti < triCnt; ++ti)
 		{
-			const auto tr = m_mesh->triangles.at(ti);
-
-			const bool s0 = sel.contains(tr[0]);
-			const bool s1 = sel.contains(tr[1]);
-			const bool s2 = sel.contains(tr[2]);
-			if (s0 || s1 || s2)
+			for (int i = 0; i < 3; ++i)
 			{
-				gt.insert(ti);
-				if (!s0)
-				{
-					sel.insert(tr[0]);
-					grow = true;
-				}
-				if (!s1)
-				{
-					sel.insert(tr[1]);
-					grow = true;
-				}
-				if (!s2)
-				{
-					sel.insert(tr[2]);
-					grow = true;
-				}
+				adj[fill[m_mesh->triangles[ti][i]]++] = static_cast<uint32_t>(ti);
 			}
 		}
-		for (uint32_t ti : gt)
-		{
-			tris.erase(ti);
-		}
-		gt.clear();
 	}
 
-	m_selection->clear();
-	m_selection->reserve(sel.size());
-	for (uint32_t i : sel)
+	// flood fill from all selected vertices
+	std::vector<uint32_t> stack = sel.ToIndices();
+	while (!stack.empty())
 	{
-		m_selection->push_back(i);
+		const uint32_t v = stack.back();
+		stack.pop_back();
+		for (uint32_t a = adjStart[v]; a < adjStart[v + 1]; ++a)
+		{
+			const data::Triangle& t = m_mesh->triangles[adj[a]];
+			for (int i = 0; i < 3; ++i)
+			{
+				if (!sel.Get(t[i]))
+				{
+					sel.Set(t[i]);
+					stack.push_back(t[i]);
+				}
+			}
+		}
 	}
 
 	return true;
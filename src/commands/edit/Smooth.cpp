@@ -0,0 +1,213 @@
+#include "Smooth.h"
+
+#include "utilities/TaskScheduler.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <cwctype>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+using namespace meshproc::commands::edit;
+
+Smooth::Smooth(const sgrottel::ISimpleLog& log)
+	: AbstractCommand{ log }
+{
+	AddParamBinding<ParamMode::InOut, ParamType::Mesh>("Mesh", m_mesh);
+	AddParamBinding<ParamMode::In, ParamType::String>("Method", m_method);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("Iterations", m_iterations);
+	AddParamBinding<ParamMode::In, ParamType::Float>("Lambda", m_lambda);
+	AddParamBinding<ParamMode::In, ParamType::Float>("Mu", m_mu);
+	AddParamBinding<ParamMode::In, ParamType::Selection>("Selection", m_selection);
+	AddParamBinding<ParamMode::In, ParamType::FloatList>("Weights", m_weights);
+	AddParamBinding<ParamMode::In, ParamType::Bool>("LockBoundary", m_lockBoundary);
+}
+
+bool Smooth::Invoke()
+{
+	enum class Method
+	{
+		Laplacian,
+		Taubin,
+		Cotangent
+	};
+
+	if (!m_mesh)
+	{
+		Log().Error("Mesh is empty");
+		return false;
+	}
+
+	std::wstring methodName{ m_method };
+	std::transform(methodName.begin(), methodName.end(), methodName.begin(), [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+	Method method;
+	if (methodName == L"laplacian")
+	{
+		method = Method::Laplacian;
+	}
+	else if (methodName == L"taubin")
+	{
+		method = Method::Taubin;
+	}
+	else if (methodName == L"cotangent")
+	{
+		method = Method::Cotangent;
+	}
+	else
+	{
+		Log().Error(L"Method '%s' unknown; must be 'Laplacian', 'Taubin' or 'Cotangent'", m_method.c_str());
+		return false;
+	}
+
+	if (!m_mesh->IsValid())
+	{
+		Log().Error("Mesh is invalid");
+		return false;
+	}
+	const size_t vertCnt = m_mesh->vertices.size();
+	const size_t triCnt = m_mesh->triangles.size();
+	if (m_weights && m_weights->size() != vertCnt)
+	{
+		Log().Error("Weights size %d does not match vertex count %d", static_cast<int>(m_weights->size()), static_cast<int>(vertCnt));
+		return false;
+	}
+
+	// vertex -> triangles adjacency
+	std::vector<uint32_t> triStart(vertCnt + 1, 0);
+	for (const data::Triangle& t : m_mesh->triangles)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			triStart[t[i] + 1]++;
+		}
+	}
+	for (size_t v = 0; v < vertCnt; ++v)
+	{
+		triStart[v + 1] += triStart[v];
+	}
+	std::vector<uint32_t> tris(triStart.back());
+	{
+		std::vector<uint32_t> fill(triStart.begin(), triStart.end() - 1);
+		for (size_t ti = 0; ti < triCnt; ++ti)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				tris[fill[m_mesh->triangles[ti][i]]++] = static_cast<uint32_t>(ti);
+			}
+		}
+	}
+
+	// vertex -> vertex adjacency, and the factor of each vertex' step; 0 for fixed vertices
+	std::vector<uint32_t> neighborStart(vertCnt + 1, 0);
+	std::vector<uint32_t> neighborCnt(vertCnt, 0);
+	std::vector<uint32_t> neighbors(triStart.back() * 2);
+	std::vector<float> factor(vertCnt, 0.0f);
+	Tasks().ParallelFor(0, vertCnt, 0x1000, [&](size_t begin, size_t end)
+		{
+			for (size_t v = begin; v < end; ++v)
+			{
+				// each neighbor once per shared triangle, i.e. twice over inner edges and once over open border edges
+				uint32_t* const first = neighbors.data() + triStart[v] * 2;
+				uint32_t* last = first;
+				for (uint32_t a = triStart[v]; a < triStart[v + 1]; ++a)
+				{
+					const data::Triangle& t = m_mesh->triangles[tris[a]];
+					for (int i = 0; i < 3; ++i)
+					{
+						if (t[i] != v) *last++ = t[i];
+					}
+				}
+				std::sort(first, last);
+
+				bool border = false;
+				uint32_t* out = first;
+				for (uint32_t* n = first; n != last;)
+				{
+					uint32_t* m = n + 1;
+					while (m != last && *m == *n) ++m;
+					border = border || (m - n == 1);
+					*out++ = *n;
+					n = m;
+				}
+				neighborCnt[v] = static_cast<uint32_t>(out - first);
+
+				if (out == first) continue;
+				if (m_lockBoundary && border) continue;
+				if (m_selection && !m_selection->Get(v)) continue;
+				factor[v] = m_weights ? std::clamp(m_weights->at(v), 0.0f, 1.0f) : 1.0f;
+			}
+		});
+	// compact the rows
+	for (size_t v = 0; v < vertCnt; ++v)
+	{
+		const uint32_t src = triStart[v] * 2;
+		const uint32_t dst = neighborStart[v];
+		std::copy(neighbors.begin() + src, neighbors.begin() + src + neighborCnt[v], neighbors.begin() + dst);
+		neighborStart[v + 1] = dst + neighborCnt[v];
+	}
+	neighbors.resize(neighborStart.back());
+
+	std::vector<glm::vec3> next(m_mesh->vertices);
+
+	// one Jacobi step from `m_mesh->vertices` into `next`
+	auto step = [&](float lambda)
+		{
+			const std::vector<glm::vec3>& cur = m_mesh->vertices;
+			Tasks().ParallelFor(0, vertCnt, 0x1000, [&](size_t begin, size_t end)
+				{
+					for (size_t v = begin; v < end; ++v)
+					{
+						const glm::vec3 p = cur[v];
+						next[v] = p;
+						if (factor[v] == 0.0f) continue;
+
+						glm::vec3 sum{ 0.0f };
+						float weight = 0.0f;
+						if (method == Method::Cotangent)
+						{
+							// cot of the angles opposite each edge, clamped to zero against obtuse triangles
+							for (uint32_t a = triStart[v]; a < triStart[v + 1]; ++a)
+							{
+								const data::Triangle& t = m_mesh->triangles[tris[a]];
+								const int i = (t[0] == v) ? 0 : ((t[1] == v) ? 1 : 2);
+								const glm::vec3 pj = cur[t[(i + 1) % 3]];
+								const glm::vec3 pk = cur[t[(i + 2) % 3]];
+								const auto cot = [](const glm::vec3& e1, const glm::vec3& e2)
+									{
+										const float s = glm::length(glm::cross(e1, e2));
+										return (s > 0.0f) ? std::max(glm::dot(e1, e2) / s, 0.0f) : 0.0f;
+									};
+								const float wj = cot(p - pk, pj - pk);
+								const float wk = cot(p - pj, pk - pj);
+								sum += wj * (pj - p) + wk * (pk - p);
+								weight += wj + wk;
+							}
+						}
+						else
+						{
+							for (uint32_t a = neighborStart[v]; a < neighborStart[v + 1]; ++a)
+							{
+								sum += cur[neighbors[a]] - p;
+							}
+							weight = static_cast<float>(neighborStart[v + 1] - neighborStart[v]);
+						}
+						if (weight <= 0.0f) continue;
+
+						next[v] = p + (factor[v] * lambda / weight) * sum;
+					}
+				});
+			m_mesh->vertices.swap(next);
+		};
+
+	for (uint32_t it = 0; it < m_iterations; ++it)
+	{
+		step(m_lambda);
+		if (method == Method::Taubin)
+		{
+			step(m_mu);
+		}
+	}
+
+	return true;
+}
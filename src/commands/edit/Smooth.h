@@ -0,0 +1,42 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+#include "data/Selection.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace edit
+		{
+			// inplace edit of mesh: moves vertices towards the weighted average of their neighbors
+			class Smooth : public AbstractCommand
+			{
+			public:
+				Smooth(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				std::shared_ptr<data::Mesh> m_mesh;
+				// 'Laplacian', 'Taubin' or 'Cotangent'
+				const std::wstring m_method{ L"Laplacian" };
+				const uint32_t m_iterations{ 10 };
+				const float m_lambda{ 0.5f };
+				// shrink compensating step of 'Taubin', negative and of larger magnitude than Lambda
+				const float m_mu{ -0.53f };
+				// only the selected vertices are moved; all if not set
+				const std::shared_ptr<data::Selection> m_selection;
+				// per-vertex factor of the step, clamped to [0..1], e.g. for a falloff
+				const std::shared_ptr<std::vector<float>> m_weights;
+				const bool m_lockBoundary{ true };
+			};
+
+		}
+	}
+}
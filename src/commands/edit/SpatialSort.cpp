@@ -0,0 +1,118 @@
+#include "SpatialSort.h"
+
+#include "utilities/SpatialSort.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <cwctype>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+using namespace meshproc::commands::edit;
+
+namespace
+{
+
+	template<typename T>
+	void ApplyRemap(std::vector<T>& values, const std::vector<uint32_t>& remap)
+	{
+		std::vector<T> sorted(values.size());
+		for (size_t i = 0; i < remap.size(); ++i)
+		{
+			sorted[remap[i]] = values[i];
+		}
+		values.swap(sorted);
+	}
+
+}
+
+SpatialSort::SpatialSort(const sgrottel::ISimpleLog& log)
+	: AbstractCommand{ log }
+{
+	AddParamBinding<ParamMode::InOut, ParamType::Mesh>("Mesh", m_mesh);
+	AddParamBinding<ParamMode::In, ParamType::String>("Curve", m_curve);
+	AddParamBinding<ParamMode::InOut, ParamType::FloatList>("Scalars", m_scalars);
+	AddParamBinding<ParamMode::InOut, ParamType::Vec3List>("Vectors", m_vectors);
+	AddParamBinding<ParamMode::InOut, ParamType::IndexList>("Selection", m_selection);
+	AddParamBinding<ParamMode::Out, ParamType::IndexList>("Remap", m_remap);
+}
+
+bool SpatialSort::Invoke()
+{
+	using Sorter = utilities::SpatialSort;
+
+	if (!m_mesh)
+	{
+		Log().Error("Mesh is empty");
+		return false;
+	}
+
+	std::wstring curveName{ m_curve };
+	std::transform(curveName.begin(), curveName.end(), curveName.begin(), [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+	Sorter::Curve curve;
+	if (curveName == L"morton")
+	{
+		curve = Sorter::Curve::Morton;
+	}
+	else if (curveName == L"hilbert")
+	{
+		curve = Sorter::Curve::Hilbert;
+	}
+	else
+	{
+		Log().Error(L"Curve '%s' unknown; must be 'Morton' or 'Hilbert'", m_curve.c_str());
+		return false;
+	}
+
+	const size_t vertCnt = m_mesh->vertices.size();
+	if (m_scalars && m_scalars->size() != vertCnt)
+	{
+		Log().Error("Scalars size %d does not match vertex count %d", static_cast<int>(m_scalars->size()), static_cast<int>(vertCnt));
+		return false;
+	}
+	if (m_vectors && m_vectors->size() != vertCnt)
+	{
+		Log().Error("Vectors size %d does not match vertex count %d", static_cast<int>(m_vectors->size()), static_cast<int>(vertCnt));
+		return false;
+	}
+	if (m_selection)
+	{
+		for (uint32_t i : *m_selection)
+		{
+			if (i >= vertCnt)
+			{
+				Log().Error("Selection references invalid vertex index %d", static_cast<int>(i));
+				return false;
+			}
+		}
+	}
+	for (const auto& t : m_mesh->triangles)
+	{
+		if (t[0] >= vertCnt || t[1] >= vertCnt || t[2] >= vertCnt)
+		{
+			Log().Error("Mesh triangle references invalid vertex index");
+			return false;
+		}
+	}
+
+	m_remap = std::make_shared<std::vector<uint32_t>>(Sorter::SortMesh(*m_mesh, curve));
+
+	if (m_scalars)
+	{
+		ApplyRemap(*m_scalars, *m_remap);
+	}
+	if (m_vectors)
+	{
+		ApplyRemap(*m_vectors, *m_remap);
+	}
+	if (m_selection)
+	{
+		for (uint32_t& i : *m_selection)
+		{
+			i = m_remap->at(i);
+		}
+	}
+
+	return true;
+}
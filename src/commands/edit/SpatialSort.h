@@ -0,0 +1,37 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace edit
+		{
+			// inplace edit of mesh: reorders vertices and triangles along a Morton or Hilbert curve
+			class SpatialSort : public AbstractCommand
+			{
+			public:
+				SpatialSort(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				std::shared_ptr<data::Mesh> m_mesh;
+				const std::wstring m_curve{ L"Morton" };
+				std::shared_ptr<std::vector<float>> m_scalars;
+				std::shared_ptr<std::vector<glm::vec3>> m_vectors;
+				std::shared_ptr<std::vector<uint32_t>> m_selection;
+				std::shared_ptr<std::vector<uint32_t>> m_remap;
+			};
+
+		}
+	}
+}
@@ -0,0 +1,97 @@
+#include "ComponentSoup.h"
+
+#include "Torus.h"
+#include "utilities/TaskScheduler.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+
+namespace
+{
+	struct Placement
+	{
+		glm::vec3 center;
+		glm::vec3 axisX;
+		glm::vec3 axisY;
+		glm::vec3 axisZ;
+	};
+}
+
+generator::ComponentSoup::ComponentSoup(const sgrottel::ISimpleLog& log)
+	: AbstractCommand(log)
+{
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("NumComponents", m_componentCnt);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("NumSegmentsMajor", m_segCntMajor);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("NumSegmentsMinor", m_segCntMinor);
+	AddParamBinding<ParamMode::In, ParamType::Float>("Extent", m_extent);
+	AddParamBinding<ParamMode::In, ParamType::Float>("MinScale", m_minScale);
+	AddParamBinding<ParamMode::In, ParamType::Float>("MaxScale", m_maxScale);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("Seed", m_seed);
+	AddParamBinding<ParamMode::Out, ParamType::Mesh>("Mesh", m_mesh);
+}
+
+bool generator::ComponentSoup::Invoke()
+{
+	const uint32_t cntMajor = (std::max)(3u, m_segCntMajor);
+	const uint32_t cntMinor = (std::max)(3u, m_segCntMinor);
+	const size_t compVertCnt = static_cast<size_t>(cntMajor) * cntMinor;
+	const size_t vertCnt = compVertCnt * m_componentCnt;
+	if (vertCnt > std::numeric_limits<uint32_t>::max())
+	{
+		Log().Error("Too many components or segments: %llu vertices exceed the index range", static_cast<unsigned long long>(vertCnt));
+		return false;
+	}
+
+	// placements are drawn sequentially, so the result does not depend on the number of threads
+	std::mt19937 gen(m_seed);
+	std::uniform_real_distribution<float> sym(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> scale((std::min)(m_minScale, m_maxScale), (std::max)(m_minScale, m_maxScale));
+	std::uniform_real_distribution<float> angle(0.0f, 2.0f * std::numbers::pi_v<float>);
+
+	std::vector<Placement> placements(m_componentCnt);
+	for (Placement& p : placements)
+	{
+		p.center = glm::vec3{ sym(gen), sym(gen), sym(gen) } * (0.5f * m_extent);
+
+		glm::vec3 z{ sym(gen), sym(gen), sym(gen) };
+		if (glm::dot(z, z) < 1e-6f) z = glm::vec3{ 0.0f, 0.0f, 1.0f };
+		z = glm::normalize(z);
+		const glm::vec3 helper = (std::abs(z.x) < 0.9f) ? glm::vec3{ 1.0f, 0.0f, 0.0f } : glm::vec3{ 0.0f, 1.0f, 0.0f };
+		const glm::vec3 u = glm::normalize(glm::cross(helper, z));
+		const glm::vec3 v = glm::cross(z, u);
+		const float a = angle(gen);
+		const float s = scale(gen);
+
+		p.axisX = (u * std::cos(a) + v * std::sin(a)) * s;
+		p.axisY = (v * std::cos(a) - u * std::sin(a)) * s;
+		p.axisZ = z * s;
+	}
+
+	std::shared_ptr<data::Mesh> m = std::make_shared<data::Mesh>();
+	m->vertices.resize(vertCnt);
+	m->triangles.resize(vertCnt * 2);
+
+	Tasks().ParallelFor(0, m_componentCnt, (std::max<size_t>)(1, 0x10000 / compVertCnt), [&](size_t begin, size_t end)
+		{
+			for (size_t c = begin; c < end; ++c)
+			{
+				const Placement& p = placements[c];
+				for (uint32_t ring = 0; ring < cntMajor; ++ring)
+				{
+					Torus::FillRing(*m, c * compVertCnt, c * compVertCnt * 2, ring, cntMajor, cntMinor, 1.0f, 0.3f,
+						p.center, p.axisX, p.axisY, p.axisZ);
+				}
+			}
+		});
+
+	m_mesh = m;
+	return true;
+}
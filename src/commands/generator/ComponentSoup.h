@@ -0,0 +1,37 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <memory>
+#include <random>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace generator
+		{
+
+			// many closed tori, randomly placed, oriented and scaled, possibly intersecting each other
+			class ComponentSoup : public AbstractCommand
+			{
+			public:
+				ComponentSoup(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				const uint32_t m_componentCnt{ 100 };
+				const uint32_t m_segCntMajor{ 16 };
+				const uint32_t m_segCntMinor{ 8 };
+				const float m_extent{ 10.0f };
+				const float m_minScale{ 0.2f };
+				const float m_maxScale{ 1.0f };
+				const uint32_t m_seed{ std::random_device{}() };
+				std::shared_ptr<data::Mesh> m_mesh;
+			};
+
+		}
+	}
+}
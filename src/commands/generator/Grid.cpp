@@ -0,0 +1,65 @@
+#include "Grid.h"
+
+#include "utilities/TaskScheduler.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <limits>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+
+generator::Grid::Grid(const sgrottel::ISimpleLog& log)
+	: AbstractCommand(log)
+{
+	AddParamBinding<ParamMode::In, ParamType::Float>("SizeX", m_sizeX);
+	AddParamBinding<ParamMode::In, ParamType::Float>("SizeY", m_sizeY);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("NumSegmentsX", m_segCntX);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("NumSegmentsY", m_segCntY);
+	AddParamBinding<ParamMode::Out, ParamType::Mesh>("Mesh", m_mesh);
+}
+
+bool generator::Grid::Invoke()
+{
+	const uint32_t cntX = (std::max)(1u, m_segCntX);
+	const uint32_t cntY = (std::max)(1u, m_segCntY);
+	const size_t rowLen = static_cast<size_t>(cntX) + 1;
+	const size_t vertCnt = rowLen * (static_cast<size_t>(cntY) + 1);
+	if (vertCnt > std::numeric_limits<uint32_t>::max())
+	{
+		Log().Error("Too many segments: %llu vertices exceed the index range", static_cast<unsigned long long>(vertCnt));
+		return false;
+	}
+
+	std::shared_ptr<data::Mesh> m = std::make_shared<data::Mesh>();
+	m->vertices.resize(vertCnt);
+	m->triangles.resize(static_cast<size_t>(cntX) * cntY * 2);
+
+	// one row of vertices, and the row of quads above it, per work item
+	Tasks().ParallelFor(0, static_cast<size_t>(cntY) + 1, (std::max<size_t>)(1, 0x10000 / rowLen), [&](size_t begin, size_t end)
+		{
+			for (size_t y = begin; y < end; ++y)
+			{
+				const float fy = m_sizeY * static_cast<float>(y) / static_cast<float>(cntY);
+				glm::vec3* vert = m->vertices.data() + y * rowLen;
+				for (uint32_t x = 0; x <= cntX; ++x)
+				{
+					vert[x] = glm::vec3{ m_sizeX * static_cast<float>(x) / static_cast<float>(cntX), fy, 0.0f };
+				}
+
+				if (y == cntY) continue;
+				const uint32_t r0 = static_cast<uint32_t>(y * rowLen);
+				const uint32_t r1 = static_cast<uint32_t>(r0 + rowLen);
+				data::Triangle* tri = m->triangles.data() + y * cntX * 2;
+				for (uint32_t x = 0; x < cntX; ++x)
+				{
+					tri[x * 2 + 0] = data::Triangle{ r0 + x, r0 + x + 1, r1 + x + 1 };
+					tri[x * 2 + 1] = data::Triangle{ r0 + x, r1 + x + 1, r1 + x };
+				}
+			}
+		});
+
+	m_mesh = m;
+	return true;
+}
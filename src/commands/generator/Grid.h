@@ -0,0 +1,33 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <memory>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace generator
+		{
+
+			// open, flat quad grid in the xy plane, facing +z
+			class Grid : public AbstractCommand
+			{
+			public:
+				Grid(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				const float m_sizeX{ 1.0f };
+				const float m_sizeY{ 1.0f };
+				const uint32_t m_segCntX{ 1 };
+				const uint32_t m_segCntY{ 1 };
+				std::shared_ptr<data::Mesh> m_mesh;
+			};
+
+		}
+	}
+}
@@ -0,0 +1,221 @@
+#include "NoisyPatch.h"
+
+#include "utilities/TaskScheduler.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+
+namespace
+{
+	struct Wave
+	{
+		glm::vec2 dir;
+		float phase;
+		float weight;
+	};
+
+	struct Hole
+	{
+		glm::vec2 center;
+		float radiusSq;
+	};
+
+	// exclusive prefix sum in place, returns the total
+	size_t PrefixSum(std::vector<size_t>& counts)
+	{
+		size_t sum = 0;
+		for (size_t& c : counts)
+		{
+			const size_t n = c;
+			c = sum;
+			sum += n;
+		}
+		return sum;
+	}
+}
+
+generator::NoisyPatch::NoisyPatch(const sgrottel::ISimpleLog& log)
+	: AbstractCommand(log)
+{
+	AddParamBinding<ParamMode::In, ParamType::Float>("Size", m_size);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("NumSegments", m_segCnt);
+	AddParamBinding<ParamMode::In, ParamType::Float>("Amplitude", m_amplitude);
+	AddParamBinding<ParamMode::In, ParamType::Float>("Roughness", m_roughness);
+	AddParamBinding<ParamMode::In, ParamType::Float>("Jitter", m_jitter);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("NumHoles", m_holeCnt);
+	AddParamBinding<ParamMode::In, ParamType::Float>("HoleRadius", m_holeRadius);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("Seed", m_seed);
+	AddParamBinding<ParamMode::Out, ParamType::Mesh>("Mesh", m_mesh);
+}
+
+bool generator::NoisyPatch::Invoke()
+{
+	constexpr float twoPi = 2.0f * std::numbers::pi_v<float>;
+	const uint32_t cnt = (std::max)(1u, m_segCnt);
+	const size_t rowLen = static_cast<size_t>(cnt) + 1;
+	const size_t gridVertCnt = rowLen * rowLen;
+	if (gridVertCnt > std::numeric_limits<uint32_t>::max())
+	{
+		Log().Error("Too many segments: %llu vertices exceed the index range", static_cast<unsigned long long>(gridVertCnt));
+		return false;
+	}
+
+	// global shape parameters are drawn sequentially, everything per vertex is seeded per row,
+	// so the result does not depend on the number of threads
+	std::mt19937 gen(m_seed);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	std::vector<Wave> waves(4);
+	for (size_t i = 0; i < waves.size(); ++i)
+	{
+		const float angle = twoPi * unit(gen);
+		const float freq = twoPi * (1.0f + 3.0f * unit(gen)) / m_size;
+		waves[i] = Wave{ glm::vec2{ std::cos(angle), std::sin(angle) } * freq, twoPi * unit(gen), 1.0f / static_cast<float>(i + 1) };
+	}
+	std::vector<Hole> holes(m_holeCnt);
+	for (Hole& h : holes)
+	{
+		h.center = glm::vec2{ unit(gen), unit(gen) } * m_size;
+		h.radiusSq = m_holeRadius * m_holeRadius;
+	}
+
+	const float cellSize = m_size / static_cast<float>(cnt);
+	const size_t grain = (std::max<size_t>)(1, 0x10000 / rowLen);
+
+	// 1. sample all grid vertices and mark those inside of holes
+	std::vector<glm::vec3> pos(gridVertCnt);
+	std::vector<uint8_t> keep(gridVertCnt);
+	Tasks().ParallelFor(0, rowLen, grain, [&](size_t begin, size_t end)
+		{
+			for (size_t y = begin; y < end; ++y)
+			{
+				std::seed_seq seq{ m_seed, static_cast<uint32_t>(y) };
+				std::mt19937 rowGen(seq);
+				std::uniform_real_distribution<float> sym(-1.0f, 1.0f);
+
+				for (size_t x = 0; x < rowLen; ++x)
+				{
+					glm::vec2 p{ static_cast<float>(x), static_cast<float>(y) };
+					p.x += 0.5f * m_jitter * sym(rowGen);
+					p.y += 0.5f * m_jitter * sym(rowGen);
+					p.x = std::clamp(p.x * cellSize, 0.0f, m_size);
+					p.y = std::clamp(p.y * cellSize, 0.0f, m_size);
+
+					float h = m_roughness * sym(rowGen);
+					for (const Wave& w : waves)
+					{
+						h += m_amplitude * w.weight * std::sin(glm::dot(w.dir, p) + w.phase);
+					}
+
+					bool inHole = false;
+					for (const Hole& hole : holes)
+					{
+						const glm::vec2 d = p - hole.center;
+						if (glm::dot(d, d) < hole.radiusSq)
+						{
+							inHole = true;
+							break;
+						}
+					}
+
+					const size_t i = y * rowLen + x;
+					pos[i] = glm::vec3{ p.x, p.y, h };
+					keep[i] = inHole ? 0 : 1;
+				}
+			}
+		});
+
+	// a triangle survives if none of its corners is inside a hole
+	auto triKept = [&](size_t x, size_t y, int t)
+		{
+			const size_t i = y * rowLen + x;
+			return keep[i] && keep[i + rowLen + 1] && keep[(t == 0) ? (i + 1) : (i + rowLen)];
+		};
+
+	// 2. find vertices still referenced by surviving triangles
+	std::vector<uint8_t> used(gridVertCnt);
+	std::vector<size_t> rowVertOffset(rowLen);
+	Tasks().ParallelFor(0, rowLen, grain, [&](size_t begin, size_t end)
+		{
+			for (size_t y = begin; y < end; ++y)
+			{
+				size_t cntUsed = 0;
+				for (size_t x = 0; x < rowLen; ++x)
+				{
+					const bool u = (x < cnt && y < cnt && (triKept(x, y, 0) || triKept(x, y, 1)))
+						|| (x > 0 && y < cnt && triKept(x - 1, y, 0))
+						|| (x > 0 && y > 0 && (triKept(x - 1, y - 1, 0) || triKept(x - 1, y - 1, 1)))
+						|| (x < cnt && y > 0 && triKept(x, y - 1, 1));
+					used[y * rowLen + x] = u ? 1 : 0;
+					if (u) cntUsed++;
+				}
+				rowVertOffset[y] = cntUsed;
+			}
+		});
+	const size_t vertCnt = PrefixSum(rowVertOffset);
+
+	// 3. compact the used vertices, and count the triangles surviving per row of quads
+	std::shared_ptr<data::Mesh> m = std::make_shared<data::Mesh>();
+	m->vertices.resize(vertCnt);
+	std::vector<uint32_t> remap(gridVertCnt);
+	std::vector<size_t> rowTriOffset(cnt);
+	Tasks().ParallelFor(0, rowLen, grain, [&](size_t begin, size_t end)
+		{
+			for (size_t y = begin; y < end; ++y)
+			{
+				uint32_t next = static_cast<uint32_t>(rowVertOffset[y]);
+				for (size_t i = y * rowLen; i < (y + 1) * rowLen; ++i)
+				{
+					if (used[i])
+					{
+						m->vertices[next] = pos[i];
+						remap[i] = next++;
+					}
+				}
+
+				if (y == cnt) continue;
+				size_t tris = 0;
+				for (size_t x = 0; x < cnt; ++x)
+				{
+					if (triKept(x, y, 0)) tris++;
+					if (triKept(x, y, 1)) tris++;
+				}
+				rowTriOffset[y] = tris;
+			}
+		});
+	m->triangles.resize(PrefixSum(rowTriOffset));
+	pos.clear();
+	pos.shrink_to_fit();
+
+	// 4. write the triangles
+	Tasks().ParallelFor(0, cnt, grain, [&](size_t begin, size_t end)
+		{
+			for (size_t y = begin; y < end; ++y)
+			{
+				data::Triangle* tri = m->triangles.data() + rowTriOffset[y];
+				for (size_t x = 0; x < cnt; ++x)
+				{
+					const size_t i = y * rowLen + x;
+					if (triKept(x, y, 0))
+					{
+						*tri++ = data::Triangle{ remap[i], remap[i + 1], remap[i + rowLen + 1] };
+					}
+					if (triKept(x, y, 1))
+					{
+						*tri++ = data::Triangle{ remap[i], remap[i + rowLen + 1], remap[i + rowLen] };
+					}
+				}
+			}
+		});
+
+	m_mesh = m;
+	return true;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <memory>
+#include <random>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace generator
+		{
+
+			// open height field patch resembling a scanned surface: irregular sampling, undulation, noise and holes
+			class NoisyPatch : public AbstractCommand
+			{
+			public:
+				NoisyPatch(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				const float m_size{ 1.0f };
+				const uint32_t m_segCnt{ 256 };
+				const float m_amplitude{ 0.05f };
+				const float m_roughness{ 0.002f };
+				const float m_jitter{ 0.25f };
+				const uint32_t m_holeCnt{ 8 };
+				const float m_holeRadius{ 0.05f };
+				const uint32_t m_seed{ std::random_device{}() };
+				std::shared_ptr<data::Mesh> m_mesh;
+			};
+
+		}
+	}
+}
@@ -0,0 +1,79 @@
+#include "NonManifold.h"
+
+#include "utilities/TaskScheduler.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+
+generator::NonManifold::NonManifold(const sgrottel::ISimpleLog& log)
+	: AbstractCommand(log)
+{
+	AddParamBinding<ParamMode::In, ParamType::Float>("Size", m_size);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("NumSheets", m_sheetCnt);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("NumSegments", m_segCnt);
+	AddParamBinding<ParamMode::Out, ParamType::Mesh>("Mesh", m_mesh);
+}
+
+bool generator::NonManifold::Invoke()
+{
+	if (m_sheetCnt < 3)
+	{
+		Log().Error("NumSheets must be at least 3 to form non-manifold edges");
+		return false;
+	}
+	const uint32_t cnt = (std::max)(1u, m_segCnt);
+	const size_t rowLen = static_cast<size_t>(cnt) + 1;
+	const size_t rowCnt = static_cast<size_t>(m_sheetCnt) * cnt;
+	const size_t vertCnt = rowLen * (rowCnt + 1);
+	if (vertCnt > std::numeric_limits<uint32_t>::max())
+	{
+		Log().Error("Too many sheets or segments: %llu vertices exceed the index range", static_cast<unsigned long long>(vertCnt));
+		return false;
+	}
+
+	std::shared_ptr<data::Mesh> m = std::make_shared<data::Mesh>();
+	m->vertices.resize(vertCnt);
+	m->triangles.resize(rowCnt * cnt * 2);
+
+	// the spine is the first row of vertices, followed by all rows of sheet 0, then sheet 1, ...
+	for (uint32_t x = 0; x <= cnt; ++x)
+	{
+		m->vertices[x] = glm::vec3{ m_size * static_cast<float>(x) / static_cast<float>(cnt), 0.0f, 0.0f };
+	}
+
+	Tasks().ParallelFor(0, rowCnt, (std::max<size_t>)(1, 0x10000 / rowLen), [&](size_t begin, size_t end)
+		{
+			for (size_t row = begin; row < end; ++row)
+			{
+				const size_t sheet = row / cnt;
+				const size_t r = row % cnt + 1;
+				const float a = 2.0f * std::numbers::pi_v<float> * static_cast<float>(sheet) / static_cast<float>(m_sheetCnt);
+				const glm::vec3 dir = glm::vec3{ 0.0f, std::cos(a), std::sin(a) } * (m_size * static_cast<float>(r) / static_cast<float>(cnt));
+
+				const size_t v1 = (row + 1) * rowLen;
+				for (uint32_t x = 0; x <= cnt; ++x)
+				{
+					m->vertices[v1 + x] = m->vertices[x] + dir;
+				}
+
+				const uint32_t r0 = static_cast<uint32_t>((r == 1) ? 0 : (v1 - rowLen));
+				const uint32_t r1 = static_cast<uint32_t>(v1);
+				data::Triangle* tri = m->triangles.data() + row * cnt * 2;
+				for (uint32_t x = 0; x < cnt; ++x)
+				{
+					tri[x * 2 + 0] = data::Triangle{ r0 + x, r0 + x + 1, r1 + x + 1 };
+					tri[x * 2 + 1] = data::Triangle{ r0 + x, r1 + x + 1, r1 + x };
+				}
+			}
+		});
+
+	m_mesh = m;
+	return true;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <memory>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace generator
+		{
+
+			// open sheets fanning out from one shared spine along the x axis,
+			// so that every spine edge is used by one triangle per sheet
+			class NonManifold : public AbstractCommand
+			{
+			public:
+				NonManifold(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				const float m_size{ 1.0f };
+				const uint32_t m_sheetCnt{ 3 };
+				const uint32_t m_segCnt{ 16 };
+				std::shared_ptr<data::Mesh> m_mesh;
+			};
+
+		}
+	}
+}
@@ -0,0 +1,86 @@
+#include "Torus.h"
+
+#include "utilities/TaskScheduler.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+
+generator::Torus::Torus(const sgrottel::ISimpleLog& log)
+	: AbstractCommand(log)
+{
+	AddParamBinding<ParamMode::In, ParamType::Float>("MajorRadius", m_majorRadius);
+	AddParamBinding<ParamMode::In, ParamType::Float>("MinorRadius", m_minorRadius);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("NumSegmentsMajor", m_segCntMajor);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("NumSegmentsMinor", m_segCntMinor);
+	AddParamBinding<ParamMode::Out, ParamType::Mesh>("Mesh", m_mesh);
+}
+
+bool generator::Torus::Invoke()
+{
+	const uint32_t cntMajor = (std::max)(3u, m_segCntMajor);
+	const uint32_t cntMinor = (std::max)(3u, m_segCntMinor);
+	const size_t vertCnt = static_cast<size_t>(cntMajor) * cntMinor;
+	if (vertCnt > std::numeric_limits<uint32_t>::max())
+	{
+		Log().Error("Too many segments: %llu vertices exceed the index range", static_cast<unsigned long long>(vertCnt));
+		return false;
+	}
+
+	std::shared_ptr<data::Mesh> m = std::make_shared<data::Mesh>();
+	m->vertices.resize(vertCnt);
+	m->triangles.resize(vertCnt * 2);
+
+	Tasks().ParallelFor(0, cntMajor, (std::max<size_t>)(1, 0x10000 / cntMinor), [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				FillRing(*m, 0, 0, static_cast<uint32_t>(i), cntMajor, cntMinor, m_majorRadius, m_minorRadius);
+			}
+		});
+
+	m_mesh = m;
+	return true;
+}
+
+void generator::Torus::FillRing(
+	data::Mesh& mesh,
+	size_t vertexOffset,
+	size_t triangleOffset,
+	uint32_t ring,
+	uint32_t segMajor,
+	uint32_t segMinor,
+	float majorRadius,
+	float minorRadius,
+	const glm::vec3& center,
+	const glm::vec3& axisX,
+	const glm::vec3& axisY,
+	const glm::vec3& axisZ)
+{
+	constexpr float twoPi = 2.0f * std::numbers::pi_v<float>;
+	const float phi = twoPi * static_cast<float>(ring) / static_cast<float>(segMajor);
+	const glm::vec3 dir = axisX * std::cos(phi) + axisY * std::sin(phi);
+
+	const uint32_t v0 = static_cast<uint32_t>(vertexOffset) + ring * segMinor;
+	const uint32_t v1 = static_cast<uint32_t>(vertexOffset) + ((ring + 1) % segMajor) * segMinor;
+	glm::vec3* vert = mesh.vertices.data() + v0;
+	data::Triangle* tri = mesh.triangles.data() + triangleOffset + static_cast<size_t>(ring) * segMinor * 2;
+
+	for (uint32_t j = 0; j < segMinor; ++j)
+	{
+		const float theta = twoPi * static_cast<float>(j) / static_cast<float>(segMinor);
+		vert[j] = center
+			+ dir * (majorRadius + minorRadius * std::cos(theta))
+			+ axisZ * (minorRadius * std::sin(theta));
+
+		const uint32_t jn = (j + 1) % segMinor;
+		tri[j * 2 + 0] = data::Triangle{ v0 + j, v1 + j, v1 + jn };
+		tri[j * 2 + 1] = data::Triangle{ v0 + j, v1 + jn, v0 + jn };
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <glm/glm.hpp>
+
+#include <memory>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace generator
+		{
+
+			// closed torus around the z axis, tessellated with a regular quad grid
+			class Torus : public AbstractCommand
+			{
+			public:
+				Torus(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+				// Writes the vertices and triangles of major ring `ring` into preallocated arrays.
+				// The torus uses `segMajor * segMinor` vertices from `vertexOffset` on,
+				// and `segMajor * segMinor * 2` triangles from `triangleOffset` on.
+				// The axes transform the local torus coordinates, and may include scaling.
+				static void FillRing(
+					data::Mesh& mesh,
+					size_t vertexOffset,
+					size_t triangleOffset,
+					uint32_t ring,
+					uint32_t segMajor,
+					uint32_t segMinor,
+					float majorRadius,
+					float minorRadius,
+					const glm::vec3& center = glm::vec3{ 0.0f },
+					const glm::vec3& axisX = glm::vec3{ 1.0f, 0.0f, 0.0f },
+					const glm::vec3& axisY = glm::vec3{ 0.0f, 1.0f, 0.0f },
+					const glm::vec3& axisZ = glm::vec3{ 0.0f, 0.0f, 1.0f });
+
+			private:
+				const float m_majorRadius{ 1.0f };
+				const float m_minorRadius{ 0.25f };
+				const uint32_t m_segCntMajor{ 64 };
+				const uint32_t m_segCntMinor{ 32 };
+				std::shared_ptr<data::Mesh> m_mesh;
+			};
+
+		}
+	}
+}
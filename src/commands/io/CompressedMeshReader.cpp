@@ -0,0 +1,68 @@
+#include "CompressedMeshReader.h"
+
+#include "utilities/CompressedMeshCodec.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <cstdio>
+#include <vector>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+using namespace meshproc::commands::io;
+
+CompressedMeshReader::CompressedMeshReader(const sgrottel::ISimpleLog& log)
+	: AbstractCommand{ log }
+{
+	AddParamBinding<ParamMode::In, ParamType::String>("Path", m_path);
+	AddParamBinding<ParamMode::Out, ParamType::Mesh>("Mesh", m_mesh);
+}
+
+bool CompressedMeshReader::Invoke()
+{
+	FILE* file = nullptr;
+	errno_t r = _wfopen_s(&file, m_path.c_str(), L"rb");
+	if (r != 0) {
+		Log().Error(L"Failed to open \"%s\": %d", m_path.c_str(), static_cast<int>(r));
+		return false;
+	}
+	if (file == nullptr) {
+		Log().Error(L"Failed to open \"%s\": returned nullptr", m_path.c_str());
+		return false;
+	}
+
+	Log().Message(L"Reading compressed mesh: %s", m_path.c_str());
+
+	std::vector<uint8_t> data;
+	_fseeki64(file, 0, SEEK_END);
+	const int64_t size = _ftelli64(file);
+	_fseeki64(file, 0, SEEK_SET);
+	if (size < 0)
+	{
+		Log().Error(L"Failed to determine file size");
+		fclose(file);
+		return false;
+	}
+	data.resize(static_cast<size_t>(size));
+	const bool read = fread(data.data(), 1, data.size(), file) == data.size();
+	fclose(file);
+	if (!read)
+	{
+		Log().Error(L"Failed to read file data");
+		return false;
+	}
+
+	auto mesh = std::make_shared<data::Mesh>();
+	if (!utilities::CompressedMeshCodec::Decode(data.data(), data.size(), *mesh, Log()))
+	{
+		return false;
+	}
+
+	if (!mesh->IsValid())
+	{
+		Log().Error("Loaded mesh is not valid");
+	}
+
+	m_mesh = mesh;
+	return true;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <memory>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace io
+		{
+
+			class CompressedMeshReader : public AbstractCommand
+			{
+			public:
+				CompressedMeshReader(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				const std::wstring m_path{};
+				std::shared_ptr<data::Mesh> m_mesh{};
+			};
+
+		}
+	}
+}
@@ -0,0 +1,84 @@
+#include "CompressedMeshWriter.h"
+
+#include "utilities/CompressedMeshCodec.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <cstdio>
+#include <vector>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+using namespace meshproc::commands::io;
+
+CompressedMeshWriter::CompressedMeshWriter(const sgrottel::ISimpleLog& log)
+	: AbstractCommand{ log }
+{
+	AddParamBinding<ParamMode::In, ParamType::String>("Path", m_path);
+	AddParamBinding<ParamMode::In, ParamType::Scene>("Scene", m_scene);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("Bits", m_bits);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("BlockSize", m_blockSize);
+}
+
+bool CompressedMeshWriter::Invoke()
+{
+	if (!m_scene)
+	{
+		Log().Error("Scene not set");
+		return false;
+	}
+
+	// merge all scene meshes with their transformation applied
+	std::vector<glm::vec3> vertices;
+	std::vector<data::Triangle> triangles;
+	for (auto const& mesh : m_scene->m_meshes)
+	{
+		const uint32_t vertexOffset = static_cast<uint32_t>(vertices.size());
+		for (auto const& vertex : mesh.first->vertices)
+		{
+			glm::vec4 v = mesh.second * glm::vec4{ vertex, 1.0f };
+			v *= 1.0f / v.w;
+			vertices.push_back(glm::vec3{ v });
+		}
+		for (data::Triangle const& t : mesh.first->triangles)
+		{
+			triangles.push_back(data::Triangle{ t[0] + vertexOffset, t[1] + vertexOffset, t[2] + vertexOffset });
+		}
+	}
+
+	std::vector<uint8_t> data;
+	if (!utilities::CompressedMeshCodec::Encode(vertices, triangles, m_bits, m_blockSize, data, Log()))
+	{
+		return false;
+	}
+
+	FILE* file = nullptr;
+	errno_t r = _wfopen_s(&file, m_path.c_str(), L"wb");
+	if (r != 0) {
+		wchar_t errMsg[95]{};
+		_wcserror_s(errMsg, r);
+		Log().Error(L"Failed to open \"%s\": %s (%d)", m_path.c_str(), errMsg, static_cast<int>(r));
+		return false;
+	}
+	if (file == nullptr) {
+		Log().Error(L"Failed to open \"%s\": returned nullptr", m_path.c_str());
+		return false;
+	}
+
+	Log().Message(L"Writing compressed mesh: %s", m_path.c_str());
+
+	const bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+	fclose(file);
+	if (!written)
+	{
+		Log().Error(L"Failed to write \"%s\"", m_path.c_str());
+		return false;
+	}
+
+	const size_t rawSize = vertices.size() * 12 + triangles.size() * 12;
+	Log().Detail(L"Written %d triangles and %d vertices to %s: %d bytes (%.2f bytes per triangle, %.1f:1)",
+		static_cast<int>(triangles.size()), static_cast<int>(vertices.size()), m_path.c_str(), static_cast<int>(data.size()),
+		triangles.empty() ? 0.0 : static_cast<double>(data.size()) / triangles.size(),
+		data.empty() ? 0.0 : static_cast<double>(rawSize) / data.size());
+	return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Scene.h"
+
+#include <memory>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace io
+		{
+
+			class CompressedMeshWriter : public AbstractCommand
+			{
+			public:
+				CompressedMeshWriter(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				const std::wstring m_path{};
+				const std::shared_ptr<data::Scene> m_scene{};
+				const uint32_t m_bits{ 16 };
+				const uint32_t m_blockSize{ 64 * 1024 };
+			};
+
+		}
+	}
+}
@@ -0,0 +1,299 @@
+#include "MultiReader.h"
+
+#include "CompressedMeshReader.h"
+#include "Model3mfReader.h"
+#include "ObjReader.h"
+#include "PlyReader.h"
+#include "StlReader.h"
+
+#include "utilities/StringUtilities.h"
+#include "utilities/TaskScheduler.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cwctype>
+#include <filesystem>
+#include <mutex>
+#include <system_error>
+
+using namespace meshproc;
+using namespace meshproc::commands;
+using namespace meshproc::commands::io;
+
+namespace
+{
+	typedef std::shared_ptr<AbstractCommand>(*ReaderFactory)(const sgrottel::ISimpleLog&);
+
+	template<typename T>
+	std::shared_ptr<AbstractCommand> MakeReader(const sgrottel::ISimpleLog& log)
+	{
+		return std::make_shared<T>(log);
+	}
+
+	ReaderFactory FindReader(const std::filesystem::path& path)
+	{
+		std::wstring ext = path.extension().wstring();
+		std::transform(ext.begin(), ext.end(), ext.begin(), [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+		if (ext == L".3mf") return &MakeReader<Model3mfReader>;
+		if (ext == L".mpcm") return &MakeReader<CompressedMeshReader>;
+		if (ext == L".obj") return &MakeReader<ObjReader>;
+		if (ext == L".ply") return &MakeReader<PlyReader>;
+		if (ext == L".stl") return &MakeReader<StlReader>;
+		return nullptr;
+	}
+
+	bool MatchesAnyPattern(const std::wstring& patterns, const std::wstring& fileName)
+	{
+		size_t start = 0;
+		while (start <= patterns.size())
+		{
+			size_t end = patterns.find(L';', start);
+			if (end == std::wstring::npos)
+			{
+				end = patterns.size();
+			}
+			if (end > start && WildcardMatch(std::wstring_view{ patterns }.substr(start, end - start), fileName))
+			{
+				return true;
+			}
+			start = end + 1;
+		}
+		return false;
+	}
+
+	// Limits the estimated memory of all files being loaded at the same time.
+	// A single file larger than the whole budget is still loaded, but alone.
+	// `Acquire` blocks without helping the task scheduler, so it must not be called from within a task.
+	class MemoryBudget
+	{
+	public:
+		MemoryBudget(uint64_t budget)
+			: m_budget{ budget }
+		{}
+
+		void Acquire(uint64_t size)
+		{
+			std::unique_lock<std::mutex> lock{ m_lock };
+			m_cond.wait(lock, [&]() { return m_used == 0 || m_used + size <= m_budget; });
+			m_used += size;
+		}
+
+		void Release(uint64_t size)
+		{
+			{
+				std::lock_guard<std::mutex> lock{ m_lock };
+				m_used -= size;
+			}
+			m_cond.notify_all();
+		}
+
+	private:
+		const uint64_t m_budget;
+		uint64_t m_used{ 0 };
+		std::mutex m_lock;
+		std::condition_variable m_cond;
+	};
+
+}
+
+MultiReader::MultiReader(const sgrottel::ISimpleLog& log)
+	: AbstractCommand{ log }
+{
+	AddParamBinding<ParamMode::In, ParamType::String>("Directory", m_directory);
+	AddParamBinding<ParamMode::In, ParamType::String>("Pattern", m_pattern);
+	AddParamBinding<ParamMode::In, ParamType::StringList>("Paths", m_paths);
+	AddParamBinding<ParamMode::In, ParamType::Bool>("Recursive", m_recursive);
+	AddParamBinding<ParamMode::In, ParamType::UInt32>("MemoryBudgetMB", m_memoryBudgetMB);
+	AddParamBinding<ParamMode::Out, ParamType::MeshList>("Meshes", m_meshes);
+	AddParamBinding<ParamMode::Out, ParamType::StringList>("Files", m_files);
+}
+
+bool MultiReader::Invoke()
+{
+	std::vector<std::filesystem::path> files;
+
+	if (m_paths && !m_paths->empty())
+	{
+		// explicit list of paths, kept in the given order
+		files.reserve(m_paths->size());
+		for (const std::wstring& p : *m_paths)
+		{
+			std::filesystem::path path{ p };
+			if (path.is_relative() && !m_directory.empty())
+			{
+				path = std::filesystem::path{ m_directory } / path;
+			}
+			files.push_back(std::move(path));
+		}
+	}
+	else
+	{
+		if (m_directory.empty())
+		{
+			Log().Error("Neither Directory nor Paths set");
+			return false;
+		}
+		std::error_code ec;
+		if (!std::filesystem::is_directory(m_directory, ec))
+		{
+			Log().Error(L"Directory not found: %s", m_directory.c_str());
+			return false;
+		}
+
+		auto collect = [&](const std::filesystem::directory_entry& entry)
+			{
+				std::error_code entryEc;
+				if (!entry.is_regular_file(entryEc)) return;
+				const std::filesystem::path& path = entry.path();
+				if (!MatchesAnyPattern(m_pattern, path.filename().wstring())) return;
+				if (FindReader(path) == nullptr) return;
+				files.push_back(path);
+			};
+		// errors while listing are logged, and the files found until then are still loaded
+		auto iterate = [&](auto it)
+			{
+				if (ec)
+				{
+					Log().Error("Failed to list directory \"%s\": %s", ToUtf8(m_directory).c_str(), ec.message().c_str());
+					return false;
+				}
+				for (const decltype(it) end{}; it != end; )
+				{
+					const std::filesystem::path path = it->path();
+					collect(*it);
+					it.increment(ec);
+					if (ec)
+					{
+						Log().Error("Failed to continue listing after \"%s\": %s", ToUtf8(path.wstring()).c_str(), ec.message().c_str());
+						break;
+					}
+				}
+				return true;
+			};
+		const bool listed = m_recursive
+			? iterate(std::filesystem::recursive_directory_iterator{ m_directory, std::filesystem::directory_options::skip_permission_denied, ec })
+			: iterate(std::filesystem::directory_iterator{ m_directory, ec });
+		if (!listed)
+		{
+			return false;
+		}
+
+		// directory iteration order is unspecified
+		std::sort(files.begin(), files.end());
+	}
+
+	m_meshes = std::make_shared<std::vector<std::shared_ptr<data::Mesh>>>();
+	m_files = std::make_shared<std::vector<std::wstring>>();
+	if (files.empty())
+	{
+		Log().Warning("No files to load");
+		return true;
+	}
+
+	const auto startAll = std::chrono::steady_clock::now();
+
+	std::vector<std::shared_ptr<data::Mesh>> meshes(files.size());
+	MemoryBudget budget{ static_cast<uint64_t>(std::max<uint32_t>(m_memoryBudgetMB, 1)) * 1024 * 1024 };
+
+	auto loadFile = [&](const std::filesystem::path& path, ReaderFactory factory) -> std::shared_ptr<data::Mesh>
+		{
+			const auto start = std::chrono::steady_clock::now();
+			std::shared_ptr<data::Mesh> mesh;
+			try
+			{
+				std::shared_ptr<AbstractCommand> reader = factory(Log());
+				std::wstring* readerPath = ParameterBinding::GetValueTarget<ParamType::String>(reader->GetParam("Path").get());
+				const std::shared_ptr<data::Mesh>* readerMesh = ParameterBinding::GetValueSource<ParamType::Mesh>(reader->GetParam("Mesh").get());
+				if (readerPath == nullptr || readerMesh == nullptr)
+				{
+					throw std::logic_error("Reader parameters mismatch");
+				}
+				*readerPath = path.wstring();
+				if (reader->Invoke())
+				{
+					mesh = *readerMesh;
+				}
+			}
+			catch (const std::exception& ex)
+			{
+				Log().Error("Exception: %s", ex.what());
+				mesh.reset();
+			}
+
+			const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			if (mesh)
+			{
+				Log().Detail(L"Loaded \"%s\" in %.2f ms: %d vertices, %d triangles", path.c_str(), ms,
+					static_cast<int>(mesh->vertices.size()), static_cast<int>(mesh->triangles.size()));
+			}
+			else
+			{
+				Log().Error(L"Failed to load \"%s\" after %.2f ms", path.c_str(), ms);
+			}
+			return mesh;
+		};
+
+	{
+		// The budget is acquired here, on the calling thread, before a load task is submitted.
+		// Acquiring inside the tasks could block a worker which, while helping in a nested wait, runs a load task on top of a budget holder.
+		utilities::TaskScheduler::TaskGroup group{ Tasks() };
+		for (size_t i = 0; i < files.size(); ++i)
+		{
+			const std::filesystem::path& path = files[i];
+			ReaderFactory factory = FindReader(path);
+			if (factory == nullptr)
+			{
+				Log().Error(L"No reader for file type: %s", path.c_str());
+				continue;
+			}
+
+			// rough estimate of the peak memory needed while reading
+			std::error_code ec;
+			uint64_t estimate = std::filesystem::file_size(path, ec);
+			if (ec)
+			{
+				Log().Error(L"Failed to access \"%s\"", path.c_str());
+				continue;
+			}
+			estimate *= 2;
+
+			budget.Acquire(estimate);
+			group.Run([&, i, factory, estimate]()
+				{
+					try
+					{
+						meshes[i] = loadFile(files[i], factory);
+					}
+					catch (...)
+					{
+						budget.Release(estimate);
+						throw;
+					}
+					budget.Release(estimate);
+				});
+		}
+		group.Wait();
+	}
+	const size_t threadCount = std::min<size_t>(files.size(), Tasks().GetThreadCount());
+
+	// failed files are skipped; `Files` stays aligned with `Meshes`
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		if (!meshes[i]) continue;
+		m_meshes->push_back(meshes[i]);
+		m_files->push_back(files[i].wstring());
+	}
+
+	const double msAll = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startAll).count();
+	Log().Message("Loaded %d of %d files in %.2f ms using %d threads",
+		static_cast<int>(m_meshes->size()), static_cast<int>(files.size()), msAll, static_cast<int>(threadCount));
+	if (m_meshes->size() != files.size())
+	{
+		Log().Warning("%d files failed to load", static_cast<int>(files.size() - m_meshes->size()));
+	}
+
+	return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "commands/AbstractCommand.h"
+#include "data/Mesh.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace meshproc
+{
+	namespace commands
+	{
+		namespace io
+		{
+
+			// Loads many mesh files concurrently, dispatching each file by extension to the matching reader
+			class MultiReader : public AbstractCommand
+			{
+			public:
+				MultiReader(const sgrottel::ISimpleLog& log);
+
+				bool Invoke() override;
+
+			private:
+				const std::wstring m_directory{};
+				const std::wstring m_pattern{ L"*" };
+				const std::shared_ptr<std::vector<std::wstring>> m_paths;
+				const bool m_recursive{ false };
+				const uint32_t m_memoryBudgetMB{ 1024 };
+				std::shared_ptr<std::vector<std::shared_ptr<data::Mesh>>> m_meshes;
+				std::shared_ptr<std::vector<std::wstring>> m_files;
+			};
+
+		}
+	}
+}
@@ -0,0 +1,853 @@
+#include "Bvh.h"
+
+#include "data/Mesh.h"
+#include "utilities/TaskScheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <numeric>
+
+using namespace meshproc;
+using namespace meshproc::data;
+
+namespace
+{
+	constexpr uint32_t BinCount = 16;
+	// ranges larger than this build their second child as parallel task
+	constexpr size_t ParallelBuildSize = 0x4000;
+	constexpr size_t GrainSize = 0x10000;
+
+	struct Aabb
+	{
+		glm::vec3 bmin{ std::numeric_limits<float>::max() };
+		glm::vec3 bmax{ -std::numeric_limits<float>::max() };
+
+		inline void Grow(const glm::vec3& p)
+		{
+			bmin = glm::min(bmin, p);
+			bmax = glm::max(bmax, p);
+		}
+		inline void Grow(const Aabb& b)
+		{
+			bmin = glm::min(bmin, b.bmin);
+			bmax = glm::max(bmax, b.bmax);
+		}
+		inline float HalfArea() const
+		{
+			const glm::vec3 d = bmax - bmin;
+			if (d.x < 0.0f) return 0.0f;
+			return d.x * d.y + d.y * d.z + d.z * d.x;
+		}
+	};
+
+	struct BuildNode
+	{
+		Aabb bounds;
+		uint32_t left;
+		uint32_t right;
+		uint32_t first;
+		uint32_t count; // leaf if > 0
+	};
+
+	struct BuildContext
+	{
+		const std::vector<Aabb>& triBounds;
+		const std::vector<glm::vec3>& centroids;
+		std::vector<uint32_t>& order;
+		utilities::TaskScheduler& tasks;
+	};
+
+	// Builds the binary subtree of `order[begin, end)` into `nodes`, depth first, children after their parent
+	// @return the index of the subtree root in `nodes`
+	uint32_t Build(const BuildContext& ctx, size_t begin, size_t end, std::vector<BuildNode>& nodes)
+	{
+		Aabb bounds, cbounds;
+		for (size_t i = begin; i < end; ++i)
+		{
+			bounds.Grow(ctx.triBounds[ctx.order[i]]);
+			cbounds.Grow(ctx.centroids[ctx.order[i]]);
+		}
+
+		const uint32_t nodeIdx = static_cast<uint32_t>(nodes.size());
+		const size_t cnt = end - begin;
+		nodes.push_back(BuildNode{ bounds, 0, 0, static_cast<uint32_t>(begin), static_cast<uint32_t>(cnt) });
+		if (cnt <= Bvh::MaxLeafSize)
+		{
+			return nodeIdx;
+		}
+
+		const glm::vec3 ext = cbounds.bmax - cbounds.bmin;
+		const int axis = (ext.x >= ext.y && ext.x >= ext.z) ? 0 : ((ext.y >= ext.z) ? 1 : 2);
+		size_t mid = begin + cnt / 2;
+		if (ext[axis] > 0.0f)
+		{
+			const float scale = static_cast<float>(BinCount) / ext[axis];
+			const float origin = cbounds.bmin[axis];
+			auto binOf = [&](uint32_t t)
+				{
+					return std::min<uint32_t>(BinCount - 1, static_cast<uint32_t>((ctx.centroids[t][axis] - origin) * scale));
+				};
+
+			std::array<Aabb, BinCount> binBounds;
+			std::array<uint32_t, BinCount> binCnt{};
+			for (size_t i = begin; i < end; ++i)
+			{
+				const uint32_t t = ctx.order[i];
+				const uint32_t b = binOf(t);
+				binCnt[b]++;
+				binBounds[b].Grow(ctx.triBounds[t]);
+			}
+
+			// sweep from both sides; split `s` puts bins [0, s[ left
+			std::array<float, BinCount> leftCost{};
+			std::array<uint32_t, BinCount> leftCnt{};
+			Aabb acc;
+			uint32_t n = 0;
+			for (uint32_t b = 0; b + 1 < BinCount; ++b)
+			{
+				acc.Grow(binBounds[b]);
+				n += binCnt[b];
+				leftCost[b + 1] = acc.HalfArea() * static_cast<float>(n);
+				leftCnt[b + 1] = n;
+			}
+			acc = Aabb{};
+			n = 0;
+			float bestCost = std::numeric_limits<float>::max();
+			uint32_t bestSplit = 0;
+			for (uint32_t s = BinCount - 1; s > 0; --s)
+			{
+				acc.Grow(binBounds[s]);
+				n += binCnt[s];
+				if (n == 0 || leftCnt[s] == 0) continue;
+				const float cost = leftCost[s] + acc.HalfArea() * static_cast<float>(n);
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestSplit = s;
+				}
+			}
+
+			if (bestSplit > 0)
+			{
+				auto it = std::partition(ctx.order.begin() + begin, ctx.order.begin() + end, [&](uint32_t t) { return binOf(t) < bestSplit; });
+				mid = static_cast<size_t>(it - ctx.order.begin());
+			}
+		}
+		if (mid == begin || mid == end)
+		{
+			// all centroids in one bin
+			mid = begin + cnt / 2;
+		}
+
+		uint32_t left, right;
+		if (cnt > ParallelBuildSize && ctx.tasks.GetThreadCount() > 1)
+		{
+			// the second subtree is built into its own array and appended, resulting in the same layout as the serial build
+			std::vector<BuildNode> rightNodes;
+			utilities::TaskScheduler::TaskGroup group{ ctx.tasks };
+			group.Run([&]() { Build(ctx, mid, end, rightNodes); });
+			left = Build(ctx, begin, mid, nodes);
+			group.Wait();
+
+			right = static_cast<uint32_t>(nodes.size());
+			for (BuildNode bn : rightNodes)
+			{
+				if (bn.count == 0)
+				{
+					bn.left += right;
+					bn.right += right;
+				}
+				nodes.push_back(bn);
+			}
+		}
+		else
+		{
+			left = Build(ctx, begin, mid, nodes);
+			right = Build(ctx, mid, end, nodes);
+		}
+
+		BuildNode& node = nodes[nodeIdx];
+		node.left = left;
+		node.right = right;
+		node.count = 0;
+		return nodeIdx;
+	}
+
+	void ClearSlot(Bvh::Node& node, uint32_t s)
+	{
+		node.minX[s] = node.minY[s] = node.minZ[s] = std::numeric_limits<float>::max();
+		node.maxX[s] = node.maxY[s] = node.maxZ[s] = -std::numeric_limits<float>::max();
+		node.child[s] = Bvh::InvalidIndex;
+		node.count[s] = 0;
+	}
+
+	void SetSlot(Bvh::Node& node, uint32_t s, const BuildNode& bn)
+	{
+		node.minX[s] = bn.bounds.bmin.x;
+		node.minY[s] = bn.bounds.bmin.y;
+		node.minZ[s] = bn.bounds.bmin.z;
+		node.maxX[s] = bn.bounds.bmax.x;
+		node.maxY[s] = bn.bounds.bmax.y;
+		node.maxZ[s] = bn.bounds.bmax.z;
+		node.child[s] = (bn.count > 0) ? bn.first : Bvh::InvalidIndex;
+		node.count[s] = bn.count;
+	}
+
+	// Collapses the binary inner node `bidx` into one wide node, by repeatedly opening the largest inner child
+	// @return the index of the wide node in `out`
+	uint32_t Collapse(const std::vector<BuildNode>& bnodes, uint32_t bidx, std::vector<Bvh::Node>& out)
+	{
+		std::array<uint32_t, Bvh::Width> children;
+		uint32_t cc = 0;
+		children[cc++] = bnodes[bidx].left;
+		children[cc++] = bnodes[bidx].right;
+		while (cc < Bvh::Width)
+		{
+			int best = -1;
+			float bestArea = -1.0f;
+			for (uint32_t i = 0; i < cc; ++i)
+			{
+				const BuildNode& c = bnodes[children[i]];
+				if (c.count == 0 && c.bounds.HalfArea() > bestArea)
+				{
+					bestArea = c.bounds.HalfArea();
+					best = static_cast<int>(i);
+				}
+			}
+			if (best < 0) break;
+			const BuildNode& open = bnodes[children[best]];
+			children[best] = open.left;
+			children[cc++] = open.right;
+		}
+
+		const uint32_t idx = static_cast<uint32_t>(out.size());
+		out.push_back(Bvh::Node{});
+		for (uint32_t s = 0; s < Bvh::Width; ++s)
+		{
+			ClearSlot(out[idx], s);
+		}
+		for (uint32_t s = 0; s < cc; ++s)
+		{
+			const BuildNode& c = bnodes[children[s]];
+			SetSlot(out[idx], s, c);
+			if (c.count == 0)
+			{
+				const uint32_t ci = Collapse(bnodes, children[s], out);
+				out[idx].child[s] = ci;
+			}
+		}
+		return idx;
+	}
+
+	inline bool IsLeaf(const Bvh::Node& node, uint32_t s)
+	{
+		return node.count[s] > 0;
+	}
+
+	inline bool IsInner(const Bvh::Node& node, uint32_t s)
+	{
+		return node.count[s] == 0 && node.child[s] != Bvh::InvalidIndex;
+	}
+
+	// squared distance of point `p` to the bounding box of slot `s`
+	inline float SlotDistance2(const Bvh::Node& node, uint32_t s, const glm::vec3& p)
+	{
+		const float dx = std::max({ node.minX[s] - p.x, 0.0f, p.x - node.maxX[s] });
+		const float dy = std::max({ node.minY[s] - p.y, 0.0f, p.y - node.maxY[s] });
+		const float dz = std::max({ node.minZ[s] - p.z, 0.0f, p.z - node.maxZ[s] });
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	inline bool SlotOverlaps(const Bvh::Node& node, uint32_t s, const glm::vec3& bmin, const glm::vec3& bmax)
+	{
+		return node.minX[s] <= bmax.x && node.maxX[s] >= bmin.x
+			&& node.minY[s] <= bmax.y && node.maxY[s] >= bmin.y
+			&& node.minZ[s] <= bmax.z && node.maxZ[s] >= bmin.z;
+	}
+
+	inline bool BoxesOverlap(const glm::vec3& amin, const glm::vec3& amax, const glm::vec3& bmin, const glm::vec3& bmax)
+	{
+		return amin.x <= bmax.x && amax.x >= bmin.x
+			&& amin.y <= bmax.y && amax.y >= bmin.y
+			&& amin.z <= bmax.z && amax.z >= bmin.z;
+	}
+
+	inline uint64_t HashCombine(uint64_t h, uint64_t v)
+	{
+		return h ^ (v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2));
+	}
+
+	// Narrows the parameter interval of a ray to one slab of a bounding box.
+	// A ray parallel to the slab lies inside or outside of it for all parameters; testing that directly avoids
+	// `0 * inf = NaN` for origins on a bounding plane, which would cull the box.
+	inline void ClipSlab(float lo, float hi, float origin, float direction, float inv, float& tmin, float& tmax)
+	{
+		if (direction == 0.0f)
+		{
+			if (origin < lo || origin > hi) tmin = std::numeric_limits<float>::infinity();
+			return;
+		}
+		const float t0 = (lo - origin) * inv;
+		const float t1 = (hi - origin) * inv;
+		tmin = std::max(tmin, std::min(t0, t1));
+		tmax = std::min(tmax, std::max(t0, t1));
+	}
+
+	// Entry distances of the ray into the bounds of all slots, or infinity for slots missed or entered beyond `limit`
+	inline void SlotRayDistances(const Bvh::Node& node, const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& inv, float limit, float(&outDist)[Bvh::Width])
+	{
+		for (uint32_t s = 0; s < Bvh::Width; ++s)
+		{
+			float tmin = 0.0f;
+			float tmax = limit;
+			ClipSlab(node.minX[s], node.maxX[s], origin.x, direction.x, inv.x, tmin, tmax);
+			ClipSlab(node.minY[s], node.maxY[s], origin.y, direction.y, inv.y, tmin, tmax);
+			ClipSlab(node.minZ[s], node.maxZ[s], origin.z, direction.z, inv.z, tmin, tmax);
+			outDist[s] = (tmin <= tmax) ? tmin : std::numeric_limits<float>::infinity();
+		}
+	}
+
+	// Moeller-Trumbore, hitting both sides; `t >= 0` along the ray and barycentric `u`, `v` of the second and third vertex
+	inline bool RayTriangle(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3* tri, float& outT, float& outU, float& outV)
+	{
+		const glm::vec3 e1 = tri[1] - tri[0];
+		const glm::vec3 e2 = tri[2] - tri[0];
+		const glm::vec3 p = glm::cross(direction, e2);
+		const float det = glm::dot(e1, p);
+		if (det == 0.0f) return false;
+		const float invDet = 1.0f / det;
+		const glm::vec3 tv = origin - tri[0];
+		outU = glm::dot(tv, p) * invDet;
+		if (outU < 0.0f || outU > 1.0f) return false;
+		const glm::vec3 q = glm::cross(tv, e1);
+		outV = glm::dot(direction, q) * invDet;
+		if (outV < 0.0f || outU + outV > 1.0f) return false;
+		outT = glm::dot(e2, q) * invDet;
+		return outT >= 0.0f;
+	}
+
+	struct StackEntry
+	{
+		uint32_t node;
+		float dist;
+	};
+
+	// Pushes the inner children with `dist[s] <= limit` far to near, so the nearest one is popped first
+	inline void PushSorted(std::vector<StackEntry>& stack, const Bvh::Node& node, const float(&dist)[Bvh::Width], float limit)
+	{
+		std::array<StackEntry, Bvh::Width> cand;
+		uint32_t cnt = 0;
+		for (uint32_t s = 0; s < Bvh::Width; ++s)
+		{
+			if (IsInner(node, s) && dist[s] <= limit)
+			{
+				cand[cnt++] = StackEntry{ node.child[s], dist[s] };
+			}
+		}
+		std::sort(cand.begin(), cand.begin() + cnt, [](const StackEntry& a, const StackEntry& b) { return a.dist > b.dist; });
+		stack.insert(stack.end(), cand.begin(), cand.begin() + cnt);
+	}
+
+}
+
+Bvh::Bvh(const Mesh& mesh)
+{
+	m_fingerprint = Fingerprint(mesh);
+
+	const size_t triCnt = mesh.triangles.size();
+	if (triCnt == 0)
+	{
+		return;
+	}
+
+	utilities::TaskScheduler& tasks = utilities::TaskScheduler::Instance();
+
+	std::vector<Aabb> triBounds(triCnt);
+	std::vector<glm::vec3> centroids(triCnt);
+	tasks.ParallelFor(0, triCnt, GrainSize, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				const Triangle& t = mesh.triangles[i];
+				Aabb b;
+				for (int k = 0; k < 3; ++k)
+				{
+					b.Grow(mesh.vertices.at(t[k]));
+				}
+				triBounds[i] = b;
+				centroids[i] = (b.bmin + b.bmax) * 0.5f;
+			}
+		});
+
+	std::vector<uint32_t> order(triCnt);
+	std::iota(order.begin(), order.end(), 0);
+
+	std::vector<BuildNode> bnodes;
+	bnodes.reserve(2 * triCnt / MaxLeafSize + 1);
+	const BuildContext ctx{ triBounds, centroids, order, tasks };
+	Build(ctx, 0, triCnt, bnodes);
+
+	m_boundsMin = bnodes[0].bounds.bmin;
+	m_boundsMax = bnodes[0].bounds.bmax;
+	if (bnodes[0].count > 0)
+	{
+		// a single leaf
+		m_nodes.push_back(Node{});
+		for (uint32_t s = 0; s < Width; ++s)
+		{
+			ClearSlot(m_nodes[0], s);
+		}
+		SetSlot(m_nodes[0], 0, bnodes[0]);
+	}
+	else
+	{
+		m_nodes.reserve(bnodes.size() / 2 + 1);
+		Collapse(bnodes, 0, m_nodes);
+	}
+
+	m_triangles = std::move(order);
+	m_positions.resize(triCnt * 3);
+	tasks.ParallelFor(0, triCnt, GrainSize, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				const Triangle& t = mesh.triangles[m_triangles[i]];
+				for (int k = 0; k < 3; ++k)
+				{
+					m_positions[i * 3 + k] = mesh.vertices[t[k]];
+				}
+			}
+		});
+}
+
+uint64_t Bvh::Fingerprint(const Mesh& mesh)
+{
+	utilities::TaskScheduler& tasks = utilities::TaskScheduler::Instance();
+	auto combine = [](uint64_t a, uint64_t b) { return HashCombine(a, b); };
+
+	const uint64_t vh = tasks.ParallelReduce<uint64_t>(0, mesh.vertices.size(), GrainSize, 0,
+		[&](size_t begin, size_t end)
+		{
+			uint64_t h = begin;
+			for (size_t i = begin; i < end; ++i)
+			{
+				const glm::vec3& v = mesh.vertices[i];
+				h = HashCombine(h, (static_cast<uint64_t>(std::bit_cast<uint32_t>(v.x)) << 32) | std::bit_cast<uint32_t>(v.y));
+				h = HashCombine(h, std::bit_cast<uint32_t>(v.z));
+			}
+			return h;
+		}, combine);
+	const uint64_t th = tasks.ParallelReduce<uint64_t>(0, mesh.triangles.size(), GrainSize, 0,
+		[&](size_t begin, size_t end)
+		{
+			uint64_t h = begin;
+			for (size_t i = begin; i < end; ++i)
+			{
+				const Triangle& t = mesh.triangles[i];
+				h = HashCombine(h, (static_cast<uint64_t>(t[0]) << 32) | t[1]);
+				h = HashCombine(h, t[2]);
+			}
+			return h;
+		}, combine);
+
+	uint64_t h = HashCombine(mesh.vertices.size(), mesh.triangles.size());
+	h = HashCombine(h, vh);
+	return HashCombine(h, th);
+}
+
+bool Bvh::RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RayHit& outHit) const
+{
+	if (m_nodes.empty())
+	{
+		return false;
+	}
+
+	const glm::vec3 inv = 1.0f / direction;
+	float best = maxDistance;
+	uint32_t bestLeafTri = InvalidIndex;
+	float bestU = 0.0f, bestV = 0.0f;
+
+	thread_local std::vector<StackEntry> stack;
+	stack.clear();
+	stack.push_back(StackEntry{ 0, 0.0f });
+	while (!stack.empty())
+	{
+		const StackEntry e = stack.back();
+		stack.pop_back();
+		if (e.dist > best) continue;
+		const Node& node = m_nodes[e.node];
+
+		float dist[Width];
+		SlotRayDistances(node, origin, direction, inv, best, dist);
+
+		for (uint32_t s = 0; s < Width; ++s)
+		{
+			if (!IsLeaf(node, s) || dist[s] > best) continue;
+			for (uint32_t i = node.child[s]; i < node.child[s] + node.count[s]; ++i)
+			{
+				float t, u, v;
+				if (!RayTriangle(origin, direction, &m_positions[i * 3], t, u, v) || t > best) continue;
+				// equal distances resolve to the lower triangle index, independent of the tree layout
+				if (t == best && bestLeafTri != InvalidIndex && m_triangles[i] > m_triangles[bestLeafTri]) continue;
+				best = t;
+				bestLeafTri = i;
+				bestU = u;
+				bestV = v;
+			}
+		}
+
+		PushSorted(stack, node, dist, best);
+	}
+
+	if (bestLeafTri == InvalidIndex)
+	{
+		return false;
+	}
+	outHit.triangle = m_triangles[bestLeafTri];
+	outHit.distance = best;
+	outHit.barycentric = glm::vec3{ 1.0f - bestU - bestV, bestU, bestV };
+	return true;
+}
+
+void Bvh::RayCastAll(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, std::vector<RayHit>& outHits) const
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	const glm::vec3 inv = 1.0f / direction;
+	const size_t first = outHits.size();
+
+	thread_local std::vector<StackEntry> stack;
+	stack.clear();
+	stack.push_back(StackEntry{ 0, 0.0f });
+	while (!stack.empty())
+	{
+		const Node& node = m_nodes[stack.back().node];
+		stack.pop_back();
+
+		float dist[Width];
+		SlotRayDistances(node, origin, direction, inv, maxDistance, dist);
+
+		for (uint32_t s = 0; s < Width; ++s)
+		{
+			if (!IsLeaf(node, s) || dist[s] > maxDistance) continue;
+			for (uint32_t i = node.child[s]; i < node.child[s] + node.count[s]; ++i)
+			{
+				float t, u, v;
+				if (!RayTriangle(origin, direction, &m_positions[i * 3], t, u, v) || t > maxDistance) continue;
+				outHits.push_back(RayHit{ m_triangles[i], t, glm::vec3{ 1.0f - u - v, u, v } });
+			}
+		}
+
+		PushSorted(stack, node, dist, maxDistance);
+	}
+
+	std::sort(outHits.begin() + first, outHits.end(), [](const RayHit& a, const RayHit& b)
+		{
+			return (a.distance != b.distance) ? (a.distance < b.distance) : (a.triangle < b.triangle);
+		});
+}
+
+bool Bvh::ClosestPoint(const glm::vec3& point, float maxDistance, PointHit& outHit) const
+{
+	if (m_nodes.empty())
+	{
+		return false;
+	}
+
+	float best2 = (maxDistance < std::numeric_limits<float>::max()) ? maxDistance * maxDistance : std::numeric_limits<float>::infinity();
+	uint32_t bestLeafTri = InvalidIndex;
+	glm::vec3 bestPoint{ 0.0f };
+	glm::vec3 bestBary{ 0.0f };
+
+	thread_local std::vector<StackEntry> stack;
+	stack.clear();
+	stack.push_back(StackEntry{ 0, 0.0f });
+	while (!stack.empty())
+	{
+		const StackEntry e = stack.back();
+		stack.pop_back();
+		if (e.dist > best2) continue;
+		const Node& node = m_nodes[e.node];
+
+		float dist[Width];
+		for (uint32_t s = 0; s < Width; ++s)
+		{
+			dist[s] = SlotDistance2(node, s, point);
+		}
+
+		for (uint32_t s = 0; s < Width; ++s)
+		{
+			if (!IsLeaf(node, s) || dist[s] > best2) continue;
+			for (uint32_t i = node.child[s]; i < node.child[s] + node.count[s]; ++i)
+			{
+				glm::vec3 bary;
+				const glm::vec3 cp = ClosestPointOnTriangle(point, &m_positions[i * 3], bary);
+				const glm::vec3 d = cp - point;
+				const float d2 = glm::dot(d, d);
+				if (d2 > best2) continue;
+				if (d2 == best2 && bestLeafTri != InvalidIndex && m_triangles[i] > m_triangles[bestLeafTri]) continue;
+				best2 = d2;
+				bestLeafTri = i;
+				bestPoint = cp;
+				bestBary = bary;
+			}
+		}
+
+		PushSorted(stack, node, dist, best2);
+	}
+
+	if (bestLeafTri == InvalidIndex)
+	{
+		return false;
+	}
+	outHit.triangle = m_triangles[bestLeafTri];
+	outHit.distance = std::sqrt(best2);
+	outHit.point = bestPoint;
+	outHit.barycentric = bestBary;
+	return true;
+}
+
+template<typename FUNC>
+void Bvh::ForEachOverlappingLeaf(const glm::vec3& boxMin, const glm::vec3& boxMax, FUNC&& func) const
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	thread_local std::vector<uint32_t> stack;
+	stack.clear();
+	stack.push_back(0);
+	while (!stack.empty())
+	{
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+		for (uint32_t s = 0; s < Width; ++s)
+		{
+			if (node.child[s] == InvalidIndex || !SlotOverlaps(node, s, boxMin, boxMax)) continue;
+			if (IsLeaf(node, s))
+			{
+				for (uint32_t i = node.child[s]; i < node.child[s] + node.count[s]; ++i)
+				{
+					func(i);
+				}
+			}
+			else
+			{
+				stack.push_back(node.child[s]);
+			}
+		}
+	}
+}
+
+void Bvh::OverlapSphere(const glm::vec3& center, float radius, std::vector<uint32_t>& outTriangles) const
+{
+	const size_t first = outTriangles.size();
+	const glm::vec3 r{ radius };
+	const float r2 = radius * radius;
+	ForEachOverlappingLeaf(center - r, center + r, [&](uint32_t i)
+		{
+			glm::vec3 bary;
+			const glm::vec3 d = ClosestPointOnTriangle(center, &m_positions[i * 3], bary) - center;
+			if (glm::dot(d, d) <= r2)
+			{
+				outTriangles.push_back(m_triangles[i]);
+			}
+		});
+	std::sort(outTriangles.begin() + first, outTriangles.end());
+}
+
+void Bvh::OverlapBox(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<uint32_t>& outTriangles) const
+{
+	const size_t first = outTriangles.size();
+	ForEachOverlappingLeaf(boxMin, boxMax, [&](uint32_t i)
+		{
+			if (TriangleIntersectsBox(&m_positions[i * 3], boxMin, boxMax))
+			{
+				outTriangles.push_back(m_triangles[i]);
+			}
+		});
+	std::sort(outTriangles.begin() + first, outTriangles.end());
+}
+
+Bvh::Ref Bvh::RootRef() const
+{
+	return Ref{ m_boundsMin, m_boundsMax, 0, 0 };
+}
+
+void Bvh::OverlapPairs(const Bvh& a, const Bvh& b, const std::function<void(uint32_t, uint32_t)>& func)
+{
+	OverlapPairsUntil(a, b, [&func](uint32_t ta, uint32_t tb)
+		{
+			func(ta, tb);
+			return false;
+		});
+}
+
+bool Bvh::OverlapPairsUntil(const Bvh& a, const Bvh& b, const std::function<bool(uint32_t, uint32_t)>& func)
+{
+	if (a.m_nodes.empty() || b.m_nodes.empty())
+	{
+		return false;
+	}
+
+	auto area = [](const Ref& r)
+		{
+			const glm::vec3 d = r.bmax - r.bmin;
+			return d.x * d.y + d.y * d.z + d.z * d.x;
+		};
+	auto slotRef = [](const Node& node, uint32_t s)
+		{
+			return Ref{ glm::vec3{ node.minX[s], node.minY[s], node.minZ[s] }, glm::vec3{ node.maxX[s], node.maxY[s], node.maxZ[s] }, node.child[s], node.count[s] };
+		};
+
+	std::vector<std::pair<Ref, Ref>> stack;
+	stack.push_back(std::make_pair(a.RootRef(), b.RootRef()));
+	while (!stack.empty())
+	{
+		const auto [ra, rb] = stack.back();
+		stack.pop_back();
+
+		// descend into the inner node, or the larger one of two inner nodes
+		const bool openA = ra.count == 0 && (rb.count > 0 || area(ra) >= area(rb));
+		if (openA || rb.count == 0)
+		{
+			const Bvh& owner = openA ? a : b;
+			const Ref& open = openA ? ra : rb;
+			const Ref& other = openA ? rb : ra;
+			const Node& node = owner.m_nodes[open.child];
+			for (uint32_t s = 0; s < Width; ++s)
+			{
+				if (node.child[s] == InvalidIndex || !SlotOverlaps(node, s, other.bmin, other.bmax)) continue;
+				const Ref child = slotRef(node, s);
+				stack.push_back(openA ? std::make_pair(child, rb) : std::make_pair(ra, child));
+			}
+			continue;
+		}
+
+		for (uint32_t i = ra.child; i < ra.child + ra.count; ++i)
+		{
+			const glm::vec3* ta = &a.m_positions[i * 3];
+			const glm::vec3 amin = glm::min(glm::min(ta[0], ta[1]), ta[2]);
+			const glm::vec3 amax = glm::max(glm::max(ta[0], ta[1]), ta[2]);
+			for (uint32_t j = rb.child; j < rb.child + rb.count; ++j)
+			{
+				const glm::vec3* tb = &b.m_positions[j * 3];
+				const glm::vec3 bmin = glm::min(glm::min(tb[0], tb[1]), tb[2]);
+				const glm::vec3 bmax = glm::max(glm::max(tb[0], tb[1]), tb[2]);
+				if (BoxesOverlap(amin, amax, bmin, bmax) && func(a.m_triangles[i], b.m_triangles[j]))
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+bool Bvh::TriangleIntersectsBox(const glm::vec3* tri, const glm::vec3& boxMin, const glm::vec3& boxMax)
+{
+	// separating axis test, Akenine-Moeller 2001
+	const glm::vec3 c = (boxMin + boxMax) * 0.5f;
+	const glm::vec3 h = (boxMax - boxMin) * 0.5f;
+	const glm::vec3 v[3] = { tri[0] - c, tri[1] - c, tri[2] - c };
+	const glm::vec3 f[3] = { v[1] - v[0], v[2] - v[1], v[0] - v[2] };
+
+	auto separated = [&](const glm::vec3& axis)
+		{
+			const float p0 = glm::dot(v[0], axis);
+			const float p1 = glm::dot(v[1], axis);
+			const float p2 = glm::dot(v[2], axis);
+			const float r = h.x * std::abs(axis.x) + h.y * std::abs(axis.y) + h.z * std::abs(axis.z);
+			return std::max({ p0, p1, p2 }) < -r || std::min({ p0, p1, p2 }) > r;
+		};
+
+	for (int i = 0; i < 3; ++i)
+	{
+		glm::vec3 axis{ 0.0f };
+		axis[i] = 1.0f;
+		if (separated(axis)) return false;
+		for (int j = 0; j < 3; ++j)
+		{
+			if (separated(glm::cross(axis, f[j]))) return false;
+		}
+	}
+	return !separated(glm::cross(f[0], f[1]));
+}
+
+glm::vec3 Bvh::ClosestPointOnTriangle(const glm::vec3& p, const glm::vec3* tri, glm::vec3& outBarycentric)
+{
+	// Ericson, Real-Time Collision Detection, 5.1.5
+	const glm::vec3& a = tri[0];
+	const glm::vec3& b = tri[1];
+	const glm::vec3& c = tri[2];
+	const glm::vec3 ab = b - a;
+	const glm::vec3 ac = c - a;
+	const glm::vec3 ap = p - a;
+	const float d1 = glm::dot(ab, ap);
+	const float d2 = glm::dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f)
+	{
+		outBarycentric = glm::vec3{ 1.0f, 0.0f, 0.0f };
+		return a;
+	}
+
+	const glm::vec3 bp = p - b;
+	const float d3 = glm::dot(ab, bp);
+	const float d4 = glm::dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3)
+	{
+		outBarycentric = glm::vec3{ 0.0f, 1.0f, 0.0f };
+		return b;
+	}
+
+	const float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+	{
+		const float v = d1 / (d1 - d3);
+		outBarycentric = glm::vec3{ 1.0f - v, v, 0.0f };
+		return a + ab * v;
+	}
+
+	const glm::vec3 cp = p - c;
+	const float d5 = glm::dot(ab, cp);
+	const float d6 = glm::dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6)
+	{
+		outBarycentric = glm::vec3{ 0.0f, 0.0f, 1.0f };
+		return c;
+	}
+
+	const float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+	{
+		const float w = d2 / (d2 - d6);
+		outBarycentric = glm::vec3{ 1.0f - w, 0.0f, w };
+		return a + ac * w;
+	}
+
+	const float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+	{
+		const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		outBarycentric = glm::vec3{ 0.0f, 1.0f - w, w };
+		return b + (c - b) * w;
+	}
+
+	const float denom = va + vb + vc;
+	if (denom == 0.0f)
+	{
+		// degenerated triangle
+		outBarycentric = glm::vec3{ 1.0f, 0.0f, 0.0f };
+		return a;
+	}
+	const float v = vb / denom;
+	const float w = vc / denom;
+	outBarycentric = glm::vec3{ 1.0f - v - w, v, w };
+	return a + ab * v + ac * w;
+}
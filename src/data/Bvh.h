@@ -0,0 +1,130 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace meshproc
+{
+	namespace data
+	{
+		class Mesh;
+
+		// Bounding volume hierarchy over the triangles of a mesh.
+		// Built with binned surface area heuristic into binary nodes, which are collapsed into 4-wide nodes.
+		// The triangle vertex positions are copied in leaf order, so queries do not touch the mesh.
+		// The build is parallel, and its result does not depend on the thread count.
+		class Bvh
+		{
+		public:
+			static constexpr uint32_t Width = 4;
+			static constexpr uint32_t MaxLeafSize = 4;
+			static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+			struct Node
+			{
+				// child bounds in structure-of-arrays layout, to test all children in one loop
+				float minX[Width];
+				float minY[Width];
+				float minZ[Width];
+				float maxX[Width];
+				float maxY[Width];
+				float maxZ[Width];
+				// inner child: node index; leaf child: first triangle in leaf order; unused slot: InvalidIndex
+				uint32_t child[Width];
+				// number of triangles of a leaf child, 0 for inner children and unused slots
+				uint32_t count[Width];
+			};
+
+			struct RayHit
+			{
+				uint32_t triangle{ InvalidIndex };
+				float distance{ std::numeric_limits<float>::infinity() };
+				// weights of the three triangle vertices
+				glm::vec3 barycentric{ 0.0f };
+			};
+
+			struct PointHit
+			{
+				uint32_t triangle{ InvalidIndex };
+				float distance{ std::numeric_limits<float>::infinity() };
+				glm::vec3 point{ 0.0f };
+				// weights of the three triangle vertices
+				glm::vec3 barycentric{ 0.0f };
+			};
+
+			explicit Bvh(const Mesh& mesh);
+
+			// Hash of the vertex and triangle data, to detect changes of the mesh
+			static uint64_t Fingerprint(const Mesh& mesh);
+
+			inline bool IsBuiltFor(const Mesh& mesh) const
+			{
+				return Fingerprint(mesh) == m_fingerprint;
+			}
+
+			inline const std::vector<Node>& Nodes() const noexcept
+			{
+				return m_nodes;
+			}
+			inline size_t TriangleCount() const noexcept
+			{
+				return m_triangles.size();
+			}
+
+			// Nearest intersection of the ray `origin + t * direction` with `0 <= t <= maxDistance`, hitting both triangle sides.
+			// `distance` is in units of `t`, i.e. only equals the euclidean distance for a normalized `direction`.
+			bool RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RayHit& outHit) const;
+
+			// Appends all intersections of the ray `origin + t * direction` with `0 <= t <= maxDistance`, ascending by distance, then triangle
+			void RayCastAll(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, std::vector<RayHit>& outHits) const;
+
+			// Nearest point on the surface within `maxDistance` of `point`
+			bool ClosestPoint(const glm::vec3& point, float maxDistance, PointHit& outHit) const;
+
+			// Appends all triangles intersecting the sphere, ascending
+			void OverlapSphere(const glm::vec3& center, float radius, std::vector<uint32_t>& outTriangles) const;
+
+			// Appends all triangles intersecting the axis-aligned box, ascending
+			void OverlapBox(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<uint32_t>& outTriangles) const;
+
+			// Calls `func(triangleA, triangleB)` for all pairs of triangles with overlapping bounding boxes.
+			// For `a` and `b` being the same hierarchy, each pair is reported in both orders, and each triangle with itself.
+			static void OverlapPairs(const Bvh& a, const Bvh& b, const std::function<void(uint32_t, uint32_t)>& func);
+
+			// Like `OverlapPairs`, but stops the traversal as soon as `func(triangleA, triangleB)` returns true.
+			// @return true if stopped by `func`
+			static bool OverlapPairsUntil(const Bvh& a, const Bvh& b, const std::function<bool(uint32_t, uint32_t)>& func);
+
+		private:
+			struct Ref
+			{
+				glm::vec3 bmin;
+				glm::vec3 bmax;
+				uint32_t child;
+				uint32_t count;
+			};
+
+			static bool TriangleIntersectsBox(const glm::vec3* tri, const glm::vec3& boxMin, const glm::vec3& boxMax);
+			static glm::vec3 ClosestPointOnTriangle(const glm::vec3& p, const glm::vec3* tri, glm::vec3& outBarycentric);
+
+			template<typename FUNC>
+			void ForEachOverlappingLeaf(const glm::vec3& boxMin, const glm::vec3& boxMax, FUNC&& func) const;
+
+			Ref RootRef() const;
+
+			std::vector<Node> m_nodes;
+			// original triangle index, in leaf order
+			std::vector<uint32_t> m_triangles;
+			// three vertex positions per triangle, in leaf order
+			std::vector<glm::vec3> m_positions;
+			glm::vec3 m_boundsMin{ 0.0f };
+			glm::vec3 m_boundsMax{ 0.0f };
+			uint64_t m_fingerprint{ 0 };
+		};
+
+	}
+}
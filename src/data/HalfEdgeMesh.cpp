@@ -0,0 +1,393 @@
+#include "HalfEdgeMesh.h"
+
+#include "data/Mesh.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace meshproc;
+using namespace meshproc::data;
+
+bool HalfEdgeMesh::Build(const Mesh& mesh)
+{
+	const size_t vertCnt = mesh.vertices.size();
+	const size_t triCnt = mesh.triangles.size();
+	positions = mesh.vertices;
+	m_from.resize(triCnt * 3);
+	m_twin.assign(triCnt * 3, InvalidIndex);
+	m_feature.assign(triCnt * 3, 0);
+	m_vertexHalfEdge.assign(vertCnt, InvalidIndex);
+
+	for (size_t f = 0; f < triCnt; ++f)
+	{
+		const Triangle& t = mesh.triangles[f];
+		if (t[0] == t[1] || t[1] == t[2] || t[2] == t[0])
+		{
+			return false;
+		}
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			if (t[i] >= vertCnt)
+			{
+				return false;
+			}
+			m_from[f * 3 + i] = t[i];
+			m_vertexHalfEdge[t[i]] = static_cast<uint32_t>(f * 3 + i);
+		}
+	}
+
+	// pair directed edges with their reverse
+	std::vector<std::pair<uint64_t, uint32_t>> edges(m_from.size());
+	for (uint32_t h = 0; h < m_from.size(); ++h)
+	{
+		edges[h] = std::make_pair((static_cast<uint64_t>(From(h)) << 32) | To(h), h);
+	}
+	std::sort(edges.begin(), edges.end());
+	for (size_t i = 1; i < edges.size(); ++i)
+	{
+		if (edges[i].first == edges[i - 1].first)
+		{
+			return false;
+		}
+	}
+	for (const auto& e : edges)
+	{
+		const uint64_t reverse = (e.first << 32) | (e.first >> 32);
+		auto it = std::lower_bound(edges.begin(), edges.end(), std::make_pair(reverse, uint32_t{ 0 }));
+		if (it != edges.end() && it->first == reverse)
+		{
+			m_twin[e.second] = it->second;
+		}
+	}
+
+	// all triangles at a vertex must form one fan
+	std::vector<uint32_t> outgoing(vertCnt, 0);
+	for (uint32_t v : m_from)
+	{
+		outgoing[v]++;
+	}
+	for (uint32_t v = 0; v < vertCnt; ++v)
+	{
+		uint32_t cnt = 0;
+		ForEachOutgoing(v, [&cnt](uint32_t) { cnt++; });
+		if (cnt != outgoing[v])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void HalfEdgeMesh::ToMesh(Mesh& mesh) const
+{
+	std::vector<uint32_t> remap(positions.size(), InvalidIndex);
+	mesh.vertices.clear();
+	for (uint32_t v = 0; v < positions.size(); ++v)
+	{
+		if (!IsVertexAlive(v)) continue;
+		remap[v] = static_cast<uint32_t>(mesh.vertices.size());
+		mesh.vertices.push_back(positions[v]);
+	}
+	mesh.triangles.clear();
+	for (uint32_t h = 0; h < m_from.size(); h += 3)
+	{
+		if (!IsAlive(h)) continue;
+		mesh.triangles.push_back(Triangle{ remap[m_from[h]], remap[m_from[h + 1]], remap[m_from[h + 2]] });
+	}
+}
+
+void HalfEdgeMesh::SetFeature(uint32_t h, bool feature)
+{
+	m_feature[h] = feature ? 1 : 0;
+	if (m_twin[h] != InvalidIndex)
+	{
+		m_feature[m_twin[h]] = feature ? 1 : 0;
+	}
+}
+
+uint32_t HalfEdgeMesh::FirstOutgoing(uint32_t v) const
+{
+	const uint32_t start = m_vertexHalfEdge[v];
+	if (start == InvalidIndex) return InvalidIndex;
+	uint32_t h = start;
+	while (m_twin[h] != InvalidIndex)
+	{
+		h = Next(m_twin[h]);
+		if (h == start) break;
+	}
+	return h;
+}
+
+uint32_t HalfEdgeMesh::Valence(uint32_t v) const
+{
+	uint32_t cnt = 0;
+	ForEachOutgoing(v, [&cnt](uint32_t) { cnt++; });
+	return cnt + (IsBorderVertex(v) ? 1 : 0);
+}
+
+bool HalfEdgeMesh::IsBorderVertex(uint32_t v) const
+{
+	const uint32_t h = FirstOutgoing(v);
+	return h != InvalidIndex && m_twin[h] == InvalidIndex;
+}
+
+uint32_t HalfEdgeMesh::FeatureValence(uint32_t v) const
+{
+	uint32_t cnt = 0;
+	ForEachOutgoing(v, [&](uint32_t h)
+		{
+			if (m_feature[h] != 0 || m_twin[h] == InvalidIndex) cnt++;
+		});
+	// the incoming open border edge
+	return cnt + (IsBorderVertex(v) ? 1 : 0);
+}
+
+uint32_t HalfEdgeMesh::AddFace(uint32_t v0, uint32_t v1, uint32_t v2)
+{
+	const uint32_t f = static_cast<uint32_t>(m_from.size() / 3);
+	m_from.insert(m_from.end(), { v0, v1, v2 });
+	m_twin.insert(m_twin.end(), 3, InvalidIndex);
+	m_feature.insert(m_feature.end(), 3, 0);
+	return f;
+}
+
+uint32_t HalfEdgeMesh::SplitEdge(uint32_t h, const glm::vec3& p)
+{
+	const uint32_t m = static_cast<uint32_t>(positions.size());
+	positions.push_back(p);
+	m_vertexHalfEdge.push_back(InvalidIndex);
+
+	const uint32_t t = m_twin[h];
+	const uint8_t feature = m_feature[h];
+
+	// face (a, b, c) becomes (a, m, c) and the new (m, b, c)
+	const uint32_t a = From(h);
+	const uint32_t b = To(h);
+	const uint32_t hn = Next(h);
+	const uint32_t c = To(hn);
+	const uint32_t g = AddFace(m, b, c) * 3;
+	Link(g + 1, m_twin[hn]);
+	m_feature[g + 1] = m_feature[hn];
+	m_from[hn] = m;
+	m_feature[hn] = 0;
+	Link(hn, g + 2);
+	m_feature[g] = feature;
+	if (m_vertexHalfEdge[b] == hn) m_vertexHalfEdge[b] = g + 1;
+	m_vertexHalfEdge[m] = g;
+
+	if (t == InvalidIndex)
+	{
+		m_twin[h] = InvalidIndex;
+		m_twin[g] = InvalidIndex;
+		return m;
+	}
+
+	// twin face (b, a, d) becomes (b, m, d) and the new (m, a, d)
+	const uint32_t tn = Next(t);
+	const uint32_t d = To(tn);
+	const uint32_t k = AddFace(m, a, d) * 3;
+	Link(k + 1, m_twin[tn]);
+	m_feature[k + 1] = m_feature[tn];
+	m_from[tn] = m;
+	m_feature[tn] = 0;
+	Link(tn, k + 2);
+	m_feature[k] = feature;
+	if (m_vertexHalfEdge[a] == tn) m_vertexHalfEdge[a] = k + 1;
+
+	Link(h, k);
+	Link(t, g);
+	return m;
+}
+
+bool HalfEdgeMesh::CanCollapse(uint32_t h) const
+{
+	const uint32_t a = From(h);
+	const uint32_t b = To(h);
+	const uint32_t t = m_twin[h];
+	const uint32_t c = To(Next(h));
+	const uint32_t d = (t != InvalidIndex) ? To(Next(t)) : InvalidIndex;
+
+	if (t != InvalidIndex && IsBorderVertex(a) && IsBorderVertex(b))
+	{
+		// would pinch the surface
+		return false;
+	}
+
+	// link condition: the only common neighbors are the opposite vertices
+	thread_local std::vector<uint32_t> na;
+	na.clear();
+	ForEachOutgoing(a, [&](uint32_t o)
+		{
+			na.push_back(To(o));
+			na.push_back(From(Prev(o)));
+		});
+	bool ok = true;
+	ForEachOutgoing(b, [&](uint32_t o)
+		{
+			for (uint32_t n : { To(o), From(Prev(o)) })
+			{
+				if (n != a && n != c && n != d && std::find(na.begin(), na.end(), n) != na.end()) ok = false;
+			}
+		});
+	if (!ok) return false;
+
+	// the opposite vertices lose one edge each
+	for (uint32_t o : { c, d })
+	{
+		if (o == InvalidIndex) continue;
+		if (Valence(o) <= (IsBorderVertex(o) ? 2u : 3u)) return false;
+	}
+	return true;
+}
+
+void HalfEdgeMesh::CollapseEdge(uint32_t h, const glm::vec3& p)
+{
+	const uint32_t a = From(h);
+	const uint32_t b = To(h);
+	const uint32_t t = m_twin[h];
+
+	thread_local std::vector<uint32_t> outgoing;
+	outgoing.clear();
+	ForEachOutgoing(a, [](uint32_t o) { outgoing.push_back(o); });
+
+	// face (a, b, c) vanishes, its outer edges c->b and a->c merge
+	const uint32_t hn = Next(h);
+	const uint32_t hp = Prev(h);
+	const uint32_t c = To(hn);
+	const uint32_t x = m_twin[hn];
+	const uint32_t z = m_twin[hp];
+	const uint8_t featureC = m_feature[hn] | m_feature[hp];
+	Link(x, z);
+	if (x != InvalidIndex) m_feature[x] = featureC;
+	if (z != InvalidIndex) m_feature[z] = featureC;
+
+	uint32_t d = InvalidIndex;
+	uint32_t w = InvalidIndex;
+	uint32_t v = InvalidIndex;
+	if (t != InvalidIndex)
+	{
+		// face (b, a, d) vanishes, its outer edges d->a and b->d merge
+		const uint32_t tn = Next(t);
+		const uint32_t tp = Prev(t);
+		d = To(tn);
+		w = m_twin[tn];
+		v = m_twin[tp];
+		const uint8_t featureD = m_feature[tn] | m_feature[tp];
+		Link(w, v);
+		if (w != InvalidIndex) m_feature[w] = featureD;
+		if (v != InvalidIndex) m_feature[v] = featureD;
+	}
+
+	const uint32_t fh = Face(h);
+	const uint32_t ft = (t != InvalidIndex) ? Face(t) : InvalidIndex;
+	for (uint32_t o : outgoing)
+	{
+		if (Face(o) != fh && Face(o) != ft) m_from[o] = b;
+	}
+	for (uint32_t f : { fh, ft })
+	{
+		if (f == InvalidIndex) continue;
+		for (uint32_t i = f * 3; i < f * 3 + 3; ++i)
+		{
+			m_from[i] = InvalidIndex;
+			m_twin[i] = InvalidIndex;
+			m_feature[i] = 0;
+		}
+	}
+
+	positions[b] = p;
+	m_vertexHalfEdge[a] = InvalidIndex;
+
+	// re-seat the handles that pointed into the removed faces
+	auto pick = [this](std::initializer_list<uint32_t> candidates)
+		{
+			for (uint32_t o : candidates)
+			{
+				if (o != InvalidIndex && IsAlive(o)) return o;
+			}
+			return InvalidIndex;
+		};
+	m_vertexHalfEdge[b] = pick({ z, v,
+		(x != InvalidIndex) ? Next(x) : InvalidIndex,
+		(w != InvalidIndex) ? Next(w) : InvalidIndex });
+	m_vertexHalfEdge[c] = pick({ x, (z != InvalidIndex) ? Next(z) : InvalidIndex });
+	if (d != InvalidIndex)
+	{
+		m_vertexHalfEdge[d] = pick({ w, (v != InvalidIndex) ? Next(v) : InvalidIndex });
+	}
+}
+
+bool HalfEdgeMesh::CanFlip(uint32_t h) const
+{
+	const uint32_t t = m_twin[h];
+	if (t == InvalidIndex || m_feature[h] != 0) return false;
+
+	const uint32_t a = From(h);
+	const uint32_t b = To(h);
+	const uint32_t c = To(Next(h));
+	const uint32_t d = To(Next(t));
+	if (c == d) return false;
+
+	for (uint32_t o : { a, b })
+	{
+		if (Valence(o) <= (IsBorderVertex(o) ? 2u : 3u)) return false;
+	}
+
+	bool exists = false;
+	ForEachOutgoing(c, [&](uint32_t o)
+		{
+			if (To(o) == d || From(Prev(o)) == d) exists = true;
+		});
+	return !exists;
+}
+
+void HalfEdgeMesh::FlipEdge(uint32_t h)
+{
+	const uint32_t t = m_twin[h];
+	const uint32_t hn = Next(h);
+	const uint32_t hp = Prev(h);
+	const uint32_t tn = Next(t);
+	const uint32_t tp = Prev(t);
+
+	const uint32_t a = From(h);
+	const uint32_t b = To(h);
+	const uint32_t c = To(hn);
+	const uint32_t d = To(tn);
+
+	// outer edges: b->c, c->a, a->d, d->b
+	const uint32_t bc = m_twin[hn];
+	const uint32_t ca = m_twin[hp];
+	const uint32_t ad = m_twin[tn];
+	const uint32_t db = m_twin[tp];
+	const uint8_t featureBC = m_feature[hn];
+	const uint8_t featureCA = m_feature[hp];
+	const uint8_t featureAD = m_feature[tn];
+	const uint8_t featureDB = m_feature[tp];
+
+	// (a, b, c) becomes (d, c, a), (b, a, d) becomes (c, d, b)
+	m_from[h] = d;
+	m_from[hn] = c;
+	m_from[hp] = a;
+	m_from[t] = c;
+	m_from[tn] = d;
+	m_from[tp] = b;
+
+	m_twin[hn] = ca;
+	if (ca != InvalidIndex) m_twin[ca] = hn;
+	m_feature[hn] = featureCA;
+	m_twin[hp] = ad;
+	if (ad != InvalidIndex) m_twin[ad] = hp;
+	m_feature[hp] = featureAD;
+	m_twin[tn] = db;
+	if (db != InvalidIndex) m_twin[db] = tn;
+	m_feature[tn] = featureDB;
+	m_twin[tp] = bc;
+	if (bc != InvalidIndex) m_twin[bc] = tp;
+	m_feature[tp] = featureBC;
+
+	m_vertexHalfEdge[a] = hp;
+	m_vertexHalfEdge[b] = tp;
+	m_vertexHalfEdge[c] = hn;
+	m_vertexHalfEdge[d] = tn;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace meshproc
+{
+	namespace data
+	{
+		class Mesh;
+
+		// Editable half-edge structure of a manifold triangle mesh.
+		// The three half-edges of face `f` are `3 * f + 0..2`, so `Next`, `Prev` and `Face` are implicit,
+		// and only the origin vertex and the opposite half-edge are stored.
+		// Removed faces and vertices leave unused slots until `ToMesh`.
+		class HalfEdgeMesh
+		{
+		public:
+			static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+			std::vector<glm::vec3> positions;
+
+			// @return false if an edge is used by more than two triangles or twice in the same direction, or the triangles at a vertex do not form a single fan
+			bool Build(const Mesh& mesh);
+
+			// Writes the remaining vertices and faces, compacted, in their slot order
+			void ToMesh(Mesh& mesh) const;
+
+			inline size_t HalfEdgeSlots() const noexcept
+			{
+				return m_from.size();
+			}
+			inline size_t VertexSlots() const noexcept
+			{
+				return positions.size();
+			}
+
+			static inline uint32_t Face(uint32_t h) noexcept
+			{
+				return h / 3;
+			}
+			static inline uint32_t Next(uint32_t h) noexcept
+			{
+				return (h % 3 == 2) ? h - 2 : h + 1;
+			}
+			static inline uint32_t Prev(uint32_t h) noexcept
+			{
+				return (h % 3 == 0) ? h + 2 : h - 1;
+			}
+			inline uint32_t From(uint32_t h) const noexcept
+			{
+				return m_from[h];
+			}
+			inline uint32_t To(uint32_t h) const noexcept
+			{
+				return m_from[Next(h)];
+			}
+			// opposite half-edge, or InvalidIndex on an open border
+			inline uint32_t Twin(uint32_t h) const noexcept
+			{
+				return m_twin[h];
+			}
+			inline bool IsAlive(uint32_t h) const noexcept
+			{
+				return m_from[h] != InvalidIndex;
+			}
+			inline bool IsVertexAlive(uint32_t v) const noexcept
+			{
+				return m_vertexHalfEdge[v] != InvalidIndex;
+			}
+			// feature edges are neither flipped nor collapsed across; set on both half-edges
+			inline bool IsFeature(uint32_t h) const noexcept
+			{
+				return m_feature[h] != 0;
+			}
+			void SetFeature(uint32_t h, bool feature);
+
+			// Calls `func(uint32_t h)` for all half-edges starting at `v`, in order around `v`, starting at an open border if any
+			template<typename FUNC>
+			void ForEachOutgoing(uint32_t v, FUNC&& func) const
+			{
+				const uint32_t start = FirstOutgoing(v);
+				if (start == InvalidIndex) return;
+				uint32_t h = start;
+				do
+				{
+					func(h);
+					const uint32_t in = m_twin[Prev(h)];
+					if (in == InvalidIndex) break;
+					h = in;
+				} while (h != start);
+			}
+
+			uint32_t Valence(uint32_t v) const;
+			bool IsBorderVertex(uint32_t v) const;
+			// number of feature or open border edges at `v`
+			uint32_t FeatureValence(uint32_t v) const;
+
+			// Splits the edge of `h` and its twin at `p`
+			// @return the new vertex
+			uint32_t SplitEdge(uint32_t h, const glm::vec3& p);
+
+			// Checks the link condition and that no vertex is left with fewer than three edges
+			bool CanCollapse(uint32_t h) const;
+			// Removes `From(h)`, moving `To(h)` to `p`
+			void CollapseEdge(uint32_t h, const glm::vec3& p);
+
+			// Checks that the edge is inner, not a feature, and that the flipped edge does not exist yet
+			bool CanFlip(uint32_t h) const;
+			// Replaces the edge of `h` with the other diagonal of its two triangles
+			void FlipEdge(uint32_t h);
+
+		private:
+			// outgoing half-edge of `v` furthest against the order of `ForEachOutgoing`
+			uint32_t FirstOutgoing(uint32_t v) const;
+
+			inline void Link(uint32_t a, uint32_t b)
+			{
+				if (a != InvalidIndex) m_twin[a] = b;
+				if (b != InvalidIndex) m_twin[b] = a;
+			}
+
+			uint32_t AddFace(uint32_t v0, uint32_t v1, uint32_t v2);
+
+			std::vector<uint32_t> m_from;
+			std::vector<uint32_t> m_twin;
+			std::vector<uint8_t> m_feature;
+			std::vector<uint32_t> m_vertexHalfEdge;
+		};
+
+	}
+}
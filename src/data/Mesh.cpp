@@ -1,5 +1,7 @@
 #include "Mesh.h"
 
+#include "data/Bvh.h"
+
 #include <cmath>
 
 using namespace meshproc;
@@ -97,3 +99,12 @@ void Mesh::RemoveIsolatedVertices()
 		}
 	}
 }
+
+std::shared_ptr<const Bvh> Mesh::GetBvh() const
+{
+	if (!m_bvh || !m_bvh->IsBuiltFor(*this))
+	{
+		m_bvh = std::make_shared<const Bvh>(*this);
+	}
+	return m_bvh;
+}
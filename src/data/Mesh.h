@@ -1,49 +1,64 @@
-#pragma once
-
-#include "data/Triangle.h"
-
-#include <glm/glm.hpp>
-
-#include <unordered_set>
-#include <vector>
-
-namespace meshproc
-{
-	namespace data
-	{
-
-		class Mesh
-		{
-		public:
-
-			std::vector<glm::vec3> vertices;
-			std::vector<Triangle> triangles;
-
-			inline void AddQuad(unsigned int i1, unsigned int i2, unsigned int i3, unsigned int i4, bool rotate = false)
-			{
-				if (rotate)
-				{
-					triangles.push_back(Triangle{ i1, i2, i4 });
-					triangles.push_back(Triangle{ i3, i1, i4 });
-				}
-				else
-				{
-					triangles.push_back(Triangle{ i1, i2, i3 });
-					triangles.push_back(Triangle{ i3, i2, i4 });
-				}
-			}
-
-			// Checks for structural validity.
-			// Does not include checking for:
-			// - T-vertices
-			// - non-manifolds (edges used by != 2 triangles)
-			// - congruent vertices and thus degenerated triangles
-			bool IsValid() const;
-
-			std::unordered_set<data::HashableEdge> CollectOpenEdges() const;
-
-			void RemoveIsolatedVertices();
-		};
-
-	}
+#pragma once
+
+#include "data/Triangle.h"
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace meshproc
+{
+	namespace data
+	{
+		class Bvh;
+
+		class Mesh
+		{
+		public:
+
+			std::vector<glm::vec3> vertices;
+			std::vector<Triangle> triangles;
+
+			inline void AddQuad(unsigned int i1, unsigned int i2, unsigned int i3, unsigned int i4, bool rotate = false)
+			{
+				if (rotate)
+				{
+					triangles.push_back(Triangle{ i1, i2, i4 });
+					triangles.push_back(Triangle{ i3, i1, i4 });
+				}
+				else
+				{
+					triangles.push_back(Triangle{ i1, i2, i3 });
+					triangles.push_back(Triangle{ i3, i2, i4 });
+				}
+			}
+
+			// Checks for structural validity.
+			// Does not include checking for:
+			// - T-vertices
+			// - non-manifolds (edges used by != 2 triangles)
+			// - congruent vertices and thus degenerated triangles
+			bool IsValid() const;
+
+			std::unordered_set<data::HashableEdge> CollectOpenEdges() const;
+
+			void RemoveIsolatedVertices();
+
+			// Bounding volume hierarchy of the triangles, built on first use, and rebuilt when the vertices or triangles changed.
+			// Detecting changes hashes the mesh data, which is linear but much cheaper than the build. Not thread-safe.
+			std::shared_ptr<const Bvh> GetBvh() const;
+
+			// Drops the cached bounding volume hierarchy, which copies of the mesh share, so the next `GetBvh` builds it anew
+			inline void ResetBvh()
+			{
+				m_bvh.reset();
+			}
+
+		private:
+			mutable std::shared_ptr<const Bvh> m_bvh;
+		};
+
+	}
 }
\ No newline at end of file
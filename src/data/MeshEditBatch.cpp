@@ -0,0 +1,183 @@
+#include "MeshEditBatch.h"
+
+#include "data/Mesh.h"
+
+#include <algorithm>
+
+using namespace meshproc;
+using namespace meshproc::data;
+
+namespace
+{
+	// @return true if newly marked
+	bool Mark(std::vector<uint8_t>& flags, uint32_t index)
+	{
+		if (index >= flags.size())
+		{
+			flags.resize(static_cast<size_t>(index) + 1, 0);
+		}
+		if (flags[index] != 0)
+		{
+			return false;
+		}
+		flags[index] = 1;
+		return true;
+	}
+
+	// Keeps the elements not marked in `removed`, in the sequence of `order`, or in place if `order` is empty
+	// @param remap if not null, receives `remap[oldIndex] = newIndex`, `RemovedIndex` for removed elements
+	template<typename T>
+	void Compact(std::vector<T>& elements, const std::vector<uint8_t>& removed, const std::vector<uint32_t>& order, std::vector<uint32_t>* remap)
+	{
+		auto isRemoved = [&removed](size_t i)
+			{
+				return i < removed.size() && removed[i] != 0;
+			};
+		if (remap != nullptr)
+		{
+			remap->assign(elements.size(), MeshEditBatch::RemovedIndex);
+		}
+
+		if (order.empty())
+		{
+			size_t next = 0;
+			for (size_t i = 0; i < elements.size(); ++i)
+			{
+				if (isRemoved(i)) continue;
+				if (remap != nullptr) (*remap)[i] = static_cast<uint32_t>(next);
+				elements[next++] = elements[i];
+			}
+			elements.resize(next);
+			return;
+		}
+
+		std::vector<T> reordered;
+		reordered.reserve(elements.size());
+		for (uint32_t i : order)
+		{
+			if (isRemoved(i)) continue;
+			if (remap != nullptr) (*remap)[i] = static_cast<uint32_t>(reordered.size());
+			reordered.push_back(elements[i]);
+		}
+		elements = std::move(reordered);
+	}
+}
+
+MeshEditBatch::MeshEditBatch(const Mesh& mesh)
+	: m_vertexCount{ static_cast<uint32_t>(mesh.vertices.size()) }
+	, m_triangleCount{ static_cast<uint32_t>(mesh.triangles.size()) }
+{
+}
+
+void MeshEditBatch::RemoveVertex(uint32_t index)
+{
+	if (Mark(m_removedVertices, index))
+	{
+		m_removedVertexCount++;
+	}
+}
+
+void MeshEditBatch::RemoveTriangle(uint32_t index)
+{
+	if (Mark(m_removedTriangles, index))
+	{
+		m_removedTriangleCount++;
+	}
+}
+
+bool MeshEditBatch::InsertVertex(uint32_t index, uint32_t position)
+{
+	if (index < m_vertexCount || position > m_vertexCount)
+	{
+		return false;
+	}
+	m_insertedVertices.push_back(std::make_pair(index, position));
+	return true;
+}
+
+bool MeshEditBatch::InsertTriangle(uint32_t index, uint32_t position)
+{
+	if (index < m_triangleCount || position > m_triangleCount)
+	{
+		return false;
+	}
+	m_insertedTriangles.push_back(std::make_pair(index, position));
+	return true;
+}
+
+std::vector<uint32_t> MeshEditBatch::Apply(Mesh& mesh)
+{
+	std::vector<uint32_t> remap;
+	Compact(mesh.vertices, m_removedVertices, InsertOrder(mesh.vertices.size(), m_insertedVertices), &remap);
+
+	if (m_removedTriangleCount > 0 || !m_insertedTriangles.empty())
+	{
+		Compact(mesh.triangles, m_removedTriangles, InsertOrder(mesh.triangles.size(), m_insertedTriangles), nullptr);
+	}
+	if (m_removedVertexCount > 0 || !m_insertedVertices.empty())
+	{
+		RemapTriangles(mesh.triangles, remap);
+	}
+
+	m_removedVertices.clear();
+	m_removedTriangles.clear();
+	m_removedVertexCount = 0;
+	m_removedTriangleCount = 0;
+	m_insertedVertices.clear();
+	m_insertedTriangles.clear();
+	m_vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+	m_triangleCount = static_cast<uint32_t>(mesh.triangles.size());
+
+	return remap;
+}
+
+std::vector<uint32_t> MeshEditBatch::InsertOrder(size_t count, InsertList& inserts)
+{
+	std::vector<uint32_t> order;
+	if (inserts.empty())
+	{
+		return order;
+	}
+
+	std::stable_sort(inserts.begin(), inserts.end(), [](const auto& a, const auto& b) { return a.second < b.second; });
+	std::vector<uint8_t> moved(count, 0);
+	for (const auto& ins : inserts)
+	{
+		if (ins.first < count) moved[ins.first] = 1;
+	}
+
+	order.reserve(count);
+	size_t next = 0;
+	for (size_t i = 0; i <= count; ++i)
+	{
+		for (; next < inserts.size() && inserts[next].second == i; ++next)
+		{
+			if (inserts[next].first < count) order.push_back(inserts[next].first);
+		}
+		if (i < count && moved[i] == 0)
+		{
+			order.push_back(static_cast<uint32_t>(i));
+		}
+	}
+	return order;
+}
+
+void MeshEditBatch::RemapTriangles(std::vector<Triangle>& triangles, const std::vector<uint32_t>& remap)
+{
+	auto lookup = [&remap](uint32_t i)
+		{
+			return (i < remap.size()) ? remap[i] : RemovedIndex;
+		};
+
+	size_t write = 0;
+	for (size_t i = 0; i < triangles.size(); ++i)
+	{
+		const Triangle& t = triangles[i];
+		const uint32_t a = lookup(t[0]);
+		const uint32_t b = lookup(t[1]);
+		const uint32_t c = lookup(t[2]);
+		if (a == RemovedIndex || b == RemovedIndex || c == RemovedIndex) continue;
+		triangles[write++] = Triangle{ a, b, c };
+	}
+	triangles.resize(write);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "data/Triangle.h"
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace meshproc
+{
+	namespace data
+	{
+		class Mesh;
+
+		// Deferred removal and positioned insertion of vertices and triangles, applied to a mesh in one linear pass.
+		// All indices refer to the mesh state before applying the batch.
+		class MeshEditBatch
+		{
+		public:
+			static constexpr uint32_t RemovedIndex = std::numeric_limits<uint32_t>::max();
+
+			MeshEditBatch() = default;
+			// Positions of inserts refer to the vertices and triangles of `mesh` at this point
+			explicit MeshEditBatch(const Mesh& mesh);
+
+			void RemoveVertex(uint32_t index);
+			void RemoveTriangle(uint32_t index);
+
+			// Moves the element at `index`, appended after the batch began, in front of the element at `position`,
+			// an index into the elements the batch began with, or their count to place it behind them.
+			// Elements moved to the same position keep the order of the calls.
+			// @return false if `position` is out of range
+			bool InsertVertex(uint32_t index, uint32_t position);
+			bool InsertTriangle(uint32_t index, uint32_t position);
+
+			bool IsEmpty() const noexcept
+			{
+				return m_removedVertexCount == 0 && m_removedTriangleCount == 0
+					&& m_insertedVertices.empty() && m_insertedTriangles.empty();
+			}
+
+			// Removes the marked vertices, all triangles referencing them, and the marked triangles,
+			// moves the inserted vertices and triangles to their positions, then resets the batch.
+			// @return remap table `remap[oldIndex] = newIndex` of the vertices, `RemovedIndex` for removed vertices
+			std::vector<uint32_t> Apply(Mesh& mesh);
+
+			// Rewrites the vertex indices of the `triangles` by `remap`, and removes triangles referencing removed vertices
+			static void RemapTriangles(std::vector<Triangle>& triangles, const std::vector<uint32_t>& remap);
+
+		private:
+			// (index, position) pairs
+			typedef std::vector<std::pair<uint32_t, uint32_t>> InsertList;
+
+			// @return the new order of the `count` elements as old indices, with moved elements at their positions
+			static std::vector<uint32_t> InsertOrder(size_t count, InsertList& inserts);
+
+			std::vector<uint8_t> m_removedVertices;
+			std::vector<uint8_t> m_removedTriangles;
+			size_t m_removedVertexCount{ 0 };
+			size_t m_removedTriangleCount{ 0 };
+
+			uint32_t m_vertexCount{ 0 };
+			uint32_t m_triangleCount{ 0 };
+			InsertList m_insertedVertices;
+			InsertList m_insertedTriangles;
+		};
+
+	}
+}
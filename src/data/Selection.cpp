@@ -0,0 +1,120 @@
+#include "Selection.h"
+
+#include <algorithm>
+
+using namespace meshproc;
+using namespace meshproc::data;
+
+Selection::Selection(size_t size)
+	: m_words(WordCount(size), 0), m_size{ size }
+{
+}
+
+Selection Selection::FromIndices(const std::vector<uint32_t>& indices, size_t size)
+{
+	for (uint32_t i : indices)
+	{
+		size = std::max<size_t>(size, static_cast<size_t>(i) + 1);
+	}
+	Selection sel{ size };
+	for (uint32_t i : indices)
+	{
+		sel.m_words[i >> 6] |= uint64_t{ 1 } << (i & 63);
+	}
+	return sel;
+}
+
+std::vector<uint32_t> Selection::ToIndices() const
+{
+	std::vector<uint32_t> indices;
+	indices.reserve(Count());
+	ForEach([&indices](uint32_t i) { indices.push_back(i); });
+	return indices;
+}
+
+void Selection::Resize(size_t size)
+{
+	m_words.resize(WordCount(size), 0);
+	m_size = size;
+	ClearTail();
+}
+
+size_t Selection::Count() const noexcept
+{
+	size_t cnt = 0;
+	for (uint64_t w : m_words)
+	{
+		cnt += std::popcount(w);
+	}
+	return cnt;
+}
+
+bool Selection::Any() const noexcept
+{
+	return std::any_of(m_words.begin(), m_words.end(), [](uint64_t w) { return w != 0; });
+}
+
+// The word loops below are plain element-wise operations on contiguous arrays, which the compiler vectorizes
+
+void Selection::Union(const Selection& other)
+{
+	if (other.m_size > m_size)
+	{
+		Resize(other.m_size);
+	}
+	uint64_t* dst = m_words.data();
+	const uint64_t* src = other.m_words.data();
+	const size_t cnt = other.m_words.size();
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		dst[i] |= src[i];
+	}
+}
+
+void Selection::Intersect(const Selection& other)
+{
+	uint64_t* dst = m_words.data();
+	const uint64_t* src = other.m_words.data();
+	const size_t cnt = std::min(m_words.size(), other.m_words.size());
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		dst[i] &= src[i];
+	}
+	std::fill(m_words.begin() + cnt, m_words.end(), 0);
+}
+
+void Selection::Subtract(const Selection& other)
+{
+	uint64_t* dst = m_words.data();
+	const uint64_t* src = other.m_words.data();
+	const size_t cnt = std::min(m_words.size(), other.m_words.size());
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		dst[i] &= ~src[i];
+	}
+}
+
+void Selection::Invert() noexcept
+{
+	uint64_t* dst = m_words.data();
+	const size_t cnt = m_words.size();
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		dst[i] = ~dst[i];
+	}
+	ClearTail();
+}
+
+void Selection::Clear() noexcept
+{
+	std::fill(m_words.begin(), m_words.end(), 0);
+}
+
+void Selection::ClearTail() noexcept
+{
+	const size_t rest = m_size & 63;
+	if (rest != 0)
+	{
+		m_words.back() &= (uint64_t{ 1 } << rest) - 1;
+	}
+}
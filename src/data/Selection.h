@@ -0,0 +1,98 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace meshproc
+{
+	namespace data
+	{
+
+		// Dense bitset over element indices, e.g. vertices or triangles
+		// Set operations work on whole 64-bit words; bits beyond `Size()` are always zero.
+		class Selection
+		{
+		public:
+			Selection() = default;
+			explicit Selection(size_t size);
+
+			// @param size minimum size; grows to include the largest index
+			static Selection FromIndices(const std::vector<uint32_t>& indices, size_t size = 0);
+			// @return the selected indices, ascending
+			std::vector<uint32_t> ToIndices() const;
+
+			inline size_t Size() const noexcept
+			{
+				return m_size;
+			}
+			void Resize(size_t size);
+
+			inline bool Get(size_t index) const noexcept
+			{
+				return index < m_size && ((m_words[index >> 6] >> (index & 63)) & 1) != 0;
+			}
+			inline void Set(size_t index, bool selected = true)
+			{
+				if (index >= m_size)
+				{
+					if (!selected) return;
+					Resize(index + 1);
+				}
+				const uint64_t bit = uint64_t{ 1 } << (index & 63);
+				if (selected)
+				{
+					m_words[index >> 6] |= bit;
+				}
+				else
+				{
+					m_words[index >> 6] &= ~bit;
+				}
+			}
+
+			// @return the number of selected elements
+			size_t Count() const noexcept;
+			bool Any() const noexcept;
+
+			// Set operations; the size of the result is the larger of both sizes for `Union`, and the size of this selection otherwise
+			void Union(const Selection& other);
+			void Intersect(const Selection& other);
+			void Subtract(const Selection& other);
+			void Invert() noexcept;
+			void Clear() noexcept;
+
+			// Calls `func(uint32_t index)` for all selected elements, ascending
+			template<typename FUNC>
+			void ForEach(FUNC&& func) const
+			{
+				for (size_t w = 0; w < m_words.size(); ++w)
+				{
+					uint64_t bits = m_words[w];
+					while (bits != 0)
+					{
+						func(static_cast<uint32_t>((w << 6) + std::countr_zero(bits)));
+						bits &= bits - 1;
+					}
+				}
+			}
+
+			inline const std::vector<uint64_t>& Words() const noexcept
+			{
+				return m_words;
+			}
+
+		private:
+			static constexpr size_t WordCount(size_t size) noexcept
+			{
+				return (size + 63) >> 6;
+			}
+
+			// zeroes the bits of the last word beyond `m_size`
+			void ClearTail() noexcept;
+
+			std::vector<uint64_t> m_words;
+			size_t m_size{ 0 };
+		};
+
+	}
+}
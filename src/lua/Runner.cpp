@@ -5,6 +5,8 @@
 
 #include "LogFunctions.h"
 //#include "Shape2DType.h"
+#include "ThreadFunctions.h"
+#include "TraceFunctions.h"
 #include "VersionCheck.h"
 
 #include "types/CommandType.h"
@@ -13,6 +15,9 @@
 #include "types/IndexListListType.h"
 #include "types/IndexListType.h"
 #include "types/SceneType.h"
+#include "types/SelectionType.h"
+#include "types/StreamPipelineType.h"
+#include "types/StringListType.h"
 #include "types/MeshListType.h"
 #include "types/MeshType.h"
 #include "types/GlmVec3ListType.h"
@@ -21,6 +26,8 @@
 #define IMPL_COMPONENTS(FUNC) \
 	FUNC(LogFunctions) \
 /*	FUNC(Shape2DType) */ \
+	FUNC(ThreadFunctions) \
+	FUNC(TraceFunctions) \
 	FUNC(VersionCheck) \
 	FUNC(types, CommandType) \
 	FUNC(types, FloatListType) \
@@ -31,12 +38,16 @@
 	FUNC(types, IndexListListType) \
 	FUNC(types, MeshType) \
 	FUNC(types, MeshListType) \
-	FUNC(types, SceneType)
+	FUNC(types, SceneType) \
+	FUNC(types, SelectionType) \
+	FUNC(types, StreamPipelineType) \
+	FUNC(types, StringListType)
 
 #include "commands/AbstractCommand.h"
 #include "commands/CommandFactory.h"
 #include "commands/ParameterBinding.h"
 #include "utilities/StringUtilities.h"
+#include "utilities/Trace.h"
 
 #include <SimpleLog/SimpleLog.hpp>
 
@@ -146,6 +157,7 @@ bool Runner::Init()
 
 bool Runner::RegisterCommands()
 {
+	utilities::Trace::Span span{ "RegisterCommands" };
 	if (!AssertStateReady()) return false;
 	if (!m_components) return false;
 	return m_components->m_CommandCreator.RegisterCommands();
@@ -153,6 +165,7 @@ bool Runner::RegisterCommands()
 
 bool Runner::LoadScript(const std::filesystem::path& script)
 {
+	utilities::Trace::Span span{ "LoadScript" };
 	if (!AssertStateReady()) return false;
 
 	// script is assumed to be utf8 without BOM
@@ -211,6 +224,7 @@ bool Runner::SetArgs(const std::unordered_map<std::wstring_view, std::wstring_vi
 
 bool Runner::RunScript()
 {
+	utilities::Trace::Span span{ "RunScript" };
 	if (!AssertStateReady()) return false;
 
 	std::filesystem::path oldCurrentPath = std::filesystem::current_path();
@@ -17,6 +17,7 @@ namespace meshproc
 	namespace commands
 	{
 		class CommandFactory;
+		class CommandProfiler;
 	}
 
 	namespace lua
@@ -61,6 +62,12 @@ namespace meshproc
 					return m_owner.m_log;
 				}
 
+				// nullptr unless profiling is enabled
+				inline commands::CommandProfiler* Profiler() const
+				{
+					return m_owner.m_profiler.get();
+				}
+
 				template<typename T>
 				T* GetComponent() const
 				{
@@ -80,6 +87,11 @@ namespace meshproc
 			bool SetArgs(const std::unordered_map<std::wstring_view, std::wstring_view>& args);
 			bool RunScript();
 
+			inline void SetProfiler(std::shared_ptr<commands::CommandProfiler> profiler)
+			{
+				m_profiler = profiler;
+			}
+
 		private:
 			class Components;
 
@@ -96,6 +108,7 @@ namespace meshproc
 			std::shared_ptr<lua_State> m_state;
 			std::shared_ptr<Components> m_components;
 			std::filesystem::path m_workingDirectory;
+			std::shared_ptr<commands::CommandProfiler> m_profiler;
 		};
 
 	}
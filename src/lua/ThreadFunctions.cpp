@@ -0,0 +1,58 @@
+#include "ThreadFunctions.h"
+
+#include "utilities/TaskScheduler.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <lua.hpp>
+
+using namespace meshproc;
+using namespace meshproc::lua;
+
+bool ThreadFunctions::Init()
+{
+	if (!AssertStateReady()) return false;
+
+	static const struct luaL_Reg staticFuncs[] = {
+		{"set_threads", &ThreadFunctions::CallbackSetThreads},
+		{"get_threads", &ThreadFunctions::CallbackGetThreads},
+		{NULL, NULL}
+	};
+
+	lua_getglobal(lua(), "meshproc");		// load global "meshproc"
+	luaL_setfuncs(lua(), staticFuncs, 0);	// Add static functions directly to "meshproc"
+	lua_pop(lua(), 1);						// remove "meshproc" from stack
+
+	return true;
+}
+
+int ThreadFunctions::CallbackSetThreads(lua_State* lua)
+{
+	return CallLuaImpl(&ThreadFunctions::SetThreadsImpl, lua);
+}
+
+int ThreadFunctions::CallbackGetThreads(lua_State* lua)
+{
+	lua_pushinteger(lua, static_cast<lua_Integer>(utilities::TaskScheduler::Instance().GetThreadCount()));
+	return 1;
+}
+
+int ThreadFunctions::SetThreadsImpl(lua_State* lua)
+{
+	const int size = lua_gettop(lua);
+	if (size != 1)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 1, is %d", size);
+	}
+	const lua_Integer count = luaL_checkinteger(lua, 1);
+	if (count < 0)
+	{
+		return luaL_error(lua, "Number of threads must not be negative");
+	}
+
+	utilities::TaskScheduler& tasks = utilities::TaskScheduler::Instance();
+	tasks.SetThreadCount(static_cast<uint32_t>(count));
+	Log().Detail("Using %u threads", tasks.GetThreadCount());
+
+	return 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Runner.h"
+
+namespace meshproc
+{
+	namespace lua
+	{
+
+		class ThreadFunctions : public Runner::Component<ThreadFunctions>
+		{
+		public:
+			ThreadFunctions(Runner& owner)
+				: Component<ThreadFunctions>{ owner }
+			{};
+
+			bool Init();
+
+		private:
+			static int CallbackSetThreads(lua_State* lua);
+			static int CallbackGetThreads(lua_State* lua);
+
+			int SetThreadsImpl(lua_State* lua);
+		};
+
+	}
+}
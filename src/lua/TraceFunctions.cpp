@@ -0,0 +1,48 @@
+#include "TraceFunctions.h"
+
+#include "utilities/Trace.h"
+
+#include <lua.hpp>
+
+#include <string>
+
+using namespace meshproc;
+using namespace meshproc::lua;
+
+namespace
+{
+	constexpr char const* GcSentinelTypeName = "SGR.MeshProc.GcSentinel";
+}
+
+bool TraceFunctions::Init()
+{
+	if (!AssertStateReady()) return false;
+	if (!utilities::Trace::Instance().IsEnabled()) return true;
+
+	luaL_newmetatable(lua(), GcSentinelTypeName);
+	lua_pushcfunction(lua(), &TraceFunctions::CallbackGcSentinel);
+	lua_setfield(lua(), -2, "__gc");
+	lua_pop(lua(), 1);
+
+	CreateGcSentinel(lua());
+
+	return true;
+}
+
+int TraceFunctions::CallbackGcSentinel(lua_State* lua)
+{
+	// the sentinel is finalized once per completed collection cycle
+	const int memKb = lua_gc(lua, LUA_GCCOUNT);
+	utilities::Trace::Instance().AddInstant("Lua GC", "lua", "{\"memory_kb\": " + std::to_string(memKb) + "}");
+	CreateGcSentinel(lua);
+	return 0;
+}
+
+void TraceFunctions::CreateGcSentinel(lua_State* lua)
+{
+	// an unreferenced userdata, collected by the next garbage collection cycle
+	lua_newuserdatauv(lua, 1, 0);
+	luaL_getmetatable(lua, GcSentinelTypeName);
+	lua_setmetatable(lua, -2);
+	lua_pop(lua, 1);
+}
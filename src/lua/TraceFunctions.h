@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Runner.h"
+
+namespace meshproc
+{
+	namespace lua
+	{
+
+		// Records Lua garbage collection cycles into the trace, if tracing is enabled
+		class TraceFunctions : public Runner::Component<TraceFunctions>
+		{
+		public:
+			TraceFunctions(Runner& owner)
+				: Component<TraceFunctions>{ owner }
+			{};
+
+			bool Init();
+
+		private:
+			static int CallbackGcSentinel(lua_State* lua);
+
+			static void CreateGcSentinel(lua_State* lua);
+		};
+
+	}
+}
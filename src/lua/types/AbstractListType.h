@@ -3,6 +3,7 @@
 #include "AbstractType.h"
 
 #include "lua/LuaUtilities.h"
+#include "utilities/ListOps.h"
 
 #include <vector>
 #include <memory>
@@ -23,6 +24,11 @@ namespace meshproc
 				{
 					return AbstractType<std::vector<TINNERVAR>, TIMPL>::LuaGet(lua, idx);
 				}
+				// list for operations changing the number of elements; views are detached from their owner's storage first
+				static listptr_t LuaGetListForResize(lua_State* lua, int idx)
+				{
+					return AbstractType<std::vector<TINNERVAR>, TIMPL>::LuaGetDetached(lua, idx);
+				}
 
 				static void OnInserted(lua_State* /*lua*/, int /*idx*/, listptr_t /*list*/, uint32_t /*idxZeroBase*/) {}
 				static void OnRemoved(lua_State* /*lua*/, int /*idx*/, listptr_t /*list*/, uint32_t /*idxZeroBase*/) {}
@@ -40,6 +46,25 @@ namespace meshproc
 
 				using MyAbstractType = AbstractType<std::vector<TINNERVAR>, TIMPL>;
 
+				// @return the IndexList at `idx`, or nullptr if the value is no IndexList
+				static std::shared_ptr<std::vector<uint32_t>> LuaGetIndexList(lua_State* lua, int idx)
+				{
+					void* ud = luaL_testudata(lua, idx, LUA_INDEX_LIST_TYPE_NAME);
+					if (ud == nullptr)
+					{
+						return nullptr;
+					}
+
+					//
+					// re-definition of private and inaccassible "AbstractType<std::vector<uint32_t>, IndexListType>::wrapped"
+					// This is required to break a cyclic dependency
+					//
+					struct WrappedIndices {
+						std::shared_ptr<std::vector<uint32_t>> indices;
+					};
+					return static_cast<WrappedIndices*>(ud)->indices;
+				}
+
 				static int CallbackCtor(lua_State* lua)
 				{
 					MyAbstractType::LuaPush(lua, std::make_shared<std::vector<TINNERVAR>>());
@@ -84,15 +109,13 @@ namespace meshproc
 
 					uint32_t idx = 0;
 
-					if (lua_isstring(lua, 2))
+					// `lua_isstring` is also true for numbers, so check the actual type to keep element access fast
+					if (lua_type(lua, 2) == LUA_TSTRING)
 					{
 						// try to load function callback
-						size_t len;
-						std::string name = luaL_tolstring(lua, 2, &len); // copy type string
-
 						luaL_getmetatable(lua, TIMPL::LUA_TYPE_NAME);
-
-						lua_getfield(lua, -1, name.c_str());
+						lua_pushvalue(lua, 2);
+						lua_rawget(lua, -2);
 
 						if (lua_isnil(lua, -1))
 						{
@@ -164,7 +187,7 @@ namespace meshproc
 						return luaL_error(lua, "Arguments number mismatch: must be 2 or 3, is %d", argcnt);
 					}
 
-					const typename TLISTTRAITS::listptr_t list = TLISTTRAITS::LuaGetList(lua, 1);
+					const typename TLISTTRAITS::listptr_t list = TLISTTRAITS::LuaGetListForResize(lua, 1);
 					if (!list)
 					{
 						return luaL_error(lua, "Pre-First argument expected to be a IndexList");
@@ -215,7 +238,7 @@ namespace meshproc
 						return luaL_error(lua, "Arguments number mismatch: must be 1 or 2, is %d", argcnt);
 					}
 
-					const typename TLISTTRAITS::listptr_t list = TLISTTRAITS::LuaGetList(lua, 1);
+					const typename TLISTTRAITS::listptr_t list = TLISTTRAITS::LuaGetListForResize(lua, 1);
 					if (!list)
 					{
 						return luaL_error(lua, "Pre-First argument expected to be a IndexList");
@@ -230,23 +253,13 @@ namespace meshproc
 
 					if (lua_isuserdata(lua, 2))
 					{
-						void* ud = luaL_checkudata(lua, 2, LUA_INDEX_LIST_TYPE_NAME);
-						if (ud != nullptr)
+						const std::shared_ptr<std::vector<uint32_t>> indices = LuaGetIndexList(lua, 2);
+						if (indices)
 						{
 							// param is an IndexListType -> optimized implementation
-
-							//
-							// re-definition of private and inaccassible "AbstractType<std::vector<uint32_t>, IndexListType>::wrapped"
-							// This is required to break a cyclic dependency
-							//
-							struct WrappedIndices {
-								std::shared_ptr<std::vector<uint32_t>> indices;
-							};
-							WrappedIndices* wrappedIndices = static_cast<WrappedIndices*>(ud);
-
 							std::vector<uint32_t> ids;
-							ids.resize(wrappedIndices->indices->size());
-							std::copy(wrappedIndices->indices->begin(), wrappedIndices->indices->end(), ids.begin());
+							ids.resize(indices->size());
+							std::copy(indices->begin(), indices->end(), ids.begin());
 
 							std::sort(ids.begin(), ids.end());
 							ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
@@ -267,6 +280,7 @@ namespace meshproc
 							}
 
 							list->resize(write);
+							ids.resize(next_id_index); // indices beyond the list end were not removed
 
 							TLISTTRAITS::OnManyRemoved(lua, 1, list, ids);
 							return 0;
@@ -301,7 +315,7 @@ namespace meshproc
 						return luaL_error(lua, "Arguments number mismatch: must be 2, is %d", argcnt);
 					}
 
-					const typename TLISTTRAITS::listptr_t list = TLISTTRAITS::LuaGetList(lua, 1);
+					const typename TLISTTRAITS::listptr_t list = TLISTTRAITS::LuaGetListForResize(lua, 1);
 					if (!list)
 					{
 						return luaL_error(lua, "Pre-First argument expected to be a IndexList");
@@ -323,6 +337,210 @@ namespace meshproc
 					return 0;
 				}
 
+				static int CallbackClone(lua_State* lua)
+				{
+					const int argcnt = lua_gettop(lua);
+					if (argcnt != 1)
+					{
+						return luaL_error(lua, "Arguments number mismatch: must be 1, is %d", argcnt);
+					}
+
+					const typename TLISTTRAITS::listptr_t list = TLISTTRAITS::LuaGetList(lua, 1);
+					if (!list)
+					{
+						return luaL_error(lua, "Pre-First argument expected to be a list");
+					}
+
+					MyAbstractType::LuaPush(lua, std::make_shared<std::vector<TINNERVAR>>(*list));
+					return 1;
+				}
+
+				static int CallbackFill(lua_State* lua)
+				{
+					const int argcnt = lua_gettop(lua);
+					if (argcnt != 2)
+					{
+						return luaL_error(lua, "Arguments number mismatch: must be 2, is %d", argcnt);
+					}
+
+					const typename TLISTTRAITS::listptr_t list = TLISTTRAITS::LuaGetList(lua, 1);
+					if (!list)
+					{
+						return luaL_error(lua, "Pre-First argument expected to be a list");
+					}
+
+					TINNERVAR val;
+					if (!TIMPL::LuaGetElement(lua, 2, val))
+					{
+						return luaL_error(lua, "Failed to get value argument");
+					}
+
+					utilities::ListOps::Transform(*list, [val](const TINNERVAR&) { return val; });
+
+					lua_pushvalue(lua, 1);
+					return 1;
+				}
+
+				// slice(first [, last]) -> new list with the elements `first` to `last` (inclusive, one-based)
+				static int CallbackSlice(lua_State* lua)
+				{
+					const int argcnt = lua_gettop(lua);
+					if ((argcnt != 2) && (argcnt != 3))
+					{
+						return luaL_error(lua, "Arguments number mismatch: must be 2 or 3, is %d", argcnt);
+					}
+
+					const typename TLISTTRAITS::listptr_t list = TLISTTRAITS::LuaGetList(lua, 1);
+					if (!list)
+					{
+						return luaL_error(lua, "Pre-First argument expected to be a list");
+					}
+
+					uint32_t first, last = static_cast<uint32_t>(list->size());
+					if (GetLuaUint32(lua, 2, first) != GetResult::Ok)
+					{
+						return luaL_error(lua, "Failed to get first index argument integer");
+					}
+					if (argcnt == 3 && GetLuaUint32(lua, 3, last) != GetResult::Ok)
+					{
+						return luaL_error(lua, "Failed to get last index argument integer");
+					}
+					if (first == 0 || last > list->size())
+					{
+						return luaL_error(lua, "Invalid slice range [%d, %d] of %d elements", first, last, static_cast<int>(list->size()));
+					}
+
+					auto result = std::make_shared<std::vector<TINNERVAR>>();
+					if (last >= first)
+					{
+						result->assign(list->begin() + (first - 1), list->begin() + last);
+					}
+					MyAbstractType::LuaPush(lua, result);
+					return 1;
+				}
+
+				// gather(indices) -> new list with the elements at the `indices`
+				static int CallbackGather(lua_State* lua)
+				{
+					const int argcnt = lua_gettop(lua);
+					if (argcnt != 2)
+					{
+						return luaL_error(lua, "Arguments number mismatch: must be 2, is %d", argcnt);
+					}
+
+					const typename TLISTTRAITS::listptr_t list = TLISTTRAITS::LuaGetList(lua, 1);
+					if (!list)
+					{
+						return luaL_error(lua, "Pre-First argument expected to be a list");
+					}
+					const std::shared_ptr<std::vector<uint32_t>> indices = LuaGetIndexList(lua, 2);
+					if (!indices)
+					{
+						return luaL_error(lua, "First argument expected to be an IndexList");
+					}
+
+					auto result = std::make_shared<std::vector<TINNERVAR>>();
+					if (!utilities::ListOps::Gather(*list, *indices, *result))
+					{
+						return luaL_error(lua, "IndexList references elements out of range");
+					}
+					MyAbstractType::LuaPush(lua, result);
+					return 1;
+				}
+
+				// scatter(indices, values) sets the elements at the `indices` to the `values`, a list or a single value
+				static int CallbackScatter(lua_State* lua)
+				{
+					const int argcnt = lua_gettop(lua);
+					if (argcnt != 3)
+					{
+						return luaL_error(lua, "Arguments number mismatch: must be 3, is %d", argcnt);
+					}
+
+					const typename TLISTTRAITS::listptr_t list = TLISTTRAITS::LuaGetList(lua, 1);
+					if (!list)
+					{
+						return luaL_error(lua, "Pre-First argument expected to be a list");
+					}
+					const std::shared_ptr<std::vector<uint32_t>> indices = LuaGetIndexList(lua, 2);
+					if (!indices)
+					{
+						return luaL_error(lua, "First argument expected to be an IndexList");
+					}
+
+					std::shared_ptr<std::vector<TINNERVAR>> values;
+					if (MyAbstractType::LuaCheck(lua, 3))
+					{
+						values = MyAbstractType::LuaGet(lua, 3);
+						if (!values || values->size() != indices->size())
+						{
+							return luaL_error(lua, "Second argument must have as many elements as the IndexList");
+						}
+					}
+					else
+					{
+						TINNERVAR val;
+						if (!TIMPL::LuaGetElement(lua, 3, val))
+						{
+							return luaL_error(lua, "Failed to get value argument");
+						}
+						values = std::make_shared<std::vector<TINNERVAR>>(1, val);
+					}
+
+					if (!utilities::ListOps::Scatter(*list, *indices, *values))
+					{
+						return luaL_error(lua, "IndexList references elements out of range");
+					}
+					lua_pushvalue(lua, 1);
+					return 1;
+				}
+
+				// Elementwise in-place `list[i] = op(list[i], operand)`, with the operand being
+				// a list of the same type and length, a number, or a single value
+				// @return self, for chaining
+				template<typename OP>
+				static int ArithmeticImpl(lua_State* lua, const OP& op)
+				{
+					const int argcnt = lua_gettop(lua);
+					if (argcnt != 2)
+					{
+						return luaL_error(lua, "Arguments number mismatch: must be 2, is %d", argcnt);
+					}
+
+					const typename TLISTTRAITS::listptr_t list = TLISTTRAITS::LuaGetList(lua, 1);
+					if (!list)
+					{
+						return luaL_error(lua, "Pre-First argument expected to be a list");
+					}
+
+					TINNERVAR val;
+					float num;
+					if (MyAbstractType::LuaCheck(lua, 2))
+					{
+						const std::shared_ptr<std::vector<TINNERVAR>> other = MyAbstractType::LuaGet(lua, 2);
+						if (!other || other->size() != list->size())
+						{
+							return luaL_error(lua, "List lengths mismatch");
+						}
+						utilities::ListOps::Transform(*list, *other, op);
+					}
+					else if (GetLuaFloat(lua, 2, num) == GetResult::Ok)
+					{
+						utilities::ListOps::Transform(*list, [&](const TINNERVAR& a) { return op(a, num); });
+					}
+					else if (TIMPL::LuaGetElement(lua, 2, val))
+					{
+						utilities::ListOps::Transform(*list, [&](const TINNERVAR& a) { return op(a, val); });
+					}
+					else
+					{
+						return luaL_error(lua, "Operand must be a list, a value, or a number");
+					}
+
+					lua_pushvalue(lua, 1);
+					return 1;
+				}
+
 			};
 		}
 	}
@@ -21,6 +21,14 @@ namespace meshproc
 				static std::shared_ptr<TVAR> LuaGet(lua_State* lua, int idx);
 				static bool LuaCheck(lua_State* lua, int idx);
 
+				// Pushes an object sharing storage owned by another object, e.g. by the aliasing constructor of `std::shared_ptr`.
+				// Element changes are visible to the owner; `LuaGetDetached` replaces the storage with a private copy first.
+				static int LuaPushView(lua_State* lua, std::shared_ptr<TVAR> val);
+				// Like `LuaGet`, but copy-on-write for views, for operations which must not affect the owner of the storage
+				static std::shared_ptr<TVAR> LuaGetDetached(lua_State* lua, int idx);
+				// True if the object was pushed by `LuaPushView`, and not yet detached
+				static bool LuaIsView(lua_State* lua, int idx);
+
 				AbstractType(Runner& owner)
 					: Runner::Component<TIMPL>{ owner }
 				{};
@@ -37,6 +45,7 @@ namespace meshproc
 				struct wrapped
 				{
 					std::shared_ptr<TVAR> val;
+					bool view;
 				};
 
 				static wrapped* GetWrappedObject(lua_State* lua, int idx, bool errorOnTypeMismatch = true)
@@ -94,6 +103,41 @@ namespace meshproc
 				return 1;
 			}
 
+			template<typename TVAR, typename TIMPL>
+			int AbstractType<TVAR, TIMPL>::LuaPushView(lua_State* lua, std::shared_ptr<TVAR> val)
+			{
+				const int retval = LuaPush(lua, val);
+				wrapped* w = GetWrappedObject(lua, -1);
+				if (w != nullptr)
+				{
+					w->view = true;
+				}
+				return retval;
+			}
+
+			template<typename TVAR, typename TIMPL>
+			std::shared_ptr<TVAR> AbstractType<TVAR, TIMPL>::LuaGetDetached(lua_State* lua, int idx)
+			{
+				wrapped* w = GetWrappedObject(lua, idx);
+				if (w == nullptr)
+				{
+					return nullptr;
+				}
+				if (w->view && w->val)
+				{
+					w->val = std::make_shared<TVAR>(*w->val);
+				}
+				w->view = false;
+				return w->val;
+			}
+
+			template<typename TVAR, typename TIMPL>
+			bool AbstractType<TVAR, TIMPL>::LuaIsView(lua_State* lua, int idx)
+			{
+				wrapped* w = GetWrappedObject(lua, idx, false);
+				return w != nullptr && w->view;
+			}
+
 			template<typename TVAR, typename TIMPL>
 			std::shared_ptr<TVAR> AbstractType<TVAR, TIMPL>::LuaGet(lua_State* lua, int idx)
 			{
@@ -131,6 +175,11 @@ namespace meshproc
 					lua_pushstring(lua, "nil");
 					return 1;
 				}
+				if (w->view)
+				{
+					lua_pushfstring(lua, "%s (view)", TIMPL::LUA_TYPE_NAME);
+					return 1;
+				}
 				lua_pushstring(lua, TIMPL::LUA_TYPE_NAME);
 				return 1;
 			}
@@ -12,14 +12,19 @@
 #include "MeshType.h"
 #include "MeshListType.h"
 #include "SceneType.h"
+#include "SelectionType.h"
+#include "StringListType.h"
 //#include "Shape2DType.h"
 #include "HalfSpaceType.h"
 
 #include "commands/AbstractCommand.h"
+#include "commands/CommandProfiler.h"
 
 #include "data/Scene.h"
+#include "data/Selection.h"
 
 #include "utilities/StringUtilities.h"
+#include "utilities/Trace.h"
 
 #include <SimpleLog/SimpleLog.hpp>
 
@@ -157,7 +162,39 @@ namespace
 	//struct LuaParamMapping<ParamType::Shape2D> : LuaWrappedParamMapping<Shape2DType, data::Shape2D> {};
 
 	template<>
-	struct LuaParamMapping<ParamType::IndexList> : LuaWrappedParamMapping<IndexListType, std::vector<uint32_t>> {};
+	struct LuaParamMapping<ParamType::IndexList> : LuaWrappedParamMapping<IndexListType, std::vector<uint32_t>>
+	{
+		static bool GetVal(lua_State* lua, std::shared_ptr<std::vector<uint32_t>>& tar)
+		{
+			if (luaL_testudata(lua, 3, SelectionType::LUA_TYPE_NAME) != nullptr)
+			{
+				const auto sel = SelectionType::LuaGet(lua, 3);
+				if (!sel)
+				{
+					return false;
+				}
+				tar = std::make_shared<std::vector<uint32_t>>(sel->ToIndices());
+				return true;
+			}
+			return LuaWrappedParamMapping<IndexListType, std::vector<uint32_t>>::GetVal(lua, tar);
+		}
+	};
+
+	template<>
+	struct LuaParamMapping<ParamType::Selection> : LuaWrappedParamMapping<SelectionType, data::Selection>
+	{
+		static bool GetVal(lua_State* lua, std::shared_ptr<data::Selection>& tar)
+		{
+			// an IndexList is converted into a new Selection
+			auto sel = SelectionType::LuaGetOrConvert(lua, 3);
+			if (sel)
+			{
+				tar = sel;
+				return true;
+			}
+			return false;
+		}
+	};
 
 	template<>
 	struct LuaParamMapping<ParamType::IndexListList> : LuaWrappedParamMapping<IndexListListType, std::vector<std::shared_ptr<std::vector<uint32_t>>>> {};
@@ -191,7 +228,23 @@ namespace
 	};
 
 	template<>
-	struct LuaParamMapping<ParamType::Vec3List> : LuaWrappedParamMapping<GlmVec3ListType, std::vector<glm::vec3>> {};
+	struct LuaParamMapping<ParamType::Vec3List> : LuaWrappedParamMapping<GlmVec3ListType, std::vector<glm::vec3>>
+	{
+		// A view, e.g. `mesh.vertices`, is bound as private copy to a parameter the command writes; the view itself is unchanged.
+		// Otherwise the command would change the same storage through two parameters, e.g. compacting the vertices twice.
+		static bool GetPrivateVal(lua_State* lua, std::shared_ptr<std::vector<glm::vec3>>& tar)
+		{
+			if (!GetVal(lua, tar))
+			{
+				return false;
+			}
+			if (tar && GlmVec3ListType::LuaIsView(lua, 3))
+			{
+				tar = std::make_shared<std::vector<glm::vec3>>(*tar);
+			}
+			return true;
+		}
+	};
 
 	template<>
 	struct LuaParamMapping<ParamType::Vec3ListList> : LuaWrappedParamMapping<GlmVec3ListListType, std::vector<std::shared_ptr<std::vector<glm::vec3>>>> {};
@@ -199,6 +252,9 @@ namespace
 	template<>
 	struct LuaParamMapping<ParamType::FloatList> : LuaWrappedParamMapping<FloatListType, std::vector<float>> {};
 
+	template<>
+	struct LuaParamMapping<ParamType::StringList> : LuaWrappedParamMapping<StringListType, std::vector<std::wstring>> {};
+
 	template<>
 	struct LuaParamMapping<ParamType::HalfSpace> : LuaWrappedParamMapping<HalfSpaceType, data::HalfSpace> {};
 
@@ -260,7 +316,19 @@ namespace
 			}
 		}
 
-		if (!LuaParamMapping<PT>::GetVal(lua, *v))
+		bool loaded = false;
+		if constexpr (requires { LuaParamMapping<PT>::GetPrivateVal(lua, *v); })
+		{
+			loaded = (param->m_mode != ParamMode::In)
+				? LuaParamMapping<PT>::GetPrivateVal(lua, *v)
+				: LuaParamMapping<PT>::GetVal(lua, *v);
+		}
+		else
+		{
+			loaded = LuaParamMapping<PT>::GetVal(lua, *v);
+		}
+
+		if (!loaded)
 		{
 			log.Error("Failed to set parameter value; likely type mismatch");
 			return false;
@@ -296,6 +364,46 @@ namespace
 		return MakeLuaTryLoadValTableValues(seq);
 	}
 
+	// Profiles one command invocation, ending the measurement also when the invocation throws
+	class ProfileScope
+	{
+	public:
+		ProfileScope(commands::CommandProfiler* profiler, const commands::AbstractCommand& cmd)
+			: m_profiler{ profiler }, m_cmd{ cmd }
+		{
+			if (m_profiler != nullptr)
+			{
+				m_measurement = m_profiler->Begin(cmd);
+			}
+		}
+
+		~ProfileScope()
+		{
+			if (m_profiler == nullptr) return;
+			try
+			{
+				m_profiler->End(m_cmd, m_measurement, m_success);
+			}
+			catch (...)
+			{
+			}
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+		void SetSuccess(bool success)
+		{
+			m_success = success;
+		}
+
+	private:
+		commands::CommandProfiler* m_profiler;
+		const commands::AbstractCommand& m_cmd;
+		commands::CommandProfiler::Measurement m_measurement;
+		bool m_success{ false };
+	};
+
 }
 
 bool CommandType::Init()
@@ -350,7 +458,11 @@ int CommandType::InvokeImpl(lua_State* lua)
 	try
 	{
 		Log().Detail("Invoking %s", name);
+		utilities::Trace::Span span{ name, "command" };
+		ProfileScope profile{ Profiler(), *cmd };
 		bool rv = cmd->Invoke();
+		UpdateIndexListArgs(*cmd);
+		profile.SetSuccess(rv);
 		if (!rv)
 		{
 			Log().Warning("Invoking %s returned unsuccessful", name);
@@ -379,6 +491,14 @@ int CommandType::GetImpl(lua_State* lua, std::shared_ptr<commands::AbstractComma
 		Log().Error("Field name %s not found", name.c_str());
 		return 0;
 	}
+	if (param->m_mode == ParamMode::InOut && param->m_type == ParamType::Selection)
+	{
+		auto arg = m_indexListArgs.find(param.get());
+		if (arg != m_indexListArgs.end() && arg->second.param.lock() == param)
+		{
+			return IndexListType::LuaPush(lua, arg->second.list);
+		}
+	}
 
 	size_t functableIndex = static_cast<size_t>(param->m_type);
 	if (functableIndex < functable.size())
@@ -478,6 +598,33 @@ int CommandType::SetImpl(lua_State* lua)
 		return 0;
 	}
 
-	functable[functableIndex](lua, param, Log());
+	if (functable[functableIndex](lua, param, Log()) && param->m_mode == ParamMode::InOut && param->m_type == ParamType::Selection)
+	{
+		std::erase_if(m_indexListArgs, [](const auto& arg) { return arg.second.param.expired(); });
+		if (IndexListType::LuaCheck(lua, 3))
+		{
+			m_indexListArgs[param.get()] = IndexListArg{ param, IndexListType::LuaGet(lua, 3) };
+		}
+		else
+		{
+			m_indexListArgs.erase(param.get());
+		}
+	}
 	return 0;
 }
+
+void CommandType::UpdateIndexListArgs(const commands::AbstractCommand& cmd)
+{
+	if (m_indexListArgs.empty()) return;
+	for (const auto& p : cmd.GetParams())
+	{
+		auto arg = m_indexListArgs.find(p.second.get());
+		if (arg == m_indexListArgs.end() || arg->second.param.lock() != p.second) continue;
+		const auto* sel = ParameterBinding::GetValueSource<ParamType::Selection>(p.second.get());
+		if (sel != nullptr && *sel && arg->second.list)
+		{
+			// updated in place, ascending
+			*arg->second.list = (*sel)->ToIndices();
+		}
+	}
+}
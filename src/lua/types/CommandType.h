@@ -2,6 +2,14 @@
 
 #include "AbstractType.h"
 
+#include "commands/ParameterBinding.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace meshproc
 {
 	namespace commands
@@ -36,6 +44,17 @@ namespace meshproc
 				int IndexDispatcherImpl(lua_State* lua);
 				int SetImpl(lua_State* lua);
 
+				// Writes the results of InOut Selection parameters back into the IndexList arguments they were converted from
+				void UpdateIndexListArgs(const commands::AbstractCommand& cmd);
+
+				// IndexList set as InOut Selection parameter, so reading the parameter returns the type the caller passed
+				struct IndexListArg
+				{
+					std::weak_ptr<commands::ParameterBinding::ParamBindingBase> param;
+					std::shared_ptr<std::vector<uint32_t>> list;
+				};
+				std::unordered_map<const commands::ParameterBinding::ParamBindingBase*, IndexListArg> m_indexListArgs;
+
 			};
 
 		}
@@ -1,11 +1,76 @@
 #include "FloatListType.h"
 
+#include "GlmVec3ListType.h"
+#include "IndexListType.h"
+
 #include <SimpleLog/SimpleLog.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 using namespace meshproc;
 using namespace meshproc::lua;
 using namespace meshproc::lua::types;
 
+namespace
+{
+	using utilities::ListOps;
+
+	// values of a FloatList or of a lua table of numbers
+	bool GetFloats(lua_State* lua, int idx, std::vector<float>& outValues)
+	{
+		if (FloatListType::LuaCheck(lua, idx))
+		{
+			auto list = FloatListType::LuaGet(lua, idx);
+			if (!list) return false;
+			outValues = *list;
+			return true;
+		}
+		if (!lua_istable(lua, idx))
+		{
+			return false;
+		}
+		const size_t len = static_cast<size_t>(lua_rawlen(lua, idx));
+		outValues.resize(len);
+		for (size_t i = 0; i < len; ++i)
+		{
+			lua_rawgeti(lua, idx, static_cast<lua_Integer>(i + 1));
+			const GetResult res = GetLuaFloat(lua, -1, outValues[i]);
+			lua_pop(lua, 1);
+			if (res != GetResult::Ok) return false;
+		}
+		return true;
+	}
+
+	// min and max, ignoring NaN values
+	std::pair<float, float> MinMax(const std::vector<float>& list)
+	{
+		using MinMaxPair = std::pair<float, float>;
+		const MinMaxPair identity{ std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+		return utilities::TaskScheduler::Instance().ParallelReduce(0, list.size(), ListOps::GrainSize, identity,
+			[&](size_t begin, size_t end)
+			{
+				MinMaxPair mm = identity;
+				for (size_t i = begin; i < end; ++i)
+				{
+					mm.first = (list[i] < mm.first) ? list[i] : mm.first;
+					mm.second = (list[i] > mm.second) ? list[i] : mm.second;
+				}
+				return mm;
+			},
+			[](const MinMaxPair& a, const MinMaxPair& b)
+			{
+				return MinMaxPair{ (std::min)(a.first, b.first), (std::max)(a.second, b.second) };
+			});
+	}
+
+	double Sum(const std::vector<float>& list)
+	{
+		return ListOps::Reduce(list, 0.0, [](double a, double b) { return a + b; });
+	}
+}
+
 bool FloatListType::Init()
 {
 	static const struct luaL_Reg staticFuncs[] = {
@@ -22,6 +87,23 @@ bool FloatListType::Init()
 		{"insert", &FloatListType::CallbackInsert},
 		{"remove", &FloatListType::CallbackRemove},
 		{"resize", &FloatListType::CallbackResize},
+		{"clone", &FloatListType::CallbackClone},
+		{"fill", &FloatListType::CallbackFill},
+		{"slice", &FloatListType::CallbackSlice},
+		{"gather", &FloatListType::CallbackGather},
+		{"scatter", &FloatListType::CallbackScatter},
+		{"add", &FloatListType::CallbackAdd},
+		{"sub", &FloatListType::CallbackSub},
+		{"mul", &FloatListType::CallbackMul},
+		{"div", &FloatListType::CallbackDiv},
+		{"clamp", &FloatListType::CallbackClamp},
+		{"min", &FloatListType::CallbackMin},
+		{"max", &FloatListType::CallbackMax},
+		{"sum", &FloatListType::CallbackSum},
+		{"mean", &FloatListType::CallbackMean},
+		{"sort", &FloatListType::CallbackSort},
+		{"argsort", &FloatListType::CallbackArgSort},
+		{"map_gradient", &FloatListType::CallbackMapGradient},
 		{nullptr, nullptr}
 	};
 
@@ -57,3 +139,173 @@ float FloatListType::GetInvalidValue()
 {
 	return 0.0f;
 }
+
+int FloatListType::CallbackAdd(lua_State* lua)
+{
+	return ArithmeticImpl(lua, [](float a, float b) { return a + b; });
+}
+
+int FloatListType::CallbackSub(lua_State* lua)
+{
+	return ArithmeticImpl(lua, [](float a, float b) { return a - b; });
+}
+
+int FloatListType::CallbackMul(lua_State* lua)
+{
+	return ArithmeticImpl(lua, [](float a, float b) { return a * b; });
+}
+
+int FloatListType::CallbackDiv(lua_State* lua)
+{
+	return ArithmeticImpl(lua, [](float a, float b) { return a / b; });
+}
+
+int FloatListType::CallbackClamp(lua_State* lua)
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 3)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 3, is %d", argcnt);
+	}
+
+	auto list = LuaGet(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a FloatList");
+	}
+
+	float minVal, maxVal;
+	if (GetLuaFloat(lua, 2, minVal) != GetResult::Ok || GetLuaFloat(lua, 3, maxVal) != GetResult::Ok)
+	{
+		return luaL_error(lua, "Failed to get min and max argument numbers");
+	}
+
+	ListOps::Transform(*list, [=](float v) { return (v < minVal) ? minVal : ((v > maxVal) ? maxVal : v); });
+
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int FloatListType::CallbackMin(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list || list->empty())
+	{
+		lua_pushnil(lua);
+		return 1;
+	}
+	lua_pushnumber(lua, MinMax(*list).first);
+	return 1;
+}
+
+int FloatListType::CallbackMax(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list || list->empty())
+	{
+		lua_pushnil(lua);
+		return 1;
+	}
+	lua_pushnumber(lua, MinMax(*list).second);
+	return 1;
+}
+
+int FloatListType::CallbackSum(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a FloatList");
+	}
+	lua_pushnumber(lua, Sum(*list));
+	return 1;
+}
+
+int FloatListType::CallbackMean(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list || list->empty())
+	{
+		lua_pushnil(lua);
+		return 1;
+	}
+	lua_pushnumber(lua, Sum(*list) / static_cast<double>(list->size()));
+	return 1;
+}
+
+int FloatListType::CallbackSort(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a FloatList");
+	}
+
+	std::vector<float> sorted;
+	ListOps::Gather(*list, ListOps::ArgSort(*list), sorted);
+	std::swap(*list, sorted);
+
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int FloatListType::CallbackArgSort(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a FloatList");
+	}
+
+	IndexListType::LuaPush(lua, std::make_shared<std::vector<uint32_t>>(ListOps::ArgSort(*list)));
+	return 1;
+}
+
+// map_gradient(keys, stops) -> new FloatList or Vec3List, interpolating the `stops` placed at the ascending `keys`
+int FloatListType::CallbackMapGradient(lua_State* lua)
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 3)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 3, is %d", argcnt);
+	}
+
+	auto list = LuaGet(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a FloatList");
+	}
+
+	std::vector<float> keys;
+	if (!GetFloats(lua, 2, keys) || keys.empty())
+	{
+		return luaL_error(lua, "First argument expected to be a non-empty FloatList or table of numbers");
+	}
+	if (!std::is_sorted(keys.begin(), keys.end()))
+	{
+		return luaL_error(lua, "Gradient keys must be ascending");
+	}
+
+	if (GlmVec3ListType::LuaCheck(lua, 3))
+	{
+		auto stops = GlmVec3ListType::LuaGet(lua, 3);
+		if (!stops || stops->size() != keys.size())
+		{
+			return luaL_error(lua, "Gradient keys and stops must have the same length");
+		}
+		auto result = std::make_shared<std::vector<glm::vec3>>();
+		ListOps::MapGradient(*list, keys, *stops, *result);
+		GlmVec3ListType::LuaPush(lua, result);
+		return 1;
+	}
+
+	std::vector<float> stops;
+	if (!GetFloats(lua, 3, stops) || stops.size() != keys.size())
+	{
+		return luaL_error(lua, "Gradient keys and stops must have the same length");
+	}
+	auto result = std::make_shared<std::vector<float>>();
+	ListOps::MapGradient(*list, keys, stops, *result);
+	LuaPush(lua, result);
+	return 1;
+}
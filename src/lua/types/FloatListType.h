@@ -27,6 +27,19 @@ namespace meshproc
 				static bool LuaGetElement(lua_State* lua, int i, float& outVal);
 				static float GetInvalidValue();
 
+				static int CallbackAdd(lua_State* lua);
+				static int CallbackSub(lua_State* lua);
+				static int CallbackMul(lua_State* lua);
+				static int CallbackDiv(lua_State* lua);
+				static int CallbackClamp(lua_State* lua);
+				static int CallbackMin(lua_State* lua);
+				static int CallbackMax(lua_State* lua);
+				static int CallbackSum(lua_State* lua);
+				static int CallbackMean(lua_State* lua);
+				static int CallbackSort(lua_State* lua);
+				static int CallbackArgSort(lua_State* lua);
+				static int CallbackMapGradient(lua_State* lua);
+
 			};
 		}
 	}
@@ -1,13 +1,48 @@
 #include "GlmVec3ListType.h"
 
+#include "FloatListType.h"
 #include "GlmVec3Type.h"
 
 #include <SimpleLog/SimpleLog.hpp>
 
+#include <limits>
+
 using namespace meshproc;
 using namespace meshproc::lua;
 using namespace meshproc::lua::types;
 
+namespace
+{
+	using utilities::ListOps;
+
+	// component index from 1, 2, 3 or "x", "y", "z"
+	bool GetComponentIndex(lua_State* lua, int idx, int& outComponent)
+	{
+		if (lua_type(lua, idx) == LUA_TSTRING)
+		{
+			const char* name = lua_tostring(lua, idx);
+			if (name[0] >= 'x' && name[0] <= 'z' && name[1] == 0)
+			{
+				outComponent = name[0] - 'x';
+				return true;
+			}
+			return false;
+		}
+		uint32_t i;
+		if (GetLuaUint32(lua, idx, i) != GetResult::Ok || i < 1 || i > 3)
+		{
+			return false;
+		}
+		outComponent = static_cast<int>(i) - 1;
+		return true;
+	}
+
+	glm::dvec3 Sum(const std::vector<glm::vec3>& list)
+	{
+		return ListOps::Reduce(list, glm::dvec3{ 0.0 }, [](const glm::dvec3& a, const glm::dvec3& b) { return a + b; });
+	}
+}
+
 bool GlmVec3ListType::Init()
 {
 	static const struct luaL_Reg staticFuncs[] = {
@@ -24,6 +59,24 @@ bool GlmVec3ListType::Init()
 		{"insert", &GlmVec3ListType::CallbackInsert},
 		{"remove", &GlmVec3ListType::CallbackRemove},
 		{"resize", &GlmVec3ListType::CallbackResize},
+		{"clone", &GlmVec3ListType::CallbackClone},
+		{"fill", &GlmVec3ListType::CallbackFill},
+		{"slice", &GlmVec3ListType::CallbackSlice},
+		{"gather", &GlmVec3ListType::CallbackGather},
+		{"scatter", &GlmVec3ListType::CallbackScatter},
+		{"add", &GlmVec3ListType::CallbackAdd},
+		{"sub", &GlmVec3ListType::CallbackSub},
+		{"mul", &GlmVec3ListType::CallbackMul},
+		{"div", &GlmVec3ListType::CallbackDiv},
+		{"min", &GlmVec3ListType::CallbackMin},
+		{"max", &GlmVec3ListType::CallbackMax},
+		{"sum", &GlmVec3ListType::CallbackSum},
+		{"mean", &GlmVec3ListType::CallbackMean},
+		{"dot", &GlmVec3ListType::CallbackDot},
+		{"lengths", &GlmVec3ListType::CallbackLengths},
+		{"normalize", &GlmVec3ListType::CallbackNormalize},
+		{"component", &GlmVec3ListType::CallbackComponent},
+		{"set_component", &GlmVec3ListType::CallbackSetComponent},
 		{nullptr, nullptr}
 	};
 
@@ -55,3 +108,242 @@ glm::vec3 GlmVec3ListType::GetInvalidValue()
 {
 	return glm::vec3{ 0.0f, 0.0f, 0.0f };
 }
+
+// Like `ArithmeticImpl`, additionally accepting a FloatList operand applied per element
+template<typename OP>
+int GlmVec3ListType::VectorArithmeticImpl(lua_State* lua, const OP& op)
+{
+	if (lua_gettop(lua) == 2 && FloatListType::LuaCheck(lua, 2))
+	{
+		auto list = LuaGet(lua, 1);
+		auto scalars = FloatListType::LuaGet(lua, 2);
+		if (!list || !scalars || scalars->size() != list->size())
+		{
+			return luaL_error(lua, "List lengths mismatch");
+		}
+		ListOps::Transform(*list, *scalars, op);
+		lua_pushvalue(lua, 1);
+		return 1;
+	}
+	return ArithmeticImpl(lua, op);
+}
+
+int GlmVec3ListType::CallbackAdd(lua_State* lua)
+{
+	return VectorArithmeticImpl(lua, [](const glm::vec3& a, const auto& b) { return a + b; });
+}
+
+int GlmVec3ListType::CallbackSub(lua_State* lua)
+{
+	return VectorArithmeticImpl(lua, [](const glm::vec3& a, const auto& b) { return a - b; });
+}
+
+int GlmVec3ListType::CallbackMul(lua_State* lua)
+{
+	return VectorArithmeticImpl(lua, [](const glm::vec3& a, const auto& b) { return a * b; });
+}
+
+int GlmVec3ListType::CallbackDiv(lua_State* lua)
+{
+	return VectorArithmeticImpl(lua, [](const glm::vec3& a, const auto& b) { return a / b; });
+}
+
+int GlmVec3ListType::CallbackMin(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list || list->empty())
+	{
+		lua_pushnil(lua);
+		return 1;
+	}
+	const glm::vec3 identity{ std::numeric_limits<float>::infinity() };
+	GlmVec3Type::Push(lua, ListOps::Reduce(*list, identity, [](const glm::vec3& a, const glm::vec3& b) { return glm::min(a, b); }));
+	return 1;
+}
+
+int GlmVec3ListType::CallbackMax(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list || list->empty())
+	{
+		lua_pushnil(lua);
+		return 1;
+	}
+	const glm::vec3 identity{ -std::numeric_limits<float>::infinity() };
+	GlmVec3Type::Push(lua, ListOps::Reduce(*list, identity, [](const glm::vec3& a, const glm::vec3& b) { return glm::max(a, b); }));
+	return 1;
+}
+
+int GlmVec3ListType::CallbackSum(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Vec3List");
+	}
+	GlmVec3Type::Push(lua, glm::vec3{ Sum(*list) });
+	return 1;
+}
+
+int GlmVec3ListType::CallbackMean(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list || list->empty())
+	{
+		lua_pushnil(lua);
+		return 1;
+	}
+	GlmVec3Type::Push(lua, glm::vec3{ Sum(*list) / static_cast<double>(list->size()) });
+	return 1;
+}
+
+// dot(other) -> new FloatList of the dot products with a Vec3List of the same length, or with a single vector
+int GlmVec3ListType::CallbackDot(lua_State* lua)
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 2)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 2, is %d", argcnt);
+	}
+
+	auto list = LuaGet(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Vec3List");
+	}
+
+	auto result = std::make_shared<std::vector<float>>();
+	if (LuaCheck(lua, 2))
+	{
+		auto other = LuaGet(lua, 2);
+		if (!other || other->size() != list->size())
+		{
+			return luaL_error(lua, "List lengths mismatch");
+		}
+		result->resize(list->size());
+		const glm::vec3* b = other->data();
+		const glm::vec3* a = list->data();
+		float* r = result->data();
+		utilities::TaskScheduler::Instance().ParallelFor(0, list->size(), ListOps::GrainSize, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					r[i] = glm::dot(a[i], b[i]);
+				}
+			});
+	}
+	else
+	{
+		glm::vec3 v;
+		if (!GlmVec3Type::TryGet(lua, 2, v))
+		{
+			return luaL_error(lua, "First argument expected to be a Vec3List or a vector");
+		}
+		ListOps::Map(*list, *result, [v](const glm::vec3& a) { return glm::dot(a, v); });
+	}
+
+	FloatListType::LuaPush(lua, result);
+	return 1;
+}
+
+int GlmVec3ListType::CallbackLengths(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Vec3List");
+	}
+
+	auto result = std::make_shared<std::vector<float>>();
+	ListOps::Map(*list, *result, [](const glm::vec3& a) { return glm::length(a); });
+	FloatListType::LuaPush(lua, result);
+	return 1;
+}
+
+int GlmVec3ListType::CallbackNormalize(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Vec3List");
+	}
+
+	// zero length vectors stay zero
+	ListOps::Transform(*list, [](const glm::vec3& a)
+		{
+			const float len = glm::length(a);
+			return (len > 0.0f) ? (a / len) : a;
+		});
+
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+// component(axis) -> new FloatList of one component of all vectors
+int GlmVec3ListType::CallbackComponent(lua_State* lua)
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 2)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 2, is %d", argcnt);
+	}
+
+	auto list = LuaGet(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Vec3List");
+	}
+	int c;
+	if (!GetComponentIndex(lua, 2, c))
+	{
+		return luaL_error(lua, "First argument expected to be a component 1, 2, 3, or \"x\", \"y\", \"z\"");
+	}
+
+	auto result = std::make_shared<std::vector<float>>();
+	ListOps::Map(*list, *result, [c](const glm::vec3& v) { return v[c]; });
+	FloatListType::LuaPush(lua, result);
+	return 1;
+}
+
+// set_component(axis, values) sets one component of all vectors from a FloatList of the same length, or a number
+int GlmVec3ListType::CallbackSetComponent(lua_State* lua)
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 3)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 3, is %d", argcnt);
+	}
+
+	auto list = LuaGet(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Vec3List");
+	}
+	int c;
+	if (!GetComponentIndex(lua, 2, c))
+	{
+		return luaL_error(lua, "First argument expected to be a component 1, 2, 3, or \"x\", \"y\", \"z\"");
+	}
+
+	float num;
+	if (FloatListType::LuaCheck(lua, 3))
+	{
+		auto values = FloatListType::LuaGet(lua, 3);
+		if (!values || values->size() != list->size())
+		{
+			return luaL_error(lua, "List lengths mismatch");
+		}
+		ListOps::Transform(*list, *values, [c](glm::vec3 v, float f) { v[c] = f; return v; });
+	}
+	else if (GetLuaFloat(lua, 3, num) == GetResult::Ok)
+	{
+		ListOps::Transform(*list, [c, num](glm::vec3 v) { v[c] = num; return v; });
+	}
+	else
+	{
+		return luaL_error(lua, "Second argument expected to be a FloatList or a number");
+	}
+
+	lua_pushvalue(lua, 1);
+	return 1;
+}
@@ -29,6 +29,23 @@ namespace meshproc
 				static bool LuaGetElement(lua_State* lua, int i, glm::vec3& outVal);
 				static glm::vec3 GetInvalidValue();
 
+				template<typename OP>
+				static int VectorArithmeticImpl(lua_State* lua, const OP& op);
+
+				static int CallbackAdd(lua_State* lua);
+				static int CallbackSub(lua_State* lua);
+				static int CallbackMul(lua_State* lua);
+				static int CallbackDiv(lua_State* lua);
+				static int CallbackMin(lua_State* lua);
+				static int CallbackMax(lua_State* lua);
+				static int CallbackSum(lua_State* lua);
+				static int CallbackMean(lua_State* lua);
+				static int CallbackDot(lua_State* lua);
+				static int CallbackLengths(lua_State* lua);
+				static int CallbackNormalize(lua_State* lua);
+				static int CallbackComponent(lua_State* lua);
+				static int CallbackSetComponent(lua_State* lua);
+
 			};
 		}
 	}
@@ -2,6 +2,8 @@
 
 #include <SimpleLog/SimpleLog.hpp>
 
+#include <algorithm>
+
 using namespace meshproc;
 using namespace meshproc::lua;
 using namespace meshproc::lua::types;
@@ -22,6 +24,15 @@ bool IndexListType::Init()
 		{"insert", &IndexListType::CallbackInsert},
 		{"remove", &IndexListType::CallbackRemove},
 		{"resize", &IndexListType::CallbackResize},
+		{"clone", &IndexListType::CallbackClone},
+		{"fill", &IndexListType::CallbackFill},
+		{"slice", &IndexListType::CallbackSlice},
+		{"gather", &IndexListType::CallbackGather},
+		{"scatter", &IndexListType::CallbackScatter},
+		{"sort", &IndexListType::CallbackSort},
+		{"unique", &IndexListType::CallbackUnique},
+		{"min", &IndexListType::CallbackMin},
+		{"max", &IndexListType::CallbackMax},
 		{nullptr, nullptr}
 	};
 
@@ -58,3 +69,53 @@ uint32_t IndexListType::GetInvalidValue()
 {
 	return std::numeric_limits<uint32_t>::max();
 }
+
+int IndexListType::CallbackSort(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a IndexList");
+	}
+	std::sort(list->begin(), list->end());
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+// sorts and removes duplicates
+int IndexListType::CallbackUnique(lua_State* lua)
+{
+	auto list = LuaGetDetached(lua, 1);
+	if (!list)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a IndexList");
+	}
+	std::sort(list->begin(), list->end());
+	list->erase(std::unique(list->begin(), list->end()), list->end());
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int IndexListType::CallbackMin(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list || list->empty())
+	{
+		lua_pushnil(lua);
+		return 1;
+	}
+	lua_pushinteger(lua, static_cast<lua_Integer>(*std::min_element(list->begin(), list->end())) + 1);
+	return 1;
+}
+
+int IndexListType::CallbackMax(lua_State* lua)
+{
+	auto list = LuaGet(lua, 1);
+	if (!list || list->empty())
+	{
+		lua_pushnil(lua);
+		return 1;
+	}
+	lua_pushinteger(lua, static_cast<lua_Integer>(*std::max_element(list->begin(), list->end())) + 1);
+	return 1;
+}
@@ -31,6 +31,11 @@ namespace meshproc
 				static bool LuaGetElement(lua_State* lua, int i, uint32_t& outVal);
 				static uint32_t GetInvalidValue();
 
+				static int CallbackSort(lua_State* lua);
+				static int CallbackUnique(lua_State* lua);
+				static int CallbackMin(lua_State* lua);
+				static int CallbackMax(lua_State* lua);
+
 			};
 		}
 	}
@@ -2,12 +2,15 @@
 
 #include "GlmMat4Type.h"
 #include "GlmUVec3Type.h"
+#include "GlmVec3ListType.h"
 #include "GlmVec3Type.h"
+#include "IndexListType.h"
 
 #include "lua/LuaUtilities.h"
 
 #include <SimpleLog/SimpleLog.hpp>
 
+#include <cstring>
 #include <unordered_set>
 
 using namespace meshproc;
@@ -98,42 +101,67 @@ void MeshType::VertexListTraits::OnManyRemoved(lua_State* lua, int idx, [[maybe_
 	auto mesh = MeshType::LuaGet(lua, -1);
 	lua_pop(lua, 1);
 
-	std::unordered_map<uint32_t, uint32_t> remap;
-	const uint32_t oldSize = static_cast<uint32_t>(mesh->vertices.size() + idxListZeroBaseSortedAsc.size());
-	remap.reserve(mesh->vertices.size());
+	const size_t oldSize = mesh->vertices.size() + idxListZeroBaseSortedAsc.size();
+	std::vector<uint32_t> remap(oldSize);
 	uint32_t off = 0;
 	for (uint32_t i = 0; i < oldSize; ++i)
 	{
 		if (off < idxListZeroBaseSortedAsc.size() && i == idxListZeroBaseSortedAsc.at(off))
 		{
 			off++;
+			remap[i] = data::MeshEditBatch::RemovedIndex;
 		}
 		else
 		{
-			remap.insert(std::make_pair(i, i - off));
+			remap[i] = i - off;
 		}
 	}
 
-	std::erase_if(mesh->triangles, [&remap](data::Triangle& t)
-		{
-			return !remap.contains(t[0])
-				|| !remap.contains(t[1])
-				|| !remap.contains(t[2]);
-		});
+	data::MeshEditBatch::RemapTriangles(mesh->triangles, remap);
+}
 
+int MeshType::Vertex::CallbackInsert(lua_State* lua)
+{
+	luaL_checkudata(lua, 1, LUA_TYPE_NAME);
+	glm::vec3 val;
+	if (lua_gettop(lua) != 3 || GetEditBatch(lua, 1) == nullptr || !LuaGetElement(lua, 3, val))
+	{
+		return MyAbstractListType::CallbackInsert(lua);
+	}
+	return DeferInsert(lua, VertexListTraits::LuaGetList(lua, 1)->size(), &data::MeshEditBatch::InsertVertex, &MyAbstractListType::CallbackInsert);
+}
 
-	for (data::Triangle& t : mesh->triangles)
+int MeshType::Vertex::CallbackRemove(lua_State* lua)
+{
+	luaL_checkudata(lua, 1, LUA_TYPE_NAME);
+	if (GetEditBatch(lua, 1) == nullptr)
 	{
-		for (size_t i = 0; i < 3; ++i)
+		return MyAbstractListType::CallbackRemove(lua);
+	}
+	return DeferRemove(lua, VertexListTraits::LuaGetList(lua, 1)->size(), &data::MeshEditBatch::RemoveVertex);
+}
+
+int MeshType::Vertex::CallbackResize(lua_State* lua)
+{
+	luaL_checkudata(lua, 1, LUA_TYPE_NAME);
+	if (lua_gettop(lua) == 2 && GetEditBatch(lua, 1) != nullptr)
+	{
+		uint32_t newlen;
+		if (GetLuaUint32(lua, 2, newlen) == GetResult::Ok && newlen < VertexListTraits::LuaGetList(lua, 1)->size())
 		{
-			t[i] = remap.at(t[i]);
+			return luaL_error(lua, "Shrinking the vertex list is not supported during an edit; use remove");
 		}
 	}
+	return MyAbstractListType::CallbackResize(lua);
 }
 
 int MeshType::Vertex::CallbackRemoveIsolated(lua_State* lua)
 {
 	luaL_checkudata(lua, -1, LUA_TYPE_NAME);
+	if (GetEditBatch(lua, -1) != nullptr)
+	{
+		return luaL_error(lua, "Removing isolated vertices is not supported during an edit");
+	}
 	lua_getuservalue(lua, -1);
 	auto mesh = MeshType::LuaGet(lua, -1);
 	lua_pop(lua, 1);
@@ -165,6 +193,41 @@ std::vector<data::Triangle>* MeshType::TriangleListTraits::LuaGetList(lua_State*
 	return &(mesh->triangles);
 }
 
+int MeshType::Triangle::CallbackInsert(lua_State* lua)
+{
+	luaL_checkudata(lua, 1, LUA_TYPE_NAME);
+	data::Triangle val;
+	if (lua_gettop(lua) != 3 || GetEditBatch(lua, 1) == nullptr || !LuaGetElement(lua, 3, val))
+	{
+		return MyAbstractListType::CallbackInsert(lua);
+	}
+	return DeferInsert(lua, TriangleListTraits::LuaGetList(lua, 1)->size(), &data::MeshEditBatch::InsertTriangle, &MyAbstractListType::CallbackInsert);
+}
+
+int MeshType::Triangle::CallbackRemove(lua_State* lua)
+{
+	luaL_checkudata(lua, 1, LUA_TYPE_NAME);
+	if (GetEditBatch(lua, 1) == nullptr)
+	{
+		return MyAbstractListType::CallbackRemove(lua);
+	}
+	return DeferRemove(lua, TriangleListTraits::LuaGetList(lua, 1)->size(), &data::MeshEditBatch::RemoveTriangle);
+}
+
+int MeshType::Triangle::CallbackResize(lua_State* lua)
+{
+	luaL_checkudata(lua, 1, LUA_TYPE_NAME);
+	if (lua_gettop(lua) == 2 && GetEditBatch(lua, 1) != nullptr)
+	{
+		uint32_t newlen;
+		if (GetLuaUint32(lua, 2, newlen) == GetResult::Ok && newlen < TriangleListTraits::LuaGetList(lua, 1)->size())
+		{
+			return luaL_error(lua, "Shrinking the triangle list is not supported during an edit; use remove");
+		}
+	}
+	return MyAbstractListType::CallbackResize(lua);
+}
+
 void MeshType::Triangle::LuaPushElementValue(lua_State* lua, const std::vector<data::Triangle>& list, uint32_t indexZeroBased)
 {
 	const auto& t = list.at(indexZeroBased);
@@ -272,6 +335,8 @@ bool MeshType::Init()
 		{"calc_boundingbox", &MeshType::CallbackCalcBoundingBox},
 		{"is_valid", &MeshType::CallbackIsValid},
 		{"clone", &MeshType::CallbackClone},
+		{"begin_edit", &MeshType::CallbackBeginEdit},
+		{"commit", &MeshType::CallbackCommit},
 
 		{nullptr, nullptr}
 	};
@@ -287,6 +352,12 @@ bool MeshType::Init()
 	lua_setfield(lua(), -2, "Mesh");		// store new table as "Mesh" in "meshproc"; also pops that table
 	lua_pop(lua(), 1);						// remove "meshproc" from stack
 
+	// Edit transaction user data
+	luaL_newmetatable(lua(), LUA_EDIT_TYPE_NAME);
+	lua_pushcfunction(lua(), &MeshType::CallbackEditDelete);
+	lua_setfield(lua(), -2, "__gc");
+	lua_pop(lua(), 1);
+
 	// Vertex user table!
 	static const struct luaL_Reg vertexMemberFuncs[] = {
 		{"__tostring", &Vertex::CallbackToString},
@@ -347,6 +418,18 @@ int MeshType::CallbackIndexDispatch(lua_State* lua)
 		lua_pop(lua, 1); // pop metatable
 	}
 	
+	if (lua_type(lua, 2) == LUA_TSTRING && strcmp(lua_tostring(lua, 2), "vertices") == 0)
+	{
+		// Vec3List view sharing the vertex storage of the mesh, and keeping the mesh alive
+		const auto mesh = MeshType::LuaGet(lua, 1);
+		if (!mesh)
+		{
+			return luaL_error(lua, "Pre-First argument expected to be a Mesh");
+		}
+		GlmVec3ListType::LuaPushView(lua, std::shared_ptr<std::vector<glm::vec3>>(mesh, &mesh->vertices));
+		return 1;
+	}
+
 	lua_getuservalue(lua, 1);
 	lua_pushvalue(lua, 2);
 	lua_rawget(lua, -2);
@@ -465,3 +548,144 @@ int MeshType::CallbackClone(lua_State* lua)
 	LuaPush(lua, clone);
 	return 1;
 }
+
+int MeshType::CallbackBeginEdit(lua_State* lua)
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 1)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 1, is %d", argcnt);
+	}
+	const auto mesh = MeshType::LuaGet(lua, 1);
+	if (!mesh)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Mesh");
+	}
+
+	lua_getuservalue(lua, 1);
+	lua_getfield(lua, -1, "edit");
+	if (!lua_isnil(lua, -1))
+	{
+		return luaL_error(lua, "Mesh edit already begun; commit it first");
+	}
+	lua_pop(lua, 1);
+
+	void* ud = lua_newuserdata(lua, sizeof(data::MeshEditBatch));
+	new (ud) data::MeshEditBatch{ *mesh };
+	luaL_getmetatable(lua, LUA_EDIT_TYPE_NAME);
+	lua_setmetatable(lua, -2);
+	lua_setfield(lua, -2, "edit");
+	lua_pop(lua, 1);
+
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int MeshType::CallbackCommit(lua_State* lua)
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 1)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 1, is %d", argcnt);
+	}
+	const auto mesh = MeshType::LuaGet(lua, 1);
+	if (!mesh)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Mesh");
+	}
+
+	lua_getuservalue(lua, 1);
+	lua_getfield(lua, -1, "edit");
+	auto* batch = static_cast<data::MeshEditBatch*>(luaL_testudata(lua, -1, LUA_EDIT_TYPE_NAME));
+	if (batch == nullptr)
+	{
+		return luaL_error(lua, "Mesh edit not begun");
+	}
+	if (!batch->IsEmpty())
+	{
+		batch->Apply(*mesh);
+	}
+	lua_pop(lua, 1);
+	lua_pushnil(lua);
+	lua_setfield(lua, -2, "edit");
+	lua_pop(lua, 1);
+
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int MeshType::CallbackEditDelete(lua_State* lua)
+{
+	auto* batch = static_cast<data::MeshEditBatch*>(luaL_checkudata(lua, 1, LUA_EDIT_TYPE_NAME));
+	batch->~MeshEditBatch();
+	return 0;
+}
+
+data::MeshEditBatch* MeshType::GetEditBatch(lua_State* lua, int listIdx)
+{
+	lua_getuservalue(lua, listIdx); // the mesh
+	if (lua_getuservalue(lua, -1) != LUA_TTABLE) // the fields of the mesh
+	{
+		lua_pop(lua, 2);
+		return nullptr;
+	}
+	lua_getfield(lua, -1, "edit");
+	auto* batch = static_cast<data::MeshEditBatch*>(luaL_testudata(lua, -1, LUA_EDIT_TYPE_NAME));
+	lua_pop(lua, 3);
+	return batch; // kept alive by the fields of the mesh
+}
+
+int MeshType::DeferInsert(lua_State* lua, size_t listSize, bool (data::MeshEditBatch::*insert)(uint32_t, uint32_t), int (*append)(lua_State*))
+{
+	uint32_t idx;
+	if (GetLuaUint32(lua, 2, idx) != GetResult::Ok)
+	{
+		return luaL_error(lua, "Failed to get insert index argument integer");
+	}
+	if (idx != listSize + 1)
+	{
+		// appended now, so all indices stay stable during the edit, and moved to its position at commit
+		data::MeshEditBatch* batch = GetEditBatch(lua, 1);
+		if (idx == 0 || !(batch->*insert)(static_cast<uint32_t>(listSize), idx - 1))
+		{
+			return luaL_error(lua, "Invalid insert index argument integer, %d; during an edit, positions refer to the elements before the edit", idx);
+		}
+		lua_remove(lua, 2);
+	}
+	return append(lua);
+}
+
+int MeshType::DeferRemove(lua_State* lua, size_t listSize, void (data::MeshEditBatch::*remove)(uint32_t))
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 2)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 2 during an edit, is %d", argcnt);
+	}
+	data::MeshEditBatch* batch = GetEditBatch(lua, 1);
+
+	if (luaL_testudata(lua, 2, IndexListType::LUA_TYPE_NAME) != nullptr)
+	{
+		const auto indices = IndexListType::LuaGet(lua, 2);
+		for (uint32_t i : *indices)
+		{
+			if (i < listSize)
+			{
+				(batch->*remove)(i);
+			}
+		}
+		return 0;
+	}
+
+	uint32_t idx;
+	if (GetLuaUint32(lua, 2, idx) != GetResult::Ok)
+	{
+		return luaL_error(lua, "Failed to get remove index argument integer");
+	}
+	if (idx == 0 || idx > listSize)
+	{
+		return luaL_error(lua, "Invalid remove index argument integer, %d", idx);
+	}
+	(batch->*remove)(idx - 1);
+	return 0;
+}
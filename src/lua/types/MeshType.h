@@ -4,6 +4,7 @@
 #include "AbstractType.h"
 
 #include "data/Mesh.h"
+#include "data/MeshEditBatch.h"
 #include "data/Triangle.h"
 
 #include <glm/glm.hpp>
@@ -18,6 +19,7 @@ namespace meshproc
 			{
 			public:
 				static constexpr const char* LUA_TYPE_NAME = "SGR.MeshProc.Data.Mesh";
+				static constexpr const char* LUA_EDIT_TYPE_NAME = "SGR.MeshProc.Data.Mesh_Edit";
 
 				static int LuaPush(lua_State* lua, std::shared_ptr<data::Mesh> val);
 
@@ -33,6 +35,7 @@ namespace meshproc
 				public:
 					using listptr_t = std::vector<glm::vec3>*;
 					static listptr_t LuaGetList(lua_State* lua, int idx);
+					static listptr_t LuaGetListForResize(lua_State* lua, int idx) { return LuaGetList(lua, idx); }
 					static void OnInserted(lua_State* lua, int idx, listptr_t list, uint32_t idxZeroBase);
 					static void OnRemoved(lua_State* lua, int idx, listptr_t list, uint32_t idxZeroBase);
 					static void OnResized(lua_State* lua, int idx, listptr_t list, uint32_t newsize, uint32_t oldsize);
@@ -51,9 +54,11 @@ namespace meshproc
 					using MyAbstractListType::CallbackLength;
 					using MyAbstractListType::CallbackDispatchGet;
 					using MyAbstractListType::CallbackSet;
-					using MyAbstractListType::CallbackInsert;
-					using MyAbstractListType::CallbackRemove;
-					using MyAbstractListType::CallbackResize;
+
+					// deferred during an edit transaction of the mesh
+					static int CallbackInsert(lua_State* lua);
+					static int CallbackRemove(lua_State* lua);
+					static int CallbackResize(lua_State* lua);
 
 					static int CallbackRemoveIsolated(lua_State* lua);
 
@@ -67,6 +72,7 @@ namespace meshproc
 				public:
 					using listptr_t = std::vector<data::Triangle>*;
 					static listptr_t LuaGetList(lua_State* lua, int idx);
+					static listptr_t LuaGetListForResize(lua_State* lua, int idx) { return LuaGetList(lua, idx); }
 					static void OnInserted(lua_State* /*lua*/, int /*idx*/, listptr_t /*list*/, uint32_t /*idxZeroBase*/) {}
 					static void OnRemoved(lua_State* /*lua*/, int /*idx*/, listptr_t /*list*/, uint32_t /*idxZeroBase*/) {}
 					static void OnResized(lua_State* /*lua*/, int /*idx*/, listptr_t /*list*/, uint32_t /*newsize*/, uint32_t /*oldsize*/) {}
@@ -85,9 +91,11 @@ namespace meshproc
 					using MyAbstractListType::CallbackLength;
 					using MyAbstractListType::CallbackDispatchGet;
 					using MyAbstractListType::CallbackSet;
-					using MyAbstractListType::CallbackInsert;
-					using MyAbstractListType::CallbackRemove;
-					using MyAbstractListType::CallbackResize;
+
+					// deferred during an edit transaction of the mesh
+					static int CallbackInsert(lua_State* lua);
+					static int CallbackRemove(lua_State* lua);
+					static int CallbackResize(lua_State* lua);
 
 					static void LuaPushElementValue(lua_State* lua, const std::vector<data::Triangle>& list, uint32_t indexZeroBased);
 					static bool LuaGetElement(lua_State* lua, int i, data::Triangle& outVal);
@@ -102,6 +110,16 @@ namespace meshproc
 				static int CallbackCalcBoundingBox(lua_State* lua);
 				static int CallbackIsValid(lua_State* lua);
 				static int CallbackClone(lua_State* lua);
+				static int CallbackBeginEdit(lua_State* lua);
+				static int CallbackCommit(lua_State* lua);
+				static int CallbackEditDelete(lua_State* lua);
+
+				// @return the open edit transaction of the mesh owning the vertex or triangle list at `listIdx`, or nullptr
+				static data::MeshEditBatch* GetEditBatch(lua_State* lua, int listIdx);
+				// Appends the element at stack position 3, to be moved at commit to the position given at stack position 2
+				static int DeferInsert(lua_State* lua, size_t listSize, bool (data::MeshEditBatch::*insert)(uint32_t, uint32_t), int (*append)(lua_State*));
+				// Marks the elements given as index or IndexList argument at stack position 2 for removal at commit
+				static int DeferRemove(lua_State* lua, size_t listSize, void (data::MeshEditBatch::*remove)(uint32_t));
 
 				int IsValid(lua_State* lua);
 
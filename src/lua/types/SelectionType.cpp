@@ -0,0 +1,320 @@
+#include "SelectionType.h"
+
+#include "IndexListType.h"
+
+#include "data/Selection.h"
+#include "lua/LuaUtilities.h"
+
+using namespace meshproc;
+using namespace meshproc::lua;
+using namespace meshproc::lua::types;
+
+bool SelectionType::Init()
+{
+	static const struct luaL_Reg staticFuncs[] = {
+		{"new", &SelectionType::CallbackCtor},
+		{NULL, NULL}
+	};
+
+	static const struct luaL_Reg memberFuncs[] = {
+		{"__tostring", &SelectionType::CallbackToString},
+		{"__gc", &SelectionType::CallbackDelete},
+		{"__len", &SelectionType::CallbackLength},
+		{"__index", &SelectionType::CallbackDispatchGet},
+		{"__newindex", &SelectionType::CallbackSet},
+		{"resize", &SelectionType::CallbackResize},
+		{"count", &SelectionType::CallbackCount},
+		{"any", &SelectionType::CallbackAny},
+		{"clear", &SelectionType::CallbackClear},
+		{"clone", &SelectionType::CallbackClone},
+		{"union", &SelectionType::CallbackUnion},
+		{"intersect", &SelectionType::CallbackIntersect},
+		{"subtract", &SelectionType::CallbackSubtract},
+		{"invert", &SelectionType::CallbackInvert},
+		{"to_indexlist", &SelectionType::CallbackToIndexList},
+		{nullptr, nullptr}
+	};
+
+	if (!InitImpl(memberFuncs))
+	{
+		return false;
+	}
+
+	lua_getglobal(lua(), "meshproc");
+	lua_newtable(lua());
+	luaL_setfuncs(lua(), staticFuncs, 0);
+	lua_setfield(lua(), -2, "Selection");
+	lua_pop(lua(), 1);
+
+	return true;
+}
+
+std::shared_ptr<data::Selection> SelectionType::LuaGetOrConvert(lua_State* lua, int idx)
+{
+	if (luaL_testudata(lua, idx, LUA_TYPE_NAME) != nullptr)
+	{
+		return SelectionType::LuaGet(lua, idx);
+	}
+	if (luaL_testudata(lua, idx, IndexListType::LUA_TYPE_NAME) != nullptr)
+	{
+		const auto indices = IndexListType::LuaGet(lua, idx);
+		if (indices)
+		{
+			return std::make_shared<data::Selection>(data::Selection::FromIndices(*indices));
+		}
+	}
+	return nullptr;
+}
+
+int SelectionType::CallbackCtor(lua_State* lua)
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt > 2)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 0, 1 or 2, is %d", argcnt);
+	}
+
+	uint32_t size = 0;
+	if (argcnt >= 1 && lua_type(lua, argcnt) == LUA_TNUMBER)
+	{
+		if (GetLuaUint32(lua, argcnt, size) != GetResult::Ok)
+		{
+			return luaL_error(lua, "Failed to get size argument integer");
+		}
+	}
+
+	if (argcnt >= 1 && lua_type(lua, 1) != LUA_TNUMBER)
+	{
+		const auto indices = (luaL_testudata(lua, 1, IndexListType::LUA_TYPE_NAME) != nullptr) ? IndexListType::LuaGet(lua, 1) : nullptr;
+		if (!indices)
+		{
+			return luaL_error(lua, "First argument expected to be an IndexList or an integer size");
+		}
+		SelectionType::LuaPush(lua, std::make_shared<data::Selection>(data::Selection::FromIndices(*indices, size)));
+		return 1;
+	}
+
+	SelectionType::LuaPush(lua, std::make_shared<data::Selection>(size));
+	return 1;
+}
+
+int SelectionType::CallbackLength(lua_State* lua)
+{
+	const auto sel = SelectionType::LuaGet(lua, 1);
+	if (!sel)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Selection");
+	}
+	lua_pushinteger(lua, static_cast<lua_Integer>(sel->Size()));
+	return 1;
+}
+
+int SelectionType::CallbackDispatchGet(lua_State* lua)
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 2)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 2, is %d", argcnt);
+	}
+
+	if (lua_type(lua, 2) == LUA_TSTRING)
+	{
+		// member function
+		luaL_getmetatable(lua, LUA_TYPE_NAME);
+		lua_pushvalue(lua, 2);
+		lua_rawget(lua, -2);
+		lua_remove(lua, -2);
+		return 1;
+	}
+
+	const auto sel = SelectionType::LuaGet(lua, 1);
+	if (!sel)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Selection");
+	}
+
+	uint32_t idx;
+	if (GetLuaUint32(lua, 2, idx) != GetResult::Ok)
+	{
+		return luaL_error(lua, "Failed to get index argument integer");
+	}
+	if (idx == 0 || idx > sel->Size())
+	{
+		lua_pushnil(lua);
+		return 1;
+	}
+
+	lua_pushboolean(lua, sel->Get(idx - 1) ? 1 : 0);
+	return 1;
+}
+
+int SelectionType::CallbackSet(lua_State* lua)
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 3)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 3, is %d", argcnt);
+	}
+
+	const auto sel = SelectionType::LuaGet(lua, 1);
+	if (!sel)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Selection");
+	}
+
+	uint32_t idx;
+	if (GetLuaUint32(lua, 2, idx) != GetResult::Ok || idx == 0)
+	{
+		return luaL_error(lua, "Failed to get index argument integer");
+	}
+
+	bool val;
+	if (GetLuaBool(lua, 3, val) != GetResult::Ok)
+	{
+		return luaL_error(lua, "Failed to get value argument boolean");
+	}
+
+	// setting beyond the size grows the selection
+	sel->Set(idx - 1, val);
+	return 0;
+}
+
+int SelectionType::CallbackResize(lua_State* lua)
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 2)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 2, is %d", argcnt);
+	}
+
+	const auto sel = SelectionType::LuaGet(lua, 1);
+	if (!sel)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Selection");
+	}
+
+	uint32_t size;
+	if (GetLuaUint32(lua, 2, size) != GetResult::Ok)
+	{
+		return luaL_error(lua, "Failed to get size argument integer");
+	}
+
+	sel->Resize(size);
+	return 0;
+}
+
+int SelectionType::CallbackCount(lua_State* lua)
+{
+	const auto sel = SelectionType::LuaGet(lua, 1);
+	if (!sel)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Selection");
+	}
+	lua_pushinteger(lua, static_cast<lua_Integer>(sel->Count()));
+	return 1;
+}
+
+int SelectionType::CallbackAny(lua_State* lua)
+{
+	const auto sel = SelectionType::LuaGet(lua, 1);
+	if (!sel)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Selection");
+	}
+	lua_pushboolean(lua, sel->Any() ? 1 : 0);
+	return 1;
+}
+
+int SelectionType::CallbackClear(lua_State* lua)
+{
+	const auto sel = SelectionType::LuaGet(lua, 1);
+	if (!sel)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Selection");
+	}
+	sel->Clear();
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int SelectionType::CallbackClone(lua_State* lua)
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 1)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 1, is %d", argcnt);
+	}
+
+	const auto sel = SelectionType::LuaGet(lua, 1);
+	if (!sel)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Selection");
+	}
+
+	SelectionType::LuaPush(lua, std::make_shared<data::Selection>(*sel));
+	return 1;
+}
+
+int SelectionType::SetOperationImpl(lua_State* lua, void (data::Selection::* op)(const data::Selection&))
+{
+	const int argcnt = lua_gettop(lua);
+	if (argcnt != 2)
+	{
+		return luaL_error(lua, "Arguments number mismatch: must be 2, is %d", argcnt);
+	}
+
+	const auto sel = SelectionType::LuaGet(lua, 1);
+	if (!sel)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Selection");
+	}
+
+	const auto other = LuaGetOrConvert(lua, 2);
+	if (!other)
+	{
+		return luaL_error(lua, "First argument expected to be a Selection or an IndexList");
+	}
+
+	((*sel).*op)(*other);
+
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int SelectionType::CallbackUnion(lua_State* lua)
+{
+	return SetOperationImpl(lua, &data::Selection::Union);
+}
+
+int SelectionType::CallbackIntersect(lua_State* lua)
+{
+	return SetOperationImpl(lua, &data::Selection::Intersect);
+}
+
+int SelectionType::CallbackSubtract(lua_State* lua)
+{
+	return SetOperationImpl(lua, &data::Selection::Subtract);
+}
+
+int SelectionType::CallbackInvert(lua_State* lua)
+{
+	const auto sel = SelectionType::LuaGet(lua, 1);
+	if (!sel)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Selection");
+	}
+	sel->Invert();
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int SelectionType::CallbackToIndexList(lua_State* lua)
+{
+	const auto sel = SelectionType::LuaGet(lua, 1);
+	if (!sel)
+	{
+		return luaL_error(lua, "Pre-First argument expected to be a Selection");
+	}
+	IndexListType::LuaPush(lua, std::make_shared<std::vector<uint32_t>>(sel->ToIndices()));
+	return 1;
+}
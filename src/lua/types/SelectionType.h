@@ -0,0 +1,55 @@
+#pragma once
+
+#include "AbstractType.h"
+
+#include <memory>
+
+namespace meshproc
+{
+	namespace data
+	{
+		class Selection;
+	}
+
+	namespace lua
+	{
+		namespace types
+		{
+			/*
+			 * Bitset of selected elements; the lua API is one-based, like for IndexList
+			 */
+			class SelectionType : public AbstractType<data::Selection, SelectionType>
+			{
+			public:
+				static constexpr const char* LUA_TYPE_NAME = "SGR.MeshProc.Data.Selection";
+
+				SelectionType(Runner& owner)
+					: AbstractType<data::Selection, SelectionType>{ owner }
+				{};
+				bool Init();
+
+				// @return the Selection at `idx`, or a new Selection converted from the IndexList at `idx`, or nullptr
+				static std::shared_ptr<data::Selection> LuaGetOrConvert(lua_State* lua, int idx);
+
+			private:
+				static int CallbackCtor(lua_State* lua);
+				static int CallbackLength(lua_State* lua);
+				static int CallbackDispatchGet(lua_State* lua);
+				static int CallbackSet(lua_State* lua);
+				static int CallbackResize(lua_State* lua);
+				static int CallbackCount(lua_State* lua);
+				static int CallbackAny(lua_State* lua);
+				static int CallbackClear(lua_State* lua);
+				static int CallbackClone(lua_State* lua);
+				static int CallbackUnion(lua_State* lua);
+				static int CallbackIntersect(lua_State* lua);
+				static int CallbackSubtract(lua_State* lua);
+				static int CallbackInvert(lua_State* lua);
+				static int CallbackToIndexList(lua_State* lua);
+
+				static int SetOperationImpl(lua_State* lua, void (data::Selection::*op)(const data::Selection&));
+			};
+
+		}
+	}
+}
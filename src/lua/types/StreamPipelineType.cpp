@@ -0,0 +1,209 @@
+#include "StreamPipelineType.h"
+
+#include "GlmMat4Type.h"
+#include "HalfSpaceType.h"
+#include "lua/LuaUtilities.h"
+
+#include "data/HalfSpace.h"
+#include "stream/Pipeline.h"
+#include "utilities/StringUtilities.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <cstring>
+
+using namespace meshproc;
+using namespace meshproc::lua;
+using namespace meshproc::lua::types;
+
+namespace
+{
+	std::shared_ptr<stream::Pipeline> GetPipelineWithArgs(lua_State* lua, int expectedArgCnt)
+	{
+		const int argcnt = lua_gettop(lua);
+		if (argcnt != expectedArgCnt)
+		{
+			luaL_error(lua, "Arguments number mismatch: must be %d, is %d", expectedArgCnt, argcnt);
+			return nullptr;
+		}
+		auto pipeline = StreamPipelineType::LuaGet(lua, 1);
+		if (!pipeline)
+		{
+			luaL_error(lua, "Pre-First argument expected to be a StreamPipeline");
+		}
+		return pipeline;
+	}
+}
+
+bool StreamPipelineType::Init()
+{
+	static const struct luaL_Reg staticFuncs[] = {
+		{"new", &StreamPipelineType::CallbackCtor},
+		{NULL, NULL}
+	};
+
+	static const struct luaL_Reg memberFuncs[] = {
+		{"__tostring", &StreamPipelineType::CallbackToString},
+		{"__gc", &StreamPipelineType::CallbackDelete},
+		{"read", &StreamPipelineType::CallbackRead},
+		{"transform", &StreamPipelineType::CallbackTransform},
+		{"cut", &StreamPipelineType::CallbackCut},
+		{"compute", &StreamPipelineType::CallbackCompute},
+		{"write", &StreamPipelineType::CallbackWrite},
+		{"set_chunk_size", &StreamPipelineType::CallbackSetChunkSize},
+		{"set_weld_window", &StreamPipelineType::CallbackSetWeldWindow},
+		{"run", &StreamPipelineType::CallbackRun},
+		{"stats", &StreamPipelineType::CallbackStats},
+		{nullptr, nullptr}
+	};
+
+	if (!InitImpl(memberFuncs))
+	{
+		return false;
+	}
+
+	lua_getglobal(lua(), "meshproc");
+	lua_newtable(lua());
+	luaL_setfuncs(lua(), staticFuncs, 0);
+	lua_setfield(lua(), -2, "StreamPipeline");
+	lua_pop(lua(), 1);
+
+	return true;
+}
+
+int StreamPipelineType::CallbackCtor(lua_State* lua)
+{
+	StreamPipelineType::LuaPush(lua, std::make_shared<stream::Pipeline>());
+	return 1;
+}
+
+int StreamPipelineType::CallbackRead(lua_State* lua)
+{
+	auto pipeline = GetPipelineWithArgs(lua, 2);
+	if (lua_type(lua, 2) != LUA_TSTRING)
+	{
+		return luaL_error(lua, "First argument expected to be a file path string");
+	}
+	pipeline->SetSource(FromUtf8(lua_tostring(lua, 2)));
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int StreamPipelineType::CallbackTransform(lua_State* lua)
+{
+	auto pipeline = GetPipelineWithArgs(lua, 2);
+	glm::mat4 mat{ 1.0f };
+	if (!GlmMat4Type::TryGet(lua, 2, mat))
+	{
+		return luaL_error(lua, "First argument expected to be a XMat4");
+	}
+	pipeline->AddTransform(mat);
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int StreamPipelineType::CallbackCut(lua_State* lua)
+{
+	auto pipeline = GetPipelineWithArgs(lua, 2);
+	auto hs = HalfSpaceType::LuaGet(lua, 2);
+	if (!hs)
+	{
+		return luaL_error(lua, "First argument expected to be a HalfSpace");
+	}
+	pipeline->AddCut(*hs);
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int StreamPipelineType::CallbackCompute(lua_State* lua)
+{
+	auto pipeline = GetPipelineWithArgs(lua, 2);
+	if (lua_type(lua, 2) != LUA_TSTRING)
+	{
+		return luaL_error(lua, "First argument expected to be an attribute name string");
+	}
+	const char* name = lua_tostring(lua, 2);
+	if (strcmp(name, "normal") == 0)
+	{
+		pipeline->ComputedAttributes().normal = true;
+	}
+	else if (strcmp(name, "area") == 0)
+	{
+		pipeline->ComputedAttributes().area = true;
+	}
+	else
+	{
+		return luaL_error(lua, "Unknown attribute \"%s\"; expected \"normal\" or \"area\"", name);
+	}
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int StreamPipelineType::CallbackWrite(lua_State* lua)
+{
+	auto pipeline = GetPipelineWithArgs(lua, 2);
+	if (lua_type(lua, 2) != LUA_TSTRING)
+	{
+		return luaL_error(lua, "First argument expected to be a file path string");
+	}
+	pipeline->SetSink(FromUtf8(lua_tostring(lua, 2)));
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int StreamPipelineType::CallbackSetChunkSize(lua_State* lua)
+{
+	auto pipeline = GetPipelineWithArgs(lua, 2);
+	uint32_t size;
+	if (GetLuaUint32(lua, 2, size) != GetResult::Ok || size == 0)
+	{
+		return luaL_error(lua, "First argument expected to be a positive integer");
+	}
+	pipeline->chunkSize = size;
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int StreamPipelineType::CallbackSetWeldWindow(lua_State* lua)
+{
+	auto pipeline = GetPipelineWithArgs(lua, 2);
+	uint32_t size;
+	if (GetLuaUint32(lua, 2, size) != GetResult::Ok)
+	{
+		return luaL_error(lua, "First argument expected to be a non-negative integer");
+	}
+	pipeline->weldWindow = size;
+	lua_pushvalue(lua, 1);
+	return 1;
+}
+
+int StreamPipelineType::CallbackRun(lua_State* lua)
+{
+	return CallLuaImpl(&StreamPipelineType::Run, lua);
+}
+
+int StreamPipelineType::Run(lua_State* lua)
+{
+	auto pipeline = GetPipelineWithArgs(lua, 1);
+	lua_pushboolean(lua, pipeline->Run(Log()));
+	return 1;
+}
+
+int StreamPipelineType::CallbackStats(lua_State* lua)
+{
+	auto pipeline = GetPipelineWithArgs(lua, 1);
+	const stream::Pipeline::Stats& stats = pipeline->GetStats();
+
+	lua_newtable(lua);
+	lua_pushinteger(lua, static_cast<lua_Integer>(stats.trianglesRead));
+	lua_setfield(lua, -2, "triangles_read");
+	lua_pushinteger(lua, static_cast<lua_Integer>(stats.trianglesWritten));
+	lua_setfield(lua, -2, "triangles_written");
+	lua_pushinteger(lua, static_cast<lua_Integer>(stats.verticesWritten));
+	lua_setfield(lua, -2, "vertices_written");
+	lua_pushinteger(lua, static_cast<lua_Integer>(stats.chunks));
+	lua_setfield(lua, -2, "chunks");
+	lua_pushnumber(lua, stats.seconds);
+	lua_setfield(lua, -2, "seconds");
+	return 1;
+}
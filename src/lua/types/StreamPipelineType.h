@@ -0,0 +1,43 @@
+#pragma once
+
+#include "AbstractType.h"
+
+namespace meshproc
+{
+	namespace stream
+	{
+		class Pipeline;
+	}
+
+	namespace lua
+	{
+		namespace types
+		{
+			class StreamPipelineType : public AbstractType<stream::Pipeline, StreamPipelineType>
+			{
+			public:
+				static constexpr const char* LUA_TYPE_NAME = "SGR.MeshProc.StreamPipeline";
+
+				StreamPipelineType(Runner& owner)
+					: AbstractType<stream::Pipeline, StreamPipelineType>{ owner }
+				{};
+				bool Init();
+
+			private:
+				static int CallbackCtor(lua_State* lua);
+				static int CallbackRead(lua_State* lua);
+				static int CallbackTransform(lua_State* lua);
+				static int CallbackCut(lua_State* lua);
+				static int CallbackCompute(lua_State* lua);
+				static int CallbackWrite(lua_State* lua);
+				static int CallbackSetChunkSize(lua_State* lua);
+				static int CallbackSetWeldWindow(lua_State* lua);
+				static int CallbackRun(lua_State* lua);
+				static int CallbackStats(lua_State* lua);
+
+				int Run(lua_State* lua);
+			};
+
+		}
+	}
+}
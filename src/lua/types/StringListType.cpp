@@ -0,0 +1,62 @@
+#include "StringListType.h"
+
+#include "utilities/StringUtilities.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+using namespace meshproc;
+using namespace meshproc::lua;
+using namespace meshproc::lua::types;
+
+bool StringListType::Init()
+{
+	static const struct luaL_Reg staticFuncs[] = {
+		{"new", &StringListType::CallbackCtor},
+		{NULL, NULL}
+	};
+
+	static const struct luaL_Reg memberFuncs[] = {
+		{"__tostring", &StringListType::CallbackToString},
+		{"__gc", &StringListType::CallbackDelete},
+		{"__len", &StringListType::CallbackLength},
+		{"__index", &StringListType::CallbackDispatchGet},
+		{"__newindex", &StringListType::CallbackSet},
+		{"insert", &StringListType::CallbackInsert},
+		{"remove", &StringListType::CallbackRemove},
+		{"resize", &StringListType::CallbackResize},
+		{nullptr, nullptr}
+	};
+
+	if (!InitImpl(memberFuncs))
+	{
+		return false;
+	}
+
+	lua_getglobal(lua(), "meshproc");
+	lua_newtable(lua());
+	luaL_setfuncs(lua(), staticFuncs, 0);
+	lua_setfield(lua(), -2, "StringList");
+	lua_pop(lua(), 1);
+
+	return true;
+}
+
+void StringListType::LuaPushElementValue(lua_State* lua, const std::vector<std::wstring>& list, uint32_t indexZeroBased)
+{
+	lua_pushstring(lua, ToUtf8(list.at(indexZeroBased)).c_str());
+}
+
+bool StringListType::LuaGetElement(lua_State* lua, int i, std::wstring& outVal)
+{
+	if (lua_type(lua, i) == LUA_TSTRING)
+	{
+		outVal = FromUtf8(lua_tostring(lua, i));
+		return true;
+	}
+	return false;
+}
+
+std::wstring StringListType::GetInvalidValue()
+{
+	return {};
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "AbstractListType.h"
+
+#include <string>
+#include <vector>
+
+namespace meshproc
+{
+	namespace lua
+	{
+		namespace types
+		{
+			class StringListType : public AbstractListType<std::wstring, StringListType>
+			{
+			public:
+				static constexpr const char* LUA_TYPE_NAME = "SGR.MeshProc.Data.StringList";
+
+				StringListType(Runner& owner)
+					: AbstractListType<std::wstring, StringListType>{ owner }
+				{}
+				bool Init();
+
+			private:
+				friend AbstractListType<std::wstring, StringListType>;
+
+				static void LuaPushElementValue(lua_State* lua, const std::vector<std::wstring>& list, uint32_t indexZeroBased);
+				static bool LuaGetElement(lua_State* lua, int i, std::wstring& outVal);
+				static std::wstring GetInvalidValue();
+
+			};
+		}
+	}
+}
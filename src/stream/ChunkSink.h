@@ -0,0 +1,27 @@
+#pragma once
+
+#include "TriangleChunk.h"
+
+#include <cstdint>
+
+namespace meshproc
+{
+	namespace stream
+	{
+
+		class ChunkSink
+		{
+		public:
+			virtual ~ChunkSink() = default;
+
+			virtual bool Write(const TriangleChunk& chunk) = 0;
+
+			// Completes and closes the output file
+			virtual bool Finish() = 0;
+
+			virtual uint64_t VertexCount() const = 0;
+			virtual uint64_t TriangleCount() const = 0;
+		};
+
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "TriangleChunk.h"
+
+#include <cstdint>
+
+namespace meshproc
+{
+	namespace stream
+	{
+
+		class ChunkSource
+		{
+		public:
+			virtual ~ChunkSource() = default;
+
+			// Replaces the content of `chunk` with the next up to `maxTriangles` triangles.
+			// An empty chunk marks the end of the stream. Returns false on errors.
+			virtual bool ReadChunk(TriangleChunk& chunk, size_t maxTriangles) = 0;
+
+			virtual uint64_t TriangleCount() const = 0;
+		};
+
+	}
+}
@@ -0,0 +1,148 @@
+#include "ChunkStages.h"
+
+#include "utilities/MortonCode.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace meshproc;
+using namespace meshproc::stream;
+
+void TransformStage::Process(TriangleChunk& chunk)
+{
+	for (auto& tri : chunk.triangles)
+	{
+		for (glm::vec3& v : tri)
+		{
+			glm::vec4 p = m_mat * glm::vec4{ v, 1.0f };
+			v = glm::vec3{ p } / p.w;
+		}
+	}
+}
+
+void CutStage::Process(TriangleChunk& chunk)
+{
+	m_out.clear();
+	m_out.reserve(chunk.triangles.size());
+
+	for (const auto& tri : chunk.triangles)
+	{
+		const float d[3] = {
+			m_halfSpace.Dist(tri[0]),
+			m_halfSpace.Dist(tri[1]),
+			m_halfSpace.Dist(tri[2])
+		};
+		const int inCnt = (d[0] >= 0.0f ? 1 : 0) + (d[1] >= 0.0f ? 1 : 0) + (d[2] >= 0.0f ? 1 : 0);
+		if (inCnt == 3)
+		{
+			m_out.push_back(tri);
+			continue;
+		}
+		if (inCnt == 0)
+		{
+			continue;
+		}
+
+		// clip the triangle polygon, keeping the winding order
+		glm::vec3 poly[4];
+		int polyCnt = 0;
+		for (int i = 0; i < 3; ++i)
+		{
+			const int j = (i + 1) % 3;
+			if (d[i] >= 0.0f)
+			{
+				poly[polyCnt++] = tri[i];
+			}
+			if ((d[i] >= 0.0f) != (d[j] >= 0.0f))
+			{
+				const float t = d[i] / (d[i] - d[j]);
+				poly[polyCnt++] = tri[i] + (tri[j] - tri[i]) * t;
+			}
+		}
+
+		m_out.push_back({ poly[0], poly[1], poly[2] });
+		if (polyCnt == 4)
+		{
+			m_out.push_back({ poly[0], poly[2], poly[3] });
+		}
+	}
+
+	chunk.triangles.swap(m_out);
+	// attributes are computed after all geometry stages
+	chunk.normals.clear();
+	chunk.areas.clear();
+}
+
+void meshproc::stream::ComputeAttributes(TriangleChunk& chunk, const Attributes& attributes)
+{
+	const size_t cnt = chunk.triangles.size();
+	if (attributes.normal)
+	{
+		chunk.normals.resize(cnt);
+	}
+	if (attributes.area)
+	{
+		chunk.areas.resize(cnt);
+	}
+	if (!attributes.normal && !attributes.area)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		const auto& tri = chunk.triangles[i];
+		const glm::vec3 c = glm::cross(tri[1] - tri[0], tri[2] - tri[0]);
+		const float len = glm::length(c);
+		if (attributes.normal)
+		{
+			chunk.normals[i] = (len > 0.0f) ? (c / len) : glm::vec3{ 0.0f, 0.0f, 0.0f };
+		}
+		if (attributes.area)
+		{
+			chunk.areas[i] = 0.5f * len;
+		}
+	}
+}
+
+void meshproc::stream::SpatialSortChunk(TriangleChunk& chunk)
+{
+	const size_t cnt = chunk.triangles.size();
+	if (cnt < 2)
+	{
+		return;
+	}
+
+	std::vector<glm::vec3> centroids(cnt);
+	glm::vec3 bbMin = chunk.triangles[0][0];
+	glm::vec3 bbMax = bbMin;
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		const auto& tri = chunk.triangles[i];
+		centroids[i] = (tri[0] + tri[1] + tri[2]) / 3.0f;
+		bbMin = glm::min(bbMin, centroids[i]);
+		bbMax = glm::max(bbMax, centroids[i]);
+	}
+
+	const utilities::MortonGrid grid{ bbMin, bbMax };
+	std::vector<std::pair<uint64_t, uint32_t>> keys(cnt);
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		keys[i] = { grid.Code(centroids[i]), static_cast<uint32_t>(i) };
+	}
+	std::sort(keys.begin(), keys.end());
+
+	auto reorder = [&](auto& list)
+		{
+			if (list.empty()) return;
+			std::remove_reference_t<decltype(list)> sorted(cnt);
+			for (size_t i = 0; i < cnt; ++i)
+			{
+				sorted[i] = list[keys[i].second];
+			}
+			list.swap(sorted);
+		};
+	reorder(chunk.triangles);
+	reorder(chunk.normals);
+	reorder(chunk.areas);
+}
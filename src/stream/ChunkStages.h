@@ -0,0 +1,57 @@
+#pragma once
+
+#include "TriangleChunk.h"
+
+#include "data/HalfSpace.h"
+
+#include <glm/glm.hpp>
+
+namespace meshproc
+{
+	namespace stream
+	{
+
+		class ChunkStage
+		{
+		public:
+			virtual ~ChunkStage() = default;
+
+			virtual void Process(TriangleChunk& chunk) = 0;
+		};
+
+		class TransformStage : public ChunkStage
+		{
+		public:
+			TransformStage(const glm::mat4& mat)
+				: m_mat{ mat }
+			{}
+
+			void Process(TriangleChunk& chunk) override;
+
+		private:
+			const glm::mat4 m_mat;
+		};
+
+		// Keeps the parts of all triangles in the positive half space, like `edit::CutHalfSpace`,
+		// but without closing the cut, as the open border is never known as a whole
+		class CutStage : public ChunkStage
+		{
+		public:
+			CutStage(const data::HalfSpace& halfSpace)
+				: m_halfSpace{ halfSpace }
+			{}
+
+			void Process(TriangleChunk& chunk) override;
+
+		private:
+			const data::HalfSpace m_halfSpace;
+			std::vector<std::array<glm::vec3, 3>> m_out;
+		};
+
+		void ComputeAttributes(TriangleChunk& chunk, const Attributes& attributes);
+
+		// Reorders the triangles of the chunk along the Morton curve of their centroids
+		void SpatialSortChunk(TriangleChunk& chunk);
+
+	}
+}
@@ -0,0 +1,143 @@
+#include "Pipeline.h"
+
+#include "PlyChunkSink.h"
+#include "PlyChunkSource.h"
+#include "StlChunkSink.h"
+#include "StlChunkSource.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cwctype>
+#include <filesystem>
+#include <future>
+
+using namespace meshproc;
+using namespace meshproc::stream;
+
+namespace
+{
+	std::wstring LowerExtension(const std::wstring& path)
+	{
+		std::wstring ext = std::filesystem::path{ path }.extension().wstring();
+		std::transform(ext.begin(), ext.end(), ext.begin(), [](wchar_t c) { return static_cast<wchar_t>(std::towlower(c)); });
+		return ext;
+	}
+}
+
+bool Pipeline::Run(const sgrottel::ISimpleLog& log)
+{
+	m_stats = Stats{};
+	const auto start = std::chrono::steady_clock::now();
+
+	if (m_sourcePath.empty() || m_sinkPath.empty())
+	{
+		log.Error("Stream pipeline requires input and output files");
+		return false;
+	}
+	if (chunkSize == 0)
+	{
+		log.Error("Stream pipeline chunk size must not be zero");
+		return false;
+	}
+
+	std::unique_ptr<ChunkSource> source;
+	const std::wstring srcExt = LowerExtension(m_sourcePath);
+	if (srcExt == L".stl")
+	{
+		auto stl = std::make_unique<StlChunkSource>(log);
+		if (!stl->Open(m_sourcePath)) return false;
+		source = std::move(stl);
+	}
+	else if (srcExt == L".ply")
+	{
+		auto ply = std::make_unique<PlyChunkSource>(log, vertexCachePages);
+		if (!ply->Open(m_sourcePath)) return false;
+		source = std::move(ply);
+	}
+	else
+	{
+		log.Error(L"Stream pipeline cannot read \"%s\": only binary STL and PLY files are supported", m_sourcePath.c_str());
+		return false;
+	}
+
+	std::unique_ptr<ChunkSink> sink;
+	const std::wstring sinkExt = LowerExtension(m_sinkPath);
+	if (sinkExt == L".stl")
+	{
+		if (m_attributes.area)
+		{
+			log.Warning("STL cannot store the triangle area attribute");
+		}
+		auto stl = std::make_unique<StlChunkSink>(log);
+		if (!stl->Open(m_sinkPath)) return false;
+		sink = std::move(stl);
+	}
+	else if (sinkExt == L".ply")
+	{
+		auto ply = std::make_unique<PlyChunkSink>(log, weldWindow, m_attributes);
+		if (!ply->Open(m_sinkPath)) return false;
+		sink = std::move(ply);
+	}
+	else
+	{
+		log.Error(L"Stream pipeline cannot write \"%s\": only binary STL and PLY files are supported", m_sinkPath.c_str());
+		return false;
+	}
+
+	// reading the next chunk overlaps with processing and writing the current one
+	TriangleChunk chunk;
+	TriangleChunk nextChunk;
+	if (!source->ReadChunk(chunk, chunkSize))
+	{
+		return false;
+	}
+	while (!chunk.triangles.empty())
+	{
+		m_stats.trianglesRead += chunk.triangles.size();
+		m_stats.chunks++;
+
+		std::future<bool> nextRead = std::async(std::launch::async, [&]() { return source->ReadChunk(nextChunk, chunkSize); });
+
+		for (auto& stage : m_stages)
+		{
+			stage->Process(chunk);
+		}
+		ComputeAttributes(chunk, m_attributes);
+		if (spatialSort)
+		{
+			SpatialSortChunk(chunk);
+		}
+		const bool written = sink->Write(chunk);
+
+		const bool read = nextRead.get();
+		if (!written || !read)
+		{
+			return false;
+		}
+		std::swap(chunk, nextChunk);
+	}
+
+	if (!sink->Finish())
+	{
+		return false;
+	}
+
+	m_stats.trianglesWritten = sink->TriangleCount();
+	m_stats.verticesWritten = sink->VertexCount();
+	m_stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	log.Message("Streamed %llu triangles in %llu chunks to %llu triangles and %llu vertices in %.3f s",
+		static_cast<unsigned long long>(m_stats.trianglesRead),
+		static_cast<unsigned long long>(m_stats.chunks),
+		static_cast<unsigned long long>(m_stats.trianglesWritten),
+		static_cast<unsigned long long>(m_stats.verticesWritten),
+		m_stats.seconds);
+	if (const PlyChunkSource* ply = dynamic_cast<const PlyChunkSource*>(source.get()); ply != nullptr)
+	{
+		log.Detail("PLY vertex cache loaded %llu pages", static_cast<unsigned long long>(ply->PageLoads()));
+	}
+
+	return true;
+}
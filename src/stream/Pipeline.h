@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ChunkStages.h"
+#include "TriangleChunk.h"
+
+#include "data/HalfSpace.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sgrottel
+{
+	class ISimpleLog;
+}
+
+namespace meshproc
+{
+	namespace stream
+	{
+
+		// Out-of-core processing chain: read -> transform/cut stages -> attributes -> write.
+		// Only fixed-size chunks of triangles are held in memory, never the whole mesh.
+		class Pipeline
+		{
+		public:
+			struct Stats
+			{
+				uint64_t trianglesRead{ 0 };
+				uint64_t trianglesWritten{ 0 };
+				uint64_t verticesWritten{ 0 };
+				uint64_t chunks{ 0 };
+				double seconds{ 0.0 };
+			};
+
+			void SetSource(const std::wstring& path)
+			{
+				m_sourcePath = path;
+			}
+			void SetSink(const std::wstring& path)
+			{
+				m_sinkPath = path;
+			}
+			void AddTransform(const glm::mat4& mat)
+			{
+				m_stages.push_back(std::make_shared<TransformStage>(mat));
+			}
+			void AddCut(const data::HalfSpace& halfSpace)
+			{
+				m_stages.push_back(std::make_shared<CutStage>(halfSpace));
+			}
+			Attributes& ComputedAttributes()
+			{
+				return m_attributes;
+			}
+
+			uint32_t chunkSize{ 64 * 1024 };
+			uint32_t weldWindow{ 1024 * 1024 };
+			uint32_t vertexCachePages{ 256 };
+			bool spatialSort{ true };
+
+			bool Run(const sgrottel::ISimpleLog& log);
+
+			inline const Stats& GetStats() const
+			{
+				return m_stats;
+			}
+
+		private:
+			std::wstring m_sourcePath;
+			std::wstring m_sinkPath;
+			std::vector<std::shared_ptr<ChunkStage>> m_stages;
+			Attributes m_attributes;
+			Stats m_stats;
+		};
+
+	}
+}
@@ -0,0 +1,192 @@
+#include "PlyChunkSink.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <cstring>
+#include <filesystem>
+
+using namespace meshproc;
+using namespace meshproc::stream;
+
+namespace
+{
+	// placeholder width of element counts in the header, patched on `Finish`
+	constexpr const char* CountFormat = "%010u\n";
+}
+
+PlyChunkSink::PlyChunkSink(const sgrottel::ISimpleLog& log, uint32_t weldWindow, const Attributes& attributes)
+	: m_log{ log }, m_weldWindow{ weldWindow }, m_attributes{ attributes }, m_file{ MakeFilePtr() }, m_faceFile{ MakeFilePtr() }
+{
+}
+
+PlyChunkSink::~PlyChunkSink()
+{
+	if (m_faceFile)
+	{
+		m_faceFile.reset();
+		std::error_code ec;
+		std::filesystem::remove(m_faceFilePath, ec);
+	}
+}
+
+bool PlyChunkSink::Open(const std::wstring& path)
+{
+	FILE* file = nullptr;
+	errno_t r = _wfopen_s(&file, path.c_str(), L"wb");
+	if (r != 0 || file == nullptr)
+	{
+		m_log.Error(L"Failed to open \"%s\": %d", path.c_str(), static_cast<int>(r));
+		return false;
+	}
+	m_file = MakeFilePtr(file);
+
+	m_faceFilePath = path + L".faces.tmp";
+	file = nullptr;
+	r = _wfopen_s(&file, m_faceFilePath.c_str(), L"w+b");
+	if (r != 0 || file == nullptr)
+	{
+		m_log.Error(L"Failed to open temporary file \"%s\": %d", m_faceFilePath.c_str(), static_cast<int>(r));
+		return false;
+	}
+	m_faceFile = MakeFilePtr(file);
+
+	file = m_file.get();
+	fprintf(file, "ply\n");
+	fprintf(file, "format binary_little_endian 1.0\n");
+
+	fprintf(file, "element vertex ");
+	m_vertCntPos = _ftelli64(file);
+	fprintf(file, CountFormat, 0u);
+	fprintf(file, "property float x\n");
+	fprintf(file, "property float y\n");
+	fprintf(file, "property float z\n");
+
+	fprintf(file, "element face ");
+	m_triCntPos = _ftelli64(file);
+	fprintf(file, CountFormat, 0u);
+	fprintf(file, "property list uchar uint vertex_indices\n");
+	if (m_attributes.normal)
+	{
+		fprintf(file, "property float nx\n");
+		fprintf(file, "property float ny\n");
+		fprintf(file, "property float nz\n");
+	}
+	if (m_attributes.area)
+	{
+		fprintf(file, "property float area\n");
+	}
+
+	fprintf(file, "end_header\n");
+
+	m_vertCnt = 0;
+	m_triCnt = 0;
+	m_window.clear();
+	m_windowOrder.clear();
+
+	m_log.Message(L"Streaming to PLY: %s", path.c_str());
+	return true;
+}
+
+uint32_t PlyChunkSink::WeldVertex(const glm::vec3& v)
+{
+	auto it = m_window.find(v);
+	if (it != m_window.end())
+	{
+		return it->second;
+	}
+
+	const uint32_t idx = m_vertCnt++;
+	m_vertBuf.push_back(v);
+
+	if (m_weldWindow > 0)
+	{
+		if (m_windowOrder.size() >= m_weldWindow)
+		{
+			m_window.erase(m_windowOrder.front());
+			m_windowOrder.pop_front();
+		}
+		m_window.emplace(v, idx);
+		m_windowOrder.push_back(v);
+	}
+
+	return idx;
+}
+
+bool PlyChunkSink::Write(const TriangleChunk& chunk)
+{
+	const size_t cnt = chunk.triangles.size();
+	const size_t faceSize = 1 + 3 * 4 + (m_attributes.normal ? 12 : 0) + (m_attributes.area ? 4 : 0);
+
+	m_vertBuf.clear();
+	m_faceBuf.resize(cnt * faceSize);
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		uint8_t* tar = m_faceBuf.data() + i * faceSize;
+		tar[0] = 3;
+		uint32_t idx[3];
+		for (int j = 0; j < 3; ++j)
+		{
+			idx[j] = WeldVertex(chunk.triangles[i][j]);
+		}
+		std::memcpy(tar + 1, idx, 12);
+		tar += 13;
+		if (m_attributes.normal)
+		{
+			std::memcpy(tar, &chunk.normals.at(i), 12);
+			tar += 12;
+		}
+		if (m_attributes.area)
+		{
+			std::memcpy(tar, &chunk.areas.at(i), 4);
+		}
+	}
+
+	if (fwrite(m_vertBuf.data(), 12, m_vertBuf.size(), m_file.get()) != m_vertBuf.size())
+	{
+		m_log.Error("Failed to write PLY vertex data");
+		return false;
+	}
+	if (fwrite(m_faceBuf.data(), faceSize, cnt, m_faceFile.get()) != cnt)
+	{
+		m_log.Error("Failed to write PLY face data to temporary file");
+		return false;
+	}
+	m_triCnt += static_cast<uint32_t>(cnt);
+	return true;
+}
+
+bool PlyChunkSink::Finish()
+{
+	// append spooled faces
+	if (_fseeki64(m_faceFile.get(), 0, SEEK_SET) != 0)
+	{
+		m_log.Error("Failed to rewind temporary PLY face file");
+		return false;
+	}
+	std::vector<uint8_t> buf(4 * 1024 * 1024);
+	for (;;)
+	{
+		const size_t n = fread(buf.data(), 1, buf.size(), m_faceFile.get());
+		if (n == 0) break;
+		if (fwrite(buf.data(), 1, n, m_file.get()) != n)
+		{
+			m_log.Error("Failed to write PLY face data");
+			return false;
+		}
+	}
+
+	// patch element counts
+	FILE* file = m_file.get();
+	if (_fseeki64(file, m_vertCntPos, SEEK_SET) != 0 || fprintf(file, CountFormat, m_vertCnt) < 0
+		|| _fseeki64(file, m_triCntPos, SEEK_SET) != 0 || fprintf(file, CountFormat, m_triCnt) < 0)
+	{
+		m_log.Error("Failed to update PLY element counts");
+		return false;
+	}
+
+	m_file.reset();
+	m_faceFile.reset();
+	std::error_code ec;
+	std::filesystem::remove(m_faceFilePath, ec);
+	return true;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "ChunkSink.h"
+
+#include <glm/glm.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+namespace sgrottel
+{
+	class ISimpleLog;
+}
+
+namespace meshproc
+{
+	namespace stream
+	{
+
+		// Writes an indexed binary PLY file.
+		// Vertices are welded within a bounded window of the most recently written vertices.
+		// Faces are spooled to a temporary file and appended on `Finish`, when the element counts are known.
+		class PlyChunkSink : public ChunkSink
+		{
+		public:
+			PlyChunkSink(const sgrottel::ISimpleLog& log, uint32_t weldWindow, const Attributes& attributes);
+			~PlyChunkSink();
+
+			bool Open(const std::wstring& path);
+
+			bool Write(const TriangleChunk& chunk) override;
+			bool Finish() override;
+
+			inline uint64_t VertexCount() const override
+			{
+				return m_vertCnt;
+			}
+			inline uint64_t TriangleCount() const override
+			{
+				return m_triCnt;
+			}
+
+		private:
+			uint32_t WeldVertex(const glm::vec3& v);
+
+			const sgrottel::ISimpleLog& m_log;
+			const uint32_t m_weldWindow;
+			const Attributes m_attributes;
+
+			FilePtr m_file;
+			FilePtr m_faceFile;
+			std::wstring m_faceFilePath;
+			int64_t m_vertCntPos{ 0 };
+			int64_t m_triCntPos{ 0 };
+			uint32_t m_vertCnt{ 0 };
+			uint32_t m_triCnt{ 0 };
+
+			std::unordered_map<glm::vec3, uint32_t> m_window;
+			std::deque<glm::vec3> m_windowOrder;
+
+			std::vector<glm::vec3> m_vertBuf;
+			std::vector<uint8_t> m_faceBuf;
+		};
+
+	}
+}
@@ -0,0 +1,142 @@
+#include "PlyChunkSource.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+
+using namespace meshproc;
+using namespace meshproc::stream;
+
+PlyChunkSource::PlyChunkSource(const sgrottel::ISimpleLog& log, uint32_t maxCachedPages)
+	: m_log{ log }, m_maxCachedPages{ std::max<uint32_t>(maxCachedPages, 1) }, m_faceFile{ MakeFilePtr() }, m_vertexFile{ MakeFilePtr() }
+{
+}
+
+bool PlyChunkSource::Open(const std::wstring& path)
+{
+	FILE* file = nullptr;
+	errno_t r = _wfopen_s(&file, path.c_str(), L"rb");
+	if (r != 0 || file == nullptr)
+	{
+		m_log.Error(L"Failed to open \"%s\": %d", path.c_str(), static_cast<int>(r));
+		return false;
+	}
+	m_faceFile = MakeFilePtr(file);
+
+	if (!m_header.Read(file, m_log))
+	{
+		return false;
+	}
+	m_vertexDataPos = _ftelli64(file);
+
+	// second handle for random access into the vertex data
+	file = nullptr;
+	r = _wfopen_s(&file, path.c_str(), L"rb");
+	if (r != 0 || file == nullptr)
+	{
+		m_log.Error(L"Failed to open \"%s\": %d", path.c_str(), static_cast<int>(r));
+		return false;
+	}
+	m_vertexFile = MakeFilePtr(file);
+
+	const int64_t faceDataPos = m_vertexDataPos + static_cast<int64_t>(m_header.vertCnt) * m_header.vertSize;
+	if (_fseeki64(m_faceFile.get(), faceDataPos, SEEK_SET) != 0)
+	{
+		m_log.Error("Failed to seek to PLY face data");
+		return false;
+	}
+	m_facesRead = 0;
+
+	m_log.Message(L"Streaming PLY: %s (%d vertices, %d triangles)", path.c_str(), m_header.vertCnt, m_header.faceCnt);
+	return true;
+}
+
+bool PlyChunkSource::ReadChunk(TriangleChunk& chunk, size_t maxTriangles)
+{
+	chunk.Clear();
+	const size_t cnt = std::min<size_t>(maxTriangles, static_cast<size_t>(m_header.faceCnt - m_facesRead));
+	if (cnt == 0)
+	{
+		return true;
+	}
+
+	m_buf.resize(cnt * m_header.faceSize);
+	if (fread(m_buf.data(), m_header.faceSize, cnt, m_faceFile.get()) != cnt)
+	{
+		m_log.Error("Failed to read PLY face data");
+		return false;
+	}
+	m_facesRead += static_cast<int>(cnt);
+
+	chunk.triangles.resize(cnt);
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		uint32_t idx[3];
+		if (!m_header.ReadFace(m_buf.data() + i * m_header.faceSize, idx[0], idx[1], idx[2]))
+		{
+			m_log.Error("Failed to read face data, only triangle faces are currently supported");
+			return false;
+		}
+		for (int j = 0; j < 3; ++j)
+		{
+			const glm::vec3* v = GetVertex(idx[j]);
+			if (v == nullptr)
+			{
+				return false;
+			}
+			chunk.triangles[i][j] = *v;
+		}
+	}
+
+	return true;
+}
+
+const glm::vec3* PlyChunkSource::GetVertex(uint32_t idx)
+{
+	if (idx >= static_cast<uint32_t>(m_header.vertCnt))
+	{
+		m_log.Error("Face references invalid vertex index %u", idx);
+		return nullptr;
+	}
+
+	const uint32_t pageIdx = idx / PageSize;
+	const uint32_t inPageIdx = idx % PageSize;
+
+	auto it = m_pages.find(pageIdx);
+	if (it != m_pages.end())
+	{
+		m_lru.splice(m_lru.begin(), m_lru, it->second.lruPos);
+		return &it->second.vertices[inPageIdx];
+	}
+
+	Page page;
+	if (m_pages.size() >= m_maxCachedPages)
+	{
+		// evict least recently used page, reusing its memory
+		auto victim = m_pages.find(m_lru.back());
+		page.vertices = std::move(victim->second.vertices);
+		m_pages.erase(victim);
+		m_lru.pop_back();
+	}
+
+	const uint32_t first = pageIdx * PageSize;
+	const uint32_t cnt = std::min<uint32_t>(PageSize, static_cast<uint32_t>(m_header.vertCnt) - first);
+	m_pageBuf.resize(static_cast<size_t>(cnt) * m_header.vertSize);
+	if (_fseeki64(m_vertexFile.get(), m_vertexDataPos + static_cast<int64_t>(first) * m_header.vertSize, SEEK_SET) != 0
+		|| fread(m_pageBuf.data(), m_header.vertSize, cnt, m_vertexFile.get()) != cnt)
+	{
+		m_log.Error("Failed to read PLY vertex data");
+		return nullptr;
+	}
+	page.vertices.resize(cnt);
+	for (uint32_t i = 0; i < cnt; ++i)
+	{
+		page.vertices[i] = m_header.ReadVertex(m_pageBuf.data() + static_cast<size_t>(i) * m_header.vertSize);
+	}
+	m_pageLoads++;
+
+	m_lru.push_front(pageIdx);
+	page.lruPos = m_lru.begin();
+	auto inserted = m_pages.emplace(pageIdx, std::move(page)).first;
+	return &inserted->second.vertices[inPageIdx];
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "ChunkSource.h"
+
+#include "utilities/PlyHeader.h"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace sgrottel
+{
+	class ISimpleLog;
+}
+
+namespace meshproc
+{
+	namespace stream
+	{
+
+		// Reads the faces of a binary PLY file sequentially.
+		// Vertices are fetched on demand through a bounded LRU cache of fixed-size pages.
+		class PlyChunkSource : public ChunkSource
+		{
+		public:
+			static constexpr uint32_t PageSize = 16 * 1024;
+
+			PlyChunkSource(const sgrottel::ISimpleLog& log, uint32_t maxCachedPages);
+
+			bool Open(const std::wstring& path);
+
+			bool ReadChunk(TriangleChunk& chunk, size_t maxTriangles) override;
+
+			inline uint64_t TriangleCount() const override
+			{
+				return static_cast<uint64_t>(m_header.faceCnt);
+			}
+
+			inline uint64_t PageLoads() const
+			{
+				return m_pageLoads;
+			}
+
+		private:
+			struct Page
+			{
+				std::vector<glm::vec3> vertices;
+				std::list<uint32_t>::iterator lruPos;
+			};
+
+			const glm::vec3* GetVertex(uint32_t idx);
+
+			const sgrottel::ISimpleLog& m_log;
+			const uint32_t m_maxCachedPages;
+			utilities::PlyHeader m_header;
+			FilePtr m_faceFile;
+			FilePtr m_vertexFile;
+			int64_t m_vertexDataPos{ 0 };
+			int m_facesRead{ 0 };
+
+			std::unordered_map<uint32_t, Page> m_pages;
+			std::list<uint32_t> m_lru;
+			uint64_t m_pageLoads{ 0 };
+
+			std::vector<uint8_t> m_buf;
+			std::vector<uint8_t> m_pageBuf;
+		};
+
+	}
+}
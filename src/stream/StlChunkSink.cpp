@@ -0,0 +1,91 @@
+#include "StlChunkSink.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <cstring>
+#include <limits>
+
+using namespace meshproc;
+using namespace meshproc::stream;
+
+namespace
+{
+	// normal, 3 vertices, attribute
+	constexpr size_t StlTriSize = 12 + 36 + 2;
+}
+
+StlChunkSink::StlChunkSink(const sgrottel::ISimpleLog& log)
+	: m_log{ log }, m_file{ MakeFilePtr() }
+{
+}
+
+bool StlChunkSink::Open(const std::wstring& path)
+{
+	FILE* file = nullptr;
+	errno_t r = _wfopen_s(&file, path.c_str(), L"wb");
+	if (r != 0 || file == nullptr)
+	{
+		m_log.Error(L"Failed to open \"%s\": %d", path.c_str(), static_cast<int>(r));
+		return false;
+	}
+	m_file = MakeFilePtr(file);
+
+	// 80-byte header
+	constexpr const char header[] =
+		// 234567890123456789
+		"**MeshProc** streame"
+		"d stl file for fun a"
+		"nd profit..........."
+		"....................";
+	static_assert(sizeof(header) >= 80);
+	fwrite(header, 1, 80, file);
+
+	// placeholder for the triangle count
+	m_triCnt = 0;
+	fwrite(&m_triCnt, 4, 1, file);
+
+	m_log.Message(L"Streaming to STL: %s", path.c_str());
+	return true;
+}
+
+bool StlChunkSink::Write(const TriangleChunk& chunk)
+{
+	const size_t cnt = chunk.triangles.size();
+	if (static_cast<uint64_t>(m_triCnt) + cnt > std::numeric_limits<uint32_t>::max())
+	{
+		m_log.Error("Too many triangles for STL");
+		return false;
+	}
+
+	m_buf.resize(cnt * StlTriSize);
+	const glm::vec3 nullNormal{ 0.0f, 0.0f, 0.0f };
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		uint8_t* tar = m_buf.data() + i * StlTriSize;
+		const glm::vec3& n = chunk.normals.empty() ? nullNormal : chunk.normals[i];
+		std::memcpy(tar, &n, 12);
+		std::memcpy(tar + 12, chunk.triangles[i].data(), 36);
+		tar[48] = 0;
+		tar[49] = 0;
+	}
+
+	if (fwrite(m_buf.data(), StlTriSize, cnt, m_file.get()) != cnt)
+	{
+		m_log.Error("Failed to write STL triangle data");
+		return false;
+	}
+	m_triCnt += static_cast<uint32_t>(cnt);
+	return true;
+}
+
+bool StlChunkSink::Finish()
+{
+	if (_fseeki64(m_file.get(), 80, SEEK_SET) != 0
+		|| fwrite(&m_triCnt, 4, 1, m_file.get()) != 1)
+	{
+		m_log.Error("Failed to update STL triangle count");
+		return false;
+	}
+	m_file.reset();
+	return true;
+}
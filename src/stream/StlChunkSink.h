@@ -0,0 +1,45 @@
+#pragma once
+
+#include "ChunkSink.h"
+
+#include <string>
+
+namespace sgrottel
+{
+	class ISimpleLog;
+}
+
+namespace meshproc
+{
+	namespace stream
+	{
+
+		// Writes a binary STL file; the triangle count is patched into the header on `Finish`
+		class StlChunkSink : public ChunkSink
+		{
+		public:
+			StlChunkSink(const sgrottel::ISimpleLog& log);
+
+			bool Open(const std::wstring& path);
+
+			bool Write(const TriangleChunk& chunk) override;
+			bool Finish() override;
+
+			inline uint64_t VertexCount() const override
+			{
+				return static_cast<uint64_t>(m_triCnt) * 3;
+			}
+			inline uint64_t TriangleCount() const override
+			{
+				return m_triCnt;
+			}
+
+		private:
+			const sgrottel::ISimpleLog& m_log;
+			FilePtr m_file;
+			uint32_t m_triCnt{ 0 };
+			std::vector<uint8_t> m_buf;
+		};
+
+	}
+}
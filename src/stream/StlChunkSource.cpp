@@ -0,0 +1,71 @@
+#include "StlChunkSource.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace meshproc;
+using namespace meshproc::stream;
+
+namespace
+{
+	// normal, 3 vertices, attribute
+	constexpr size_t StlTriSize = 12 + 36 + 2;
+}
+
+StlChunkSource::StlChunkSource(const sgrottel::ISimpleLog& log)
+	: m_log{ log }, m_file{ MakeFilePtr() }
+{
+}
+
+bool StlChunkSource::Open(const std::wstring& path)
+{
+	FILE* file = nullptr;
+	errno_t r = _wfopen_s(&file, path.c_str(), L"rb");
+	if (r != 0 || file == nullptr)
+	{
+		m_log.Error(L"Failed to open \"%s\": %d", path.c_str(), static_cast<int>(r));
+		return false;
+	}
+	m_file = MakeFilePtr(file);
+
+	char header[80];
+	if (fread(header, 80, 1, file) != 1 || fread(&m_triCnt, 4, 1, file) != 1)
+	{
+		m_log.Error(L"Failed to read STL header");
+		return false;
+	}
+	m_triRead = 0;
+
+	m_log.Message(L"Streaming STL: %s (%u triangles)", path.c_str(), m_triCnt);
+	return true;
+}
+
+bool StlChunkSource::ReadChunk(TriangleChunk& chunk, size_t maxTriangles)
+{
+	chunk.Clear();
+	const size_t cnt = std::min<size_t>(maxTriangles, m_triCnt - m_triRead);
+	if (cnt == 0)
+	{
+		return true;
+	}
+
+	m_buf.resize(cnt * StlTriSize);
+	if (fread(m_buf.data(), StlTriSize, cnt, m_file.get()) != cnt)
+	{
+		m_log.Error("Failed to read STL triangle data");
+		return false;
+	}
+	m_triRead += static_cast<uint32_t>(cnt);
+
+	chunk.triangles.resize(cnt);
+	for (size_t i = 0; i < cnt; ++i)
+	{
+		// skip the stored normal, it is recomputed on demand
+		const uint8_t* src = m_buf.data() + i * StlTriSize + 12;
+		std::memcpy(chunk.triangles[i].data(), src, 36);
+	}
+
+	return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ChunkSource.h"
+
+#include <string>
+
+namespace sgrottel
+{
+	class ISimpleLog;
+}
+
+namespace meshproc
+{
+	namespace stream
+	{
+
+		// Reads a binary STL file sequentially
+		class StlChunkSource : public ChunkSource
+		{
+		public:
+			StlChunkSource(const sgrottel::ISimpleLog& log);
+
+			bool Open(const std::wstring& path);
+
+			bool ReadChunk(TriangleChunk& chunk, size_t maxTriangles) override;
+
+			inline uint64_t TriangleCount() const override
+			{
+				return m_triCnt;
+			}
+
+		private:
+			const sgrottel::ISimpleLog& m_log;
+			FilePtr m_file;
+			uint32_t m_triCnt{ 0 };
+			uint32_t m_triRead{ 0 };
+			std::vector<uint8_t> m_buf;
+		};
+
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace meshproc
+{
+	namespace stream
+	{
+
+		// Per-triangle attributes computed by the pipeline
+		struct Attributes
+		{
+			bool normal{ false };
+			bool area{ false };
+		};
+
+		// Block of independent triangles, the unit of work of the streaming pipeline
+		struct TriangleChunk
+		{
+			std::vector<std::array<glm::vec3, 3>> triangles;
+
+			// optional, one entry per triangle, or empty
+			std::vector<glm::vec3> normals;
+			std::vector<float> areas;
+
+			inline void Clear()
+			{
+				triangles.clear();
+				normals.clear();
+				areas.clear();
+			}
+		};
+
+		using FilePtr = std::unique_ptr<FILE, int(*)(FILE*)>;
+
+		inline FilePtr MakeFilePtr(FILE* file = nullptr)
+		{
+			return FilePtr{ file, &fclose };
+		}
+
+	}
+}
@@ -0,0 +1,399 @@
+#include "CompressedMeshCodec.h"
+
+#include "MortonCode.h"
+#include "RansCoder.h"
+#include "TaskScheduler.h"
+
+#include "data/Mesh.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+using namespace meshproc;
+using namespace meshproc::utilities;
+
+namespace
+{
+	constexpr char Magic[4] = { 'M', 'P', 'C', 'M' };
+	constexpr uint32_t Version = 1;
+
+	struct FileHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t bits;
+		float bboxMin[3];
+		float bboxMax[3];
+		uint32_t vertexCount;
+		uint32_t triangleCount;
+		uint32_t blockCount;
+	};
+	static_assert(sizeof(FileHeader) == 48);
+
+	struct BlockHeader
+	{
+		uint32_t triangleCount;
+		uint32_t vertexCount;
+		uint32_t payloadSize;
+	};
+	static_assert(sizeof(BlockHeader) == 12);
+
+	struct BlockInfo
+	{
+		BlockHeader header;
+		uint32_t firstTriangle;
+		uint32_t firstVertex;
+		const uint8_t* payload;
+	};
+
+	void RunParallel(size_t count, const std::function<void(size_t)>& func)
+	{
+		TaskScheduler::Instance().ParallelFor(0, count, 1, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					func(i);
+				}
+			});
+	}
+
+	template<typename T>
+	void Append(std::vector<uint8_t>& out, const T& v)
+	{
+		const size_t pos = out.size();
+		out.resize(pos + sizeof(T));
+		std::memcpy(out.data() + pos, &v, sizeof(T));
+	}
+
+	void AppendStream(std::vector<uint8_t>& out, const std::vector<uint8_t>& raw)
+	{
+		WriteVarUInt(out, raw.size());
+		RansCoder::Encode(raw.data(), raw.size(), out);
+	}
+
+	bool ReadStream(const uint8_t*& in, const uint8_t* end, std::vector<uint8_t>& raw)
+	{
+		uint64_t size;
+		// guards against absurd sizes from corrupt data
+		if (!ReadVarUInt(in, end, size) || size > (uint64_t{ 1 } << 32)) return false;
+		raw.resize(static_cast<size_t>(size));
+		return RansCoder::Decode(in, end, raw.data(), raw.size());
+	}
+
+}
+
+bool CompressedMeshCodec::Encode(
+	const std::vector<glm::vec3>& vertices,
+	const std::vector<data::Triangle>& triangles,
+	uint32_t bits,
+	uint32_t blockSize,
+	std::vector<uint8_t>& out,
+	const sgrottel::ISimpleLog& log)
+{
+	if (bits < MinBits || bits > MaxBits)
+	{
+		log.Error("Quantization bits must be in [%u..%u]", MinBits, MaxBits);
+		return false;
+	}
+	if (blockSize == 0)
+	{
+		log.Error("Block size must not be zero");
+		return false;
+	}
+	for (const data::Triangle& t : triangles)
+	{
+		if (t[0] >= vertices.size() || t[1] >= vertices.size() || t[2] >= vertices.size())
+		{
+			log.Error("Triangle references invalid vertex index");
+			return false;
+		}
+	}
+
+	// quantization grid
+	glm::vec3 bbMin{ 0.0f }, bbMax{ 0.0f };
+	if (!vertices.empty())
+	{
+		bbMin = bbMax = vertices.front();
+		for (const glm::vec3& v : vertices)
+		{
+			bbMin = glm::min(bbMin, v);
+			bbMax = glm::max(bbMax, v);
+		}
+	}
+	const uint32_t maxQ = (1u << bits) - 1;
+	const glm::vec3 extent = bbMax - bbMin;
+	glm::vec3 qScale;
+	for (int i = 0; i < 3; ++i)
+	{
+		qScale[i] = (extent[i] > 0.0f) ? (static_cast<float>(maxQ) / extent[i]) : 0.0f;
+	}
+	auto quantize = [&](const glm::vec3& v)
+		{
+			const glm::vec3 q = glm::clamp((v - bbMin) * qScale + 0.5f, 0.0f, static_cast<float>(maxQ));
+			return glm::uvec3(q);
+		};
+
+	// triangle order for locality
+	std::vector<std::pair<uint64_t, uint32_t>> order(triangles.size());
+	{
+		const MortonGrid grid{ bbMin, bbMax };
+		for (size_t i = 0; i < triangles.size(); ++i)
+		{
+			const data::Triangle& t = triangles[i];
+			const glm::vec3 centroid = (vertices[t[0]] + vertices[t[1]] + vertices[t[2]]) / 3.0f;
+			order[i] = { grid.Code(centroid), static_cast<uint32_t>(i) };
+		}
+		std::sort(order.begin(), order.end());
+	}
+
+	// first-use vertex numbering and block partitioning
+	constexpr uint32_t unassigned = std::numeric_limits<uint32_t>::max();
+	std::vector<uint32_t> newIndex(vertices.size(), unassigned);
+	std::vector<uint32_t> firstUse; // new index -> old index
+	firstUse.reserve(vertices.size());
+	std::vector<BlockInfo> blocks;
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		if (i % blockSize == 0)
+		{
+			BlockInfo b{};
+			b.firstTriangle = static_cast<uint32_t>(i);
+			b.firstVertex = static_cast<uint32_t>(firstUse.size());
+			blocks.push_back(b);
+		}
+		const data::Triangle& t = triangles[order[i].second];
+		for (int c = 0; c < 3; ++c)
+		{
+			if (newIndex[t[c]] == unassigned)
+			{
+				newIndex[t[c]] = static_cast<uint32_t>(firstUse.size());
+				firstUse.push_back(t[c]);
+			}
+		}
+	}
+	for (size_t b = 0; b < blocks.size(); ++b)
+	{
+		const bool last = (b + 1 == blocks.size());
+		blocks[b].header.triangleCount = (last ? static_cast<uint32_t>(order.size()) : blocks[b + 1].firstTriangle) - blocks[b].firstTriangle;
+		blocks[b].header.vertexCount = (last ? static_cast<uint32_t>(firstUse.size()) : blocks[b + 1].firstVertex) - blocks[b].firstVertex;
+	}
+
+	// encode blocks independently
+	std::vector<std::vector<uint8_t>> payloads(blocks.size());
+	RunParallel(blocks.size(), [&](size_t b)
+		{
+			const BlockInfo& block = blocks[b];
+			std::vector<uint8_t> idxStream;
+			std::vector<uint8_t> posStream;
+			idxStream.reserve(block.header.triangleCount * 3 * 2);
+			posStream.reserve(block.header.vertexCount * 3 * 2);
+
+			uint32_t nextNew = block.firstVertex;
+			glm::ivec3 prev{ 0, 0, 0 };
+			for (uint32_t i = 0; i < block.header.triangleCount; ++i)
+			{
+				const data::Triangle& t = triangles[order[block.firstTriangle + i].second];
+				for (int c = 0; c < 3; ++c)
+				{
+					const uint32_t idx = newIndex[t[c]];
+					// 0 marks the next new vertex, otherwise the distance back to a known one
+					WriteVarUInt(idxStream, nextNew - idx);
+					if (idx == nextNew)
+					{
+						nextNew++;
+						const glm::ivec3 q = glm::ivec3(quantize(vertices[t[c]]));
+						for (int k = 0; k < 3; ++k)
+						{
+							WriteVarUInt(posStream, ZigZagEncode(static_cast<int64_t>(q[k]) - prev[k]));
+						}
+						prev = q;
+					}
+				}
+			}
+
+			AppendStream(payloads[b], idxStream);
+			AppendStream(payloads[b], posStream);
+		});
+
+	// assemble file
+	FileHeader header{};
+	std::memcpy(header.magic, Magic, 4);
+	header.version = Version;
+	header.bits = bits;
+	for (int i = 0; i < 3; ++i)
+	{
+		header.bboxMin[i] = bbMin[i];
+		header.bboxMax[i] = bbMax[i];
+	}
+	header.vertexCount = static_cast<uint32_t>(firstUse.size());
+	header.triangleCount = static_cast<uint32_t>(triangles.size());
+	header.blockCount = static_cast<uint32_t>(blocks.size());
+
+	out.clear();
+	Append(out, header);
+	for (size_t b = 0; b < blocks.size(); ++b)
+	{
+		blocks[b].header.payloadSize = static_cast<uint32_t>(payloads[b].size());
+		Append(out, blocks[b].header);
+	}
+	for (const auto& p : payloads)
+	{
+		out.insert(out.end(), p.begin(), p.end());
+	}
+
+	if (firstUse.size() != vertices.size())
+	{
+		log.Warning("%d unreferenced vertices are not stored", static_cast<int>(vertices.size() - firstUse.size()));
+	}
+
+	return true;
+}
+
+bool CompressedMeshCodec::Decode(const uint8_t* data, size_t size, data::Mesh& outMesh, const sgrottel::ISimpleLog& log)
+{
+	FileHeader header;
+	if (size < sizeof(FileHeader))
+	{
+		log.Error("Compressed mesh data truncated");
+		return false;
+	}
+	std::memcpy(&header, data, sizeof(FileHeader));
+	if (std::memcmp(header.magic, Magic, 4) != 0)
+	{
+		log.Error("Not a compressed mesh file");
+		return false;
+	}
+	if (header.version != Version)
+	{
+		log.Error("Unsupported compressed mesh version %u", header.version);
+		return false;
+	}
+	if (header.bits < MinBits || header.bits > MaxBits)
+	{
+		log.Error("Invalid quantization bits %u", header.bits);
+		return false;
+	}
+
+	const uint8_t* end = data + size;
+	const uint8_t* ptr = data + sizeof(FileHeader);
+	if (static_cast<uint64_t>(end - ptr) < static_cast<uint64_t>(header.blockCount) * sizeof(BlockHeader))
+	{
+		log.Error("Compressed mesh block table truncated");
+		return false;
+	}
+
+	std::vector<BlockInfo> blocks(header.blockCount);
+	const uint8_t* payload = ptr + header.blockCount * sizeof(BlockHeader);
+	uint64_t firstTriangle = 0;
+	uint64_t firstVertex = 0;
+	for (BlockInfo& b : blocks)
+	{
+		std::memcpy(&b.header, ptr, sizeof(BlockHeader));
+		ptr += sizeof(BlockHeader);
+		b.firstTriangle = static_cast<uint32_t>(firstTriangle);
+		b.firstVertex = static_cast<uint32_t>(firstVertex);
+		b.payload = payload;
+		firstTriangle += b.header.triangleCount;
+		firstVertex += b.header.vertexCount;
+		if (b.header.payloadSize > static_cast<uint64_t>(end - payload))
+		{
+			log.Error("Compressed mesh block data truncated");
+			return false;
+		}
+		payload += b.header.payloadSize;
+	}
+	if (firstTriangle != header.triangleCount || firstVertex != header.vertexCount)
+	{
+		log.Error("Compressed mesh block table inconsistent");
+		return false;
+	}
+
+	glm::vec3 bbMin, step;
+	for (int i = 0; i < 3; ++i)
+	{
+		bbMin[i] = header.bboxMin[i];
+		step[i] = (header.bboxMax[i] - header.bboxMin[i]) / static_cast<float>((1u << header.bits) - 1);
+	}
+
+	outMesh.vertices.resize(header.vertexCount);
+	outMesh.triangles.resize(header.triangleCount);
+
+	std::atomic<bool> failed{ false };
+	RunParallel(blocks.size(), [&](size_t bi)
+		{
+			const BlockInfo& block = blocks[bi];
+			const uint8_t* in = block.payload;
+			const uint8_t* blockEnd = block.payload + block.header.payloadSize;
+			std::vector<uint8_t> idxStream;
+			std::vector<uint8_t> posStream;
+			if (!ReadStream(in, blockEnd, idxStream) || !ReadStream(in, blockEnd, posStream))
+			{
+				failed = true;
+				return;
+			}
+
+			const uint8_t* idxIn = idxStream.data();
+			const uint8_t* idxEnd = idxIn + idxStream.size();
+			const uint8_t* posIn = posStream.data();
+			const uint8_t* posEnd = posIn + posStream.size();
+			const uint32_t vertexEnd = block.firstVertex + block.header.vertexCount;
+			uint32_t nextNew = block.firstVertex;
+			glm::ivec3 prev{ 0, 0, 0 };
+			for (uint32_t i = 0; i < block.header.triangleCount; ++i)
+			{
+				data::Triangle& t = outMesh.triangles[block.firstTriangle + i];
+				for (int c = 0; c < 3; ++c)
+				{
+					uint64_t code;
+					if (!ReadVarUInt(idxIn, idxEnd, code) || code > nextNew)
+					{
+						failed = true;
+						return;
+					}
+					const uint32_t idx = nextNew - static_cast<uint32_t>(code);
+					if (code == 0)
+					{
+						if (nextNew >= vertexEnd)
+						{
+							failed = true;
+							return;
+						}
+						glm::ivec3 q;
+						for (int k = 0; k < 3; ++k)
+						{
+							uint64_t zz;
+							if (!ReadVarUInt(posIn, posEnd, zz))
+							{
+								failed = true;
+								return;
+							}
+							q[k] = static_cast<int>(prev[k] + ZigZagDecode(zz));
+						}
+						prev = q;
+						outMesh.vertices[nextNew] = bbMin + glm::vec3(q) * step;
+						nextNew++;
+					}
+					t[c] = idx;
+				}
+			}
+			if (nextNew != vertexEnd)
+			{
+				failed = true;
+			}
+		});
+
+	if (failed)
+	{
+		log.Error("Compressed mesh data corrupt");
+		outMesh.vertices.clear();
+		outMesh.triangles.clear();
+		return false;
+	}
+
+	return true;
+}
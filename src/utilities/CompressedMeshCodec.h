@@ -0,0 +1,49 @@
+#pragma once
+
+#include "data/Triangle.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace sgrottel
+{
+	class ISimpleLog;
+}
+
+namespace meshproc
+{
+	namespace data
+	{
+		class Mesh;
+	}
+
+	namespace utilities
+	{
+
+		// Compressed mesh file format:
+		// - positions quantized to `bits` per axis relative to the bounding box
+		// - triangles ordered along a Morton curve, vertices renumbered in first-use order
+		// - blocks of triangles, each independently decodable, with delta/zigzag varint coded
+		//   indices and positions, entropy coded with a static rANS coder
+		// Vertices not referenced by any triangle are not stored.
+		class CompressedMeshCodec
+		{
+		public:
+			static constexpr uint32_t MinBits = 1;
+			static constexpr uint32_t MaxBits = 24;
+
+			static bool Encode(
+				const std::vector<glm::vec3>& vertices,
+				const std::vector<data::Triangle>& triangles,
+				uint32_t bits,
+				uint32_t blockSize,
+				std::vector<uint8_t>& out,
+				const sgrottel::ISimpleLog& log);
+
+			static bool Decode(const uint8_t* data, size_t size, data::Mesh& outMesh, const sgrottel::ISimpleLog& log);
+		};
+
+	}
+}
@@ -1,5 +1,7 @@
 #include "Constrained2DTriangulation.h"
 
+#include "utilities/TaskScheduler.h"
+
 #include <SimpleLog/SimpleLog.hpp>
 
 #pragma warning(push)
@@ -7,12 +9,146 @@
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Constrained_Delaunay_triangulation_2.h>
 #include <CGAL/Triangulation_vertex_base_with_info_2.h>
+#include <CGAL/Triangulation_face_base_with_info_2.h>
 #include <CGAL/Constrained_triangulation_face_base_2.h>
 #include <CGAL/Triangulation_data_structure_2.h>
 #pragma warning(pop)
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+
 using namespace meshproc;
 
+namespace
+{
+	typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
+	typedef K::Point_2 Point;
+
+	struct FaceInfo
+	{
+		int depth{ -1 };
+	};
+
+	// vertex info is the index into the inserted points
+	typedef CGAL::Triangulation_vertex_base_with_info_2<uint32_t, K> Vb;
+	typedef CGAL::Triangulation_face_base_with_info_2<FaceInfo, K> Fbi;
+	typedef CGAL::Constrained_triangulation_face_base_2<K, Fbi> Fb;
+	typedef CGAL::Triangulation_data_structure_2<Vb, Fb> TDS;
+	typedef CGAL::Constrained_Delaunay_triangulation_2<K, TDS> CDT;
+
+	// Constraint loops triangulated together
+	struct Group
+	{
+		std::vector<std::pair<Point, uint32_t>> points;
+		// original index per point
+		std::vector<uint32_t> ids;
+		std::vector<std::pair<uint32_t, uint32_t>> edges;
+	};
+
+	uint32_t FindRoot(std::vector<uint32_t>& parent, uint32_t i)
+	{
+		while (parent[i] != i)
+		{
+			parent[i] = parent[parent[i]];
+			i = parent[i];
+		}
+		return i;
+	}
+
+	// Sets the nesting depth of all faces by flood fills across unconstrained edges, starting at the infinite face
+	void MarkDomains(CDT& cdt)
+	{
+		for (auto f = cdt.all_faces_begin(); f != cdt.all_faces_end(); ++f)
+		{
+			f->info().depth = -1;
+		}
+
+		std::vector<CDT::Face_handle> border{ cdt.infinite_face() };
+		std::vector<CDT::Face_handle> nextBorder;
+		std::vector<CDT::Face_handle> stack;
+		for (int depth = 0; !border.empty(); ++depth)
+		{
+			nextBorder.clear();
+			for (CDT::Face_handle start : border)
+			{
+				if (start->info().depth != -1) continue;
+				start->info().depth = depth;
+				stack.push_back(start);
+				while (!stack.empty())
+				{
+					const CDT::Face_handle f = stack.back();
+					stack.pop_back();
+					for (int i = 0; i < 3; ++i)
+					{
+						const CDT::Face_handle n = f->neighbor(i);
+						if (n->info().depth != -1) continue;
+						if (cdt.is_constrained(CDT::Edge(f, i)))
+						{
+							nextBorder.push_back(n);
+						}
+						else
+						{
+							n->info().depth = depth;
+							stack.push_back(n);
+						}
+					}
+				}
+			}
+			std::swap(border, nextBorder);
+		}
+	}
+
+	bool Triangulate(const Group& group, utilities::Constrained2DTriangulation::Region region, std::vector<glm::uvec3>& outTriangles)
+	{
+		typedef utilities::Constrained2DTriangulation::Region Region;
+
+		// all points at once, spatially sorted
+		CDT cdt;
+		cdt.insert(group.points.begin(), group.points.end());
+
+		std::vector<CDT::Vertex_handle> handles(group.points.size());
+		for (auto v = cdt.finite_vertices_begin(); v != cdt.finite_vertices_end(); ++v)
+		{
+			handles[v->info()] = v;
+		}
+		for (size_t i = 0; i < handles.size(); ++i)
+		{
+			if (handles[i] == CDT::Vertex_handle())
+			{
+				// duplicate position, resolves to the existing vertex
+				handles[i] = cdt.insert(group.points[i].first);
+			}
+		}
+
+		for (const auto& [a, b] : group.edges)
+		{
+			if (handles[a] != handles[b])
+			{
+				cdt.insert_constraint(handles[a], handles[b]);
+			}
+		}
+		if (!cdt.is_valid())
+		{
+			return false;
+		}
+
+		if (region != Region::All)
+		{
+			MarkDomains(cdt);
+		}
+		for (auto f = cdt.finite_faces_begin(); f != cdt.finite_faces_end(); ++f)
+		{
+			const int depth = f->info().depth;
+			if ((region == Region::Enclosed && depth <= 0) || (region == Region::Inside && depth % 2 != 1)) continue;
+			outTriangles.push_back(glm::uvec3{ group.ids[f->vertex(0)->info()], group.ids[f->vertex(1)->info()], group.ids[f->vertex(2)->info()] });
+		}
+		return true;
+	}
+
+}
+
 utilities::Constrained2DTriangulation::Constrained2DTriangulation(
 	const std::unordered_map<uint32_t, glm::vec2>& points,
 	const std::unordered_set<data::HashableEdge>& edges,
@@ -24,48 +160,133 @@ utilities::Constrained2DTriangulation::Constrained2DTriangulation(
 {
 }
 
-std::vector<glm::uvec3> utilities::Constrained2DTriangulation::Compute() const
+std::vector<glm::uvec3> utilities::Constrained2DTriangulation::Compute(Region region) const
 {
 	std::vector<glm::uvec3> result;
 
 	m_hasError = true; // assume early exit
 
-	// use CGAL implementation:
-	typedef CGAL::Single_precision_epick K;
-	typedef K::Point_2 Point;
-	typedef uint32_t VertexInfo;
-	typedef CGAL::Triangulation_vertex_base_with_info_2<VertexInfo, K> Vb;
-	typedef CGAL::Constrained_triangulation_face_base_2<K> Fb;
-	typedef CGAL::Triangulation_data_structure_2<Vb, Fb> TDS;
-	typedef CGAL::Constrained_Delaunay_triangulation_2<K, TDS> CDT;
-
-	CDT cdt;
+	// vertices of the constraint edges, ascending by original index
+	std::vector<uint32_t> ids;
+	ids.reserve(m_edges.size() * 2);
+	for (const data::HashableEdge& e : m_edges)
+	{
+		ids.push_back(e.i0);
+		ids.push_back(e.i1);
+	}
+	std::sort(ids.begin(), ids.end());
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+	const uint32_t n = static_cast<uint32_t>(ids.size());
+	auto local = [&ids](uint32_t id)
+		{
+			return static_cast<uint32_t>(std::lower_bound(ids.begin(), ids.end(), id) - ids.begin());
+		};
+	std::vector<std::pair<uint32_t, uint32_t>> edges;
+	edges.reserve(m_edges.size());
+	for (const data::HashableEdge& e : m_edges)
+	{
+		edges.push_back(std::make_pair(local(e.i0), local(e.i1)));
+	}
+	std::vector<glm::vec2> pos(n);
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		pos[i] = m_points.at(ids[i]);
+	}
 
-	for (auto const& edge : m_edges)
+	// connected loops, merged while their bounding boxes overlap; the hull of `Region::All` needs all of them together
+	std::vector<uint32_t> parent(n);
+	std::iota(parent.begin(), parent.end(), 0);
+	if (region != Region::All)
+	{
+		for (const auto& [a, b] : edges)
+		{
+			parent[FindRoot(parent, a)] = FindRoot(parent, b);
+		}
+		std::vector<glm::vec4> box(n, glm::vec4{ std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() });
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			glm::vec4& b = box[FindRoot(parent, i)];
+			b = glm::vec4{ std::min(b.x, pos[i].x), std::min(b.y, pos[i].y), std::max(b.z, pos[i].x), std::max(b.w, pos[i].y) };
+		}
+		std::vector<uint32_t> loops;
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			if (parent[i] == i) loops.push_back(i);
+		}
+		std::sort(loops.begin(), loops.end(), [&box](uint32_t a, uint32_t b) { return box[a].x < box[b].x; });
+		std::vector<uint32_t> active;
+		for (uint32_t l : loops)
+		{
+			std::erase_if(active, [&](uint32_t a) { return box[a].z < box[l].x; });
+			for (uint32_t a : active)
+			{
+				if (box[a].y <= box[l].w && box[l].y <= box[a].w)
+				{
+					parent[FindRoot(parent, a)] = FindRoot(parent, l);
+				}
+			}
+			active.push_back(l);
+		}
+	}
+	else
 	{
-		auto const& v0 = m_points.at(edge.i0);
-		auto const& v1 = m_points.at(edge.i1);
+		std::fill(parent.begin(), parent.end(), 0);
+	}
 
-		auto vh0 = cdt.insert(Point(v0.x, v0.y));
-		vh0->info() = edge.i0;
-		auto vh1 = cdt.insert(Point(v1.x, v1.y));
-		vh1->info() = edge.i1;
+	std::vector<Group> groups;
+	std::vector<uint32_t> groupOf(n, std::numeric_limits<uint32_t>::max());
+	std::vector<uint32_t> indexInGroup(n);
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		const uint32_t root = FindRoot(parent, i);
+		if (groupOf[root] == std::numeric_limits<uint32_t>::max())
+		{
+			groupOf[root] = static_cast<uint32_t>(groups.size());
+			groups.emplace_back();
+		}
+		Group& g = groups[groupOf[root]];
+		indexInGroup[i] = static_cast<uint32_t>(g.points.size());
+		g.points.push_back(std::make_pair(Point(pos[i].x, pos[i].y), indexInGroup[i]));
+		g.ids.push_back(ids[i]);
+	}
+	for (const auto& [a, b] : edges)
+	{
+		groups[groupOf[FindRoot(parent, a)]].edges.push_back(std::make_pair(indexInGroup[a], indexInGroup[b]));
+	}
 
-		cdt.insert_constraint(vh0, vh1);
+	std::vector<std::vector<glm::uvec3>> triangles(groups.size());
+	std::vector<uint8_t> valid(groups.size(), 0);
+	auto run = [&](size_t begin, size_t end)
+		{
+			for (size_t g = begin; g < end; ++g)
+			{
+				valid[g] = Triangulate(groups[g], region, triangles[g]) ? 1 : 0;
+			}
+		};
+	if (groups.size() > 1)
+	{
+		TaskScheduler::Instance().ParallelFor(0, groups.size(), 1, run);
 	}
-	if (!cdt.is_valid())
+	else
+	{
+		run(0, groups.size());
+	}
+
+	if (std::find(valid.begin(), valid.end(), 0) != valid.end())
 	{
 		m_log.Error("Constrained Delaunay triangulation of open edge loops failed");
-		result.clear();
 		return result;
 	}
 
-	for (auto fit = cdt.finite_faces_begin(); fit != cdt.finite_faces_end(); ++fit) {
-		const uint32_t i0 = fit->vertex(0)->info();
-		const uint32_t i1 = fit->vertex(1)->info();
-		const uint32_t i2 = fit->vertex(2)->info();
-
-		result.push_back(glm::uvec3{ i0, i1, i2 });
+	size_t cnt = 0;
+	for (const auto& t : triangles)
+	{
+		cnt += t.size();
+	}
+	result.reserve(cnt);
+	for (const auto& t : triangles)
+	{
+		result.insert(result.end(), t.begin(), t.end());
 	}
 
 	m_hasError = false;
@@ -25,6 +25,17 @@ namespace meshproc
 		class Constrained2DTriangulation
 		{
 		public:
+			// Faces to return, by their nesting depth, i.e. the number of constraint edges crossed on the way from outside
+			enum class Region
+			{
+				// the whole convex hull
+				All,
+				// nesting depth above zero, i.e. enclosed by the constraint loops, like a polygon subdivided by inner edges
+				Enclosed,
+				// odd nesting depth, like a cap bounded by outer loops with holes
+				Inside
+			};
+
 			// @param points -- maps from original index (of 3d point) to a 2d point
 			// @param edges -- edges with indices into `points` (not original indices)
 			Constrained2DTriangulation(
@@ -33,8 +44,10 @@ namespace meshproc
 				const sgrottel::ISimpleLog& log
 				);
 
-			// triangle winding rules NOT enforced
-			std::vector<glm::uvec3> Compute() const;
+			// Triangles are counter-clockwise in the 2d points.
+			// Except for `Region::All`, groups of constraint loops with disjoint bounding boxes are triangulated independently in parallel.
+			// Throws if constraint edges cross each other.
+			std::vector<glm::uvec3> Compute(Region region = Region::All) const;
 
 			inline bool HasError() const
 			{
@@ -0,0 +1,26 @@
+#include "ListOps.h"
+
+#include "utilities/SpatialSort.h"
+
+#include <algorithm>
+#include <bit>
+
+using namespace meshproc;
+using namespace meshproc::utilities;
+
+std::vector<uint32_t> ListOps::ArgSort(const std::vector<float>& values)
+{
+	// order preserving integer keys of the float bit patterns; sorted by the stable parallel radix sort
+	std::vector<uint64_t> keys;
+	Map(values, keys, [](float v)
+		{
+			const uint32_t bits = std::bit_cast<uint32_t>(v);
+			return static_cast<uint64_t>((bits & 0x80000000u) ? ~bits : (bits | 0x80000000u));
+		});
+	return SpatialSort::SortedOrder(keys);
+}
+
+size_t ListOps::UpperBound(const std::vector<float>& keys, float v)
+{
+	return static_cast<size_t>(std::upper_bound(keys.begin(), keys.end(), v) - keys.begin());
+}
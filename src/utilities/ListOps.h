@@ -0,0 +1,147 @@
+#pragma once
+
+#include "utilities/TaskScheduler.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace meshproc
+{
+	namespace utilities
+	{
+
+		// Bulk operations on attribute lists.
+		// The element loops are kept branch free and contiguous, so they are vectorized by the compiler,
+		// and large lists are split into chunks processed in parallel.
+		class ListOps
+		{
+		public:
+			static constexpr size_t GrainSize = 0x10000;
+
+			// a[i] = op(a[i])
+			template<typename T, typename OP>
+			static void Transform(std::vector<T>& a, const OP& op)
+			{
+				T* data = a.data();
+				TaskScheduler::Instance().ParallelFor(0, a.size(), GrainSize, [&](size_t begin, size_t end)
+					{
+						for (size_t i = begin; i < end; ++i)
+						{
+							data[i] = op(data[i]);
+						}
+					});
+			}
+
+			// a[i] = op(a[i], b[i]); `b` must have at least as many elements as `a`
+			template<typename T, typename U, typename OP>
+			static void Transform(std::vector<T>& a, const std::vector<U>& b, const OP& op)
+			{
+				T* data = a.data();
+				const U* other = b.data();
+				TaskScheduler::Instance().ParallelFor(0, a.size(), GrainSize, [&](size_t begin, size_t end)
+					{
+						for (size_t i = begin; i < end; ++i)
+						{
+							data[i] = op(data[i], other[i]);
+						}
+					});
+			}
+
+			// out[i] = op(a[i])
+			template<typename T, typename R, typename OP>
+			static void Map(const std::vector<T>& a, std::vector<R>& out, const OP& op)
+			{
+				out.resize(a.size());
+				const T* data = a.data();
+				R* target = out.data();
+				TaskScheduler::Instance().ParallelFor(0, a.size(), GrainSize, [&](size_t begin, size_t end)
+					{
+						for (size_t i = begin; i < end; ++i)
+						{
+							target[i] = op(data[i]);
+						}
+					});
+			}
+
+			// reduces all elements with `op`, starting from `identity`
+			// The result does not depend on the number of threads.
+			template<typename ACC, typename T, typename OP>
+			static ACC Reduce(const std::vector<T>& a, const ACC& identity, const OP& op)
+			{
+				const T* data = a.data();
+				return TaskScheduler::Instance().ParallelReduce(0, a.size(), GrainSize, identity,
+					[&](size_t begin, size_t end)
+					{
+						ACC acc = identity;
+						for (size_t i = begin; i < end; ++i)
+						{
+							acc = op(acc, ACC(data[i]));
+						}
+						return acc;
+					},
+					op);
+			}
+
+			// out[i] = src[indices[i]]
+			// @return false if any index is out of range
+			template<typename T>
+			static bool Gather(const std::vector<T>& src, const std::vector<uint32_t>& indices, std::vector<T>& out)
+			{
+				for (uint32_t i : indices)
+				{
+					if (i >= src.size()) return false;
+				}
+				out.resize(indices.size());
+				for (size_t i = 0; i < indices.size(); ++i)
+				{
+					out[i] = src[indices[i]];
+				}
+				return true;
+			}
+
+			// dst[indices[i]] = values[i], or `values[0]` for all indices if `values` holds only one element
+			// @return false if any index is out of range
+			template<typename T>
+			static bool Scatter(std::vector<T>& dst, const std::vector<uint32_t>& indices, const std::vector<T>& values)
+			{
+				for (uint32_t i : indices)
+				{
+					if (i >= dst.size()) return false;
+				}
+				const size_t step = (values.size() == 1) ? 0 : 1;
+				for (size_t i = 0; i < indices.size(); ++i)
+				{
+					dst[indices[i]] = values[i * step];
+				}
+				return true;
+			}
+
+			// Stable ascending order of `values`
+			// @return the old index for each new position
+			static std::vector<uint32_t> ArgSort(const std::vector<float>& values);
+
+			// Piecewise linear mapping of `values` by the gradient of `stops` placed at the ascending `keys`.
+			// Values outside of the keys' range are clamped to the first or last stop.
+			template<typename T>
+			static void MapGradient(const std::vector<float>& values, const std::vector<float>& keys, const std::vector<T>& stops, std::vector<T>& out)
+			{
+				Map(values, out, [&](float v)
+					{
+						const size_t upper = UpperBound(keys, v);
+						if (upper == 0) return stops.front();
+						if (upper == keys.size()) return stops.back();
+						const float k0 = keys[upper - 1];
+						const float k1 = keys[upper];
+						const float t = (k1 > k0) ? ((v - k0) / (k1 - k0)) : 0.0f;
+						return stops[upper - 1] + (stops[upper] - stops[upper - 1]) * t;
+					});
+			}
+
+		private:
+			static size_t UpperBound(const std::vector<float>& keys, float v);
+		};
+
+	}
+}
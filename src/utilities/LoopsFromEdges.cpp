@@ -0,0 +1,201 @@
+#include "LoopsFromEdges.h"
+
+#include "utilities/TaskScheduler.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <utility>
+
+using namespace meshproc;
+
+namespace
+{
+	constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+	// components per task, as most components are single small loops
+	constexpr size_t ComponentGrainSize = 16;
+
+	uint32_t FindRoot(std::vector<uint32_t>& parent, uint32_t i)
+	{
+		while (parent[i] != i)
+		{
+			parent[i] = parent[parent[i]];
+			i = parent[i];
+		}
+		return i;
+	}
+
+}
+
+void utilities::LoopsFromEdges(
+	std::vector<data::HashableEdge> edges,
+	commands::ParamTypeInfo_t<commands::ParamType::IndexListList>& outLoops,
+	sgrottel::ISimpleLog const& log)
+{
+	if (outLoops)
+	{
+		outLoops->clear();
+	}
+	else
+	{
+		outLoops = std::make_shared<std::vector<commands::ParamTypeInfo_t<commands::ParamType::IndexList>>>();
+	}
+
+	// both directions of all edges as `from << 32 | to`, sorted, without duplicates and self loops
+	std::vector<uint64_t> halfEdges;
+	halfEdges.reserve(edges.size() * 2);
+	for (const data::HashableEdge& e : edges)
+	{
+		if (e.i0 == e.i1) continue;
+		halfEdges.push_back((static_cast<uint64_t>(e.i0) << 32) | e.i1);
+		halfEdges.push_back((static_cast<uint64_t>(e.i1) << 32) | e.i0);
+	}
+	edges = {};
+	std::sort(halfEdges.begin(), halfEdges.end());
+	halfEdges.erase(std::unique(halfEdges.begin(), halfEdges.end()), halfEdges.end());
+	if (halfEdges.empty())
+	{
+		return;
+	}
+
+	// compact vertex numbering, ascending by original index, with the neighbors of `v` at `neighbor[offset[v]..offset[v + 1])`, ascending
+	std::vector<uint32_t> ids;
+	std::vector<uint32_t> offset;
+	for (size_t h = 0; h < halfEdges.size(); ++h)
+	{
+		const uint32_t from = static_cast<uint32_t>(halfEdges[h] >> 32);
+		if (ids.empty() || ids.back() != from)
+		{
+			ids.push_back(from);
+			offset.push_back(static_cast<uint32_t>(h));
+		}
+	}
+	offset.push_back(static_cast<uint32_t>(halfEdges.size()));
+	const uint32_t vertexCnt = static_cast<uint32_t>(ids.size());
+
+	std::vector<uint32_t> neighbor(halfEdges.size());
+	std::vector<uint32_t> parent(vertexCnt);
+	std::iota(parent.begin(), parent.end(), 0);
+	for (uint32_t v = 0; v < vertexCnt; ++v)
+	{
+		for (uint32_t h = offset[v]; h < offset[v + 1]; ++h)
+		{
+			const uint32_t to = static_cast<uint32_t>(halfEdges[h] & 0xffffffffu);
+			const uint32_t n = static_cast<uint32_t>(std::lower_bound(ids.begin(), ids.end(), to) - ids.begin());
+			neighbor[h] = n;
+			if (v < n)
+			{
+				parent[FindRoot(parent, v)] = FindRoot(parent, n);
+			}
+		}
+	}
+	halfEdges = {};
+
+	// connected components, ordered by their smallest vertex, with their vertices ascending
+	std::vector<uint32_t> componentOf(vertexCnt);
+	std::vector<uint32_t> rootComponent(vertexCnt, InvalidIndex);
+	std::vector<uint32_t> componentStart;
+	for (uint32_t v = 0; v < vertexCnt; ++v)
+	{
+		uint32_t& c = rootComponent[FindRoot(parent, v)];
+		if (c == InvalidIndex)
+		{
+			c = static_cast<uint32_t>(componentStart.size());
+			componentStart.push_back(0);
+		}
+		componentOf[v] = c;
+		componentStart[c]++;
+	}
+	const size_t componentCnt = componentStart.size();
+	componentStart.push_back(0);
+	std::exclusive_scan(componentStart.begin(), componentStart.end(), componentStart.begin(), 0u);
+	std::vector<uint32_t> componentVertices(vertexCnt);
+	{
+		std::vector<uint32_t> fill(componentStart.begin(), componentStart.end() - 1);
+		for (uint32_t v = 0; v < vertexCnt; ++v)
+		{
+			componentVertices[fill[componentOf[v]]++] = v;
+		}
+	}
+
+	// components share no vertices, so the flags and cursors are written by one task each
+	std::vector<uint8_t> used(neighbor.size(), 0);
+	std::vector<uint32_t> cursor(offset.begin(), offset.end() - 1);
+	auto nextUnused = [&](uint32_t v)
+		{
+			uint32_t& s = cursor[v];
+			while (s < offset[v + 1] && used[s]) ++s;
+			return (s < offset[v + 1]) ? s : InvalidIndex;
+		};
+	auto markUsed = [&](uint32_t from, uint32_t slot)
+		{
+			used[slot] = 1;
+			const uint32_t to = neighbor[slot];
+			const auto begin = neighbor.begin() + offset[to];
+			const auto end = neighbor.begin() + offset[to + 1];
+			used[std::lower_bound(begin, end, from) - neighbor.begin()] = 1;
+		};
+
+	std::vector<std::vector<commands::ParamTypeInfo_t<commands::ParamType::IndexList>>> componentLoops(componentCnt);
+	std::vector<uint32_t> deadEnd(componentCnt, InvalidIndex);
+	TaskScheduler::Instance().ParallelFor(0, componentCnt, ComponentGrainSize, [&](size_t begin, size_t end)
+		{
+			for (size_t c = begin; c < end; ++c)
+			{
+				for (uint32_t i = componentStart[c]; i < componentStart[c + 1]; ++i)
+				{
+					const uint32_t start = componentVertices[i];
+					for (uint32_t slot = nextUnused(start); slot != InvalidIndex; slot = nextUnused(start))
+					{
+						auto loop = std::make_shared<std::vector<uint32_t>>();
+						loop->push_back(ids[start]);
+						uint32_t v = start;
+						bool closed = false;
+						while (true)
+						{
+							markUsed(v, slot);
+							v = neighbor[slot];
+							if (v == start)
+							{
+								closed = true;
+								break;
+							}
+							loop->push_back(ids[v]);
+							slot = nextUnused(v);
+							if (slot == InvalidIndex)
+							{
+								if (deadEnd[c] == InvalidIndex) deadEnd[c] = ids[v];
+								break;
+							}
+						}
+						// open chains are dropped, as callers rely on closed loops
+						if (closed)
+						{
+							componentLoops[c].push_back(loop);
+						}
+					}
+				}
+			}
+		});
+
+	for (uint32_t v : deadEnd)
+	{
+		if (v != InvalidIndex)
+		{
+			log.Error("Failed to complete loop at %d; open chain dropped", static_cast<int>(v));
+		}
+	}
+
+	size_t loopCnt = 0;
+	for (const auto& loops : componentLoops)
+	{
+		loopCnt += loops.size();
+	}
+	outLoops->reserve(loopCnt);
+	for (auto& loops : componentLoops)
+	{
+		outLoops->insert(outLoops->end(), loops.begin(), loops.end());
+	}
+}
@@ -5,82 +5,31 @@
 
 #include <SimpleLog/SimpleLog.hpp>
 
+#include <vector>
+
 namespace meshproc
 {
 	namespace utilities
 	{
 
+		// Connects the edges into closed loops.
+		// Each loop starts at the smallest vertex index of its connected component not yet fully used, and continues at the smallest unused neighbor,
+		// so vertices joining several loops (figure-eight) are resolved deterministically.
+		// Connected components are traced in parallel; the loops are ordered by the smallest vertex index of their component.
+		// Chains ending at a vertex with no unused edge left are logged as error and not returned, so all returned loops are closed.
+		void LoopsFromEdges(
+			std::vector<data::HashableEdge> edges,
+			commands::ParamTypeInfo_t<commands::ParamType::IndexListList>& outLoops,
+			sgrottel::ISimpleLog const& log);
+
 		template<typename EdgesT>
 		void LoopsFromEdges(
 			EdgesT const& edges,
 			commands::ParamTypeInfo_t<commands::ParamType::IndexListList>& outLoops,
 			sgrottel::ISimpleLog const& log)
 		{
-			std::unordered_map<uint32_t, std::unordered_set<uint32_t>> halfEdges;
-			halfEdges.reserve(edges.size());
-			for (data::HashableEdge const& e : edges)
-			{
-				halfEdges[e.x].insert(e.y);
-				halfEdges[e.y].insert(e.x);
-			}
-
-			auto removeEdge = [&halfEdges](uint32_t x, uint32_t y)
-				{
-					if (halfEdges.contains(x))
-					{
-						halfEdges[x].erase(y);
-						if (halfEdges[x].empty())
-						{
-							halfEdges.erase(x);
-						}
-					}
-					if (halfEdges.contains(y))
-					{
-						halfEdges[y].erase(x);
-						if (halfEdges[y].empty())
-						{
-							halfEdges.erase(y);
-						}
-					}
-				};
-
-			if (outLoops)
-			{
-				outLoops->clear();
-			}
-			else
-			{
-				outLoops = std::make_shared<std::vector<commands::ParamTypeInfo_t<commands::ParamType::IndexList>>>();
-			}
-
-			while (!halfEdges.empty())
-			{
-				commands::ParamTypeInfo_t<commands::ParamType::IndexList> loop = outLoops->emplace_back(std::make_shared<std::vector<uint32_t>>());
-
-				uint32_t next, last;
-				{
-					auto const& start = halfEdges.begin();
-					loop->push_back(last = start->first);
-					loop->push_back(next = *start->second.begin());
-					removeEdge(last, next);
-				}
-
-				while (next != loop->front())
-				{
-					last = next;
-					std::unordered_set<uint32_t>& t = halfEdges[last];
-					if (t.empty())
-					{
-						log.Error("Failed to complete loop at %d", static_cast<int>(last));
-					}
-					next = *t.begin();
-					removeEdge(last, next);
-					if (next != loop->front())
-					{
-						loop->push_back(next);
-					}
-				}
-			}
+			LoopsFromEdges(std::vector<data::HashableEdge>(edges.begin(), edges.end()), outLoops, log);
 		}
+
 	}
 }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+namespace meshproc
+{
+	namespace utilities
+	{
+
+		// spreads the lower 21 bits of `v` to every third bit
+		inline uint64_t MortonSpreadBits(uint32_t v)
+		{
+			uint64_t x = v & 0x1fffff;
+			x = (x | (x << 32)) & 0x1f00000000ffffull;
+			x = (x | (x << 16)) & 0x1f0000ff0000ffull;
+			x = (x | (x << 8)) & 0x100f00f00f00f00full;
+			x = (x | (x << 4)) & 0x10c30c30c30c30c3ull;
+			x = (x | (x << 2)) & 0x1249249249249249ull;
+			return x;
+		}
+
+		// 63-bit Morton code of three 21-bit coordinates
+		inline uint64_t MortonCode(uint32_t x, uint32_t y, uint32_t z)
+		{
+			return MortonSpreadBits(x) | (MortonSpreadBits(y) << 1) | (MortonSpreadBits(z) << 2);
+		}
+
+		// Maps positions within a bounding box onto the 21-bit grid of the Morton code
+		class MortonGrid
+		{
+		public:
+			static constexpr uint32_t MaxCoord = (1u << 21) - 1;
+
+			MortonGrid(const glm::vec3& bboxMin, const glm::vec3& bboxMax)
+				: m_min{ bboxMin }
+			{
+				const glm::vec3 size = bboxMax - bboxMin;
+				for (int i = 0; i < 3; ++i)
+				{
+					m_scale[i] = (size[i] > 0.0f) ? (static_cast<float>(MaxCoord) / size[i]) : 0.0f;
+				}
+			}
+
+			inline glm::uvec3 Cell(const glm::vec3& p) const
+			{
+				const glm::vec3 c = glm::clamp((p - m_min) * m_scale, 0.0f, static_cast<float>(MaxCoord));
+				return glm::uvec3(c);
+			}
+
+			inline uint64_t Code(const glm::vec3& p) const
+			{
+				const glm::uvec3 c = Cell(p);
+				return MortonCode(c.x, c.y, c.z);
+			}
+
+		private:
+			glm::vec3 m_min;
+			glm::vec3 m_scale;
+		};
+
+	}
+}
@@ -0,0 +1,297 @@
+#include "PlyHeader.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <cstring>
+
+using namespace meshproc;
+using namespace meshproc::utilities;
+
+namespace
+{
+
+	int TypeStrToFormatId(const char* name)
+	{
+		if (strcmp(name, "char") == 0) return 0;
+		if (strcmp(name, "uchar") == 0) return 1;
+		if (strcmp(name, "short") == 0) return 2;
+		if (strcmp(name, "ushort") == 0) return 3;
+		if (strcmp(name, "int") == 0) return 4;
+		if (strcmp(name, "uint") == 0) return 5;
+		if (strcmp(name, "float") == 0) return 6;
+		if (strcmp(name, "double") == 0) return 7;
+		return -1;
+	}
+
+	int FormatByteSize(int id)
+	{
+		switch (id)
+		{
+		case 0: return 1;
+		case 1: return 1;
+		case 2: return 2;
+		case 3: return 2;
+		case 4: return 4;
+		case 5: return 4;
+		case 6: return 4;
+		case 7: return 8;
+		}
+		return -1;
+	}
+
+	template<typename T>
+	T ReadAs(const uint8_t* buf, int offset, int format)
+	{
+		switch (format)
+		{
+		case 0: return static_cast<T>(*reinterpret_cast<const int8_t*>(buf + offset));
+		case 1: return static_cast<T>(*reinterpret_cast<const uint8_t*>(buf + offset));
+		case 2: return static_cast<T>(*reinterpret_cast<const int16_t*>(buf + offset));
+		case 3: return static_cast<T>(*reinterpret_cast<const uint16_t*>(buf + offset));
+		case 4: return static_cast<T>(*reinterpret_cast<const int32_t*>(buf + offset));
+		case 5: return static_cast<T>(*reinterpret_cast<const uint32_t*>(buf + offset));
+		case 6: return static_cast<T>(*reinterpret_cast<const float*>(buf + offset));
+		case 7: return static_cast<T>(*reinterpret_cast<const double*>(buf + offset));
+		}
+		return static_cast<T>(0);
+	}
+
+	float ReadAsFloat(const uint8_t* buf, int offset, int format)
+	{
+		return ReadAs<float>(buf, offset, format);
+	}
+
+
+	uint32_t ReadAsUInt32(const uint8_t* buf, int offset, int format)
+	{
+		return ReadAs<uint32_t>(buf, offset, format);
+	}
+
+}
+
+bool PlyHeader::Read(FILE* file, const sgrottel::ISimpleLog& log)
+{
+	constexpr size_t lineBufSize = 1024;
+	char lineBuf[lineBufSize + 1];
+	lineBuf[lineBufSize] = 0;
+	auto ReadLine = [&]() {
+		if (fgets(lineBuf, lineBufSize, file) == nullptr)
+		{
+			log.Error(L"Failed to read header line");
+			return false;
+		}
+		return true;
+		};
+
+	if (!ReadLine()) return false;
+	if (strcmp(lineBuf, "ply\n") != 0)
+	{
+		log.Error(L"Failed to read first header id line 'ply'");
+		return false;
+	}
+
+	int fileFormat = 0;
+
+	int curElement = 0;
+
+	while (ReadLine())
+	{
+		if (strcmp(lineBuf, "end_header\n") == 0)
+		{
+			curElement = 3;
+			break;
+		}
+		else if (strncmp(lineBuf, "format ", 7) == 0)
+		{
+			char formatType[256];
+			char formatVersion[256];
+			if (sscanf_s(lineBuf, "format %255s %255s\n", &formatType, static_cast<unsigned int>(_countof(formatType)), &formatVersion, static_cast<unsigned int>(_countof(formatVersion))) != 2)
+			{
+				log.Error(L"Failed to read header format line");
+				return false;
+			}
+			formatType[255] = 0;
+			formatVersion[255] = 0;
+			if (strcmp(formatType, "binary_little_endian") == 0 && strcmp(formatVersion, "1.0") == 0)
+			{
+				fileFormat = 1;
+			}
+			else
+			{
+				log.Error(L"ERROR: Currently, only PLY format 'binary_little_endian 1.0' is supported");
+				return false;
+			}
+		}
+		else if (strncmp(lineBuf, "comment ", 8) == 0)
+		{
+			// ignore comment rest of line
+			continue;
+		}
+		else if (strncmp(lineBuf, "element ", 8) == 0)
+		{
+			char name[256];
+			int size;
+			if (sscanf_s(lineBuf, "element %255s %d\n", &name, static_cast<unsigned int>(_countof(name)), &size) != 2)
+			{
+				log.Error(L"Failed to read header element line: %s", lineBuf);
+				return false;
+			}
+			name[255] = 0;
+			if (strcmp(name, "vertex") == 0)
+			{
+				curElement = 1;
+				vertCnt += size;
+			}
+			else if (strcmp(name, "face") == 0)
+			{
+				curElement = 2;
+				faceCnt += size;
+			}
+			else
+			{
+				curElement = -1;
+			}
+		}
+		else if (strncmp(lineBuf, "property ", 9) == 0)
+		{
+			char name[256];
+			char typeStr[256];
+			char typeStr2[256];
+			bool isList = false;
+			int typeFormat = -1;
+			int subTypeFormat = -1;
+
+			if (sscanf_s(lineBuf, "property list %255s %255s %255s\n", &typeStr, static_cast<unsigned int>(_countof(typeStr)), &typeStr2, static_cast<unsigned int>(_countof(typeStr2)), &name, static_cast<unsigned int>(_countof(name))) == 3)
+			{
+				isList = true;
+				typeStr2[255] = 0;
+				subTypeFormat = TypeStrToFormatId(typeStr2);
+				if (subTypeFormat < 0)
+				{
+					log.Error(L"Failed to read header property line, unsupported list second type: %s", lineBuf);
+					return false;
+				}
+			}
+			else if (sscanf_s(lineBuf, "property %255s %255s\n", &typeStr, static_cast<unsigned int>(_countof(typeStr)), &name, static_cast<unsigned int>(_countof(name))) == 2)
+			{
+				isList = false;
+			}
+			else
+			{
+				log.Error(L"Failed to read header property line: %s", lineBuf);
+				return false;
+			}
+			name[255] = 0;
+			typeStr[255] = 0;
+			typeFormat = TypeStrToFormatId(typeStr);
+			if (typeFormat < 0)
+			{
+				log.Error(L"Failed to read header property line, unsupported list second type: %s", lineBuf);
+				return false;
+			}
+
+			if (curElement == 1)
+			{
+				if (isList)
+				{
+					log.Error(L"Failed to read header property line, list property in vertex element is not supported: %s", lineBuf);
+					return false;
+				}
+
+				if (strcmp(name, "x") == 0)
+				{
+					m_vertXOffset = vertSize;
+					m_vertXFormat = typeFormat;
+				}
+				else if (strcmp(name, "y") == 0)
+				{
+					m_vertYOffset = vertSize;
+					m_vertYFormat = typeFormat;
+				}
+				else if (strcmp(name, "z") == 0)
+				{
+					m_vertZOffset = vertSize;
+					m_vertZFormat = typeFormat;
+				}
+
+				vertSize += FormatByteSize(typeFormat);
+			}
+			else if (curElement == 2)
+			{
+				if (isList)
+				{
+					if (strcmp(name, "vertex_indices") != 0)
+					{
+						log.Error(L"Failed to read header property list line, 'vertex_indices' list property must be first in face element: %s", lineBuf);
+						return false;
+					}
+
+					m_faceListLenOffset = faceSize;
+					m_faceListLenFormat = typeFormat;
+					m_faceListFormat = subTypeFormat;
+
+					// assume all triangles
+					faceSize += FormatByteSize(m_faceListLenFormat) + 3 * FormatByteSize(m_faceListFormat);
+				}
+				else
+				{
+					faceSize += FormatByteSize(typeFormat);
+				}
+			}
+			else
+			{
+				// ignoring custom elements
+				continue;
+			}
+		}
+	}
+	if (curElement != 3)
+	{
+		log.Error(L"Failed to read header: %d", curElement);
+		return false;
+	}
+	if (fileFormat != 1)
+	{
+		log.Error(L"Failed to read header: unknown file format");
+		return false;
+	}
+
+	if (m_vertXOffset < 0 || m_vertXFormat < 0 ||
+		m_vertYOffset < 0 || m_vertYFormat < 0 ||
+		m_vertZOffset < 0 || m_vertZFormat < 0)
+	{
+		log.Error(L"Failed to read header: vertex position data incomplete or unsupported");
+		return false;
+	}
+	if (m_faceListLenOffset < 0 || m_faceListLenFormat < 0 || m_faceListFormat < 0)
+	{
+		log.Error(L"Failed to read header: face data incomplete or unsupported");
+		return false;
+	}
+	m_faceListOffset = m_faceListLenOffset + FormatByteSize(m_faceListLenFormat);
+	m_faceListFormatSize = FormatByteSize(m_faceListFormat);
+
+	return true;
+}
+
+glm::vec3 PlyHeader::ReadVertex(const uint8_t* buf) const
+{
+	return glm::vec3{
+		ReadAsFloat(buf, m_vertXOffset, m_vertXFormat),
+		ReadAsFloat(buf, m_vertYOffset, m_vertYFormat),
+		ReadAsFloat(buf, m_vertZOffset, m_vertZFormat)
+	};
+}
+
+bool PlyHeader::ReadFace(const uint8_t* buf, uint32_t& outI0, uint32_t& outI1, uint32_t& outI2) const
+{
+	const uint32_t listLen = ReadAsUInt32(buf, m_faceListLenOffset, m_faceListLenFormat);
+	if (listLen != 3)
+	{
+		return false;
+	}
+	outI0 = ReadAsUInt32(buf, m_faceListOffset, m_faceListFormat);
+	outI1 = ReadAsUInt32(buf, m_faceListOffset + m_faceListFormatSize, m_faceListFormat);
+	outI2 = ReadAsUInt32(buf, m_faceListOffset + m_faceListFormatSize * 2, m_faceListFormat);
+	return true;
+}
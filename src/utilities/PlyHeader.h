@@ -0,0 +1,51 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstdio>
+
+namespace sgrottel
+{
+	class ISimpleLog;
+}
+
+namespace meshproc
+{
+	namespace utilities
+	{
+
+		// Header of a 'binary_little_endian 1.0' PLY file with triangle faces
+		class PlyHeader
+		{
+		public:
+			// Reads the header and leaves `file` positioned at the start of the vertex data
+			bool Read(FILE* file, const sgrottel::ISimpleLog& log);
+
+			glm::vec3 ReadVertex(const uint8_t* buf) const;
+
+			// returns false if the face is not a triangle
+			bool ReadFace(const uint8_t* buf, uint32_t& outI0, uint32_t& outI1, uint32_t& outI2) const;
+
+			int vertCnt = 0;
+			int vertSize = 0;
+			int faceCnt = 0;
+			int faceSize = 0;
+
+		private:
+			int m_vertXOffset = -1;
+			int m_vertXFormat = -1;
+			int m_vertYOffset = -1;
+			int m_vertYFormat = -1;
+			int m_vertZOffset = -1;
+			int m_vertZFormat = -1;
+
+			int m_faceListLenOffset = -1;
+			int m_faceListLenFormat = -1;
+			int m_faceListFormat = -1;
+			int m_faceListOffset = -1;
+			int m_faceListFormatSize = -1;
+		};
+
+	}
+}
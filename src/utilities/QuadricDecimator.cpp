@@ -0,0 +1,607 @@
+#include "QuadricDecimator.h"
+
+#include "data/Mesh.h"
+#include "data/Selection.h"
+#include "utilities/SpatialSort.h"
+#include "utilities/TaskScheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <queue>
+
+using namespace meshproc;
+using namespace meshproc::utilities;
+
+namespace
+{
+
+	// open border edges are preserved by planes perpendicular to their triangle, weighted by this factor
+	constexpr double borderPenalty = 100.0;
+
+	constexpr uint32_t invalidIndex = std::numeric_limits<uint32_t>::max();
+
+	glm::dvec3 FaceCross(const std::vector<glm::vec3>& positions, const data::Triangle& t)
+	{
+		const glm::dvec3 p0{ positions[t[0]] };
+		return glm::cross(glm::dvec3{ positions[t[1]] } - p0, glm::dvec3{ positions[t[2]] } - p0);
+	}
+
+	struct Collapse
+	{
+		double error;
+		uint32_t u;
+		uint32_t v;
+		uint32_t stampU;
+		uint32_t stampV;
+		glm::vec3 p;
+
+		// min-heap order, with ties broken by vertex indices for deterministic results
+		inline bool operator<(const Collapse& rhs) const
+		{
+			if (error != rhs.error) return error > rhs.error;
+			if (u != rhs.u) return u > rhs.u;
+			return v > rhs.v;
+		}
+	};
+
+}
+
+QuadricDecimator::Quadric QuadricDecimator::Quadric::FromPlane(const glm::dvec3& n, double d, double errorWeight, double weight)
+{
+	Quadric q;
+	q.a00 = errorWeight * n.x * n.x;
+	q.a01 = errorWeight * n.x * n.y;
+	q.a02 = errorWeight * n.x * n.z;
+	q.a11 = errorWeight * n.y * n.y;
+	q.a12 = errorWeight * n.y * n.z;
+	q.a22 = errorWeight * n.z * n.z;
+	q.b0 = errorWeight * n.x * d;
+	q.b1 = errorWeight * n.y * d;
+	q.b2 = errorWeight * n.z * d;
+	q.c = errorWeight * d * d;
+	q.weight = weight;
+	return q;
+}
+
+QuadricDecimator::Quadric& QuadricDecimator::Quadric::operator+=(const Quadric& rhs)
+{
+	a00 += rhs.a00;
+	a01 += rhs.a01;
+	a02 += rhs.a02;
+	a11 += rhs.a11;
+	a12 += rhs.a12;
+	a22 += rhs.a22;
+	b0 += rhs.b0;
+	b1 += rhs.b1;
+	b2 += rhs.b2;
+	c += rhs.c;
+	weight += rhs.weight;
+	return *this;
+}
+
+double QuadricDecimator::Quadric::Evaluate(const glm::vec3& p) const
+{
+	const double x = p.x, y = p.y, z = p.z;
+	return a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z
+		+ a11 * y * y + 2.0 * a12 * y * z
+		+ a22 * z * z
+		+ 2.0 * (b0 * x + b1 * y + b2 * z)
+		+ c;
+}
+
+bool QuadricDecimator::Quadric::Minimize(glm::vec3& outP) const
+{
+	// solve A p = -b by Cramer's rule
+	const double c00 = a11 * a22 - a12 * a12;
+	const double c01 = a02 * a12 - a01 * a22;
+	const double c02 = a01 * a12 - a02 * a11;
+	const double det = a00 * c00 + a01 * c01 + a02 * c02;
+	const double scale = std::abs(a00 * a11 * a22);
+	if (!(std::abs(det) > 1e-6 * scale) || det == 0.0)
+	{
+		return false;
+	}
+	const double c11 = a00 * a22 - a02 * a02;
+	const double c12 = a01 * a02 - a00 * a12;
+	const double c22 = a00 * a11 - a01 * a01;
+	const double inv = -1.0 / det;
+	outP.x = static_cast<float>((c00 * b0 + c01 * b1 + c02 * b2) * inv);
+	outP.y = static_cast<float>((c01 * b0 + c11 * b1 + c12 * b2) * inv);
+	outP.z = static_cast<float>((c02 * b0 + c12 * b1 + c22 * b2) * inv);
+	return std::isfinite(outP.x) && std::isfinite(outP.y) && std::isfinite(outP.z);
+}
+
+float QuadricDecimator::Decimate(data::Mesh& mesh, std::vector<glm::vec3>* attributes, const Settings& settings)
+{
+	TaskScheduler& tasks = TaskScheduler::Instance();
+	const size_t vertCnt = mesh.vertices.size();
+	const size_t triCnt = mesh.triangles.size();
+	if (triCnt == 0)
+	{
+		return 0.0f;
+	}
+
+	// vertex -> triangles adjacency
+	std::vector<uint32_t> adjStart(vertCnt + 1, 0);
+	for (const data::Triangle& t : mesh.triangles)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			adjStart[t[i] + 1]++;
+		}
+	}
+	for (size_t v = 0; v < vertCnt; ++v)
+	{
+		adjStart[v + 1] += adjStart[v];
+	}
+	std::vector<uint32_t> adj(adjStart.back());
+	{
+		std::vector<uint32_t> fill(adjStart.begin(), adjStart.end() - 1);
+		for (size_t ti = 0; ti < triCnt; ++ti)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				adj[fill[mesh.triangles[ti][i]]++] = static_cast<uint32_t>(ti);
+			}
+		}
+	}
+
+	std::vector<glm::dvec3> faceNormals(triCnt);
+	tasks.ParallelFor(0, triCnt, 0x4000, [&](size_t begin, size_t end)
+		{
+			for (size_t ti = begin; ti < end; ++ti)
+			{
+				const glm::dvec3 n = FaceCross(mesh.vertices, mesh.triangles[ti]);
+				const double len = glm::length(n);
+				faceNormals[ti] = (len > 0.0) ? n / len : glm::dvec3{ 0.0 };
+			}
+		});
+
+	// per-vertex quadrics gathered from the adjacent triangles, which keeps the sums independent of the thread count
+	const double creaseCos = std::cos(glm::radians(static_cast<double>(std::clamp(settings.creaseAngle, 0.0f, 180.0f))));
+	const bool creases = settings.creaseAngle < 180.0f;
+	std::vector<Quadric> quadrics(vertCnt);
+	data::Selection locked{ vertCnt };
+	std::vector<uint8_t> onBorder(vertCnt, 0);
+	tasks.ParallelFor(0, vertCnt, 0x1000, [&](size_t begin, size_t end)
+		{
+			for (size_t v = begin; v < end; ++v)
+			{
+				Quadric q;
+				for (uint32_t a = adjStart[v]; a < adjStart[v + 1]; ++a)
+				{
+					const uint32_t ti = adj[a];
+					const data::Triangle& t = mesh.triangles[ti];
+					const glm::dvec3& n = faceNormals[ti];
+					const double area = 0.5 * glm::length(FaceCross(mesh.vertices, t));
+					q += Quadric::FromPlane(n, -glm::dot(n, glm::dvec3{ mesh.vertices[t[0]] }), area, area);
+
+					// both edges of `t` at `v`
+					for (int i = 0; i < 3; ++i)
+					{
+						const uint32_t e0 = t[i];
+						const uint32_t e1 = t[(i + 1) % 3];
+						if (e0 != v && e1 != v) continue;
+
+						uint32_t otherCnt = 0;
+						bool crease = false;
+						for (uint32_t b = adjStart[e0]; b < adjStart[e0 + 1]; ++b)
+						{
+							if (adj[b] == ti || !mesh.triangles[adj[b]].HasIndex(e1)) continue;
+							otherCnt++;
+							crease = crease || (glm::dot(n, faceNormals[adj[b]]) < creaseCos);
+						}
+						if (otherCnt == 0)
+						{
+							onBorder[v] = 1;
+						}
+						if (otherCnt == 0 || (creases && crease))
+						{
+							const glm::dvec3 p0{ mesh.vertices[e0] };
+							const glm::dvec3 edge = glm::dvec3{ mesh.vertices[e1] } - p0;
+							const glm::dvec3 side = glm::cross(edge, n);
+							const double len = glm::length(side);
+							if (len <= 0.0) continue;
+							const glm::dvec3 sn = side / len;
+							q += Quadric::FromPlane(sn, -glm::dot(sn, p0), borderPenalty * glm::dot(edge, edge), 0.0);
+						}
+					}
+				}
+				quadrics[v] = q;
+			}
+		});
+	if (settings.lockBoundary)
+	{
+		for (size_t v = 0; v < vertCnt; ++v)
+		{
+			if (onBorder[v] != 0) locked.Set(v);
+		}
+	}
+
+	std::vector<glm::vec3>& positions = mesh.vertices;
+	float maxError = 0.0f;
+	const size_t target = settings.targetTriangleCount;
+
+	if (triCnt > 2 * PartitionSize)
+	{
+		// spatially coherent partitions of fixed size along the Morton curve of the triangle centroids
+		std::vector<glm::vec3> centroids(triCnt);
+		for (size_t ti = 0; ti < triCnt; ++ti)
+		{
+			const data::Triangle& t = mesh.triangles[ti];
+			centroids[ti] = (positions[t[0]] + positions[t[1]] + positions[t[2]]) / 3.0f;
+		}
+		const std::vector<uint32_t> order = SpatialSort::SortedOrder(SpatialSort::ComputeKeys(centroids, SpatialSort::Curve::Morton));
+		centroids.clear();
+		centroids.shrink_to_fit();
+
+		const size_t partCnt = (triCnt + PartitionSize - 1) / PartitionSize;
+		std::vector<std::vector<data::Triangle>> parts(partCnt);
+		// vertices shared between partitions miss parts of their neighborhood, and are left for the final pass
+		data::Selection pinned{ vertCnt };
+		std::vector<uint32_t> owner(vertCnt, invalidIndex);
+		for (size_t p = 0; p < partCnt; ++p)
+		{
+			const size_t end = std::min(triCnt, (p + 1) * PartitionSize);
+			parts[p].reserve(end - p * PartitionSize);
+			for (size_t i = p * PartitionSize; i < end; ++i)
+			{
+				const data::Triangle& t = mesh.triangles[order[i]];
+				parts[p].push_back(t);
+				for (int j = 0; j < 3; ++j)
+				{
+					if (owner[t[j]] == invalidIndex)
+					{
+						owner[t[j]] = static_cast<uint32_t>(p);
+					}
+					else if (owner[t[j]] != p)
+					{
+						pinned.Set(t[j]);
+					}
+				}
+			}
+		}
+		owner.clear();
+		owner.shrink_to_fit();
+
+		std::vector<float> partErrors(partCnt, 0.0f);
+		tasks.ParallelFor(0, partCnt, 1, [&](size_t begin, size_t end)
+			{
+				for (size_t p = begin; p < end; ++p)
+				{
+					// stop at twice the proportional share, as forcing all collapses into partitions with fixed borders
+					// takes expensive ones, which the final pass, ordered over the whole mesh, avoids
+					const size_t partTarget = 2 * static_cast<size_t>(static_cast<double>(target) * parts[p].size() / triCnt);
+					partErrors[p] = DecimatePart(parts[p], positions, quadrics, attributes, locked, &pinned, partTarget, settings.maxError);
+				}
+			});
+
+		mesh.triangles.clear();
+		for (size_t p = 0; p < partCnt; ++p)
+		{
+			mesh.triangles.insert(mesh.triangles.end(), parts[p].begin(), parts[p].end());
+			maxError = std::max(maxError, partErrors[p]);
+		}
+	}
+
+	maxError = std::max(maxError, DecimatePart(mesh.triangles, positions, quadrics, attributes, locked, nullptr, target, settings.maxError));
+
+	// remove unreferenced vertices, keeping the order of the remaining ones
+	std::vector<uint32_t> remap(vertCnt, invalidIndex);
+	for (const data::Triangle& t : mesh.triangles)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			remap[t[i]] = 0;
+		}
+	}
+	uint32_t newCnt = 0;
+	for (size_t v = 0; v < vertCnt; ++v)
+	{
+		if (remap[v] == invalidIndex) continue;
+		remap[v] = newCnt;
+		positions[newCnt] = positions[v];
+		if (attributes != nullptr)
+		{
+			(*attributes)[newCnt] = (*attributes)[v];
+		}
+		newCnt++;
+	}
+	positions.resize(newCnt);
+	if (attributes != nullptr)
+	{
+		attributes->resize(newCnt);
+	}
+	for (data::Triangle& t : mesh.triangles)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			t[i] = remap[t[i]];
+		}
+	}
+
+	return maxError;
+}
+
+float QuadricDecimator::DecimatePart(
+	std::vector<data::Triangle>& triangles,
+	std::vector<glm::vec3>& positions,
+	std::vector<Quadric>& quadrics,
+	std::vector<glm::vec3>* attributes,
+	const data::Selection& locked,
+	const data::Selection* pinned,
+	size_t targetTriangleCount,
+	float maxError)
+{
+	const size_t triCnt = triangles.size();
+	if (triCnt <= targetTriangleCount)
+	{
+		return 0.0f;
+	}
+
+	// local vertex numbering, in order of the global indices
+	std::vector<uint32_t> globalIds;
+	globalIds.reserve(triCnt * 3);
+	for (const data::Triangle& t : triangles)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			globalIds.push_back(t[i]);
+		}
+	}
+	std::sort(globalIds.begin(), globalIds.end());
+	globalIds.erase(std::unique(globalIds.begin(), globalIds.end()), globalIds.end());
+	const size_t vertCnt = globalIds.size();
+
+	std::vector<std::array<uint32_t, 3>> tris(triCnt);
+	std::vector<std::vector<uint32_t>> vertTris(vertCnt);
+	for (size_t ti = 0; ti < triCnt; ++ti)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			const uint32_t v = static_cast<uint32_t>(std::lower_bound(globalIds.begin(), globalIds.end(), triangles[ti][i]) - globalIds.begin());
+			tris[ti][i] = v;
+			vertTris[v].push_back(static_cast<uint32_t>(ti));
+		}
+	}
+	std::vector<uint8_t> triAlive(triCnt, 1);
+	size_t aliveCnt = triCnt;
+
+	std::vector<glm::vec3> pos(vertCnt);
+	std::vector<Quadric> quad(vertCnt);
+	std::vector<glm::vec3> attr(attributes != nullptr ? vertCnt : 0);
+	// 0: free, 1: locked, 2: pinned
+	std::vector<uint8_t> lock(vertCnt);
+	for (size_t v = 0; v < vertCnt; ++v)
+	{
+		pos[v] = positions[globalIds[v]];
+		quad[v] = quadrics[globalIds[v]];
+		if (attributes != nullptr)
+		{
+			attr[v] = (*attributes)[globalIds[v]];
+		}
+		lock[v] = (pinned != nullptr && pinned->Get(globalIds[v])) ? 2 : (locked.Get(globalIds[v]) ? 1 : 0);
+	}
+	std::vector<uint32_t> stamp(vertCnt, 0);
+	std::vector<uint8_t> removed(vertCnt, 0);
+
+	// sorted other vertices of all triangles of `v`, with duplicates, i.e. each neighbor once per shared triangle
+	auto collectNeighbors = [&](uint32_t v, std::vector<uint32_t>& out)
+		{
+			out.clear();
+			for (uint32_t ti : vertTris[v])
+			{
+				for (uint32_t w : tris[ti])
+				{
+					if (w != v) out.push_back(w);
+				}
+			}
+			std::sort(out.begin(), out.end());
+		};
+
+	const double maxErrorSq = static_cast<double>(maxError) * static_cast<double>(maxError);
+	std::priority_queue<Collapse> heap;
+	auto pushCollapse = [&](uint32_t u, uint32_t v)
+		{
+			if ((lock[u] != 0 && lock[v] != 0) || lock[u] == 2 || lock[v] == 2) return;
+			Quadric q = quad[u];
+			q += quad[v];
+			glm::vec3 p;
+			if (lock[u] != 0)
+			{
+				p = pos[u];
+			}
+			else if (lock[v] != 0)
+			{
+				p = pos[v];
+			}
+			else
+			{
+				// the optimum of a nearly singular quadric may lie far off; fall back to the best point on the edge
+				const float edgeLenSq = glm::dot(pos[v] - pos[u], pos[v] - pos[u]);
+				const glm::vec3 mid = (pos[u] + pos[v]) * 0.5f;
+				if (!q.Minimize(p) || glm::dot(p - mid, p - mid) > 4.0f * edgeLenSq)
+				{
+					p = pos[u];
+					double best = q.Error(p);
+					for (const glm::vec3& c : { pos[v], mid })
+					{
+						const double e = q.Error(c);
+						if (e < best)
+						{
+							best = e;
+							p = c;
+						}
+					}
+				}
+			}
+			const double error = q.Error(p);
+			if (error > maxErrorSq) return;
+			heap.push(Collapse{ error, u, v, stamp[u], stamp[v], p });
+		};
+
+	{
+		std::vector<uint64_t> edges;
+		edges.reserve(triCnt * 3);
+		for (const auto& t : tris)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				const uint32_t a = std::min(t[i], t[(i + 1) % 3]);
+				const uint32_t b = std::max(t[i], t[(i + 1) % 3]);
+				edges.push_back((static_cast<uint64_t>(a) << 32) | b);
+			}
+		}
+		std::sort(edges.begin(), edges.end());
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+		for (uint64_t e : edges)
+		{
+			pushCollapse(static_cast<uint32_t>(e >> 32), static_cast<uint32_t>(e));
+		}
+	}
+
+	std::vector<uint32_t> nu, nv, uniqueU, uniqueV, common;
+	auto isBorder = [](const std::vector<uint32_t>& sortedNeighbors)
+		{
+			// a manifold neighbor on a closed fan is shared by two triangles
+			for (size_t i = 0; i < sortedNeighbors.size();)
+			{
+				size_t j = i + 1;
+				while (j < sortedNeighbors.size() && sortedNeighbors[j] == sortedNeighbors[i]) ++j;
+				if (j - i == 1) return true;
+				i = j;
+			}
+			return false;
+		};
+	// triangles of `moved` not shared with `other` must not flip or degenerate when `moved` is placed at `p`
+	auto keepsOrientation = [&](uint32_t moved, uint32_t other, const glm::vec3& p)
+		{
+			for (uint32_t ti : vertTris[moved])
+			{
+				const auto& t = tris[ti];
+				if (t[0] == other || t[1] == other || t[2] == other) continue;
+				glm::vec3 q[3]{ pos[t[0]], pos[t[1]], pos[t[2]] };
+				const glm::vec3 n0 = glm::cross(q[1] - q[0], q[2] - q[0]);
+				for (int i = 0; i < 3; ++i)
+				{
+					if (t[i] == moved) q[i] = p;
+				}
+				const glm::vec3 n1 = glm::cross(q[1] - q[0], q[2] - q[0]);
+				if (glm::dot(n0, n1) <= 0.0f) return false;
+			}
+			return true;
+		};
+
+	double maxCollapseError = 0.0;
+	while (aliveCnt > targetTriangleCount && !heap.empty())
+	{
+		const Collapse c = heap.top();
+		heap.pop();
+		if (removed[c.u] != 0 || removed[c.v] != 0 || stamp[c.u] != c.stampU || stamp[c.v] != c.stampV)
+		{
+			continue;
+		}
+
+		// keep `u`, remove `v`
+		uint32_t u = c.u;
+		uint32_t v = c.v;
+		if (lock[v] != 0)
+		{
+			std::swap(u, v);
+		}
+
+		// link condition: the common neighbors must be exactly the opposite vertices of the shared triangles
+		collectNeighbors(u, nu);
+		collectNeighbors(v, nv);
+		size_t sharedTris = 0;
+		for (uint32_t ti : vertTris[v])
+		{
+			const auto& t = tris[ti];
+			if (t[0] == u || t[1] == u || t[2] == u) sharedTris++;
+		}
+		if (sharedTris == 0) continue;
+		uniqueU.clear();
+		uniqueV.clear();
+		common.clear();
+		std::unique_copy(nu.begin(), nu.end(), std::back_inserter(uniqueU));
+		std::unique_copy(nv.begin(), nv.end(), std::back_inserter(uniqueV));
+		std::set_intersection(uniqueU.begin(), uniqueU.end(), uniqueV.begin(), uniqueV.end(), std::back_inserter(common));
+		if (common.size() != sharedTris) continue;
+		// collapsing an inner edge between two border vertices would pinch the surface
+		if (sharedTris > 1 && isBorder(nu) && isBorder(nv)) continue;
+
+		if (!keepsOrientation(u, v, c.p) || !keepsOrientation(v, u, c.p)) continue;
+
+		// collapse
+		for (uint32_t ti : vertTris[v])
+		{
+			auto& t = tris[ti];
+			if (t[0] == u || t[1] == u || t[2] == u)
+			{
+				triAlive[ti] = 0;
+				aliveCnt--;
+				for (uint32_t w : t)
+				{
+					if (w == u || w == v) continue;
+					auto& wt = vertTris[w];
+					wt.erase(std::remove(wt.begin(), wt.end(), ti), wt.end());
+				}
+			}
+			else
+			{
+				for (uint32_t& w : t)
+				{
+					if (w == v) w = u;
+				}
+				vertTris[u].push_back(ti);
+			}
+		}
+		auto& ut = vertTris[u];
+		ut.erase(std::remove_if(ut.begin(), ut.end(), [&](uint32_t ti) { return triAlive[ti] == 0; }), ut.end());
+		vertTris[v].clear();
+		vertTris[v].shrink_to_fit();
+
+		if (!attr.empty())
+		{
+			const glm::vec3 e = pos[v] - pos[u];
+			const float lenSq = glm::dot(e, e);
+			const float s = (lenSq > 0.0f) ? std::clamp(glm::dot(c.p - pos[u], e) / lenSq, 0.0f, 1.0f) : 0.0f;
+			attr[u] = glm::mix(attr[u], attr[v], s);
+		}
+		pos[u] = c.p;
+		quad[u] += quad[v];
+		removed[v] = 1;
+		stamp[u]++;
+		maxCollapseError = std::max(maxCollapseError, c.error);
+
+		collectNeighbors(u, nu);
+		nu.erase(std::unique(nu.begin(), nu.end()), nu.end());
+		for (uint32_t w : nu)
+		{
+			pushCollapse(u, w);
+		}
+	}
+
+	// write back, except for locked and pinned vertices, which may be shared with concurrent calls
+	for (size_t v = 0; v < vertCnt; ++v)
+	{
+		if (lock[v] != 0 || removed[v] != 0) continue;
+		positions[globalIds[v]] = pos[v];
+		quadrics[globalIds[v]] = quad[v];
+		if (attributes != nullptr)
+		{
+			(*attributes)[globalIds[v]] = attr[v];
+		}
+	}
+	size_t dst = 0;
+	for (size_t ti = 0; ti < triCnt; ++ti)
+	{
+		if (triAlive[ti] == 0) continue;
+		triangles[dst++] = data::Triangle{ globalIds[tris[ti][0]], globalIds[tris[ti][1]], globalIds[tris[ti][2]] };
+	}
+	triangles.resize(dst);
+
+	return static_cast<float>(std::sqrt(maxCollapseError));
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "data/Triangle.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace meshproc
+{
+	namespace data
+	{
+		class Mesh;
+		class Selection;
+	}
+
+	namespace utilities
+	{
+
+		// Mesh decimation by edge collapses ordered by the quadric error metric, following
+		// "Surface Simplification Using Quadric Error Metrics", Garland & Heckbert 1997.
+		class QuadricDecimator
+		{
+		public:
+			struct Settings
+			{
+				// stops when the mesh has no more than this number of triangles
+				size_t targetTriangleCount{ 0 };
+				// stops before the first collapse with a larger error, i.e. root mean square distance to the planes of the collapsed triangles
+				float maxError{ std::numeric_limits<float>::max() };
+				// edges between triangles with normals differing by more than this angle, in degrees, are preserved like open borders
+				float creaseAngle{ 180.0f };
+				// vertices on open borders are neither moved nor removed
+				bool lockBoundary{ false };
+			};
+
+			// Symmetric 4x4 matrix of the sum of squared distances to planes, and the sum of the plane weights
+			struct Quadric
+			{
+				double a00{ 0.0 }, a01{ 0.0 }, a02{ 0.0 }, a11{ 0.0 }, a12{ 0.0 }, a22{ 0.0 };
+				double b0{ 0.0 }, b1{ 0.0 }, b2{ 0.0 };
+				double c{ 0.0 };
+				double weight{ 0.0 };
+
+				// plane `dot(n, x) + d = 0` with normalized `n`
+				// @param errorWeight scales the squared distances
+				// @param weight is added to the normalization weight of the error
+				static Quadric FromPlane(const glm::dvec3& n, double d, double errorWeight, double weight);
+
+				Quadric& operator+=(const Quadric& rhs);
+
+				double Evaluate(const glm::vec3& p) const;
+
+				// squared distance, normalized by the plane weights
+				inline double Error(const glm::vec3& p) const
+				{
+					const double e = std::max(Evaluate(p), 0.0);
+					return (weight > 0.0) ? e / weight : e;
+				}
+
+				// @return false if the minimum is not unique
+				bool Minimize(glm::vec3& outP) const;
+			};
+
+			// Decimates the mesh in place, and removes the vertices no longer referenced.
+			// Large meshes are first decimated in spatially coherent partitions in parallel, with the vertices shared
+			// between partitions left untouched, followed by one pass over the whole remaining mesh.
+			// The result does not depend on the thread count.
+			// @param attributes optional per-vertex values, interpolated along collapsed edges and compacted with the vertices
+			// @return the largest error of all collapses
+			static float Decimate(data::Mesh& mesh, std::vector<glm::vec3>* attributes, const Settings& settings);
+
+		private:
+			// number of triangles per partition
+			static constexpr size_t PartitionSize = 0x10000;
+
+			// Decimates `triangles`, given in indices of the global arrays, in place.
+			// Locked vertices are kept in place, pinned vertices are not part of any collapse.
+			// Values of both are read but never written, so concurrent calls may share them.
+			// @return the largest error of all collapses
+			static float DecimatePart(
+				std::vector<data::Triangle>& triangles,
+				std::vector<glm::vec3>& positions,
+				std::vector<Quadric>& quadrics,
+				std::vector<glm::vec3>* attributes,
+				const data::Selection& locked,
+				const data::Selection* pinned,
+				size_t targetTriangleCount,
+				float maxError);
+		};
+
+	}
+}
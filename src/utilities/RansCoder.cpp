@@ -0,0 +1,161 @@
+#include "RansCoder.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace meshproc;
+using namespace meshproc::utilities;
+
+namespace
+{
+
+	// Scales the symbol counts to frequencies summing up to `total`, keeping every present symbol representable
+	void NormalizeFrequencies(const std::array<uint64_t, 256>& counts, uint64_t countSum, uint32_t total, std::array<uint32_t, 256>& freq)
+	{
+		uint32_t sum = 0;
+		int largest = 0;
+		for (int s = 0; s < 256; ++s)
+		{
+			if (counts[s] == 0)
+			{
+				freq[s] = 0;
+				continue;
+			}
+			freq[s] = std::max<uint32_t>(1, static_cast<uint32_t>((counts[s] * total) / countSum));
+			sum += freq[s];
+			if (freq[s] > freq[largest]) largest = s;
+		}
+
+		// fix rounding errors, preferably at the most frequent symbols
+		while (sum != total)
+		{
+			if (sum < total)
+			{
+				freq[largest] += total - sum;
+				sum = total;
+			}
+			else
+			{
+				const uint32_t excess = sum - total;
+				int victim = -1;
+				for (int s = 0; s < 256; ++s)
+				{
+					if (freq[s] > 1 && (victim < 0 || freq[s] > freq[victim])) victim = s;
+				}
+				const uint32_t take = std::min(excess, freq[victim] - 1);
+				freq[victim] -= take;
+				sum -= take;
+			}
+		}
+	}
+
+}
+
+void RansCoder::Encode(const uint8_t* data, size_t size, std::vector<uint8_t>& out)
+{
+	if (size == 0)
+	{
+		return;
+	}
+
+	std::array<uint64_t, 256> counts{};
+	for (size_t i = 0; i < size; ++i)
+	{
+		counts[data[i]]++;
+	}
+	std::array<uint32_t, 256> freq;
+	NormalizeFrequencies(counts, size, ProbScale, freq);
+	std::array<uint32_t, 256> start;
+	uint32_t cum = 0;
+	for (int s = 0; s < 256; ++s)
+	{
+		start[s] = cum;
+		cum += freq[s];
+	}
+
+	// frequency table
+	for (int s = 0; s < 256; ++s)
+	{
+		WriteVarUInt(out, freq[s]);
+	}
+
+	// rANS encodes backwards, emitting bytes in reverse order
+	std::vector<uint8_t> rev;
+	rev.reserve(size / 2 + 16);
+	uint32_t x = StateLow;
+	for (size_t i = size; i > 0; --i)
+	{
+		const uint8_t s = data[i - 1];
+		const uint32_t f = freq[s];
+		const uint32_t xMax = ((StateLow >> ProbBits) << 8) * f;
+		while (x >= xMax)
+		{
+			rev.push_back(static_cast<uint8_t>(x & 0xff));
+			x >>= 8;
+		}
+		x = ((x / f) << ProbBits) + (x % f) + start[s];
+	}
+	for (int i = 0; i < 4; ++i)
+	{
+		rev.push_back(static_cast<uint8_t>(x & 0xff));
+		x >>= 8;
+	}
+
+	WriteVarUInt(out, rev.size());
+	out.insert(out.end(), rev.rbegin(), rev.rend());
+}
+
+bool RansCoder::Decode(const uint8_t*& in, const uint8_t* end, uint8_t* out, size_t size)
+{
+	if (size == 0)
+	{
+		return true;
+	}
+
+	std::array<uint32_t, 256> freq;
+	std::array<uint32_t, 256> start;
+	uint32_t cum = 0;
+	for (int s = 0; s < 256; ++s)
+	{
+		uint64_t f;
+		if (!ReadVarUInt(in, end, f) || f > ProbScale) return false;
+		freq[s] = static_cast<uint32_t>(f);
+		start[s] = cum;
+		cum += freq[s];
+	}
+	if (cum != ProbScale) return false;
+
+	std::array<uint8_t, ProbScale> slotToSymbol;
+	for (int s = 0; s < 256; ++s)
+	{
+		std::fill_n(slotToSymbol.begin() + start[s], freq[s], static_cast<uint8_t>(s));
+	}
+
+	uint64_t codedSize;
+	if (!ReadVarUInt(in, end, codedSize) || codedSize < 4 || codedSize > static_cast<uint64_t>(end - in)) return false;
+	const uint8_t* ptr = in;
+	const uint8_t* codedEnd = in + codedSize;
+	in = codedEnd;
+
+	// state bytes were emitted least significant first, then reversed
+	uint32_t x = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		x = (x << 8) | *ptr++;
+	}
+
+	constexpr uint32_t mask = ProbScale - 1;
+	for (size_t i = 0; i < size; ++i)
+	{
+		const uint8_t s = slotToSymbol[x & mask];
+		out[i] = s;
+		x = freq[s] * (x >> ProbBits) + (x & mask) - start[s];
+		while (x < StateLow)
+		{
+			if (ptr >= codedEnd) return false;
+			x = (x << 8) | *ptr++;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace meshproc
+{
+	namespace utilities
+	{
+
+		// Static order-0 rANS entropy coder for byte streams.
+		// The symbol frequency table is stored with the coded data.
+		class RansCoder
+		{
+		public:
+			// Appends the coded form of `data` to `out`
+			static void Encode(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+			// Decodes exactly `size` bytes into `out`, reading coded data from `in`, which is advanced.
+			// Returns false on corrupt input.
+			static bool Decode(const uint8_t*& in, const uint8_t* end, uint8_t* out, size_t size);
+
+		private:
+			static constexpr uint32_t ProbBits = 12;
+			static constexpr uint32_t ProbScale = 1u << ProbBits;
+			static constexpr uint32_t StateLow = 1u << 23;
+		};
+
+		// LEB128 variable length integers
+		inline void WriteVarUInt(std::vector<uint8_t>& out, uint64_t v)
+		{
+			while (v >= 0x80)
+			{
+				out.push_back(static_cast<uint8_t>(v | 0x80));
+				v >>= 7;
+			}
+			out.push_back(static_cast<uint8_t>(v));
+		}
+
+		inline bool ReadVarUInt(const uint8_t*& in, const uint8_t* end, uint64_t& v)
+		{
+			v = 0;
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				if (in >= end) return false;
+				const uint8_t b = *in++;
+				v |= static_cast<uint64_t>(b & 0x7f) << shift;
+				if ((b & 0x80) == 0) return true;
+			}
+			return false;
+		}
+
+		inline uint64_t ZigZagEncode(int64_t v)
+		{
+			return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+		}
+
+		inline int64_t ZigZagDecode(uint64_t v)
+		{
+			return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+		}
+
+	}
+}
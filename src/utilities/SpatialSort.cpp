@@ -0,0 +1,211 @@
+#include "SpatialSort.h"
+
+#include "data/Mesh.h"
+#include "utilities/MortonCode.h"
+#include "utilities/TaskScheduler.h"
+#include "utilities/VertexCacheOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+using namespace meshproc;
+using namespace meshproc::utilities;
+
+namespace
+{
+
+	template<typename FUNC>
+	void RunChunks(size_t chunkCount, const FUNC& func)
+	{
+		TaskScheduler::Instance().ParallelFor(0, chunkCount, 1, [&](size_t begin, size_t end)
+			{
+				for (size_t c = begin; c < end; ++c)
+				{
+					func(c);
+				}
+			});
+	}
+
+}
+
+uint64_t SpatialSort::HilbertCode(uint32_t x, uint32_t y, uint32_t z)
+{
+	// John Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707, 2004
+	constexpr int n = 3;
+	constexpr uint32_t m = 1u << 20;
+	uint32_t c[n]{ x & MortonGrid::MaxCoord, y & MortonGrid::MaxCoord, z & MortonGrid::MaxCoord };
+
+	for (uint32_t q = m; q > 1; q >>= 1)
+	{
+		const uint32_t p = q - 1;
+		for (int i = 0; i < n; ++i)
+		{
+			if (c[i] & q)
+			{
+				c[0] ^= p;
+			}
+			else
+			{
+				const uint32_t t = (c[0] ^ c[i]) & p;
+				c[0] ^= t;
+				c[i] ^= t;
+			}
+		}
+	}
+
+	for (int i = 1; i < n; ++i)
+	{
+		c[i] ^= c[i - 1];
+	}
+	uint32_t t = 0;
+	for (uint32_t q = m; q > 1; q >>= 1)
+	{
+		if (c[n - 1] & q)
+		{
+			t ^= q - 1;
+		}
+	}
+	for (int i = 0; i < n; ++i)
+	{
+		c[i] ^= t;
+	}
+
+	// the transposed index interleaves with c[0] as most significant bit of each triple
+	return MortonCode(c[2], c[1], c[0]);
+}
+
+std::vector<uint64_t> SpatialSort::ComputeKeys(const std::vector<glm::vec3>& points, Curve curve)
+{
+	std::vector<uint64_t> keys(points.size());
+	if (points.empty())
+	{
+		return keys;
+	}
+
+	glm::vec3 bboxMin = points.front();
+	glm::vec3 bboxMax = points.front();
+	for (const glm::vec3& p : points)
+	{
+		bboxMin = glm::min(bboxMin, p);
+		bboxMax = glm::max(bboxMax, p);
+	}
+	const MortonGrid grid{ bboxMin, bboxMax };
+
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		if (curve == Curve::Hilbert)
+		{
+			const glm::uvec3 c = grid.Cell(points[i]);
+			keys[i] = HilbertCode(c.x, c.y, c.z);
+		}
+		else
+		{
+			keys[i] = grid.Code(points[i]);
+		}
+	}
+	return keys;
+}
+
+std::vector<uint32_t> SpatialSort::SortedOrder(const std::vector<uint64_t>& keys)
+{
+	constexpr int digitBits = 8;
+	constexpr size_t bucketCount = 1u << digitBits;
+	constexpr size_t minChunkSize = 1u << 16;
+
+	const size_t count = keys.size();
+	const size_t chunkCount = std::clamp<size_t>(count / minChunkSize, 1, std::max<size_t>(TaskScheduler::Instance().GetThreadCount(), 1));
+	const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+	std::vector<uint64_t> key{ keys };
+	std::vector<uint64_t> keyTmp(count);
+	std::vector<uint32_t> order(count);
+	std::vector<uint32_t> orderTmp(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		order[i] = static_cast<uint32_t>(i);
+	}
+
+	std::vector<std::array<size_t, bucketCount>> offsets(chunkCount);
+	for (int shift = 0; shift < 64; shift += digitBits)
+	{
+		RunChunks(chunkCount, [&](size_t c)
+			{
+				std::array<size_t, bucketCount>& hist = offsets[c];
+				hist.fill(0);
+				const size_t end = std::min(count, (c + 1) * chunkSize);
+				for (size_t i = c * chunkSize; i < end; ++i)
+				{
+					hist[(key[i] >> shift) & (bucketCount - 1)]++;
+				}
+			});
+
+		// exclusive prefix sum over (bucket, chunk), keeping the sort stable
+		size_t sum = 0;
+		bool trivial = false;
+		for (size_t b = 0; b < bucketCount; ++b)
+		{
+			size_t bucketSize = 0;
+			for (size_t c = 0; c < chunkCount; ++c)
+			{
+				const size_t cnt = offsets[c][b];
+				offsets[c][b] = sum;
+				sum += cnt;
+				bucketSize += cnt;
+			}
+			if (bucketSize == count)
+			{
+				trivial = true;
+			}
+		}
+		if (trivial)
+		{
+			// all keys share this digit
+			continue;
+		}
+
+		RunChunks(chunkCount, [&](size_t c)
+			{
+				std::array<size_t, bucketCount>& pos = offsets[c];
+				const size_t end = std::min(count, (c + 1) * chunkSize);
+				for (size_t i = c * chunkSize; i < end; ++i)
+				{
+					const size_t dst = pos[(key[i] >> shift) & (bucketCount - 1)]++;
+					keyTmp[dst] = key[i];
+					orderTmp[dst] = order[i];
+				}
+			});
+		key.swap(keyTmp);
+		order.swap(orderTmp);
+	}
+
+	return order;
+}
+
+std::vector<uint32_t> SpatialSort::SortMesh(data::Mesh& mesh, Curve curve)
+{
+	const std::vector<uint32_t> vertOrder = SortedOrder(ComputeKeys(mesh.vertices, curve));
+	std::vector<uint32_t> remap(vertOrder.size());
+	for (size_t i = 0; i < vertOrder.size(); ++i)
+	{
+		remap[vertOrder[i]] = static_cast<uint32_t>(i);
+	}
+	VertexCacheOptimizer::RemapVertices(mesh, remap);
+
+	std::vector<glm::vec3> centroids;
+	centroids.reserve(mesh.triangles.size());
+	for (const data::Triangle& t : mesh.triangles)
+	{
+		centroids.push_back((mesh.vertices[t[0]] + mesh.vertices[t[1]] + mesh.vertices[t[2]]) / 3.0f);
+	}
+	const std::vector<uint32_t> triOrder = SortedOrder(ComputeKeys(centroids, curve));
+	std::vector<data::Triangle> triangles;
+	triangles.reserve(triOrder.size());
+	for (uint32_t ti : triOrder)
+	{
+		triangles.push_back(mesh.triangles[ti]);
+	}
+	mesh.triangles.swap(triangles);
+
+	return remap;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace meshproc
+{
+	namespace data
+	{
+		class Mesh;
+	}
+
+	namespace utilities
+	{
+
+		class SpatialSort
+		{
+		public:
+			enum class Curve
+			{
+				Morton,
+				Hilbert
+			};
+
+			// 63-bit space-filling curve keys of the `points` quantized within their bounding box
+			static std::vector<uint64_t> ComputeKeys(const std::vector<glm::vec3>& points, Curve curve);
+
+			// 63-bit Hilbert code of three 21-bit coordinates
+			static uint64_t HilbertCode(uint32_t x, uint32_t y, uint32_t z);
+
+			// Stable parallel LSD radix sort of the `keys`
+			// @return sorted order, i.e. the old index for each new position
+			static std::vector<uint32_t> SortedOrder(const std::vector<uint64_t>& keys);
+
+			// Reorders vertices along the curve, and triangles along the curve of their centroids
+			// @return remap table `remap[oldIndex] = newIndex` of the vertices
+			static std::vector<uint32_t> SortMesh(data::Mesh& mesh, Curve curve);
+		};
+
+	}
+}
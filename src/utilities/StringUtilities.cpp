@@ -2,6 +2,8 @@
 
 #include <windows.h>
 
+#include <cwctype>
+
 namespace
 {
 	inline std::string ToUtf8Impl(const wchar_t* wstr, size_t wstrSize)
@@ -52,3 +54,41 @@ std::wstring meshproc::FromUtf8(const std::string& str)
 
 	return result;
 }
+
+bool meshproc::WildcardMatch(const std::wstring_view& pattern, const std::wstring_view& str)
+{
+	size_t p = 0;
+	size_t s = 0;
+	size_t starP = std::wstring_view::npos;
+	size_t starS = 0;
+
+	while (s < str.size())
+	{
+		if (p < pattern.size() && pattern[p] == L'*')
+		{
+			starP = p++;
+			starS = s;
+		}
+		else if (p < pattern.size() && (pattern[p] == L'?' || std::towlower(pattern[p]) == std::towlower(str[s])))
+		{
+			p++;
+			s++;
+		}
+		else if (starP != std::wstring_view::npos)
+		{
+			// backtrack: let the last `*` consume one more character
+			p = starP + 1;
+			s = ++starS;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	while (p < pattern.size() && pattern[p] == L'*')
+	{
+		p++;
+	}
+	return p == pattern.size();
+}
@@ -8,4 +8,7 @@ namespace meshproc
 	std::string ToUtf8(const std::wstring& wstr);
 	std::string ToUtf8(const std::wstring_view& wstr);
 	std::wstring FromUtf8(const std::string& str);
+
+	// Matches `str` against a file name pattern with `*` and `?` wildcards, ignoring case
+	bool WildcardMatch(const std::wstring_view& pattern, const std::wstring_view& str);
 }
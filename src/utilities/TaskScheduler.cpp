@@ -0,0 +1,282 @@
+#include "TaskScheduler.h"
+
+#include "Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+using namespace meshproc;
+using namespace meshproc::utilities;
+
+namespace
+{
+	// index of the queue owned by the current thread; 0 for all threads not owned by the scheduler
+	thread_local size_t t_queueIndex = 0;
+}
+
+TaskScheduler::TaskGroup::TaskGroup(TaskScheduler& scheduler)
+	: m_scheduler{ scheduler }
+{
+}
+
+TaskScheduler::TaskGroup::~TaskGroup()
+{
+	try
+	{
+		Wait();
+	}
+	catch (...)
+	{
+	}
+}
+
+void TaskScheduler::TaskGroup::Run(std::function<void()> task)
+{
+	if (m_scheduler.m_threadCount <= 1)
+	{
+		// deterministic inline execution
+		std::exception_ptr error;
+		try
+		{
+			task();
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+		m_pending++;
+		Finished(error);
+		return;
+	}
+
+	m_pending++;
+	m_scheduler.Push(Task{ std::move(task), this });
+}
+
+void TaskScheduler::TaskGroup::Wait()
+{
+	while (m_pending.load() > 0)
+	{
+		if (m_scheduler.TryRunOne()) continue;
+
+		// the remaining tasks are running on other threads, or will be stolen soon
+		std::unique_lock<std::mutex> lock{ m_lock };
+		m_done.wait_for(lock, std::chrono::milliseconds(1), [this]() { return m_pending.load() == 0; });
+	}
+
+	std::exception_ptr error;
+	{
+		std::lock_guard<std::mutex> lock{ m_lock };
+		std::swap(error, m_error);
+	}
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+
+void TaskScheduler::TaskGroup::Finished(std::exception_ptr error)
+{
+	std::lock_guard<std::mutex> lock{ m_lock };
+	if (error && !m_error)
+	{
+		m_error = error;
+	}
+	if (--m_pending == 0)
+	{
+		m_done.notify_all();
+	}
+}
+
+TaskScheduler& TaskScheduler::Instance()
+{
+	static TaskScheduler instance;
+	return instance;
+}
+
+TaskScheduler::TaskScheduler()
+{
+	SetThreadCount(0);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+	StopWorkers();
+}
+
+void TaskScheduler::SetThreadCount(uint32_t count)
+{
+	if (count == 0)
+	{
+		count = std::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+	}
+	StopWorkers();
+	m_threadCount = count;
+}
+
+void TaskScheduler::ParallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& body)
+{
+	if (end <= begin)
+	{
+		return;
+	}
+	grainSize = std::max<size_t>(grainSize, 1);
+	const size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+
+	if (m_threadCount <= 1 || chunkCount == 1)
+	{
+		for (size_t b = begin; b < end; b += grainSize)
+		{
+			body(b, std::min(end, b + grainSize));
+		}
+		return;
+	}
+
+	std::atomic<size_t> nextChunk{ 0 };
+	auto runChunks = [&]()
+		{
+			for (size_t c = nextChunk++; c < chunkCount; c = nextChunk++)
+			{
+				const size_t b = begin + c * grainSize;
+				body(b, std::min(end, b + grainSize));
+			}
+		};
+
+	TaskGroup group{ *this };
+	const size_t taskCount = std::min<size_t>(chunkCount, m_threadCount);
+	for (size_t t = 1; t < taskCount; ++t)
+	{
+		group.Run(runChunks);
+	}
+	std::exception_ptr error;
+	try
+	{
+		runChunks();
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+		nextChunk = chunkCount;
+	}
+	group.Wait();
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+
+void TaskScheduler::Push(Task&& task)
+{
+	StartWorkers();
+	Queue& queue = *m_queues[t_queueIndex];
+	{
+		// counted while the task is in a queue, so idle workers never see a count without a task to take
+		std::lock_guard<std::mutex> lock{ queue.lock };
+		queue.tasks.push_back(std::move(task));
+		m_queued++;
+	}
+	{
+		// a worker between checking `m_queued` and sleeping holds this lock, so the notification cannot be lost
+		std::lock_guard<std::mutex> lock{ m_sleepLock };
+	}
+	m_wake.notify_one();
+}
+
+bool TaskScheduler::TryRunOne()
+{
+	if (m_queued.load() == 0) return false;
+
+	Task task{};
+	bool found = false;
+	const size_t self = t_queueIndex;
+	{
+		// own queue: newest first
+		Queue& queue = *m_queues[self];
+		std::lock_guard<std::mutex> lock{ queue.lock };
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+			m_queued--;
+			found = true;
+		}
+	}
+	for (size_t i = 1; !found && i < m_queues.size(); ++i)
+	{
+		// steal: oldest first
+		Queue& queue = *m_queues[(self + i) % m_queues.size()];
+		std::lock_guard<std::mutex> lock{ queue.lock };
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			m_queued--;
+			found = true;
+		}
+	}
+	if (!found) return false;
+
+	std::exception_ptr error;
+	try
+	{
+		Trace::Span span{ "task", "tasks" };
+		task.func();
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+	task.group->Finished(error);
+	return true;
+}
+
+void TaskScheduler::WorkerMain(size_t index)
+{
+	t_queueIndex = index;
+	Trace::Instance().SetThreadName("worker " + std::to_string(index));
+	while (true)
+	{
+		if (TryRunOne()) continue;
+
+		std::unique_lock<std::mutex> lock{ m_sleepLock };
+		m_wake.wait(lock, [this]() { return m_stop || m_queued.load() > 0; });
+		if (m_stop) break;
+	}
+}
+
+void TaskScheduler::StartWorkers()
+{
+	std::lock_guard<std::mutex> lock{ m_startLock };
+	if (m_started) return;
+
+	m_stop = false;
+	m_queues.clear();
+	for (uint32_t i = 0; i < m_threadCount; ++i)
+	{
+		m_queues.push_back(std::make_unique<Queue>());
+	}
+	for (uint32_t i = 1; i < m_threadCount; ++i)
+	{
+		m_workers.emplace_back(&TaskScheduler::WorkerMain, this, static_cast<size_t>(i));
+	}
+	m_started = true;
+}
+
+void TaskScheduler::StopWorkers()
+{
+	std::lock_guard<std::mutex> lock{ m_startLock };
+	if (!m_started) return;
+
+	{
+		std::lock_guard<std::mutex> sleepLock{ m_sleepLock };
+		m_stop = true;
+	}
+	m_wake.notify_all();
+	for (std::thread& t : m_workers)
+	{
+		t.join();
+	}
+	m_workers.clear();
+	m_started = false;
+}
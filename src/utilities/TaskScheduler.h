@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace meshproc
+{
+	namespace utilities
+	{
+
+		// Process-wide work-stealing task scheduler.
+		// With a thread count of 1 all work runs inline on the calling thread, in submission order.
+		class TaskScheduler
+		{
+		public:
+
+			// Set of tasks which can be waited for together
+			class TaskGroup
+			{
+			public:
+				TaskGroup(TaskScheduler& scheduler);
+				~TaskGroup();
+
+				void Run(std::function<void()> task);
+
+				// Waits for all tasks of the group, while helping to execute pending tasks.
+				// Rethrows the first exception thrown by any task of the group.
+				void Wait();
+
+			private:
+				friend class TaskScheduler;
+
+				void Finished(std::exception_ptr error);
+
+				TaskScheduler& m_scheduler;
+				std::atomic<size_t> m_pending{ 0 };
+				std::mutex m_lock;
+				std::condition_variable m_done;
+				std::exception_ptr m_error;
+			};
+
+			static TaskScheduler& Instance();
+
+			~TaskScheduler();
+
+			// @param count The number of threads, including the calling thread; 0 selects the hardware concurrency
+			// Must not be called while tasks are running
+			void SetThreadCount(uint32_t count);
+
+			inline uint32_t GetThreadCount() const
+			{
+				return m_threadCount;
+			}
+
+			// Calls `body(rangeBegin, rangeEnd)` for consecutive sub ranges of at most `grainSize` elements
+			void ParallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+			// Maps sub ranges of at most `grainSize` elements to partial results, and reduces them in range order.
+			// The result only depends on `grainSize`, not on the thread count.
+			template<typename T, typename MAP, typename REDUCE>
+			T ParallelReduce(size_t begin, size_t end, size_t grainSize, const T& identity, const MAP& map, const REDUCE& reduce)
+			{
+				if (end <= begin)
+				{
+					return identity;
+				}
+				grainSize = std::max<size_t>(grainSize, 1);
+				const size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+				std::vector<T> partial(chunkCount, identity);
+				ParallelFor(0, chunkCount, 1, [&](size_t cb, size_t ce)
+					{
+						for (size_t c = cb; c < ce; ++c)
+						{
+							const size_t b = begin + c * grainSize;
+							partial[c] = map(b, std::min(end, b + grainSize));
+						}
+					});
+				T result = identity;
+				for (const T& p : partial)
+				{
+					result = reduce(result, p);
+				}
+				return result;
+			}
+
+		private:
+			struct Task
+			{
+				std::function<void()> func;
+				TaskGroup* group;
+			};
+
+			struct Queue
+			{
+				std::mutex lock;
+				std::deque<Task> tasks;
+			};
+
+			TaskScheduler();
+
+			void Push(Task&& task);
+			bool TryRunOne();
+			void WorkerMain(size_t index);
+			void StartWorkers();
+			void StopWorkers();
+
+			uint32_t m_threadCount{ 1 };
+
+			// queue 0 is shared by all threads not owned by the scheduler
+			std::vector<std::unique_ptr<Queue>> m_queues;
+			std::vector<std::thread> m_workers;
+			std::mutex m_startLock;
+			bool m_started{ false };
+
+			std::atomic<size_t> m_queued{ 0 };
+			std::mutex m_sleepLock;
+			std::condition_variable m_wake;
+			bool m_stop{ false };
+		};
+
+	}
+}
@@ -0,0 +1,157 @@
+#include "Trace.h"
+
+#include <SimpleLog/SimpleLog.hpp>
+
+#include <cstdio>
+
+using namespace meshproc;
+using namespace meshproc::utilities;
+
+namespace
+{
+
+	std::atomic<uint32_t> s_nextThreadId{ 1 };
+
+	void WriteJsonString(FILE* file, const std::string& str)
+	{
+		fputc('"', file);
+		for (char c : str)
+		{
+			if (c == '"' || c == '\\')
+			{
+				fputc('\\', file);
+				fputc(c, file);
+			}
+			else if (static_cast<unsigned char>(c) < 0x20)
+			{
+				fprintf(file, "\\u%04x", static_cast<unsigned int>(c));
+			}
+			else
+			{
+				fputc(c, file);
+			}
+		}
+		fputc('"', file);
+	}
+
+}
+
+Trace::Span::Span(const char* name, const char* category)
+	: m_name{ name }
+	, m_category{ category }
+	, m_start{ 0.0 }
+	, m_active{ Trace::Instance().IsEnabled() }
+{
+	if (m_active)
+	{
+		m_start = Trace::Instance().NowUs();
+	}
+}
+
+Trace::Span::~Span()
+{
+	End();
+}
+
+void Trace::Span::End()
+{
+	if (!m_active) return;
+	m_active = false;
+	Trace& trace = Trace::Instance();
+	trace.AddSpan(m_name, m_category, m_start, trace.NowUs());
+}
+
+Trace& Trace::Instance()
+{
+	static Trace instance;
+	return instance;
+}
+
+void Trace::Enable()
+{
+	std::lock_guard<std::mutex> lock{ m_lock };
+	if (m_enabled) return;
+	m_start = std::chrono::steady_clock::now();
+	m_enabled = true;
+}
+
+void Trace::SetThreadName(const std::string& name)
+{
+	if (!IsEnabled()) return;
+	std::lock_guard<std::mutex> lock{ m_lock };
+	m_events.push_back(Event{ 'M', "thread_name", "__metadata", 0.0, 0.0, ThreadId(), name });
+}
+
+void Trace::AddSpan(const std::string& name, const char* category, double startUs, double endUs)
+{
+	if (!IsEnabled()) return;
+	std::lock_guard<std::mutex> lock{ m_lock };
+	m_events.push_back(Event{ 'X', name, category, startUs, endUs - startUs, ThreadId(), {} });
+}
+
+void Trace::AddInstant(const std::string& name, const char* category, const std::string& argsJson)
+{
+	if (!IsEnabled()) return;
+	const double now = NowUs();
+	std::lock_guard<std::mutex> lock{ m_lock };
+	m_events.push_back(Event{ 'i', name, category, now, 0.0, ThreadId(), argsJson });
+}
+
+double Trace::NowUs() const
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_start).count();
+}
+
+uint32_t Trace::ThreadId()
+{
+	thread_local uint32_t id = s_nextThreadId++;
+	return id;
+}
+
+bool Trace::WriteJson(const std::filesystem::path& path, const sgrottel::ISimpleLog& log) const
+{
+	FILE* file = nullptr;
+	errno_t r = _wfopen_s(&file, path.wstring().c_str(), L"wb");
+	if (r != 0 || file == nullptr)
+	{
+		log.Error(L"Failed to open \"%s\": %d", path.wstring().c_str(), static_cast<int>(r));
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock{ m_lock };
+	fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+	for (size_t i = 0; i < m_events.size(); ++i)
+	{
+		const Event& e = m_events[i];
+		fprintf(file, "{\"ph\": \"%c\", \"pid\": 1, \"tid\": %u, \"name\": ", e.phase, e.tid);
+		WriteJsonString(file, e.name);
+		if (e.phase == 'M')
+		{
+			fprintf(file, ", \"args\": {\"name\": ");
+			WriteJsonString(file, e.args);
+			fprintf(file, "}");
+		}
+		else
+		{
+			fprintf(file, ", \"cat\": \"%s\", \"ts\": %.3f", e.category, e.ts);
+			if (e.phase == 'X')
+			{
+				fprintf(file, ", \"dur\": %.3f", e.dur);
+			}
+			else
+			{
+				fprintf(file, ", \"s\": \"t\"");
+			}
+			if (!e.args.empty())
+			{
+				fprintf(file, ", \"args\": %s", e.args.c_str());
+			}
+		}
+		fprintf(file, "}%s\n", (i + 1 < m_events.size()) ? "," : "");
+	}
+	fprintf(file, "]}\n");
+
+	fclose(file);
+	log.Detail(L"Trace of %d events written to \"%s\"", static_cast<int>(m_events.size()), path.wstring().c_str());
+	return true;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sgrottel
+{
+	class ISimpleLog;
+}
+
+namespace meshproc
+{
+	namespace utilities
+	{
+
+		// Process-wide recorder of timeline events, written in the Chrome trace-event format.
+		// Recording is a no-op unless enabled.
+		class Trace
+		{
+		public:
+
+			// Records the time from construction to destruction, or to `End`, as span on the calling thread's track
+			class Span
+			{
+			public:
+				// `name` must stay valid for the life time of the span
+				Span(const char* name, const char* category = "meshproc");
+				~Span();
+
+				Span(const Span&) = delete;
+				Span& operator=(const Span&) = delete;
+
+				void End();
+
+			private:
+				const char* m_name;
+				const char* m_category;
+				double m_start;
+				bool m_active;
+			};
+
+			static Trace& Instance();
+
+			void Enable();
+
+			inline bool IsEnabled() const noexcept
+			{
+				return m_enabled.load(std::memory_order_relaxed);
+			}
+
+			// Names the track of the calling thread
+			void SetThreadName(const std::string& name);
+
+			void AddSpan(const std::string& name, const char* category, double startUs, double endUs);
+			void AddInstant(const std::string& name, const char* category, const std::string& argsJson = {});
+
+			// Microseconds since tracing was enabled
+			double NowUs() const;
+
+			bool WriteJson(const std::filesystem::path& path, const sgrottel::ISimpleLog& log) const;
+
+		private:
+			struct Event
+			{
+				char phase;
+				std::string name;
+				const char* category;
+				double ts;
+				double dur;
+				uint32_t tid;
+				std::string args;
+			};
+
+			Trace() = default;
+
+			static uint32_t ThreadId();
+
+			std::atomic<bool> m_enabled{ false };
+			std::chrono::steady_clock::time_point m_start;
+			mutable std::mutex m_lock;
+			std::vector<Event> m_events;
+		};
+
+	}
+}
@@ -0,0 +1,288 @@
+#include "TriangleIntersection.h"
+
+#pragma warning(push)
+#pragma warning(disable: 4702)
+#include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
+#pragma warning(pop)
+
+#include <algorithm>
+#include <utility>
+
+using namespace meshproc;
+using namespace meshproc::utilities;
+
+namespace
+{
+	typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
+
+	inline K::Point_3 ToPoint(const glm::vec3& v)
+	{
+		return K::Point_3(v.x, v.y, v.z);
+	}
+
+	inline int Orientation(const glm::vec3& p, const glm::vec3& q, const glm::vec3& r, const glm::vec3& s)
+	{
+		return static_cast<int>(CGAL::orientation(ToPoint(p), ToPoint(q), ToPoint(r), ToPoint(s)));
+	}
+
+	inline int Orientation2(const glm::vec2& p, const glm::vec2& q, const glm::vec2& r)
+	{
+		return static_cast<int>(CGAL::orientation(K::Point_2(p.x, p.y), K::Point_2(q.x, q.y), K::Point_2(r.x, r.y)));
+	}
+
+	inline bool Less(const glm::vec3& a, const glm::vec3& b)
+	{
+		if (a.x != b.x) return a.x < b.x;
+		if (a.y != b.y) return a.y < b.y;
+		return a.z < b.z;
+	}
+
+	// crossing of the edge `p`-`q` with the plane of `tri`
+	glm::vec3 EdgePlane(glm::vec3 p, glm::vec3 q, const glm::vec3* tri)
+	{
+		if (Less(q, p)) std::swap(p, q);
+		const glm::dvec3 t0{ tri[0] };
+		const glm::dvec3 n = glm::cross(glm::dvec3{ tri[1] } - t0, glm::dvec3{ tri[2] } - t0);
+		const double dp = glm::dot(n, glm::dvec3{ p } - t0);
+		const double dq = glm::dot(n, glm::dvec3{ q } - t0);
+		const double den = dp - dq;
+		const double t = (den != 0.0) ? std::clamp(dp / den, 0.0, 1.0) : 0.5;
+		return glm::vec3{ glm::dvec3{ p } + t * (glm::dvec3{ q } - glm::dvec3{ p }) };
+	}
+
+	// crossing of the coplanar edges `p`-`q` and `u`-`v`, as the point on the lexicographically smaller edge closest to the other line
+	glm::vec3 EdgeEdge(glm::vec3 p, glm::vec3 q, glm::vec3 u, glm::vec3 v)
+	{
+		if (Less(q, p)) std::swap(p, q);
+		if (Less(v, u)) std::swap(u, v);
+		if (Less(u, p) || (u == p && Less(v, q)))
+		{
+			std::swap(p, u);
+			std::swap(q, v);
+		}
+		const glm::dvec3 d1 = glm::dvec3{ q } - glm::dvec3{ p };
+		const glm::dvec3 d2 = glm::dvec3{ v } - glm::dvec3{ u };
+		const glm::dvec3 r = glm::dvec3{ p } - glm::dvec3{ u };
+		const double a = glm::dot(d1, d1);
+		const double b = glm::dot(d1, d2);
+		const double c = glm::dot(d2, d2);
+		const double den = a * c - b * b;
+		const double t = (den > 0.0) ? std::clamp((b * glm::dot(d2, r) - c * glm::dot(d1, r)) / den, 0.0, 1.0) : 0.5;
+		return glm::vec3{ glm::dvec3{ p } + t * d1 };
+	}
+
+	// Interval overlap test of [Guigue & Devillers 2003] for triangles crossing each other's plane.
+	// With `p1` alone on the positive side of the plane of the second triangle, and `p2` alone on its side of the plane of the first one,
+	// the intervals on the line shared by both planes overlap iff `q2` does not lie beyond `p1`-`q1`, and `r2` not beyond `p1`-`r1`.
+	bool CheckMinMax(const glm::vec3& p1, const glm::vec3& q1, const glm::vec3& r1, const glm::vec3& p2, const glm::vec3& q2, const glm::vec3& r2)
+	{
+		return Orientation(q1, p2, p1, q2) <= 0 && Orientation(p1, p2, r1, r2) <= 0;
+	}
+
+	// permutes the second triangle so that `p2` is alone on its side of the plane of the first one
+	bool IntervalsOverlap2(const glm::vec3& p1, const glm::vec3& q1, const glm::vec3& r1, const glm::vec3& p2, const glm::vec3& q2, const glm::vec3& r2, int dp2, int dq2, int dr2)
+	{
+		if (dp2 > 0)
+		{
+			if (dq2 > 0) return CheckMinMax(p1, r1, q1, r2, p2, q2);
+			if (dr2 > 0) return CheckMinMax(p1, r1, q1, q2, r2, p2);
+			return CheckMinMax(p1, q1, r1, p2, q2, r2);
+		}
+		if (dp2 < 0)
+		{
+			if (dq2 < 0) return CheckMinMax(p1, q1, r1, r2, p2, q2);
+			if (dr2 < 0) return CheckMinMax(p1, q1, r1, q2, r2, p2);
+			return CheckMinMax(p1, r1, q1, p2, q2, r2);
+		}
+		if (dq2 < 0)
+		{
+			if (dr2 >= 0) return CheckMinMax(p1, r1, q1, q2, r2, p2);
+			return CheckMinMax(p1, q1, r1, p2, q2, r2);
+		}
+		if (dq2 > 0)
+		{
+			if (dr2 > 0) return CheckMinMax(p1, r1, q1, p2, q2, r2);
+			return CheckMinMax(p1, q1, r1, q2, r2, p2);
+		}
+		if (dr2 > 0) return CheckMinMax(p1, q1, r1, r2, p2, q2);
+		return CheckMinMax(p1, r1, q1, r2, p2, q2);
+	}
+
+	// permutes the first triangle so that `p1` is alone on its side of the plane of the second one, and flips the second triangle to make that side positive
+	bool IntervalsOverlap(const glm::vec3* a, const int* sa, const glm::vec3* b, const int* sb)
+	{
+		if (sa[0] > 0)
+		{
+			if (sa[1] > 0) return IntervalsOverlap2(a[2], a[0], a[1], b[0], b[2], b[1], sb[0], sb[2], sb[1]);
+			if (sa[2] > 0) return IntervalsOverlap2(a[1], a[2], a[0], b[0], b[2], b[1], sb[0], sb[2], sb[1]);
+			return IntervalsOverlap2(a[0], a[1], a[2], b[0], b[1], b[2], sb[0], sb[1], sb[2]);
+		}
+		if (sa[0] < 0)
+		{
+			if (sa[1] < 0) return IntervalsOverlap2(a[2], a[0], a[1], b[0], b[1], b[2], sb[0], sb[1], sb[2]);
+			if (sa[2] < 0) return IntervalsOverlap2(a[1], a[2], a[0], b[0], b[1], b[2], sb[0], sb[1], sb[2]);
+			return IntervalsOverlap2(a[0], a[1], a[2], b[0], b[2], b[1], sb[0], sb[2], sb[1]);
+		}
+		if (sa[1] < 0)
+		{
+			if (sa[2] >= 0) return IntervalsOverlap2(a[1], a[2], a[0], b[0], b[2], b[1], sb[0], sb[2], sb[1]);
+			return IntervalsOverlap2(a[0], a[1], a[2], b[0], b[1], b[2], sb[0], sb[1], sb[2]);
+		}
+		if (sa[1] > 0)
+		{
+			if (sa[2] > 0) return IntervalsOverlap2(a[0], a[1], a[2], b[0], b[2], b[1], sb[0], sb[2], sb[1]);
+			return IntervalsOverlap2(a[1], a[2], a[0], b[0], b[1], b[2], sb[0], sb[1], sb[2]);
+		}
+		if (sa[2] > 0) return IntervalsOverlap2(a[2], a[0], a[1], b[0], b[1], b[2], sb[0], sb[1], sb[2]);
+		return IntervalsOverlap2(a[2], a[0], a[1], b[0], b[2], b[1], sb[0], sb[2], sb[1]);
+	}
+
+	// Points where `tri` meets the plane of `other`, given the sides of its vertices.
+	// `slot` selects which feature of the points refers to `tri`.
+	int PlanePoints(const glm::vec3* tri, const int* side, const glm::vec3* other, int slot, TriangleIntersection::Point* out)
+	{
+		int cnt = 0;
+		for (int i = 0; i < 3; ++i)
+		{
+			if (side[i] != 0) continue;
+			TriangleIntersection::Point& pt = out[cnt++];
+			pt.position = tri[i];
+			pt.feature[slot] = TriangleIntersection::Vertex + static_cast<uint8_t>(i);
+			pt.feature[1 - slot] = TriangleIntersection::Interior;
+			for (int k = 0; k < 3; ++k)
+			{
+				if (other[k] == tri[i])
+				{
+					pt.feature[1 - slot] = TriangleIntersection::Vertex + static_cast<uint8_t>(k);
+					break;
+				}
+				if (CGAL::collinear(ToPoint(other[k]), ToPoint(other[(k + 1) % 3]), ToPoint(tri[i])))
+				{
+					pt.feature[1 - slot] = TriangleIntersection::Edge + static_cast<uint8_t>(k);
+				}
+			}
+		}
+		for (int i = 0; i < 3; ++i)
+		{
+			const int j = (i + 1) % 3;
+			if (side[i] * side[j] >= 0) continue;
+			TriangleIntersection::Point& pt = out[cnt++];
+			pt.feature[slot] = TriangleIntersection::Edge + static_cast<uint8_t>(i);
+			pt.feature[1 - slot] = TriangleIntersection::Interior;
+			// the edge might cross an edge, or a vertex, of the other triangle
+			int onEdge = -1;
+			int onEdgeCnt = 0;
+			for (int k = 0; k < 3; ++k)
+			{
+				if (Orientation(other[k], other[(k + 1) % 3], tri[i], tri[j]) == 0)
+				{
+					onEdge = (onEdgeCnt == 0) ? k : ((onEdge + 1) % 3 == k ? k : onEdge);
+					onEdgeCnt++;
+				}
+			}
+			if (onEdgeCnt >= 2)
+			{
+				// the vertex shared by the two edges
+				pt.position = other[onEdge];
+				pt.feature[1 - slot] = TriangleIntersection::Vertex + static_cast<uint8_t>(onEdge);
+			}
+			else if (onEdgeCnt == 1)
+			{
+				pt.position = EdgeEdge(tri[i], tri[j], other[onEdge], other[(onEdge + 1) % 3]);
+				pt.feature[1 - slot] = TriangleIntersection::Edge + static_cast<uint8_t>(onEdge);
+			}
+			else
+			{
+				pt.position = EdgePlane(tri[i], tri[j], other);
+			}
+		}
+		return cnt;
+	}
+
+}
+
+TriangleIntersection::Result TriangleIntersection::Intersect(const glm::vec3* a, const glm::vec3* b, Point outSegment[2])
+{
+	int sa[3];
+	for (int i = 0; i < 3; ++i)
+	{
+		sa[i] = Orientation(b[0], b[1], b[2], a[i]);
+	}
+	if (sa[0] == sa[1] && sa[1] == sa[2])
+	{
+		return (sa[0] == 0) ? Result::Coplanar : Result::Disjoint;
+	}
+	int sb[3];
+	for (int i = 0; i < 3; ++i)
+	{
+		sb[i] = Orientation(a[0], a[1], a[2], b[i]);
+	}
+	if (sb[0] == sb[1] && sb[1] == sb[2])
+	{
+		return Result::Disjoint;
+	}
+
+	// both triangles meet the line shared by both planes in an interval; whether these overlap is decided exactly
+	if (!IntervalsOverlap(a, sa, b, sb))
+	{
+		return Result::Disjoint;
+	}
+	Point pa[3];
+	Point pb[3];
+	const int cntA = PlanePoints(a, sa, b, 0, pa);
+	const int cntB = PlanePoints(b, sb, a, 1, pb);
+	if (cntA == 1) pa[1] = pa[0];
+	if (cntB == 1) pb[1] = pb[0];
+
+	const glm::dvec3 na = glm::cross(glm::dvec3{ a[1] } - glm::dvec3{ a[0] }, glm::dvec3{ a[2] } - glm::dvec3{ a[0] });
+	const glm::dvec3 nb = glm::cross(glm::dvec3{ b[1] } - glm::dvec3{ b[0] }, glm::dvec3{ b[2] } - glm::dvec3{ b[0] });
+	const glm::dvec3 dir = glm::cross(na, nb);
+	auto param = [&dir](const Point& p) { return glm::dot(dir, glm::dvec3{ p.position }); };
+	if (param(pa[1]) < param(pa[0])) std::swap(pa[0], pa[1]);
+	if (param(pb[1]) < param(pb[0])) std::swap(pb[0], pb[1]);
+
+	const Point& lo = (param(pa[0]) >= param(pb[0])) ? pa[0] : pb[0];
+	const Point& hi = (param(pa[1]) <= param(pb[1])) ? pa[1] : pb[1];
+	// touching intervals may have their constructed end points ordered the other way round
+	outSegment[0] = lo;
+	outSegment[1] = hi;
+	return Result::Segment;
+}
+
+bool TriangleIntersection::CoplanarOverlap(const glm::vec3* a, const glm::vec3* b)
+{
+	// projection along the dominant axis of the normal keeps the orientations exact
+	const glm::dvec3 n = glm::abs(glm::cross(glm::dvec3{ a[1] } - glm::dvec3{ a[0] }, glm::dvec3{ a[2] } - glm::dvec3{ a[0] }));
+	const int axis = (n.x >= n.y && n.x >= n.z) ? 0 : ((n.y >= n.z) ? 1 : 2);
+	const int u = (axis + 1) % 3;
+	const int v = (axis + 2) % 3;
+	glm::vec2 tri[2][3];
+	for (int k = 0; k < 3; ++k)
+	{
+		tri[0][k] = glm::vec2{ a[k][u], a[k][v] };
+		tri[1][k] = glm::vec2{ b[k][u], b[k][v] };
+	}
+
+	// separating axis test on the lines of all six edges
+	for (int s = 0; s < 2; ++s)
+	{
+		const glm::vec2* t = tri[s];
+		const glm::vec2* o = tri[1 - s];
+		for (int i = 0; i < 3; ++i)
+		{
+			const glm::vec2& p = t[i];
+			const glm::vec2& q = t[(i + 1) % 3];
+			const int side = Orientation2(p, q, t[(i + 2) % 3]);
+			if (side == 0)
+			{
+				// degenerate triangles have no interior
+				return false;
+			}
+			if (Orientation2(p, q, o[0]) != side && Orientation2(p, q, o[1]) != side && Orientation2(p, q, o[2]) != side)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+namespace meshproc
+{
+	namespace utilities
+	{
+
+		// Intersection of two triangles in space.
+		// The topology of the intersection is decided by filtered exact orientation predicates.
+		// Constructed points only depend on the edge and the plane, or the two edges, they are constructed from,
+		// so the same crossing computed for neighboring triangles yields bit-identical points.
+		class TriangleIntersection
+		{
+		public:
+			// Location of a point on a triangle: `Vertex + i`, `Edge + i` for the edge from vertex i to i + 1, or `Interior`
+			static constexpr uint8_t Vertex = 0;
+			static constexpr uint8_t Edge = 3;
+			static constexpr uint8_t Interior = 6;
+
+			struct Point
+			{
+				glm::vec3 position{ 0.0f };
+				// location on the first and on the second triangle
+				uint8_t feature[2]{ Interior, Interior };
+			};
+
+			enum class Result
+			{
+				Disjoint,
+				// the triangles intersect in a segment, or touch in a single point if both end points are equal
+				Segment,
+				// the triangles lie in the same plane; the intersection is not computed
+				Coplanar
+			};
+
+			static Result Intersect(const glm::vec3* a, const glm::vec3* b, Point outSegment[2]);
+
+			// Tests if the interiors of two triangles in the same plane overlap; touching borders do not count
+			static bool CoplanarOverlap(const glm::vec3* a, const glm::vec3* b);
+		};
+
+	}
+}
@@ -0,0 +1,182 @@
+#include "VertexCacheOptimizer.h"
+
+#include "data/Mesh.h"
+
+#include <limits>
+
+using namespace meshproc;
+using namespace meshproc::utilities;
+
+float VertexCacheOptimizer::CalcAcmr(const std::vector<data::Triangle>& triangles, size_t vertexCount, uint32_t cacheSize)
+{
+	if (triangles.empty())
+	{
+		return 0.0f;
+	}
+
+	// a vertex is in the FIFO cache if less than `cacheSize` misses happened since it was loaded
+	constexpr uint32_t never = std::numeric_limits<uint32_t>::max();
+	std::vector<uint32_t> loadedAt(vertexCount, never);
+	uint32_t misses = 0;
+	for (const data::Triangle& t : triangles)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			uint32_t& l = loadedAt[t[i]];
+			if (l == never || misses - l >= cacheSize)
+			{
+				l = misses++;
+			}
+		}
+	}
+
+	return static_cast<float>(misses) / static_cast<float>(triangles.size());
+}
+
+std::vector<uint32_t> VertexCacheOptimizer::TipsifyOrder(const std::vector<data::Triangle>& triangles, size_t vertexCount, uint32_t cacheSize)
+{
+	const size_t triCnt = triangles.size();
+	std::vector<uint32_t> order;
+	order.reserve(triCnt);
+	if (triCnt == 0)
+	{
+		return order;
+	}
+
+	// vertex -> triangles adjacency, and live triangle count per vertex
+	std::vector<uint32_t> live(vertexCount, 0);
+	for (const data::Triangle& t : triangles)
+	{
+		live[t[0]]++;
+		live[t[1]]++;
+		live[t[2]]++;
+	}
+	std::vector<uint32_t> adjStart(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		adjStart[v + 1] = adjStart[v] + live[v];
+	}
+	std::vector<uint32_t> adj(adjStart.back());
+	{
+		std::vector<uint32_t> fill(adjStart.begin(), adjStart.end() - 1);
+		for (size_t ti = 0; ti < triCnt; ++ti)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				adj[fill[triangles[ti][i]]++] = static_cast<uint32_t>(ti);
+			}
+		}
+	}
+
+	const int64_t k = cacheSize;
+	std::vector<int64_t> cacheTime(vertexCount, 0);
+	std::vector<bool> emitted(triCnt, false);
+	std::vector<uint32_t> deadEnd;
+	std::vector<uint32_t> candidates;
+	int64_t time = k + 1;
+	size_t cursor = 0;
+
+	auto skipDeadEnd = [&]() -> int64_t
+		{
+			while (!deadEnd.empty())
+			{
+				const uint32_t d = deadEnd.back();
+				deadEnd.pop_back();
+				if (live[d] > 0) return d;
+			}
+			while (cursor < vertexCount)
+			{
+				if (live[cursor] > 0) return static_cast<int64_t>(cursor);
+				cursor++;
+			}
+			return -1;
+		};
+
+	int64_t fan = skipDeadEnd();
+	while (fan >= 0)
+	{
+		candidates.clear();
+		for (uint32_t a = adjStart[fan]; a < adjStart[fan + 1]; ++a)
+		{
+			const uint32_t ti = adj[a];
+			if (emitted[ti]) continue;
+			emitted[ti] = true;
+			order.push_back(ti);
+			for (int i = 0; i < 3; ++i)
+			{
+				const uint32_t v = triangles[ti][i];
+				deadEnd.push_back(v);
+				candidates.push_back(v);
+				live[v]--;
+				if (time - cacheTime[v] > k)
+				{
+					cacheTime[v] = time++;
+				}
+			}
+		}
+
+		// next fanning vertex: the candidate staying longest in cache which still has live triangles
+		int64_t next = -1;
+		int64_t best = -1;
+		for (uint32_t v : candidates)
+		{
+			if (live[v] == 0) continue;
+			int64_t priority = 0;
+			if (time - cacheTime[v] + 2 * static_cast<int64_t>(live[v]) <= k)
+			{
+				priority = time - cacheTime[v];
+			}
+			if (priority > best)
+			{
+				best = priority;
+				next = v;
+			}
+		}
+		fan = (next >= 0) ? next : skipDeadEnd();
+	}
+
+	return order;
+}
+
+std::vector<uint32_t> VertexCacheOptimizer::FirstUseVertexOrder(const std::vector<data::Triangle>& triangles, size_t vertexCount)
+{
+	constexpr uint32_t unassigned = std::numeric_limits<uint32_t>::max();
+	std::vector<uint32_t> remap(vertexCount, unassigned);
+	uint32_t next = 0;
+	for (const data::Triangle& t : triangles)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			if (remap[t[i]] == unassigned)
+			{
+				remap[t[i]] = next++;
+			}
+		}
+	}
+	for (uint32_t& r : remap)
+	{
+		if (r == unassigned)
+		{
+			r = next++;
+		}
+	}
+	return remap;
+}
+
+void VertexCacheOptimizer::RemapVertices(data::Mesh& mesh, const std::vector<uint32_t>& remap)
+{
+	std::vector<glm::vec3> vertices(mesh.vertices.size());
+	for (size_t i = 0; i < remap.size(); ++i)
+	{
+		vertices[remap[i]] = mesh.vertices[i];
+	}
+	mesh.vertices.swap(vertices);
+
+	for (data::Triangle& t : mesh.triangles)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			t[i] = remap[t[i]];
+		}
+	}
+}
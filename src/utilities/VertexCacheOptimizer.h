@@ -0,0 +1,38 @@
+#pragma once
+
+#include "data/Triangle.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace meshproc
+{
+	namespace data
+	{
+		class Mesh;
+	}
+
+	namespace utilities
+	{
+
+		class VertexCacheOptimizer
+		{
+		public:
+			// Average cache miss ratio (misses per triangle) of a simulated FIFO post-transform vertex cache
+			static float CalcAcmr(const std::vector<data::Triangle>& triangles, size_t vertexCount, uint32_t cacheSize);
+
+			// Triangle order for vertex cache reuse, following "Fast Triangle Reordering for Vertex Locality
+			// and Reduced Overdraw" (Tipsify), Sander et al. 2007. Linear in the number of triangles.
+			// @return new triangle order, i.e. the old triangle index for each new position
+			static std::vector<uint32_t> TipsifyOrder(const std::vector<data::Triangle>& triangles, size_t vertexCount, uint32_t cacheSize);
+
+			// @return remap table `remap[oldIndex] = newIndex` numbering vertices in order of first use.
+			//   Unreferenced vertices are placed at the end, keeping their relative order.
+			static std::vector<uint32_t> FirstUseVertexOrder(const std::vector<data::Triangle>& triangles, size_t vertexCount);
+
+			// Reorders the vertices of `mesh` according to `remap[oldIndex] = newIndex` and updates all triangles
+			static void RemapVertices(data::Mesh& mesh, const std::vector<uint32_t>& remap);
+		};
+
+	}
+}
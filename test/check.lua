@@ -0,0 +1,13 @@
+--
+-- Test helper
+-- Shared assertion of the test scripts: `local check = require("check")`
+--
+
+-- Raises `msg` as error, attributed to the calling line, unless `cond` holds
+local function check(cond, msg)
+	if not cond then
+		error(msg, 2)
+	end
+end
+
+return check
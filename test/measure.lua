@@ -0,0 +1,20 @@
+--
+-- Test helper
+-- Shared mesh measurements of the test scripts: `local measure = require("measure")`
+--
+local measure = {}
+
+-- Enclosed volume of a closed mesh, positive for outward facing triangles
+function measure.volume(mesh)
+	local v = 0
+	for i = 1, #mesh.triangle do
+		local t = mesh.triangle[i]
+		local a = mesh.vertex[t.x]
+		local b = mesh.vertex[t.y]
+		local c = mesh.vertex[t.z]
+		v = v + a.x * (b.y * c.z - b.z * c.y) + a.y * (b.z * c.x - b.x * c.z) + a.z * (b.x * c.y - b.y * c.x)
+	end
+	return v / 6
+end
+
+return measure
@@ -0,0 +1,12 @@
+[CmdletBinding()]
+param(
+	[Parameter(Mandatory = $true)][string]$exe
+)
+$verboseArg=$null
+if ($PSBoundParameters.ContainsKey('Verbose')) { $verboseArg='-v' }
+
+# run test; the script validates its results itself
+& $exe run (Join-Path $PSScriptRoot "test-bvh.lua") $verboseArg
+if ($LASTEXITCODE -ne 0) { throw }
+
+#done
@@ -0,0 +1,24 @@
+[CmdletBinding()]
+param(
+	[Parameter(Mandatory = $true)][string]$exe
+)
+$verboseArg=$null
+if ($PSBoundParameters.ContainsKey('Verbose')) { $verboseArg='-v' }
+
+# delete files to be generated by the test
+Remove-Item -Path (Join-Path $PSScriptRoot "test-layout.obj") -ErrorAction SilentlyContinue
+Remove-Item -Path (Join-Path $PSScriptRoot "test-layout-1.obj") -ErrorAction SilentlyContinue
+
+# run test
+& $exe run (Join-Path $PSScriptRoot "test-layout.lua") $verboseArg
+if ($LASTEXITCODE -ne 0) { throw }
+
+# validate files generated
+cd $PSScriptRoot
+
+.\Compare-WavefrontObjFiles.ps1 .\test-layout.obj .\test-layout-1.obj
+if ($LASTEXITCODE -ne 0) { cd -; throw }
+
+cd -
+
+#done
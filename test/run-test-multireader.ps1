@@ -0,0 +1,17 @@
+[CmdletBinding()]
+param(
+	[Parameter(Mandatory = $true)][string]$exe
+)
+$verboseArg=$null
+if ($PSBoundParameters.ContainsKey('Verbose')) { $verboseArg='-v' }
+
+# fresh directory for the files generated by the test
+$dir = Join-Path $PSScriptRoot "test-multireader"
+Remove-Item -Path $dir -Recurse -ErrorAction SilentlyContinue
+New-Item -Path (Join-Path $dir "sub") -ItemType Directory | Out-Null
+
+# run test; the script validates its results itself
+& $exe run (Join-Path $PSScriptRoot "test-multireader.lua") $verboseArg
+if ($LASTEXITCODE -ne 0) { throw }
+
+#done
@@ -0,0 +1,39 @@
+[CmdletBinding()]
+param(
+	[Parameter(Mandatory = $true)][string]$exe
+)
+$verboseArg=$null
+if ($PSBoundParameters.ContainsKey('Verbose')) { $verboseArg='-v' }
+
+# delete files to be generated by the test
+$profileFile = Join-Path $PSScriptRoot "test-profile.profile.json"
+Remove-Item -Path $profileFile -ErrorAction SilentlyContinue
+
+# run test
+& $exe run (Join-Path $PSScriptRoot "test-profile.lua") $verboseArg --profile-out $profileFile
+if ($LASTEXITCODE -ne 0) { throw }
+
+# validate profile generated
+$result = Get-Content -Raw $profileFile | ConvertFrom-Json
+
+$inv = $result.invocations
+if ($inv.Count -ne 4) { throw "Expected 4 invocations, got $($inv.Count)" }
+if ($inv[0].command -ne "generator.SphereIco" -or -not $inv[0].success) { throw "First invocation mismatch" }
+if ($inv[1].output.triangles -ne 1280) { throw "SphereIco output triangles mismatch: $($inv[1].output.triangles)" }
+if ($inv[2].command -ne "edit.Decimate" -or $inv[2].input.triangles -ne 1280 -or $inv[2].output.triangles -gt 500) { throw "Decimate invocation mismatch" }
+if ($inv[3].success) { throw "Failing invocation reported as success" }
+foreach ($i in $inv) {
+	if ($null -eq $i.peak_rss_growth_bytes -or $i.peak_rss_growth_bytes -lt 0) { throw "peak_rss_growth_bytes missing" }
+	if ($i.wall_ms -lt 0 -or $i.cpu_ms -lt 0) { throw "Negative times" }
+}
+
+$cmds = $result.commands
+if ($cmds.Count -ne 2) { throw "Expected 2 aggregated commands, got $($cmds.Count)" }
+foreach ($c in $cmds) {
+	if ($c.calls -ne 2) { throw "$($c.command) expected 2 calls, got $($c.calls)" }
+	if ($null -eq $c.peak_rss_growth_max_bytes) { throw "peak_rss_growth_max_bytes missing" }
+}
+$sphere = $cmds | Where-Object { $_.command -eq "generator.SphereIco" }
+if ($sphere.output.triangles -ne 2560) { throw "Aggregated output triangles mismatch: $($sphere.output.triangles)" }
+
+#done
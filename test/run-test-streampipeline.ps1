@@ -0,0 +1,16 @@
+[CmdletBinding()]
+param(
+	[Parameter(Mandatory = $true)][string]$exe
+)
+$verboseArg=$null
+if ($PSBoundParameters.ContainsKey('Verbose')) { $verboseArg='-v' }
+
+# delete files to be generated by the test
+Remove-Item -Path (Join-Path $PSScriptRoot "test-streampipeline.stl") -ErrorAction SilentlyContinue
+Remove-Item -Path (Join-Path $PSScriptRoot "test-streampipeline.ply") -ErrorAction SilentlyContinue
+
+# run test; the script validates its results itself
+& $exe run (Join-Path $PSScriptRoot "test-streampipeline.lua") $verboseArg
+if ($LASTEXITCODE -ne 0) { throw }
+
+#done
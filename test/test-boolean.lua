@@ -0,0 +1,70 @@
+--
+-- Test script
+-- Boolean operations on closed meshes
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+local check = require("check")
+local volume = require("measure").volume
+
+local function isClosed(mesh)
+	local openBorder = meshproc.compute.OpenBorder.new()
+	openBorder.Mesh = mesh
+	openBorder:invoke()
+	return #openBorder.EdgeLists == 0
+end
+
+local function boolean(a, b, operation)
+	local cmd = meshproc.edit.Boolean.new()
+	cmd.MeshA = a
+	cmd.MeshB = b
+	cmd.Operation = operation
+	cmd:invoke()
+	local mesh = cmd.Mesh
+	check(mesh:is_valid() and isClosed(mesh), operation .. " result is closed")
+	return mesh
+end
+
+-- two unit cubes, overlapping in a box of 0.7 x 0.6 x 0.8
+local make = meshproc.generator.Cuboid.new()
+make:invoke()
+local cubeA = make["Mesh"]
+make:invoke()
+local cubeB = make["Mesh"]
+cubeB:apply_transform(XMat4.translate(0.3, 0.4, 0.2))
+
+local overlap = 0.7 * 0.6 * 0.8
+check(math.abs(volume(boolean(cubeA, cubeB, "Union")) - (2 - overlap)) < 1e-4, "Union volume")
+check(math.abs(volume(boolean(cubeA, cubeB, "Intersection")) - overlap) < 1e-4, "Intersection volume")
+check(math.abs(volume(boolean(cubeA, cubeB, "Difference")) - (1 - overlap)) < 1e-4, "Difference volume")
+
+-- flush faces: overlapping coplanar triangles are not resolved, so the command fails instead of returning an open mesh
+make:invoke()
+local cubeFlush = make["Mesh"]
+cubeFlush:apply_transform(XMat4.translate(0.5, 0, 0))
+for _, operation in ipairs({ "Union", "Intersection", "Difference" }) do
+	local cmd = meshproc.edit.Boolean.new()
+	cmd.MeshA = cubeA
+	cmd.MeshB = cubeFlush
+	cmd.Operation = operation
+	check(not cmd:invoke(), operation .. " of flush faces rejected")
+end
+
+-- curved surfaces: union and intersection add up to both volumes
+make = meshproc.generator.SphereIco.new()
+make["Iterations"] = 4
+make:invoke()
+local sphereA = make["Mesh"]
+make:invoke()
+local sphereB = make["Mesh"]
+sphereB:apply_transform(XMat4.translate(0.5, 0.1, 0.05))
+
+local sphereVolume = volume(sphereA)
+local unionVolume = volume(boolean(sphereA, sphereB, "Union"))
+local intersectionVolume = volume(boolean(sphereA, sphereB, "Intersection"))
+local differenceVolume = volume(boolean(sphereA, sphereB, "Difference"))
+check(math.abs(unionVolume + intersectionVolume - 2 * sphereVolume) < 1e-3, "Union and intersection volumes")
+check(math.abs(differenceVolume + intersectionVolume - sphereVolume) < 1e-3, "Difference and intersection volumes")
+check(intersectionVolume > 0.1 and intersectionVolume < sphereVolume, "Spheres overlap")
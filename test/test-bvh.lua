@@ -0,0 +1,111 @@
+--
+-- Test script
+-- Ray cast, closest point and mesh distance queries on the bounding volume hierarchy of a mesh
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+local check = require("check")
+
+local function near(a, b)
+	return math.abs(a - b) < 1e-4
+end
+
+-- cube from (0, 0, 0) to (2, 2, 2)
+local make = meshproc.generator.Cuboid.new()
+make["SizeX"] = 2
+make["SizeY"] = 2
+make["SizeZ"] = 2
+make["NumSegmentsX"] = 4
+make["NumSegmentsY"] = 4
+make["NumSegmentsZ"] = 4
+make:invoke()
+local mesh = make["Mesh"]
+
+local origins = meshproc.Vec3List.new()
+origins:insert(XVec3(0.5, 0.7, -3)) -- hits the bottom face
+origins:insert(XVec3(1, 1, 1)) -- inside, hits the top face
+origins:insert(XVec3(5, 5, -3)) -- misses
+local directions = meshproc.Vec3List.new()
+directions:insert(XVec3(0, 0, 1))
+
+local cast = meshproc.compute.RayCast.new()
+cast.Mesh = mesh
+cast.Origins = origins
+cast.Directions = directions
+cast:invoke()
+check(near(cast.Distances[1], 3), "Ray distance from outside")
+check(near(cast.Distances[2], 1), "Ray distance from inside")
+check(cast.Distances[3] == -1 and cast.Triangles[3] == 0, "Ray miss")
+check(cast.Triangles[1] >= 1 and cast.Triangles[1] <= #mesh.triangle, "Ray hit triangle")
+local b = cast.Barycentrics[1]
+check(near(b.x + b.y + b.z, 1), "Ray hit barycentric weights")
+
+cast.MaxDistance = 2
+cast:invoke()
+check(cast.Distances[1] == -1 and near(cast.Distances[2], 1), "Ray max distance")
+
+-- axis-aligned rays from the bounding planes of a flat grid, from (0, 0, 0) to (1, 1, 0)
+make = meshproc.generator.Grid.new()
+make:invoke()
+local grid = make["Mesh"]
+local gridOrigins = meshproc.Vec3List.new()
+gridOrigins:insert(XVec3(0, 0.55, -1)) -- on the minimum x plane
+gridOrigins:insert(XVec3(1, 0.55, -1)) -- on the maximum x plane
+gridOrigins:insert(XVec3(0.3, 0, -1)) -- on the minimum y plane
+gridOrigins:insert(XVec3(-0.1, 0.55, -1)) -- beside the grid
+local gridCast = meshproc.compute.RayCast.new()
+gridCast.Mesh = grid
+gridCast.Origins = gridOrigins
+gridCast.Directions = directions
+gridCast:invoke()
+for i = 1, 3 do
+	check(near(gridCast.Distances[i], 1), "Ray from a bounding plane hits")
+end
+check(gridCast.Distances[4] == -1, "Ray beside a bounding plane misses")
+
+local points = meshproc.Vec3List.new()
+points:insert(XVec3(1, 1, 1.2)) -- inside, nearest to the top face
+points:insert(XVec3(3, 3, 1)) -- outside, nearest to an edge
+points:insert(XVec3(-1, 0.5, 0.5)) -- outside, nearest to a face
+
+local closest = meshproc.compute.ClosestPoint.new()
+closest.Mesh = mesh
+closest.Points = points
+closest:invoke()
+check(near(closest.Distances[1], 0.8) and near(closest.ClosestPoints[1].z, 2), "Closest point from inside")
+check(near(closest.Distances[2], math.sqrt(2)), "Closest point on edge")
+local p = closest.ClosestPoints[2]
+check(near(p.x, 2) and near(p.y, 2) and near(p.z, 1), "Closest point on edge position")
+check(near(closest.Distances[3], 1) and near(closest.ClosestPoints[3].x, 0), "Closest point on face")
+
+closest.MaxDistance = 1.2
+closest:invoke()
+check(closest.Distances[2] == -1 and closest.Triangles[2] == 0, "Closest point max distance")
+check(near(closest.Distances[3], 1), "Closest point within max distance")
+
+-- the hierarchy follows changes of the mesh
+mesh:apply_transform(XMat4.translate(0, 0, 1))
+cast.MaxDistance = 100
+cast:invoke()
+check(near(cast.Distances[1], 4), "Ray cast after mesh change")
+
+-- distances to a reference mesh; the cube is now at z from 1 to 3
+local probe = meshproc.Mesh.new()
+probe.vertex:insert(XVec3(1, 1, 2)) -- inside
+probe.vertex:insert(XVec3(1, 1, 4)) -- above
+probe.vertex:insert(XVec3(3, 3, 4)) -- beyond the corner
+probe.triangle:insert(XVec3(1, 2, 3))
+
+local dist = meshproc.compute.MeshDistance.new()
+dist.Mesh = probe
+dist.Reference = mesh
+dist:invoke()
+check(near(dist.Distances[1], 1) and near(dist.Distances[2], 1) and near(dist.Distances[3], math.sqrt(3)), "Unsigned mesh distances")
+check(near(dist.Mean, (2 + math.sqrt(3)) / 3) and near(dist.RMS, math.sqrt((2 + 3) / 3)), "Mesh distance statistics")
+check(dist.Hausdorff >= math.sqrt(3), "Symmetric Hausdorff distance")
+
+dist.Signed = true
+dist:invoke()
+check(near(dist.Distances[1], -1) and near(dist.Distances[2], 1) and near(dist.Distances[3], math.sqrt(3)), "Signed mesh distances")
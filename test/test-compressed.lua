@@ -0,0 +1,48 @@
+--
+-- Test script
+-- Writes a scene as compressed mesh, reads it back, and writes both as Wavefront OBJ for comparison
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+
+local make = meshproc.generator.SphereIco.new()
+make["Iterations"] = 2
+make:invoke()
+local sphere = make["Mesh"]
+
+make = meshproc.generator.Cuboid.new()
+make["SizeX"] = 2
+make["SizeY"] = 1
+make["SizeZ"] = 0.5
+make:invoke()
+local cube = make["Mesh"]
+
+local scene = meshproc.Scene.new()
+scene:place(sphere, XMat4.translate(0, 0, 0))
+scene:place(cube, XMat4.translate(1.5, -0.5, -0.25))
+
+local file = meshproc.io.CompressedMeshWriter.new()
+file["Scene"] = scene
+file["Path"] = "test-compressed.mpcm"
+file["Bits"] = 24
+file["BlockSize"] = 64
+file:invoke()
+
+file = meshproc.io.CompressedMeshReader.new()
+file["Path"] = "test-compressed.mpcm"
+file:invoke()
+local roundtrip = file["Mesh"]
+if not roundtrip:is_valid() then
+	error("Roundtrip mesh is not valid")
+end
+
+file = meshproc.io.ObjWriter.new()
+file["Scene"] = roundtrip
+file["Path"] = "test-compressed.obj"
+file:invoke()
+
+file["Scene"] = scene
+file["Path"] = "test-compressed-1.obj"
+file:invoke()
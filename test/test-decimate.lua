@@ -0,0 +1,96 @@
+--
+-- Test script
+-- Quadric error metric decimation
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+local check = require("check")
+
+local make = meshproc.generator.Torus.new()
+make["NumSegmentsMajor"] = 200
+make["NumSegmentsMinor"] = 50
+make:invoke()
+local original = make["Mesh"]
+make:invoke()
+local mesh = make["Mesh"]
+
+-- vertex positions as attributes, so the interpolated values stay close to the collapsed positions
+local function positions(mesh)
+	local list = meshproc.Vec3List.new()
+	for i = 1, #mesh.vertex do
+		list:insert(mesh.vertex[i])
+	end
+	return list
+end
+
+local function checkAttributes(mesh, attributes, msg)
+	check(#attributes == #mesh.vertex, msg .. ": attributes compacted with vertices")
+	local maxDev = 0
+	for i = 1, #mesh.vertex do
+		maxDev = math.max(maxDev, (attributes[i] - mesh.vertex[i]):length())
+	end
+	check(maxDev < 0.1, msg .. ": attributes interpolated")
+end
+
+local attributes = positions(mesh)
+local decimate = meshproc.edit.Decimate.new()
+decimate.Mesh = mesh
+decimate.TargetTriangleCount = 2000
+decimate.Attributes = attributes
+decimate:invoke()
+check(#mesh.triangle <= 2000 and #mesh.triangle > 1500, "Decimate to target triangle count")
+check(mesh:is_valid(), "Decimated mesh is valid")
+checkAttributes(mesh, attributes, "Decimate")
+
+local dist = meshproc.compute.MeshDistance.new()
+dist.Mesh = mesh
+dist.Reference = original
+dist:invoke()
+check(dist.Hausdorff < 0.02, "Decimated mesh deviation")
+check(decimate.Error > 0 and decimate.Error < 0.02, "Decimation error")
+
+-- large enough to be decimated in partitions first
+make["NumSegmentsMajor"] = 600
+make["NumSegmentsMinor"] = 250
+make:invoke()
+local largeOriginal = make["Mesh"]
+make:invoke()
+local large = make["Mesh"]
+check(#large.triangle > 2 * 0x10000, "Mesh large enough for partitions")
+
+attributes = positions(large)
+decimate = meshproc.edit.Decimate.new()
+decimate.Mesh = large
+decimate.TargetTriangleCount = 20000
+decimate.Attributes = attributes
+decimate:invoke()
+check(#large.triangle <= 20000 and #large.triangle > 15000, "Decimate partitioned mesh to target triangle count")
+check(large:is_valid(), "Decimated partitioned mesh is valid")
+checkAttributes(large, attributes, "Decimate partitioned")
+
+dist.Mesh = large
+dist.Reference = largeOriginal
+dist:invoke()
+check(dist.Hausdorff < 0.02, "Decimated partitioned mesh deviation")
+
+-- only collapses below the error bound
+local grid = meshproc.generator.Grid.new()
+grid["NumSegmentsX"] = 20
+grid["NumSegmentsY"] = 20
+grid:invoke()
+local flat = grid["Mesh"]
+local openBorder = meshproc.compute.OpenBorder.new()
+openBorder.Mesh = flat
+openBorder:invoke()
+local borderCnt = #openBorder.EdgeLists[1]
+
+decimate = meshproc.edit.Decimate.new()
+decimate.Mesh = flat
+decimate.MaxError = 0.0001
+decimate.LockBoundary = true
+decimate:invoke()
+check(#flat.triangle < 800 and flat:is_valid(), "Decimate planar mesh")
+openBorder:invoke()
+check(#openBorder.EdgeLists[1] == borderCnt, "Boundary locked")
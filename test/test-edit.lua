@@ -0,0 +1,88 @@
+--
+-- Test script
+-- Batched edit transactions of mesh vertex and triangle lists
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+local check = require("check")
+
+local make = meshproc.generator.Grid.new()
+make["NumSegmentsX"] = 4
+make["NumSegmentsY"] = 4
+make:invoke()
+local mesh = make["Mesh"]
+local vertCnt = #mesh.vertex
+local triCnt = #mesh.triangle
+
+-- remove all vertices of the first column, and the last triangle
+local minX = mesh.vertex[1].x
+for i = 2, vertCnt do
+	minX = math.min(minX, mesh.vertex[i].x)
+end
+
+local removed = {}
+local removedCnt = 0
+mesh:begin_edit()
+for i = 1, vertCnt do
+	if mesh.vertex[i].x == minX then
+		mesh.vertex:remove(i)
+		removed[i] = true
+		removedCnt = removedCnt + 1
+	end
+	check(#mesh.vertex == vertCnt, "Vertex indices not stable during edit")
+end
+mesh.triangle:remove(triCnt)
+check(#mesh.triangle == triCnt, "Triangle indices not stable during edit")
+
+-- positioned inserts are appended during the edit, and moved to their position at commit
+mesh.vertex:insert(1, XVec3(-1, -1, -1))
+check(#mesh.vertex == vertCnt + 1 and mesh.vertex[vertCnt + 1].x == -1, "Positioned insert not appended during edit")
+local ok = pcall(function() mesh.vertex:resize(1) end)
+check(not ok, "Shrinking resize during edit not rejected")
+ok = pcall(function() mesh:begin_edit() end)
+check(not ok, "Nested edit not rejected")
+
+local keptTriCnt = 0
+for i = 1, triCnt - 1 do
+	local t = mesh.triangle[i]
+	if not (removed[t.x] or removed[t.y] or removed[t.z]) then
+		keptTriCnt = keptTriCnt + 1
+	end
+end
+
+-- appending is allowed, and all indices refer to the mesh state before the commit
+local kept = {}
+for i = 1, vertCnt do
+	if not removed[i] then
+		table.insert(kept, i)
+	end
+end
+mesh.vertex:insert(XVec3(0, 0, 1))
+mesh.triangle:insert(XVec3(kept[1], kept[2], vertCnt + 2))
+mesh.triangle:insert(1, XVec3(kept[1], kept[2], vertCnt + 1))
+local keptVertex = mesh.vertex[kept[1]]
+mesh:commit()
+
+check(removedCnt > 0, "No vertices selected")
+check(#mesh.vertex == vertCnt - removedCnt + 2, "Vertex count mismatch after commit")
+check(#mesh.triangle == keptTriCnt + 2, "Triangle count mismatch after commit")
+check(mesh:is_valid(), "Mesh not valid after commit")
+check(mesh.vertex[1].x == -1, "Positioned vertex insert not moved at commit")
+local t = mesh.triangle[1]
+check(t.z == 1 and mesh.vertex[t.x].x == keptVertex.x and mesh.vertex[t.x].y == keptVertex.y, "Positioned triangle insert not moved and remapped at commit")
+for i = 2, vertCnt - removedCnt + 1 do
+	check(mesh.vertex[i].x ~= minX, "Removed vertex still present")
+end
+
+-- outside of an edit, removals are applied immediately
+local sel = meshproc.IndexList.new()
+sel:insert(1)
+sel:insert(2)
+mesh.vertex:remove(sel)
+check(#mesh.vertex == vertCnt - removedCnt, "Immediate vertex removal failed")
+check(mesh:is_valid(), "Mesh not valid after immediate removal")
+
+ok = pcall(function() mesh:commit() end)
+check(not ok, "Commit without edit not rejected")
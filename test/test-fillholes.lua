@@ -0,0 +1,72 @@
+--
+-- Test script
+-- Filling holes of open meshes
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+local check = require("check")
+local volume = require("measure").volume
+
+local function removeTriangles(mesh, pred)
+	for i = #mesh.triangle, 1, -1 do
+		local t = mesh.triangle[i]
+		local a = mesh.vertex[t.x]
+		local b = mesh.vertex[t.y]
+		local c = mesh.vertex[t.z]
+		if pred((a.x + b.x + c.x) / 3, (a.y + b.y + c.y) / 3, (a.z + b.z + c.z) / 3) then
+			mesh.triangle:remove(i)
+		end
+	end
+end
+
+local openBorder = meshproc.compute.OpenBorder.new()
+local function openLoopCount(mesh)
+	openBorder.Mesh = mesh
+	openBorder:invoke()
+	return #openBorder.EdgeLists
+end
+
+-- planar hole
+local make = meshproc.generator.Cuboid.new()
+make:invoke()
+local cube = make["Mesh"]
+removeTriangles(cube, function(x, y, z) return z > 0.99 end)
+check(openLoopCount(cube) == 1, "Cube is open")
+
+local fill = meshproc.edit.FillHoles.new()
+fill.Mesh = cube
+fill:invoke()
+check(fill.FilledCount == 1, "Planar hole filled")
+check(openLoopCount(cube) == 0 and cube:is_valid(), "Cube is closed")
+check(math.abs(volume(cube) - 1) < 1e-5, "Cube volume restored")
+
+-- small and large non-planar holes, given explicitly
+make = meshproc.generator.SphereIco.new()
+make["Iterations"] = 4
+make:invoke()
+local sphere = make["Mesh"]
+removeTriangles(sphere, function(x, y, z) return z > 0.5 or (x - 1) * (x - 1) + y * y + z * z < 0.02 end)
+openBorder.Mesh = sphere
+openBorder:invoke()
+check(#openBorder.EdgeLists == 2, "Sphere has two holes")
+
+fill = meshproc.edit.FillHoles.new()
+fill.Mesh = sphere
+fill.Loops = openBorder.EdgeLists
+fill:invoke()
+check(fill.FilledCount == 2, "Both sphere holes filled")
+check(openLoopCount(sphere) == 0 and sphere:is_valid(), "Sphere is closed")
+local cap = math.pi * 0.25 * (3 - 0.5) / 3
+check(volume(sphere) > 4 / 3 * math.pi - cap - 0.1 and volume(sphere) < 4 / 3 * math.pi, "Sphere volume with flat cap")
+
+-- holes with too many edges are left open
+make:invoke()
+sphere = make["Mesh"]
+removeTriangles(sphere, function(x, y, z) return z > 0.5 end)
+fill = meshproc.edit.FillHoles.new()
+fill.Mesh = sphere
+fill.MaxEdges = 10
+fill:invoke()
+check(fill.FilledCount == 0 and openLoopCount(sphere) == 1, "Large hole left open")
@@ -0,0 +1,69 @@
+--
+-- Test script
+-- Generates the synthetic stress meshes single-threaded and multi-threaded, and writes both as Wavefront OBJ for comparison
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+
+local function generate(path)
+	local scene = meshproc.Scene.new()
+	local function place(mesh, x, y)
+		if not mesh:is_valid() then
+			error("Generated mesh is not valid")
+		end
+		scene:place(mesh, XMat4.translate(x, y, 0))
+	end
+
+	local make = meshproc.generator.Torus.new()
+	make["NumSegmentsMajor"] = 24
+	make["NumSegmentsMinor"] = 8
+	make:invoke()
+	if #make["Mesh"].triangle ~= 24 * 8 * 2 then
+		error("Torus triangle count mismatch")
+	end
+	place(make["Mesh"], 0, 0)
+
+	make = meshproc.generator.Grid.new()
+	make["NumSegmentsX"] = 6
+	make["NumSegmentsY"] = 4
+	make:invoke()
+	if #make["Mesh"].vertex ~= 7 * 5 then
+		error("Grid vertex count mismatch")
+	end
+	place(make["Mesh"], 2, 0)
+
+	make = meshproc.generator.NoisyPatch.new()
+	make["NumSegments"] = 32
+	make["NumHoles"] = 3
+	make["HoleRadius"] = 0.1
+	make["Seed"] = 42
+	make:invoke()
+	if #make["Mesh"].triangle >= 32 * 32 * 2 then
+		error("NoisyPatch has no holes")
+	end
+	place(make["Mesh"], 4, 0)
+
+	make = meshproc.generator.ComponentSoup.new()
+	make["NumComponents"] = 5
+	make["Seed"] = 42
+	make:invoke()
+	place(make["Mesh"], 0, 10)
+
+	make = meshproc.generator.NonManifold.new()
+	make["NumSegments"] = 3
+	make:invoke()
+	place(make["Mesh"], 6, 0)
+
+	local file = meshproc.io.ObjWriter.new()
+	file["Scene"] = scene
+	file["Path"] = path
+	file:invoke()
+end
+
+meshproc.set_threads(1)
+generate("test-generators-1.obj")
+
+meshproc.set_threads(4)
+generate("test-generators.obj")
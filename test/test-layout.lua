@@ -0,0 +1,38 @@
+--
+-- Test script
+-- Reorders a mesh with SpatialSort and OptimizeLayout, and writes it and the original as Wavefront OBJ for comparison
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local make = meshproc.generator.SphereIco.new()
+make["Iterations"] = 3
+make:invoke()
+local sphere = make["Mesh"]
+
+local file = meshproc.io.ObjWriter.new()
+file["Scene"] = sphere
+file["Path"] = "test-layout-1.obj"
+file:invoke()
+
+local sort = meshproc.edit.SpatialSort.new()
+sort["Mesh"] = sphere
+sort["Curve"] = "Hilbert"
+sort:invoke()
+if #sort["Remap"] ~= #sphere.vertex then
+	error("SpatialSort remap size mismatch")
+end
+
+local opt = meshproc.edit.OptimizeLayout.new()
+opt["Mesh"] = sphere
+opt:invoke()
+if opt["AcmrAfter"] > opt["AcmrBefore"] then
+	error("OptimizeLayout increased ACMR")
+end
+if not sphere:is_valid() then
+	error("Reordered mesh is not valid")
+end
+
+file["Scene"] = sphere
+file["Path"] = "test-layout.obj"
+file:invoke()
@@ -0,0 +1,152 @@
+--
+-- Test script
+-- Bulk operations on FloatList, IndexList and Vec3List
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+local check = require("check")
+
+local function near(a, b)
+	return math.abs(a - b) < 1e-5
+end
+
+local f = meshproc.FloatList.new()
+for i = 1, 10 do
+	f:insert(i)
+end
+
+check(f:sum() == 55, "FloatList sum")
+check(f:mean() == 5.5, "FloatList mean")
+check(f:min() == 1 and f:max() == 10, "FloatList min/max")
+
+local g = f:clone():mul(2):sub(1)
+check(g[1] == 1 and g[10] == 19, "FloatList arithmetic with numbers")
+check(f[1] == 1, "FloatList clone is independent")
+g:div(f)
+check(near(g[2], 1.5), "FloatList arithmetic with lists")
+check(f:clone():clamp(3, 7):sum() == 3 * 3 + 4 + 5 + 6 + 7 * 4, "FloatList clamp")
+
+local s = f:slice(3, 5)
+check(#s == 3 and s[1] == 3 and s[3] == 5, "FloatList slice")
+
+local r = meshproc.FloatList.new()
+for _, v in ipairs({ 3, 1, 2, 1 }) do
+	r:insert(v)
+end
+local order = r:argsort()
+check(order[1] == 2 and order[2] == 4 and order[3] == 3 and order[4] == 1, "FloatList argsort is stable")
+local gathered = r:gather(order)
+check(gathered[1] == 1 and gathered[4] == 3, "FloatList gather")
+r:sort()
+check(r[1] == 1 and r[2] == 1 and r[3] == 2 and r[4] == 3, "FloatList sort")
+
+local sel = meshproc.IndexList.new()
+sel:insert(4)
+sel:insert(2)
+sel:insert(4)
+sel:unique()
+check(#sel == 2 and sel[1] == 2 and sel[2] == 4, "IndexList unique")
+check(sel:min() == 2 and sel:max() == 4, "IndexList min/max")
+f:scatter(sel, 0)
+check(f[2] == 0 and f[4] == 0 and f[3] == 3, "FloatList scatter")
+
+local grad = f:slice(1, 3):map_gradient({ 0, 10 }, { 100, 200 })
+check(near(grad[1], 110) and grad[2] == 100 and near(grad[3], 130), "FloatList map_gradient")
+
+local v = meshproc.Vec3List.new()
+v:insert(XVec3(1, 0, 0))
+v:insert(XVec3(0, 2, 0))
+v:insert(XVec3(0, 0, 3))
+local len = v:lengths()
+check(len[1] == 1 and len[2] == 2 and len[3] == 3, "Vec3List lengths")
+v:normalize()
+check(v:lengths():sum() == 3, "Vec3List normalize")
+v:mul(len)
+check(v[3].z == 3, "Vec3List mul by FloatList")
+v:add(XVec3(1, 1, 1))
+check(v:min().x == 1 and v:max().z == 4, "Vec3List add vector, min/max")
+check(v:dot(XVec3(0, 0, 1))[3] == 4, "Vec3List dot")
+local mean = v:mean()
+check(near(mean.x, 4 / 3) and near(mean.y, 5 / 3) and near(mean.z, 2), "Vec3List mean")
+
+local colors = f:map_gradient({ 0, 10 }, v:slice(1, 2))
+check(#colors == #f and colors[2].x == 2, "FloatList map_gradient to Vec3List")
+
+local make = meshproc.generator.Cuboid.new()
+make:invoke()
+local cube = make["Mesh"]
+local view = cube.vertices
+check(#view == #cube.vertex, "Mesh vertices view length")
+view:add(XVec3(1, 0, 0))
+check(cube.vertex[1].x == view[1].x and view:min().x == 1, "Mesh vertices view shares storage")
+view:set_component("z", view:component(1))
+check(cube.vertex[2].z == cube.vertex[2].x, "Vec3List component views")
+view:insert(XVec3(0, 0, 0))
+check(#view == #cube.vertex + 1 and cube:is_valid(), "Mesh vertices view is copied when resized")
+
+-- views bound to parameters the command writes are copied, so the command does not change the mesh twice
+local makeSphere = meshproc.generator.SphereIco.new()
+makeSphere["Iterations"] = 3
+makeSphere:invoke()
+local sphere = makeSphere["Mesh"]
+local positions = sphere.vertices
+local sort = meshproc.edit.SpatialSort.new()
+sort.Mesh = sphere
+sort.Vectors = positions
+sort:invoke()
+local sorted = true
+for i = 1, #sphere.vertex do
+	local v = sort.Vectors[i]
+	sorted = sorted and v.x == sphere.vertex[i].x and v.y == sphere.vertex[i].y and v.z == sphere.vertex[i].z
+end
+check(sorted and sphere:is_valid(), "Mesh vertices view permuted once as SpatialSort Vectors")
+local first = sphere.vertex[1]
+sphere.vertex[1] = XVec3(5, 5, 5)
+check(positions[1].x == 5, "Mesh vertices view still shares storage after binding")
+sphere.vertex[1] = first
+local decimate = meshproc.edit.Decimate.new()
+decimate.Mesh = sphere
+decimate.TargetTriangleCount = #sphere.triangle // 2
+decimate.Attributes = sphere.vertices
+decimate:invoke()
+check(sphere:is_valid() and #decimate.Attributes == #sphere.vertex, "Mesh vertices view compacted once as Decimate Attributes")
+
+local selA = meshproc.Selection.new(10)
+selA[2] = true
+selA[5] = true
+local selB = meshproc.Selection.new(sel, 10)
+check(#selB == 10 and selB[2] and selB[4] and not selB[3], "Selection from IndexList")
+check(selA:clone():union(selB):count() == 3, "Selection union")
+check(selA:clone():intersect(selB):count() == 1, "Selection intersect")
+check(selA:clone():subtract(sel):count() == 1, "Selection subtract IndexList")
+local inv = selA:clone():invert()
+check(inv:count() == 8 and not inv[2] and inv[10], "Selection invert")
+local idx = inv:to_indexlist()
+check(#idx == 8 and idx[1] == 1 and idx[2] == 3, "Selection to IndexList")
+
+cube.vertex:insert(XVec3(5, 5, 5)) -- isolated vertex
+local comp = meshproc.edit.SelectConnectedComponentVertices.new()
+comp.Mesh = cube
+comp.Selection = meshproc.Selection.new(#cube.vertex)
+comp.Selection[1] = true
+comp:invoke()
+check(comp.Selection:count() == #cube.vertex - 1, "SelectConnectedComponentVertices with Selection")
+local invCmd = meshproc.edit.InvertVertexSelection.new()
+invCmd.Mesh = cube
+local invList = comp.Selection:to_indexlist()
+invCmd.Selection = invList
+invCmd:invoke()
+check(#invList == 1 and invList[1] == #cube.vertex and invCmd.Selection[1] == #cube.vertex, "InvertVertexSelection updates IndexList in place")
+local invSel = comp.Selection:clone()
+invCmd.Selection = invSel
+invCmd:invoke()
+check(invSel:count() == 1 and invSel[#cube.vertex] and invCmd.Selection:count() == 1, "InvertVertexSelection updates Selection in place")
+local compList = meshproc.IndexList.new()
+compList:insert(1)
+comp.Selection = compList
+comp:invoke()
+check(#compList == #cube.vertex - 1 and #comp.Selection == #cube.vertex - 1 and comp.Selection[2] == 2, "SelectConnectedComponentVertices returns IndexList for IndexList")
+
+log.write("All list operations passed")
@@ -0,0 +1,44 @@
+--
+-- Test script
+-- Loops extracted from edge sets with shared vertices and open chains
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+local check = require("check")
+
+-- figure-eight: two triangles touching at vertex 1
+local mesh = meshproc.Mesh.new()
+mesh.vertex:insert(XVec3(0, 0, 0))
+mesh.vertex:insert(XVec3(1, 0, 0))
+mesh.vertex:insert(XVec3(0, 1, 0))
+mesh.vertex:insert(XVec3(-1, 0, 0))
+mesh.vertex:insert(XVec3(0, -1, 0))
+mesh.triangle:insert(XVec3(1, 2, 3))
+mesh.triangle:insert(XVec3(1, 4, 5))
+
+local openBorder = meshproc.compute.OpenBorder.new()
+openBorder.Mesh = mesh
+openBorder:invoke()
+local loops = openBorder.EdgeLists
+check(#loops == 2, "Figure-eight splits into two loops")
+for _, loop in ipairs(loops) do
+	check(#loop == 3, "Figure-eight loop is a triangle")
+	check(loop[1] == 1, "Figure-eight loop starts at the shared vertex")
+end
+check(loops[1][2] == 2 and loops[2][2] == 4, "Figure-eight loops continue at the smallest neighbor")
+
+-- open chain: the cut of an open grid does not close, and must not be cut as a loop
+local make = meshproc.generator.Grid.new()
+make:invoke()
+local grid = make["Mesh"]
+local triCnt = #grid.triangle
+
+local cut = meshproc.edit.CutPlaneLoop.new()
+cut.Mesh = grid
+cut.Point = XVec3(0.55, 0.5, 0)
+cut.Plane = meshproc.HalfSpace.new()
+cut.Plane:set(XVec3(1, 0, 0), cut.Point)
+check(not cut:invoke(), "Open chain is not returned as loop")
+check(#grid.triangle == triCnt, "Grid triangles unchanged by the rejected cut")
@@ -0,0 +1,64 @@
+--
+-- Test script
+-- Reads a directory of mixed mesh file formats, and files without reader, concurrently
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+local check = require("check")
+
+-- directory 'test-multireader' and its subdirectory 'sub' are created by the calling script
+local function write(writer, mesh, path)
+	local scene = meshproc.Scene.new()
+	scene:place(mesh, XMat4.translate(0, 0, 0))
+	local file = writer.new()
+	file["Scene"] = scene
+	file["Path"] = path
+	file:invoke()
+end
+
+local make = meshproc.generator.Cuboid.new()
+make:invoke()
+local cube = make["Mesh"]
+make = meshproc.generator.SphereIco.new()
+make["Iterations"] = 2
+make:invoke()
+local sphere = make["Mesh"]
+make = meshproc.generator.Torus.new()
+make:invoke()
+local torus = make["Mesh"]
+
+write(meshproc.io.ObjWriter, cube, "test-multireader/a-cube.obj")
+write(meshproc.io.StlWriter, sphere, "test-multireader/b-sphere.stl")
+write(meshproc.io.PlyWriter, torus, "test-multireader/c-torus.ply")
+write(meshproc.io.ObjWriter, sphere, "test-multireader/sub/d-sphere.obj")
+local notes = io.open("test-multireader/notes.txt", "w")
+notes:write("not a mesh\n")
+notes:close()
+
+local reader = meshproc.io.MultiReader.new()
+reader.Directory = "test-multireader"
+reader:invoke()
+check(#reader.Meshes == 3 and #reader.Files == 3, "Only files with a reader are loaded")
+check(reader.Files[1]:find("a%-cube%.obj$") ~= nil, "Files in sorted order")
+check(reader.Files[3]:find("c%-torus%.ply$") ~= nil, "Files in sorted order")
+check(#reader.Meshes[1].triangle == #cube.triangle, "OBJ loaded")
+check(#reader.Meshes[2].triangle == #sphere.triangle, "STL loaded")
+check(#reader.Meshes[3].triangle == #torus.triangle, "PLY loaded")
+for i = 1, #reader.Meshes do
+	check(reader.Meshes[i]:is_valid(), "Loaded mesh is valid")
+end
+
+reader.Recursive = true
+reader:invoke()
+check(#reader.Meshes == 4, "Subdirectories loaded")
+check(reader.Files[4]:find("d%-sphere%.obj$") ~= nil, "Subdirectory files in sorted order")
+
+reader.Pattern = "*.obj"
+reader:invoke()
+check(#reader.Meshes == 2, "Files filtered by pattern")
+
+reader = meshproc.io.MultiReader.new()
+reader.Directory = "test-multireader/missing"
+check(not reader:invoke(), "Missing directory fails")
@@ -0,0 +1,22 @@
+--
+-- Test script
+-- Invokes a known sequence of commands; run with profiling, the calling script checks the written profile
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local make = meshproc.generator.SphereIco.new()
+make["Iterations"] = 3
+make:invoke()
+make:invoke()
+local sphere = make["Mesh"]
+
+local decimate = meshproc.edit.Decimate.new()
+decimate.Mesh = sphere
+decimate.TargetTriangleCount = 500
+decimate:invoke()
+
+-- fails, as the mesh is missing
+decimate = meshproc.edit.Decimate.new()
+decimate.TargetTriangleCount = 500
+decimate:invoke()
@@ -0,0 +1,58 @@
+--
+-- Test script
+-- Isotropic remeshing
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+local check = require("check")
+
+local make = meshproc.generator.Torus.new()
+make["NumSegmentsMajor"] = 64
+make["NumSegmentsMinor"] = 32
+make:invoke()
+local original = make["Mesh"]
+make:invoke()
+local mesh = make["Mesh"]
+
+local remesh = meshproc.edit.Remesh.new()
+remesh.Mesh = mesh
+remesh.TargetEdgeLength = 0.05
+remesh:invoke()
+check(mesh:is_valid(), "Remeshed mesh is valid")
+-- about the area of the torus over the area of an equilateral triangle of the target edge length
+check(#mesh.triangle > 6000 and #mesh.triangle < 12000, "Remeshed to target edge length")
+
+local dist = meshproc.compute.MeshDistance.new()
+dist.Mesh = mesh
+dist.Reference = original
+dist:invoke()
+check(dist.Hausdorff < 0.005, "Remeshed mesh deviation")
+
+-- corners and sharp edges are preserved
+local cube = meshproc.generator.Cuboid.new()
+cube:invoke()
+mesh = cube["Mesh"]
+remesh = meshproc.edit.Remesh.new()
+remesh.Mesh = mesh
+remesh.TargetEdgeLength = 0.1
+remesh:invoke()
+check(mesh:is_valid() and #mesh.triangle > 1000, "Remeshed cuboid")
+
+local minPos = { math.huge, math.huge, math.huge }
+local maxPos = { -math.huge, -math.huge, -math.huge }
+for i = 1, #mesh.vertex do
+	local v = mesh.vertex[i]
+	minPos = { math.min(minPos[1], v.x), math.min(minPos[2], v.y), math.min(minPos[3], v.z) }
+	maxPos = { math.max(maxPos[1], v.x), math.max(maxPos[2], v.y), math.max(maxPos[3], v.z) }
+end
+for i = 1, 3 do
+	check(math.abs(maxPos[i] - minPos[i] - 1) < 1e-5, "Cuboid corners preserved")
+end
+
+dist.Mesh = mesh
+cube:invoke()
+dist.Reference = cube["Mesh"]
+dist:invoke()
+check(dist.Hausdorff < 1e-4, "Cuboid faces preserved")
@@ -0,0 +1,64 @@
+--
+-- Test script
+-- Self-intersection detection
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+local check = require("check")
+
+local selfIntersections = meshproc.compute.SelfIntersections.new()
+
+-- closed meshes do not intersect themselves, touching neighbors do not count
+local make = meshproc.generator.Torus.new()
+make["NumSegmentsMajor"] = 100
+make["NumSegmentsMinor"] = 30
+make:invoke()
+selfIntersections.Mesh = make["Mesh"]
+selfIntersections:invoke()
+check(not selfIntersections.Intersecting, "Torus does not intersect itself")
+check(#selfIntersections.Pairs == 0, "No pairs reported")
+check(not selfIntersections.Vertices:any(), "No vertices selected")
+
+make = meshproc.generator.Grid.new()
+make["NumSegmentsX"] = 10
+make["NumSegmentsY"] = 10
+make:invoke()
+selfIntersections.Mesh = make["Mesh"]
+selfIntersections:invoke()
+check(not selfIntersections.Intersecting, "Planar grid does not intersect itself")
+
+-- two overlapping cubes in one mesh
+make = meshproc.generator.Cuboid.new()
+make:invoke()
+local mesh = make["Mesh"]
+make:invoke()
+local other = make["Mesh"]
+other:apply_transform(XMat4.translate(0.3, 0.4, 0.2))
+local vertCnt = #mesh.vertex
+for i = 1, #other.vertex do
+	mesh.vertex:insert(other.vertex[i])
+end
+for i = 1, #other.triangle do
+	local t = other.triangle[i]
+	mesh.triangle:insert(XVec3(t.x + vertCnt, t.y + vertCnt, t.z + vertCnt))
+end
+local triCnt = #mesh.triangle / 2
+
+selfIntersections.Mesh = mesh
+selfIntersections:invoke()
+check(selfIntersections.Intersecting, "Overlapping cubes intersect")
+local pairCnt = #selfIntersections.Pairs
+check(pairCnt > 0, "Intersecting pairs reported")
+for i = 1, pairCnt do
+	local p = selfIntersections.Pairs[i]
+	check(#p == 2 and p[1] <= triCnt and p[2] > triCnt, "Pairs are between both cubes")
+end
+check(#selfIntersections.Vertices == #mesh.vertex, "Vertex selection size")
+check(selfIntersections.Vertices:any(), "Vertices of intersecting triangles selected")
+
+selfIntersections.FirstOnly = true
+selfIntersections:invoke()
+check(selfIntersections.Intersecting, "First only still reports the intersection")
+check(#selfIntersections.Pairs == 1, "First only reports one pair")
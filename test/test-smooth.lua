@@ -0,0 +1,66 @@
+--
+-- Test script
+-- Laplacian, Taubin and cotangent smoothing
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+local check = require("check")
+
+local function makeNoisySphere()
+	local make = meshproc.generator.SphereIco.new()
+	make["Iterations"] = 4
+	make:invoke()
+	local mesh = make["Mesh"]
+	local normals = meshproc.compute.VertexNormals.new()
+	normals.Mesh = mesh
+	normals:invoke()
+	local noise = meshproc.edit.DisplacementNoise.new()
+	noise.Mesh = mesh
+	noise.Dirs = normals.Normals
+	noise.Min = -0.02
+	noise.Max = 0.02
+	noise.Seed = 42
+	noise:invoke()
+	return mesh
+end
+
+-- standard deviation and mean of the distances of the vertices from the origin
+local function radii(mesh)
+	local len = mesh.vertices:lengths()
+	local mean = len:mean()
+	local dev = len:clone():sub(mean)
+	return math.sqrt(dev:mul(dev):mean()), mean
+end
+
+local noisyDev, noisyMean = radii(makeNoisySphere())
+
+for _, method in ipairs({ "Laplacian", "Taubin", "Cotangent" }) do
+	local mesh = makeNoisySphere()
+	local smooth = meshproc.edit.Smooth.new()
+	smooth.Mesh = mesh
+	smooth.Method = method
+	smooth:invoke()
+	local dev, mean = radii(mesh)
+	check(dev < noisyDev * 0.5, method .. " reduces noise")
+	if method == "Taubin" then
+		check(math.abs(mean - noisyMean) < 0.002, "Taubin preserves volume")
+	end
+end
+
+-- restricted to a selection
+local mesh = makeNoisySphere()
+local before = mesh.vertices:clone()
+local smooth = meshproc.edit.Smooth.new()
+smooth.Mesh = mesh
+smooth.Selection = meshproc.Selection.new(#mesh.vertex)
+smooth.Selection[7] = true
+smooth:invoke()
+local moved = 0
+for i = 1, #mesh.vertex do
+	if (mesh.vertex[i] - before[i]):length() > 0 then
+		moved = moved + 1
+	end
+end
+check(moved == 1, "Smoothing restricted to selection")
@@ -0,0 +1,58 @@
+--
+-- Test script
+-- Streams a mesh file through transform, cut and attribute stages in small chunks, and checks the written file
+--
+meshproc.Version.assert_or_newer(0, 6, 0)
+meshproc.Version.assert_older_than(0, 7, 0)
+
+local xyz_math = require("xyz_math")
+local check = require("check")
+
+-- unit sphere as input file
+local make = meshproc.generator.SphereIco.new()
+make["Iterations"] = 4
+make:invoke()
+local sphere = make["Mesh"]
+
+local scene = meshproc.Scene.new()
+scene:place(sphere, XMat4.translate(0, 0, 0))
+local file = meshproc.io.StlWriter.new()
+file["Scene"] = scene
+file["Path"] = "test-streampipeline.stl"
+file:invoke()
+
+-- moved up by 2, and cut at its equator, keeping the upper half
+local cut = meshproc.HalfSpace.new()
+cut:set(XVec3(0, 0, 1), XVec3(0, 0, 2))
+
+local pipeline = meshproc.StreamPipeline.new()
+pipeline:read("test-streampipeline.stl")
+	:transform(XMat4.translate(0, 0, 2))
+	:cut(cut)
+	:compute("normal")
+	:set_chunk_size(256)
+	:write("test-streampipeline.ply")
+check(pipeline:run(), "Pipeline run")
+
+local stats = pipeline:stats()
+check(stats.triangles_read == #sphere.triangle, "All triangles read")
+check(stats.chunks >= #sphere.triangle / 256, "Processed in chunks")
+check(stats.triangles_written > #sphere.triangle * 0.4 and stats.triangles_written < #sphere.triangle * 0.6, "Half of the triangles written")
+
+file = meshproc.io.PlyReader.new()
+file["Path"] = "test-streampipeline.ply"
+file:invoke()
+local result = file["Mesh"]
+check(result:is_valid(), "Written mesh is valid")
+check(#result.triangle == stats.triangles_written, "Written triangle count")
+check(#result.vertex == stats.vertices_written, "Written vertex count")
+
+local minZ = math.huge
+local maxZ = -math.huge
+for i = 1, #result.vertex do
+	local v = result.vertex[i]
+	minZ = math.min(minZ, v.z)
+	maxZ = math.max(maxZ, v.z)
+	check(math.abs((v - XVec3(0, 0, 2)):length() - 1) < 0.01, "Vertices on the moved sphere")
+end
+check(math.abs(minZ - 2) < 1e-4 and maxZ > 2.99, "Cut at the moved equator")